@@ -92,3 +92,334 @@ TEST(TestBenchmark, TestMultipleSequenceOperationMostlyGPU)
     EXPECT_LT(totalTime, 50000000);
 }
 
+
+static int64_t
+runTensorCreateDestroyChurn(kp::Manager& mgr,
+                            uint32_t numIter,
+                            uint32_t numTensors,
+                            uint32_t numElems)
+{
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors(numTensors);
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < numIter; i++) {
+        for (auto& tensor : tensors) {
+            tensor = mgr.tensorT<float>(numElems);
+        }
+        for (auto& tensor : tensors) {
+            tensor = nullptr;
+        }
+        // Opt: Drop the expired weak references held by the manager
+        mgr.clear();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                 startTime)
+      .count();
+}
+
+TEST(TestBenchmark, TestTensorCreateDestroyChurn)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIter = 100;
+
+    uint32_t numTensors = 1000;
+    uint32_t numElems = 256;
+
+    kp::Manager mgr;
+    int64_t totalTimeNoPool =
+      runTensorCreateDestroyChurn(mgr, numIter, numTensors, numElems);
+
+    kp::Manager mgrPool;
+    mgrPool.enableMemoryPool();
+    int64_t totalTimePool =
+      runTensorCreateDestroyChurn(mgrPool, numIter, numTensors, numElems);
+
+    KP_LOG_INFO("Tensor create/destroy churn of {} tensors x {} iterations: "
+                "{}us without memory pool, {}us with memory pool",
+                numTensors,
+                numIter,
+                totalTimeNoPool,
+                totalTimePool);
+
+    // All the pooled allocations should have been returned, only the last
+    // device local and host visible blocks are kept
+    EXPECT_EQ(mgrPool.getMemoryPool()->allocationCount(), 0);
+    EXPECT_LE(mgrPool.getMemoryPool()->blockCount(), 2);
+
+    // Validating significant divergences of performance
+    // Currently configured for github actions performance
+    EXPECT_LT(totalTimeNoPool, 50000000);
+    EXPECT_LT(totalTimePool, 50000000);
+}
+
+// Records one barrier command per memory object, as operations did before
+// their barriers were batched into a single command
+class OpUnbatchedMemoryBarrier : public kp::OpBase
+{
+  public:
+    OpUnbatchedMemoryBarrier(
+      const std::vector<std::shared_ptr<kp::Memory>>& memObjects,
+      const vk::AccessFlagBits& srcAccessMask,
+      const vk::AccessFlagBits& dstAccessMask,
+      const vk::PipelineStageFlagBits& srcStageMask,
+      const vk::PipelineStageFlagBits& dstStageMask)
+      : mSrcAccessMask(srcAccessMask)
+      , mDstAccessMask(dstAccessMask)
+      , mSrcStageMask(srcStageMask)
+      , mDstStageMask(dstStageMask)
+      , mMemObjects(memObjects)
+    {
+    }
+
+    void record(const vk::CommandBuffer& commandBuffer) override
+    {
+        for (const std::shared_ptr<kp::Memory>& mem : this->mMemObjects) {
+            mem->recordPrimaryMemoryBarrier(commandBuffer,
+                                            this->mSrcAccessMask,
+                                            this->mDstAccessMask,
+                                            this->mSrcStageMask,
+                                            this->mDstStageMask);
+        }
+    }
+
+    void preEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+    void postEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+  private:
+    vk::AccessFlagBits mSrcAccessMask;
+    vk::AccessFlagBits mDstAccessMask;
+    vk::PipelineStageFlagBits mSrcStageMask;
+    vk::PipelineStageFlagBits mDstStageMask;
+    std::vector<std::shared_ptr<kp::Memory>> mMemObjects;
+};
+
+template<typename TBarrierOp>
+static void
+runBarrierBatching(kp::Manager& mgr,
+                   const std::vector<std::shared_ptr<kp::Memory>>& params,
+                   const std::shared_ptr<kp::Algorithm>& algorithm,
+                   uint32_t numIter,
+                   uint32_t numOps,
+                   int64_t& recordTime,
+                   int64_t& evalTime)
+{
+    std::shared_ptr<kp::Sequence> sequence = mgr.sequence();
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < numIter; i++) {
+        sequence->clear();
+        for (uint32_t j = 0; j < numOps; j++) {
+            sequence->record<TBarrierOp>(
+              params,
+              vk::AccessFlagBits::eShaderWrite,
+              vk::AccessFlagBits::eShaderRead,
+              vk::PipelineStageFlagBits::eComputeShader,
+              vk::PipelineStageFlagBits::eComputeShader);
+            sequence->record<kp::OpAlgoDispatch>(algorithm);
+        }
+    }
+    sequence->end();
+
+    auto midTime = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < numIter; i++) {
+        sequence->eval();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    recordTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                   midTime - startTime)
+                   .count();
+    evalTime =
+      std::chrono::duration_cast<std::chrono::microseconds>(endTime - midTime)
+        .count();
+}
+
+TEST(TestBenchmark, TestBarrierBatching)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIter = 100;
+
+    uint32_t numOps = 100;
+    uint32_t numElems = 1024;
+
+    float elemValue = 1;
+
+    // Same number of bindings as the logistic regression shader
+    std::string shader(R"(
+        #version 450
+
+        layout(local_size_x = 1) in;
+
+        layout(binding = 0) buffer restrict readonly  bIn0 { float in0[]; };
+        layout(binding = 1) buffer restrict readonly  bIn1 { float in1[]; };
+        layout(binding = 2) buffer restrict readonly  bIn2 { float in2[]; };
+        layout(binding = 3) buffer restrict readonly  bIn3 { float in3[]; };
+        layout(binding = 4) buffer restrict readonly  bIn4 { float in4[]; };
+        layout(binding = 5) buffer restrict readonly  bIn5 { float in5[]; };
+        layout(binding = 6) buffer restrict readonly  bIn6 { float in6[]; };
+        layout(binding = 7) buffer restrict readonly  bIn7 { float in7[]; };
+        layout(binding = 8) buffer restrict writeonly bOut { float out_[]; };
+
+        void main() {
+            const uint i = gl_GlobalInvocationID.x;
+            out_[i] = in0[i] + in1[i] + in2[i] + in3[i] +
+                      in4[i] + in5[i] + in6[i] + in7[i];
+        }
+    )");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Memory>> params;
+    for (uint32_t i = 0; i < 8; i++) {
+        params.push_back(mgr.tensor(std::vector<float>(numElems, elemValue)));
+    }
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensor(std::vector<float>(numElems, 0));
+    params.push_back(tensorOut);
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(params, spirv);
+
+    mgr.sequence()->eval<kp::OpSyncDevice>(params);
+
+    int64_t recordTimeUnbatched = 0;
+    int64_t evalTimeUnbatched = 0;
+    runBarrierBatching<OpUnbatchedMemoryBarrier>(mgr,
+                                                 params,
+                                                 algorithm,
+                                                 numIter,
+                                                 numOps,
+                                                 recordTimeUnbatched,
+                                                 evalTimeUnbatched);
+
+    int64_t recordTimeBatched = 0;
+    int64_t evalTimeBatched = 0;
+    runBarrierBatching<kp::OpMemoryBarrier>(mgr,
+                                            params,
+                                            algorithm,
+                                            numIter,
+                                            numOps,
+                                            recordTimeBatched,
+                                            evalTimeBatched);
+
+    KP_LOG_INFO("Barriers on {} memory objects x {} operations: record {}us "
+                "and eval {}us with one barrier command per memory object, "
+                "record {}us and eval {}us with batched barriers",
+                params.size(),
+                numOps,
+                recordTimeUnbatched,
+                evalTimeUnbatched,
+                recordTimeBatched,
+                evalTimeBatched);
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorOut });
+
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>(numElems, elemValue * 8));
+
+    // Validating significant divergences of performance
+    // Currently configured for github actions performance
+    EXPECT_LT(recordTimeUnbatched + evalTimeUnbatched, 50000000);
+    EXPECT_LT(recordTimeBatched + evalTimeBatched, 50000000);
+}
+
+static int64_t
+runSequenceSubmission(
+  kp::Manager& mgr,
+  const std::vector<std::shared_ptr<kp::Sequence>>& sequences,
+  uint32_t numIter,
+  bool batched)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < numIter; i++) {
+        if (batched) {
+            // Opt: Submit all the sequences with a single submission
+            mgr.evalAsync(sequences);
+            mgr.evalAwait(sequences);
+        } else {
+            for (auto& sequence : sequences) {
+                sequence->evalAsync();
+            }
+            for (auto& sequence : sequences) {
+                sequence->evalAwait();
+            }
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(endTime -
+                                                                 startTime)
+      .count();
+}
+
+TEST(TestBenchmark, TestBatchedSequenceSubmission)
+{
+    // num<> parameters below can be tweaked for benchmark
+    uint32_t numIter = 1000;
+
+    uint32_t numSeqs = 100;
+    uint32_t numElems = 256;
+
+    // Small dispatches so the submission overhead dominates
+    std::string shader(R"(
+        #version 450
+
+        layout(local_size_x = 1) in;
+
+        layout(binding = 0) buffer tensorOut { float out_[]; };
+
+        void main() {
+            const uint i = gl_GlobalInvocationID.x;
+            out_[i] += 1.0;
+        }
+    )");
+
+    std::vector<uint32_t> spirv = compileSource(shader);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensor(std::vector<float>(numElems, 0));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorOut });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorOut }, spirv);
+
+    std::vector<std::shared_ptr<kp::Sequence>> sequences(numSeqs);
+    for (auto& sequence : sequences) {
+        sequence = mgr.sequence();
+        sequence->record<kp::OpAlgoDispatch>(algorithm);
+        sequence->end();
+    }
+
+    int64_t totalTimeSequential =
+      runSequenceSubmission(mgr, sequences, numIter, false);
+    int64_t totalTimeBatched =
+      runSequenceSubmission(mgr, sequences, numIter, true);
+
+    KP_LOG_INFO("Submission of {} sequences x {} iterations: {}us with a "
+                "submission per sequence, {}us with batched submissions",
+                numSeqs,
+                numIter,
+                totalTimeSequential,
+                totalTimeBatched);
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorOut });
+
+    EXPECT_EQ(tensorOut->vector(),
+              std::vector<float>(numElems, 2.0 * numIter * numSeqs));
+
+    // Validating significant divergences of performance
+    // Currently configured for github actions performance
+    EXPECT_LT(totalTimeSequential, 50000000);
+    EXPECT_LT(totalTimeBatched, 50000000);
+}
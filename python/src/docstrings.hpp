@@ -54,10 +54,36 @@ Parameter ``pushConstants``:
     be modified but all new values must have the same data type and
     length as otherwise it will result in errors.)doc";
 
+static const char *__doc_kp_Algorithm_BindingAccess =
+R"doc(Access performed by the shader on the memory object bound to a
+binding, which sequences use to record only the barriers required
+between operations.)doc";
+
+static const char *__doc_kp_Algorithm_BindingAccess_eReadOnly = R"doc(< The shader only reads the memory object)doc";
+
+static const char *__doc_kp_Algorithm_BindingAccess_eReadWrite = R"doc(< The shader may read and write the memory object)doc";
+
+static const char *__doc_kp_Algorithm_BindingAccess_eWriteOnly = R"doc(< The shader only writes the memory object)doc";
+
 static const char *__doc_kp_Algorithm_Algorithm_2 = R"doc(Make Algorithm uncopyable)doc";
 
 static const char *__doc_kp_Algorithm_Algorithm_3 = R"doc()doc";
 
+static const char *__doc_kp_Algorithm_addDescriptorSet =
+R"doc(Allocates an additional descriptor set pointing to the memory objects
+provided, which is compatible with the pipeline of this algorithm.
+Switching between pre-built descriptor sets with setDescriptorSet, for
+example to swap ping-pong buffers between dispatches, does not require
+any descriptor update.
+
+Parameter ``memObjects``:
+    The memory objects to bind to the new descriptor set, which must
+    match the ones the algorithm was built with in number and
+    descriptor type
+
+Returns:
+    The index of the new descriptor set)doc";
+
 static const char *__doc_kp_Algorithm_createParameters = R"doc()doc";
 
 static const char *__doc_kp_Algorithm_createPipeline = R"doc()doc";
@@ -66,6 +92,23 @@ static const char *__doc_kp_Algorithm_createShaderModule = R"doc()doc";
 
 static const char *__doc_kp_Algorithm_destroy = R"doc()doc";
 
+static const char *__doc_kp_Algorithm_getBindingAccess =
+R"doc(Gets the access the shader performs on the memory object bound to a
+binding.
+
+Parameter ``binding``:
+    The index of the binding in the memory objects
+
+Returns:
+    The access annotated for the binding, or eReadWrite if the binding
+    was not annotated)doc";
+
+static const char *__doc_kp_Algorithm_getDescriptorSetCount =
+R"doc(Gets the number of descriptor sets available to setDescriptorSet.
+
+Returns:
+    The number of descriptor sets of the algorithm)doc";
+
 static const char *__doc_kp_Algorithm_getMemObjects =
 R"doc(Gets the current memory objects that are used in the algorithm.
 
@@ -151,6 +194,17 @@ static const char *__doc_kp_Algorithm_operator_assign = R"doc()doc";
 
 static const char *__doc_kp_Algorithm_operator_assign_2 = R"doc()doc";
 
+static const char *__doc_kp_Algorithm_rebind =
+R"doc(Points the active descriptor set to the memory objects provided
+without rebuilding the shader module or the pipeline. The memory
+objects must match the ones the algorithm was built with in number and
+descriptor type. The descriptor set is updated in place, so it must not
+be in use by a running sequence and sequences that recorded this
+algorithm have to record it again.
+
+Parameter ``memObjects``:
+    The memory objects to bind to the active descriptor set)doc";
+
 static const char *__doc_kp_Algorithm_rebuild =
 R"doc(Rebuild function to reconstruct algorithm with configuration
 parameters to create the underlying resources.
@@ -197,6 +251,28 @@ alternatively using the size of the tensor by default.
 Parameter ``commandBuffer``:
     Command buffer to record the algorithm resources to)doc";
 
+static const char *__doc_kp_Algorithm_setBindingAccess =
+R"doc(Annotates how the shader accesses the memory object bound to a
+binding. Bindings that are not annotated are assumed to be read and
+written, and annotating read only bindings allows sequences to skip
+the barriers between dispatches that only read the same memory object.
+The annotations are cleared when the algorithm is rebuilt.
+
+Parameter ``binding``:
+    The index of the binding in the memory objects
+
+Parameter ``access``:
+    The access the shader performs on the binding)doc";
+
+static const char *__doc_kp_Algorithm_setDescriptorSet =
+R"doc(Selects the descriptor set bound by recordBindCore. The memory objects
+of the selected descriptor set become the ones returned by
+getMemObjects, which operations use to record their barriers.
+
+Parameter ``index``:
+    The index of the descriptor set, where 0 is the descriptor set
+    created when the algorithm was built)doc";
+
 static const char *__doc_kp_Algorithm_setPushConstants =
 R"doc(Sets the push constants to the new value provided to use in the next
 bindPush()
@@ -228,7 +304,223 @@ Parameter ``workgroup``:
     The kp::Workgroup value to use to update the algorithm. It must
     have a value greater than 1 on the x value (index 1) otherwise it
     will be initialized on the size of the first tensor (ie.
-    this->mTensor[0]->size()))doc";
+    this->mTensor[0]->size())
+
+Parameter ``minSize``:
+    The x value used when none is provided, which has to fit in the
+    32-bit dispatch size)doc";
+
+static const char *__doc_kp_BFloat16 =
+R"doc(Brain float, which keeps the 8-bit exponent of a float with a 7-bit
+mantissa, stored as its 16 bits. It is converted to and from float on
+the host with round to nearest even, and can be used as the element
+type of tensors of type eBFloat16.)doc";
+
+static const char *__doc_kp_BFloat16_BFloat16 = R"doc()doc";
+
+static const char *__doc_kp_BFloat16_BFloat16_2 = R"doc()doc";
+
+static const char *__doc_kp_BFloat16_bits = R"doc()doc";
+
+static const char *__doc_kp_BFloat16_fromFloat =
+R"doc(Converts a float to the bits of the closest bfloat16, keeping NaNs as
+quiet NaNs.
+
+Parameter ``value``:
+    The float to convert
+
+Returns:
+    The bits of the bfloat16)doc";
+
+static const char *__doc_kp_BFloat16_operator_float = R"doc()doc";
+
+static const char *__doc_kp_BFloat16_toFloat =
+R"doc(Converts the bits of a bfloat16 to a float, which is always exact.
+
+Parameter ``bits``:
+    The bits of the bfloat16
+
+Returns:
+    The float with the same value)doc";
+
+static const char *__doc_kp_BlockInt4 =
+R"doc(Block of 32 elements quantized to 4-bit values with a shared half
+precision scale, so each element is dequantized as (value - 8) * scale.
+The values are packed in pairs, the low 4 bits of the i-th byte holding
+the i-th element and the high 4 bits the (i + 16)-th element. Blocks
+take 18 bytes for 32 elements, about 7.1 times less than floats, and
+can be used as the element type of tensors of type eBlockInt4.
+
+The layout matches the Q4_0 blocks of GGML so weights quantized by
+other tools can be uploaded as they are.)doc";
+
+static const char *__doc_kp_BlockInt4_blockCount =
+R"doc(The number of blocks used to quantize the elements provided, which is
+rounded up to an even number of blocks so the blocks of a tensor take a
+multiple of 4 bytes. The elements of the padding are quantized as zero.
+
+Parameter ``elementCount``:
+    The number of elements to quantize
+
+Returns:
+    The number of blocks)doc";
+
+static const char *__doc_kp_BlockInt4_blockSize = R"doc()doc";
+
+static const char *__doc_kp_BlockInt4_dequantize =
+R"doc(Dequantizes the blocks provided into their elements.
+
+Parameter ``blocks``:
+    The blocks to dequantize
+
+Parameter ``blockCount``:
+    The number of blocks to dequantize
+
+Parameter ``data``:
+    The elements to dequantize into, which have to be at least
+    blockCount * blockSize)doc";
+
+static const char *__doc_kp_BlockInt4_dequantize_2 =
+R"doc(Dequantizes the vector of blocks provided into their elements.
+
+Parameter ``blocks``:
+    The blocks to dequantize
+
+Returns:
+    The elements, including the padding of the blocks)doc";
+
+static const char *__doc_kp_BlockInt4_quantize =
+R"doc(Quantizes the elements provided into blocks, using SIMD instructions
+when available. Each block is
+scaled so its element of largest magnitude maps to -8, which keeps the
+full range of the values.
+
+Parameter ``data``:
+    The elements to quantize
+
+Parameter ``elementCount``:
+    The number of elements to quantize
+
+Parameter ``blocks``:
+    The blocks to quantize into, which have to be at least
+    blockCount(elementCount))doc";
+
+static const char *__doc_kp_BlockInt4_quantize_2 =
+R"doc(Quantizes the vector of elements provided into blocks.
+
+Parameter ``data``:
+    The elements to quantize
+
+Returns:
+    The blocks, including the padding to an even number of blocks)doc";
+
+static const char *__doc_kp_BlockInt4_scale = R"doc()doc";
+
+static const char *__doc_kp_BlockInt4_values = R"doc()doc";
+
+static const char *__doc_kp_BlockInt8 =
+R"doc(Block of 32 elements quantized to int8 values with a shared half
+precision scale, so each element is dequantized as value * scale.
+Blocks take 34 bytes for 32 elements, about 3.8 times less than floats,
+and can be used as the element type of tensors of type eBlockInt8.
+
+The layout matches the Q8_0 blocks of GGML so weights quantized by
+other tools can be uploaded as they are.)doc";
+
+static const char *__doc_kp_BlockInt8_blockCount =
+R"doc(The number of blocks used to quantize the elements provided, which is
+rounded up to an even number of blocks so the blocks of a tensor take a
+multiple of 4 bytes. The elements of the padding are quantized as zero.
+
+Parameter ``elementCount``:
+    The number of elements to quantize
+
+Returns:
+    The number of blocks)doc";
+
+static const char *__doc_kp_BlockInt8_blockSize = R"doc()doc";
+
+static const char *__doc_kp_BlockInt8_dequantize =
+R"doc(Dequantizes the blocks provided into their elements.
+
+Parameter ``blocks``:
+    The blocks to dequantize
+
+Parameter ``blockCount``:
+    The number of blocks to dequantize
+
+Parameter ``data``:
+    The elements to dequantize into, which have to be at least
+    blockCount * blockSize)doc";
+
+static const char *__doc_kp_BlockInt8_dequantize_2 =
+R"doc(Dequantizes the vector of blocks provided into their elements.
+
+Parameter ``blocks``:
+    The blocks to dequantize
+
+Returns:
+    The elements, including the padding of the blocks)doc";
+
+static const char *__doc_kp_BlockInt8_quantize =
+R"doc(Quantizes the elements provided into blocks, using SIMD instructions
+when available. Each block is
+scaled by the largest magnitude of its elements.
+
+Parameter ``data``:
+    The elements to quantize
+
+Parameter ``elementCount``:
+    The number of elements to quantize
+
+Parameter ``blocks``:
+    The blocks to quantize into, which have to be at least
+    blockCount(elementCount))doc";
+
+static const char *__doc_kp_BlockInt8_quantize_2 =
+R"doc(Quantizes the vector of elements provided into blocks.
+
+Parameter ``data``:
+    The elements to quantize
+
+Returns:
+    The blocks, including the padding to an even number of blocks)doc";
+
+static const char *__doc_kp_BlockInt8_scale = R"doc()doc";
+
+static const char *__doc_kp_BlockInt8_values = R"doc()doc";
+
+static const char *__doc_kp_Half =
+R"doc(IEEE 754 half precision float, stored as its 16 bits. It is converted
+to and from float on the host with round to nearest even, and can be
+used as the element type of tensors and images of type eHalf.)doc";
+
+static const char *__doc_kp_Half_Half = R"doc()doc";
+
+static const char *__doc_kp_Half_Half_2 = R"doc()doc";
+
+static const char *__doc_kp_Half_bits = R"doc()doc";
+
+static const char *__doc_kp_Half_fromFloat =
+R"doc(Converts a float to the bits of the closest half, overflowing to
+infinity and keeping NaNs as quiet NaNs.
+
+Parameter ``value``:
+    The float to convert
+
+Returns:
+    The bits of the half)doc";
+
+static const char *__doc_kp_Half_operator_float = R"doc()doc";
+
+static const char *__doc_kp_Half_toFloat =
+R"doc(Converts the bits of a half to a float, which is always exact.
+
+Parameter ``bits``:
+    The bits of the half
+
+Returns:
+    The float with the same value)doc";
 
 static const char *__doc_kp_Image =
 R"doc(Image data used in GPU operations.
@@ -681,6 +973,26 @@ static const char *__doc_kp_Manager_createInstance = R"doc()doc";
 
 static const char *__doc_kp_Manager_destroy = R"doc(Destroy the GPU resources and all managed resources by manager.)doc";
 
+static const char *__doc_kp_Manager_evalAsync =
+R"doc(Submits the recorded operations of several sequences created on the
+same queue in a single queue submission with a single fence, which
+avoids the overhead of a submission per sequence when many sequences
+are evaluated together. The sequences have to be awaited with
+evalAwait, see Sequence::evalAsyncBatch.
+
+Parameter ``sequences``:
+    The sequences to submit)doc";
+
+static const char *__doc_kp_Manager_evalAwait =
+R"doc(Waits for sequences submitted with evalAsync to finish processing and
+runs the postEval of their operations, see Sequence::evalAwaitBatch.
+
+Parameter ``sequences``:
+    The sequences to wait for
+
+Parameter ``waitFor``:
+    Number of nanoseconds to wait before timing out.)doc";
+
 static const char *__doc_kp_Manager_getDeviceProperties =
 R"doc(Information about the current device.
 
@@ -688,6 +1000,15 @@ Returns:
     vk::PhysicalDeviceProperties containing information about the
     device)doc";
 
+static const char *__doc_kp_Manager_getMemoryBudget =
+R"doc(The budget tracking the device memory of the tensors of type eDevice
+created by this manager against the device memory available, through
+VK_EXT_memory_budget when the device supports it, which the manager
+enables when creating the device.
+
+Returns:
+    a shared pointer to the memory budget)doc";
+
 static const char *__doc_kp_Manager_getVkInstance =
 R"doc(The current Vulkan instance.
 
@@ -730,12 +1051,65 @@ static const char *__doc_kp_Manager_imageT_3 = R"doc()doc";
 
 static const char *__doc_kp_Manager_imageT_4 = R"doc()doc";
 
+static const char *__doc_kp_Manager_importTensor =
+R"doc(Create a managed tensor of type eHost that imports the host allocation
+provided instead of copying it, so for example memory mapped files can
+be used by the device without a copy. The allocation is imported when
+VK_EXT_external_memory_host is available, which the manager enables
+when creating the device, and the data and its size are aligned to the
+minImportedHostPointerAlignment of the device, and copied otherwise.
+
+Parameter ``data``:
+    Host allocation to import, which has to outlive the tensor
+
+Parameter ``elementTotalCount``:
+    The number of elements of the data
+
+Parameter ``elementMemorySize``:
+    The size in bytes of each element
+
+Parameter ``dataType``:
+    The data type of the elements
+
+Returns:
+    Shared pointer with initialised tensor)doc";
+
 static const char *__doc_kp_Manager_listDevices =
 R"doc(List the devices available in the current vulkan instance.
 
 Returns:
     vector of physical devices containing their respective properties)doc";
 
+static const char *__doc_kp_Manager_loadTensor =
+R"doc(Loads the data of a tensor from a region of a file one chunk at a time,
+so the host memory used is bounded by the size of the chunks rather
+than the size of the tensor. The data of tensors of type eDevice is
+streamed into their device memory through the staging ring, or through
+a temporary staging ring if it is not enabled, and has to be synced
+with OpSyncLocal to be read on the host.
+
+Parameter ``tensor``:
+    The tensor to load the data of
+
+Parameter ``path``:
+    The path of the file holding the data
+
+Parameter ``offset``:
+    The offset in bytes of the data in the file)doc";
+
+static const char *__doc_kp_Manager_loadTensors =
+R"doc(Creates managed tensors with the data type, memory type, size and data
+of the tensors saved into a checkpoint file by saveTensors. The data is
+loaded through bounded host memory like with loadTensor, so the data
+of tensors of type eDevice has to be synced with OpSyncLocal to be read
+on the host.
+
+Parameter ``path``:
+    The path of the checkpoint file
+
+Returns:
+    The tensors in the order they were saved in)doc";
+
 static const char *__doc_kp_Manager_mComputeQueueFamilyIndices = R"doc()doc";
 
 static const char *__doc_kp_Manager_mComputeQueues = R"doc()doc";
@@ -766,6 +1140,34 @@ static const char *__doc_kp_Manager_operator_assign = R"doc()doc";
 
 static const char *__doc_kp_Manager_operator_assign_2 = R"doc()doc";
 
+static const char *__doc_kp_Manager_saveTensors =
+R"doc(Saves the data of the tensors provided into a checkpoint file, in the
+format described by CheckpointHeader, together with their data type,
+memory type and size so they can be created again with loadTensors.
+The data of tensors that is only current in device memory is read back
+through the staging ring, or through a temporary staging ring if it is
+not enabled, double buffered so the read back of a chunk overlaps the
+write of the previous one. The host data of the tensors is left
+unchanged.
+
+Parameter ``path``:
+    The path of the file to write the checkpoint to
+
+Parameter ``tensors``:
+    The tensors to save)doc";
+
+static const char *__doc_kp_Manager_setEvictionPolicy =
+R"doc(Sets what happens when creating or restoring a tensor of type eDevice
+would exceed the memory budget. With
+MemoryBudget::EvictionPolicy::eLeastRecentlyUsed, the tensors that
+were used least recently by a sequence are evicted to host memory, and
+restored when a sequence records an operation using them again.
+Tensors used by a sequence being recorded or evaluated, and tensors
+pinned with Tensor::pin, are never evicted.
+
+Parameter ``evictionPolicy``:
+    The eviction policy of the memory budget)doc";
+
 static const char *__doc_kp_Manager_sequence =
 R"doc(Create a managed sequence that will be destroyed by this manager if it
 hasn't been destroyed by its reference count going to zero.
@@ -777,15 +1179,80 @@ Parameter ``nrOfTimestamps``:
     The maximum number of timestamps to allocate. If zero (default),
     disables latching of timestamps.
 
+Parameter ``slotCount``:
+    The number of command buffer and fence slots the evaluations of the
+    sequence cycle through, so up to that many evaluations can run while
+    the next one is prepared
+
 Returns:
     Shared pointer with initialised sequence)doc";
 
+static const char *__doc_kp_Manager_streamingExecutor =
+R"doc(Create an executor streaming host buffers larger than the device
+memory through an algorithm chunk by chunk, with the chunks of several
+slots in flight at the same time. The chunk size is the number of
+elements of the tensors the streamed bindings of the algorithm are
+bound to.
+
+The bound tensors are used by the first slot if they are eDevice
+tensors that do not use the staging ring, and managed tensors of the
+same type and size are created for the other slots along with a
+managed sequence per slot.
+
+Parameter ``algorithm``:
+    The algorithm to dispatch for each chunk
+
+Parameter ``inputBindings``:
+    The bindings whose data is uploaded for each chunk
+
+Parameter ``outputBindings``:
+    The bindings whose data is downloaded for each chunk
+
+Parameter ``slotCount``:
+    The number of chunks in flight at the same time
+
+Parameter ``queueIndex``:
+    The queue to submit the chunks to
+
+Returns:
+    Shared pointer with initialised streaming executor)doc";
+
 static const char *__doc_kp_Manager_tensor = R"doc()doc";
 
 static const char *__doc_kp_Manager_tensor_2 = R"doc()doc";
 
 static const char *__doc_kp_Manager_tensor_3 = R"doc()doc";
 
+static const char *__doc_kp_Manager_tensorFromFile =
+R"doc(Create a managed tensor with its data read from a region of a file
+through a memory mapping instead of an intermediate copy. Tensors of
+type eHost import the mapping when possible, and tensors of type
+eDevice use the mapping as their host data when the staging ring is
+enabled, so the file is only read when the tensor is synced. See
+loadTensor to load the data of existing tensors through bounded host
+memory.
+
+Parameter ``path``:
+    The path of the file holding the data
+
+Parameter ``offset``:
+    The offset in bytes of the data in the file
+
+Parameter ``elementTotalCount``:
+    The number of elements of the data
+
+Parameter ``elementMemorySize``:
+    The size in bytes of each element
+
+Parameter ``dataType``:
+    The data type of the elements
+
+Parameter ``tensorType``:
+    The type of tensor to initialize
+
+Returns:
+    Shared pointer with initialised tensor)doc";
+
 static const char *__doc_kp_Manager_tensorT =
 R"doc(Create a managed tensor that will be destroyed by this manager if it
 hasn't been destroyed by its reference count going to zero.
@@ -812,10 +1279,137 @@ Parameter ``tensorType``:
 Returns:
     Shared pointer with initialised tensor)doc";
 
+static const char *__doc_kp_Manager_waitAll =
+R"doc(Waits until all the sequences provided completed with a single wait on
+their fences, without awaiting them, see Sequence::waitAll.
+
+Parameter ``sequences``:
+    The sequences to wait for
+
+Parameter ``waitFor``:
+    Number of nanoseconds to wait before timing out.
+
+Returns:
+    Boolean stating whether all the sequences completed before timing
+    out)doc";
+
+static const char *__doc_kp_Manager_waitAny =
+R"doc(Waits until any of the sequences provided completed with a single wait
+on their fences, so results can be handled as soon as any submission
+completed, see Sequence::waitAny. The sequence found still has to be
+awaited, which does not block anymore.
+
+Parameter ``sequences``:
+    The sequences to wait for
+
+Parameter ``waitFor``:
+    Number of nanoseconds to wait before timing out.
+
+Returns:
+    The index of a completed sequence, or -1 if none completed before
+    timing out or none is running)doc";
+
 static const char *__doc_kp_Memory = R"doc()doc";
 
+static const char *__doc_kp_MemoryBudget =
+R"doc(Tracks the device memory used by the device tensors of a manager
+against the device memory available, and optionally evicts the tensors
+that were used least recently to host memory when allocating a new
+tensor would exceed it.
+
+The budget and usage of the device local heaps are queried through
+VK_EXT_memory_budget when the device supports it, which accounts for
+the memory used by other processes. Otherwise the budget is the size
+of the device local heaps and the usage is the memory of the tracked
+tensors. A limit can also be set to cap the memory of the tracked
+tensors below what the device reports.
+
+Evicted tensors keep their data in host memory and have their buffer
+and device memory freed. Sequences restore them when recording an
+operation that uses them, and keep the tensors of their operations
+pinned from the recording until their evaluation completed, so the
+tensors in use are never evicted. Tensors can also be pinned
+explicitly with Tensor::pin.)doc";
+
+static const char *__doc_kp_MemoryBudget_EvictionPolicy =
+R"doc(What happens when allocating a tensor would exceed the budget.)doc";
+
+static const char *__doc_kp_MemoryBudget_EvictionPolicy_eLeastRecentlyUsed = R"doc(< Least recently used tensors are evicted)doc";
+
+static const char *__doc_kp_MemoryBudget_EvictionPolicy_eNone = R"doc(< Tensors are allocated regardless)doc";
+
+static const char *__doc_kp_MemoryBudget_budget =
+R"doc(The device local memory available to this process, which is the
+budget reported by VK_EXT_memory_budget or the size of the device
+local heaps.
+
+Returns:
+    Budget in bytes of the device local heaps)doc";
+
+static const char *__doc_kp_MemoryBudget_evictionCount =
+R"doc(The number of tensors evicted since the budget was created.
+
+Returns:
+    Number of evictions)doc";
+
+static const char *__doc_kp_MemoryBudget_getEvictionPolicy =
+R"doc(The eviction policy of the budget.
+
+Returns:
+    The eviction policy)doc";
+
+static const char *__doc_kp_MemoryBudget_hasBudgetExtension =
+R"doc(Whether the budget and usage are queried through VK_EXT_memory_budget.
+
+Returns:
+    Boolean stating whether the extension is supported)doc";
+
+static const char *__doc_kp_MemoryBudget_limit =
+R"doc(The cap of the device memory of the tracked tensors.
+
+Returns:
+    The limit in bytes, or 0 if no limit is set)doc";
+
+static const char *__doc_kp_MemoryBudget_setEvictionPolicy =
+R"doc(Sets what happens when allocating a tensor would exceed the budget.
+
+Parameter ``evictionPolicy``:
+    The eviction policy)doc";
+
+static const char *__doc_kp_MemoryBudget_setLimit =
+R"doc(Caps the device memory of the tracked tensors, which is checked in
+addition to the budget of the device when allocating tensors.
+
+Parameter ``limit``:
+    The limit in bytes, or 0 to only check the budget)doc";
+
+static const char *__doc_kp_MemoryBudget_tensorCount =
+R"doc(The number of tracked tensors, evicted or not.
+
+Returns:
+    Number of tensors tracked)doc";
+
+static const char *__doc_kp_MemoryBudget_trackedSize =
+R"doc(The device memory of the tracked tensors that are not evicted.
+
+Returns:
+    Size in bytes of the resident tracked tensors)doc";
+
+static const char *__doc_kp_MemoryBudget_usage =
+R"doc(The device local memory used by this process, which is the usage
+reported by VK_EXT_memory_budget or the memory of the tracked tensors.
+
+Returns:
+    Usage in bytes of the device local heaps)doc";
+
 static const char *__doc_kp_Memory_DataTypes = R"doc()doc";
 
+static const char *__doc_kp_Memory_DataTypes_eBFloat16 = R"doc()doc";
+
+static const char *__doc_kp_Memory_DataTypes_eBlockInt4 = R"doc()doc";
+
+static const char *__doc_kp_Memory_DataTypes_eBlockInt8 = R"doc()doc";
+
 static const char *__doc_kp_Memory_DataTypes_eBool = R"doc()doc";
 
 static const char *__doc_kp_Memory_DataTypes_eChar = R"doc()doc";
@@ -826,14 +1420,20 @@ static const char *__doc_kp_Memory_DataTypes_eDouble = R"doc()doc";
 
 static const char *__doc_kp_Memory_DataTypes_eFloat = R"doc()doc";
 
+static const char *__doc_kp_Memory_DataTypes_eHalf = R"doc()doc";
+
 static const char *__doc_kp_Memory_DataTypes_eInt = R"doc()doc";
 
+static const char *__doc_kp_Memory_DataTypes_eInt64 = R"doc()doc";
+
 static const char *__doc_kp_Memory_DataTypes_eShort = R"doc()doc";
 
 static const char *__doc_kp_Memory_DataTypes_eUnsignedChar = R"doc()doc";
 
 static const char *__doc_kp_Memory_DataTypes_eUnsignedInt = R"doc()doc";
 
+static const char *__doc_kp_Memory_DataTypes_eUnsignedInt64 = R"doc()doc";
+
 static const char *__doc_kp_Memory_DataTypes_eUnsignedShort = R"doc()doc";
 
 static const char *__doc_kp_Memory_Memory = R"doc()doc";
@@ -918,7 +1518,10 @@ static const char *__doc_kp_Memory_getPrimaryMemoryPropertyFlags = R"doc()doc";
 static const char *__doc_kp_Memory_getStagingMemoryPropertyFlags = R"doc()doc";
 
 static const char *__doc_kp_Memory_getX =
-R"doc(Retreive the size of the x-dimension of the memory
+R"doc(Retreive the size of the x-dimension of the memory. Tensors are
+one-dimensional and report their number of elements, which saturates
+at 2^32 - 1 for larger tensors whose number of elements is only
+returned by size().
 
 Returns:
     Size of the x-dimension of the memory)doc";
@@ -1206,6 +1809,39 @@ submitted as a batch into the GPU.
 Parameter ``commandBuffer``:
     The command buffer to record the command into.)doc";
 
+static const char *__doc_kp_OpConvert =
+R"doc(Operation that converts the elements of a tensor of type eFloat to a
+tensor of type eHalf or eBFloat16 of the same size, or the other way
+around, so data can be stored at reduced precision and widened on the
+device.
+
+The 16-bit elements are accessed as pairs packed in 32-bit words so the
+shader does not require the 16-bit storage features of the device,
+which requires the tensors to have an even number of elements.)doc";
+
+static const char *__doc_kp_OpConvert_OpConvert =
+R"doc(Default constructor with parameters that provides the bare minimum
+requirements for the operations to be able to create and manage their
+sub-components.
+
+Parameter ``memObjects``:
+    Tensors that are to be used in this operation, which are expected
+    to be 2, the first being converted into the second
+
+Parameter ``algorithm``:
+    An algorithm that will be overridden with the OpConvert shader
+    data and the tensors provided)doc";
+
+static const char *__doc_kp_OpConvert_OpConvert_2 = R"doc(Make OpConvert non-copyable)doc";
+
+static const char *__doc_kp_OpConvert_OpConvert_3 = R"doc()doc";
+
+static const char *__doc_kp_OpConvert_conversionMode = R"doc()doc";
+
+static const char *__doc_kp_OpConvert_operator_assign = R"doc()doc";
+
+static const char *__doc_kp_OpConvert_operator_assign_2 = R"doc()doc";
+
 static const char *__doc_kp_OpCopy =
 R"doc(Operation that copies the data from the first memory object to the
 rest of the memory objects provided, using a record command for all
@@ -1230,8 +1866,10 @@ static const char *__doc_kp_OpCopy_operator_assign = R"doc()doc";
 static const char *__doc_kp_OpCopy_operator_assign_2 = R"doc()doc";
 
 static const char *__doc_kp_OpCopy_postEval =
-R"doc(Copies the local vectors for all the memory objects to sync the data
-with the gpu.
+R"doc(Does not copy the host data of the memory objects, the device writes
+of the copy mark the host data of the memory objects of type eDevice
+copied into as outdated instead, so it is only transferred when synced
+with OpSyncLocal.
 
 Parameter ``commandBuffer``:
     The command buffer to record the command into.)doc";
@@ -1249,6 +1887,38 @@ other memory objects provided. Also optionally records a barrier.
 Parameter ``commandBuffer``:
     The command buffer to record the command into.)doc";
 
+static const char *__doc_kp_OpDequantize =
+R"doc(Operation that dequantizes a tensor of type eBlockInt8 or eBlockInt4
+into a tensor of type eFloat with 32 elements per block, so weights can
+be uploaded and kept on the device quantized and only widened when
+needed.
+
+The blocks are accessed as 32-bit words so the shader does not require
+the 8-bit and 16-bit storage features of the device, which requires the
+quantized tensor to have an even number of blocks, as returned by
+BlockInt8::quantize and BlockInt4::quantize.)doc";
+
+static const char *__doc_kp_OpDequantize_OpDequantize =
+R"doc(Default constructor with parameters that provides the bare minimum
+requirements for the operations to be able to create and manage their
+sub-components.
+
+Parameter ``memObjects``:
+    Tensors that are to be used in this operation, which are expected
+    to be 2, the quantized tensor and the tensor to dequantize into
+
+Parameter ``algorithm``:
+    An algorithm that will be overridden with the OpDequantize shader
+    data and the tensors provided)doc";
+
+static const char *__doc_kp_OpDequantize_OpDequantize_2 = R"doc(Make OpDequantize non-copyable)doc";
+
+static const char *__doc_kp_OpDequantize_OpDequantize_3 = R"doc()doc";
+
+static const char *__doc_kp_OpDequantize_operator_assign = R"doc()doc";
+
+static const char *__doc_kp_OpDequantize_operator_assign_2 = R"doc()doc";
+
 static const char *__doc_kp_OpMemoryBarrier =
 R"doc(Operation that provides a general abstraction that simplifies the use
 of algorithm and parameter components which can be used with shaders.
@@ -1468,6 +2138,10 @@ static const char *__doc_kp_Sequence_clear =
 R"doc(Clear function clears all operations currently recorded and starts
 recording again.)doc";
 
+static const char *__doc_kp_Sequence_clearDependencies =
+R"doc(Removes the dependencies added with waitOn, which cannot be done while
+the sequence is running.)doc";
+
 static const char *__doc_kp_Sequence_createCommandBuffer = R"doc()doc";
 
 static const char *__doc_kp_Sequence_createCommandPool = R"doc()doc";
@@ -1532,6 +2206,11 @@ of operations into the gpu as a submit job without a barrier.
 EvalAwait() must ALWAYS be called after to ensure the sequence is
 terminated correctly.
 
+With more than one slot, each call submits the command buffer of the
+next slot, recording the operations into it first if it does not hold
+them yet, and only blocks to await the slot if its previous submission
+is still running. EvalAwait() then awaits every running slot.
+
 Returns:
     Boolean stating whether execution was successful.)doc";
 
@@ -1574,7 +2253,10 @@ Returns:
 
 static const char *__doc_kp_Sequence_evalAwait =
 R"doc(Eval Await waits for the fence to finish processing and then once it
-finishes, it runs the postEval of all operations.
+finishes, it runs the postEval of all operations. With more than one
+slot, it waits for the submissions of all the running slots. On
+timeout the submissions are no longer tracked as running: the postEval
+of the operations is skipped, and their tensors are unpinned.
 
 Parameter ``waitFor``:
     Number of milliseconds to wait before timing out.
@@ -1586,6 +2268,17 @@ static const char *__doc_kp_Sequence_getTimestamps =
 R"doc(Return the timestamps that were latched at the beginning and after
 each operation during the last eval() call.)doc";
 
+static const char *__doc_kp_Sequence_isComplete =
+R"doc(Queries the device without blocking whether the running submissions
+of the sequence completed, unlike isRunning which stays true until the
+sequence is awaited. EvalAwait() still has to be called to run the
+postEval of the operations, which does not block once this returns
+true.
+
+Returns:
+    Boolean stating if all the running submissions completed, which is
+    also the case if the sequence is not running)doc";
+
 static const char *__doc_kp_Sequence_isInit =
 R"doc(Returns true if the sequence has been initialised, and it's based on
 the GPU resources being referenced.
@@ -1601,7 +2294,7 @@ Returns:
 
 static const char *__doc_kp_Sequence_isRunning =
 R"doc(Returns true if the sequence is currently running - mostly used for
-async workloads.
+async workloads. With more than one slot, any running slot counts.
 
 Returns:
     Boolean stating if currently running.)doc";
@@ -1684,8 +2377,155 @@ R"doc(Clears command buffer and triggers re-record of all the current
 operations saved, which is useful if the underlying kp::Memorys or
 kp::Algorithms are modified and need to be re-recorded.)doc";
 
+static const char *__doc_kp_Sequence_slotCount =
+R"doc(Returns the number of command buffer and fence slots the evaluations
+of the sequence cycle through.
+
+Returns:
+    Number of slots of the sequence)doc";
+
 static const char *__doc_kp_Sequence_timestampQueryPool = R"doc()doc";
 
+static const char *__doc_kp_Sequence_waitOn =
+R"doc(Makes the submissions of this sequence wait on the device for the last
+submission of the sequence provided, so stages of a pipeline can be
+submitted up front without waiting on the host for each stage to
+complete. The dependency holds for every later submission until
+clearDependencies is called, and a submission only waits if the
+sequence provided was submitted since the previous one. The sequence
+provided still has to be awaited to run the postEval of its
+operations, which does not block once this sequence completed.
+
+Timeline semaphores are used when enabled on the device, otherwise
+each submission of the sequence provided signals a binary semaphore
+waited by the next submission of this sequence, which requires the
+sequence provided to have a single slot.
+
+Parameter ``sequence``:
+    The sequence to wait on, created on the same device
+
+Parameter ``waitStageMask``:
+    The stages of this sequence that wait
+
+Returns:
+    shared_ptr<Sequence> of the Sequence class itself)doc";
+
+static const char *__doc_kp_StreamingExecutor =
+R"doc(Executor running an algorithm over host buffers larger than the device
+memory, by splitting them in chunks of the size of the memory objects
+the algorithm is bound to and streaming the chunks through the device.
+
+Each slot of the executor has its own device tensors for the streamed
+bindings, its own descriptor set in the algorithm and its own sequence,
+which is recorded once with the upload, the dispatch and the download
+of a chunk. Chunks are submitted to the slots in turn and a slot is
+only waited on when it is reused, so while the device processes the
+chunks in flight the host copies the results of the completed chunks
+out and the data of the next chunks in.
+
+The bindings of the algorithm that are not streamed are shared by all
+the chunks in flight, so they are expected to only be read by the
+shader, for example weights or lookup tables that were synced to the
+device before.)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats = R"doc(Measurements of a run of the executor.)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats_bytesDownloaded = R"doc(Bytes copied to the outputs)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats_bytesUploaded = R"doc(Bytes copied from the inputs)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats_chunkCount = R"doc(Number of chunks dispatched)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats_elementCount = R"doc(Number of elements streamed)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats_seconds = R"doc(Wall clock duration of the run)doc";
+
+static const char *__doc_kp_StreamingExecutor_Stats_throughput =
+R"doc(The number of bytes streamed to and from the device per second.
+
+Returns:
+    Throughput of the run in bytes per second)doc";
+
+static const char *__doc_kp_StreamingExecutor_StreamingExecutor =
+R"doc(Constructor which records the sequence of each slot. The memory
+objects of each slot replace the ones the algorithm was built with, and
+only differ from them in the streamed bindings.
+
+Parameter ``algorithm``:
+    The algorithm to dispatch for each chunk
+
+Parameter ``inputBindings``:
+    The bindings whose data is uploaded for each chunk
+
+Parameter ``outputBindings``:
+    The bindings whose data is downloaded for each chunk
+
+Parameter ``sequences``:
+    The sequence of each slot
+
+Parameter ``slotMemObjects``:
+    The memory objects bound to the algorithm by each slot, whose
+    streamed bindings have to be eDevice tensors of the same number of
+    elements)doc";
+
+static const char *__doc_kp_StreamingExecutor_StreamingExecutor_2 = R"doc(Make StreamingExecutor uncopyable)doc";
+
+static const char *__doc_kp_StreamingExecutor_StreamingExecutor_3 = R"doc()doc";
+
+static const char *__doc_kp_StreamingExecutor_chunkSize =
+R"doc(The number of elements of each streamed binding processed per chunk.
+
+Returns:
+    Size of the chunks in elements)doc";
+
+static const char *__doc_kp_StreamingExecutor_getInputBindings =
+R"doc(Gets the bindings whose data is uploaded for each chunk.
+
+Returns:
+    The input bindings, in the order of the inputs of run)doc";
+
+static const char *__doc_kp_StreamingExecutor_getMemObjects =
+R"doc(Gets the memory objects bound to the algorithm by a slot.
+
+Parameter ``slot``:
+    The index of the slot
+
+Returns:
+    The memory objects of the slot, in the order of the bindings)doc";
+
+static const char *__doc_kp_StreamingExecutor_getOutputBindings =
+R"doc(Gets the bindings whose data is downloaded for each chunk.
+
+Returns:
+    The output bindings, in the order of the outputs of run)doc";
+
+static const char *__doc_kp_StreamingExecutor_run =
+R"doc(Streams host buffers through the algorithm chunk by chunk and returns
+once the results of all the chunks were copied to the outputs. The
+last chunk is padded with zeros when the number of elements is not a
+multiple of the chunk size, and only its valid elements are copied to
+the outputs.
+
+Parameter ``inputs``:
+    The host buffer of each input binding, in the order of the input
+    bindings, holding elementCount elements each
+
+Parameter ``outputs``:
+    The host buffer of each output binding, in the order of the output
+    bindings, holding elementCount elements each
+
+Parameter ``elementCount``:
+    The number of elements of each buffer
+
+Returns:
+    The measurements of the run, which are also logged)doc";
+
+static const char *__doc_kp_StreamingExecutor_slotCount =
+R"doc(The number of chunks that can be in flight at the same time.
+
+Returns:
+    Number of slots of the executor)doc";
+
 static const char *__doc_kp_Tensor = R"doc()doc";
 
 static const char *__doc_kp_Tensor_2 =
@@ -1751,9 +2591,49 @@ Parameter ``elementMemorySize``:
 Parameter ``tensorTypes``:
     Type for the tensor which is of type TensorTypes)doc";
 
-static const char *__doc_kp_Tensor_Tensor_3 = R"doc(Make Tensor uncopyable)doc";
+static const char *__doc_kp_Tensor_Tensor_3 =
+R"doc(Constructor with the data of the tensor provided by a mapped file, so
+the data is read from the file as the tensor memory is written rather
+than through an intermediate copy. Tensors of type eHost import the
+mapping as their memory when possible, like with
+HostMemoryPolicy::eImport, and tensors of type eDevice streamed through
+a staging ring use the mapping as their host data, keeping the mapped
+file alive. Other tensors copy the data of the file into their memory.
+
+Parameter ``physicalDevice``:
+    The physical device to use to fetch properties
+
+Parameter ``device``:
+    The device to use to create the buffer and memory from
+
+Parameter ``mappedFile``:
+    The mapped file region holding at least elementTotalCount elements
+
+Parameter ``elementTotalCount``:
+    the number of elements of the array
+
+Parameter ``elementMemorySize``:
+    the size of the element
 
-static const char *__doc_kp_Tensor_Tensor_4 = R"doc()doc";
+Parameter ``dataType``:
+    The data type of the elements
+
+Parameter ``memoryType``:
+    Type for the tensor which is of type MemoryTypes
+
+Parameter ``memoryPool``:
+    (optional) Pool to sub-allocate the memory from
+
+Parameter ``stagingRing``:
+    (optional) Ring to stream the data through instead of allocating
+    staging memory
+
+Parameter ``stagingPolicy``:
+    (optional) When to allocate the staging memory)doc";
+
+static const char *__doc_kp_Tensor_Tensor_4 = R"doc(Make Tensor uncopyable)doc";
+
+static const char *__doc_kp_Tensor_Tensor_5 = R"doc()doc";
 
 static const char *__doc_kp_Tensor_allocateBindMemory = R"doc()doc";
 
@@ -1779,12 +2659,37 @@ static const char *__doc_kp_Tensor_destroy =
 R"doc(Destroys and frees the GPU resources which include the buffer and
 memory.)doc";
 
+static const char *__doc_kp_Tensor_evict =
+R"doc(Moves the data of a tensor of type eDevice to host memory and frees
+its buffer and device memory, which are created again by restore. The
+data is downloaded first if the device holds newer data than the host.
+Sequences restore evicted tensors when recording operations that use
+them, while other uses of an evicted tensor have to restore it first.
+Views evict the tensor they are a view of.)doc";
+
 static const char *__doc_kp_Tensor_getPrimaryBuffer = R"doc()doc";
 
 static const char *__doc_kp_Tensor_getPrimaryBufferUsageFlags = R"doc()doc";
 
 static const char *__doc_kp_Tensor_getStagingBufferUsageFlags = R"doc()doc";
 
+static const char *__doc_kp_Tensor_importHostMemory = R"doc()doc";
+
+static const char *__doc_kp_Tensor_isEvicted =
+R"doc(Whether the tensor has been evicted to host memory, which for views is
+whether their parent has been evicted.
+
+Returns:
+    Boolean stating whether the tensor is evicted)doc";
+
+static const char *__doc_kp_Tensor_isHostMemoryImported =
+R"doc(Whether the memory of the tensor is the host allocation it was created
+from, imported instead of copied, so the data and the host allocation
+are the same memory.
+
+Returns:
+    Boolean stating whether the host allocation was imported)doc";
+
 static const char *__doc_kp_Tensor_isInit =
 R"doc(Check whether tensor is initialized based on the created gpu
 resources.
@@ -1792,12 +2697,46 @@ resources.
 Returns:
     Boolean stating whether tensor is initialized)doc";
 
+static const char *__doc_kp_Tensor_isPinned =
+R"doc(Whether the tensor is pinned, which for views is whether their parent
+is pinned.
+
+Returns:
+    Boolean stating whether the tensor cannot be evicted)doc";
+
+static const char *__doc_kp_Tensor_loadFile =
+R"doc(Loads the data of the tensor from a region of a file, mapping the file
+and writing it into the memory of the tensor one chunk at a time. The
+next chunk is read ahead while the current one is written, and chunks
+already written are dropped from host memory, so files larger than the
+host memory can be loaded. The data of tensors of type eDevice and
+eStorage is streamed into their device memory through the staging ring
+provided, without going through the host data of the tensor, which is
+left unchanged and marked as stale.
+
+Parameter ``path``:
+    The path of the file to load the data from
+
+Parameter ``offset``:
+    The offset in bytes of the data of the tensor in the file
+
+Parameter ``stagingRing``:
+    The staging ring to stream the data through, which is only used by
+    tensors of type eDevice
+
+Parameter ``chunkSize``:
+    (optional) The size in bytes of the chunks to read)doc";
+
 static const char *__doc_kp_Tensor_mDescriptorBufferInfo = R"doc()doc";
 
 static const char *__doc_kp_Tensor_mFreePrimaryBuffer = R"doc()doc";
 
 static const char *__doc_kp_Tensor_mFreeStagingBuffer = R"doc()doc";
 
+static const char *__doc_kp_Tensor_mImportedHostData = R"doc()doc";
+
+static const char *__doc_kp_Tensor_mMappedFile = R"doc()doc";
+
 static const char *__doc_kp_Tensor_mPrimaryBuffer = R"doc()doc";
 
 static const char *__doc_kp_Tensor_mStagingBuffer = R"doc()doc";
@@ -1806,6 +2745,11 @@ static const char *__doc_kp_Tensor_operator_assign = R"doc()doc";
 
 static const char *__doc_kp_Tensor_operator_assign_2 = R"doc()doc";
 
+static const char *__doc_kp_Tensor_pin =
+R"doc(Prevents the memory budget from evicting the tensor until unpin is
+called as many times as pin, and marks the tensor as the most recently
+used one. Views pin the tensor they are a view of.)doc";
+
 static const char *__doc_kp_Tensor_recordBufferMemoryBarrier = R"doc()doc";
 
 static const char *__doc_kp_Tensor_recordCopyBuffer = R"doc()doc";
@@ -1892,8 +2836,34 @@ static const char *__doc_kp_Tensor_reserve =
 R"doc(Function to reserve memory on the tensor. This does not copy any data,
 it just reserves memory, similarly to std::vector reserve() method.)doc";
 
+static const char *__doc_kp_Tensor_restore =
+R"doc(Creates the buffer and device memory of an evicted tensor again and
+uploads its data, which does nothing if the tensor is not evicted.
+Views restore the tensor they are a view of.)doc";
+
+static const char *__doc_kp_Tensor_saveToStream =
+R"doc(Writes the data of the tensor into the stream provided. The host data
+is written as it is unless the data of the tensor is only current in
+its device memory, in which case it is downloaded through the staging
+ring provided one chunk at a time into two buffers in turn, so the
+download of a chunk overlaps the write of the previous one, which is
+done in a separate thread. The host data of the tensor is left
+unchanged.
+
+Parameter ``stream``:
+    The stream to write the data into
+
+Parameter ``stagingRing``:
+    The staging ring to download the data through, which is only used
+    when the device memory holds the current data
+
+Parameter ``chunkSize``:
+    (optional) The size in bytes of the chunks to download)doc";
+
 static const char *__doc_kp_Tensor_type = R"doc()doc";
 
+static const char *__doc_kp_Tensor_unpin = R"doc(Releases a pin added by pin.)doc";
+
 static const char *__doc_kp_dataType = R"doc()doc";
 
 static const char *__doc_kp_dataType_2 = R"doc()doc";
@@ -65,6 +65,22 @@ PYBIND11_MODULE(kp, m)
 
     py::module_ np = py::module_::import("numpy");
 
+    // Structured dtypes with the layout of the quantized blocks
+    py::list blockInt8Fields;
+    blockInt8Fields.append(py::make_tuple("scale", "<f2"));
+    blockInt8Fields.append(
+      py::make_tuple("values", "i1", kp::BlockInt8::blockSize));
+    py::dtype blockInt8Dtype = np.attr("dtype")(blockInt8Fields);
+
+    py::list blockInt4Fields;
+    blockInt4Fields.append(py::make_tuple("scale", "<f2"));
+    blockInt4Fields.append(
+      py::make_tuple("values", "u1", kp::BlockInt4::blockSize / 2));
+    py::dtype blockInt4Dtype = np.attr("dtype")(blockInt4Fields);
+
+    m.attr("block_int8") = blockInt8Dtype;
+    m.attr("block_int4") = blockInt4Dtype;
+
     py::enum_<kp::Memory::DataTypes>(m, "DataTypes")
       .value(
         "bool", kp::Memory::DataTypes::eBool, DOC(kp, Memory, DataTypes, eBool))
@@ -93,6 +109,23 @@ PYBIND11_MODULE(kp, m)
       .value("uchar",
              kp::Memory::DataTypes::eUnsignedChar,
              DOC(kp, Memory, DataTypes, eUnsignedChar))
+      .value(
+        "half", kp::Memory::DataTypes::eHalf, DOC(kp, Memory, DataTypes, eHalf))
+      .value("bfloat16",
+             kp::Memory::DataTypes::eBFloat16,
+             DOC(kp, Memory, DataTypes, eBFloat16))
+      .value("int64",
+             kp::Memory::DataTypes::eInt64,
+             DOC(kp, Memory, DataTypes, eInt64))
+      .value("uint64",
+             kp::Memory::DataTypes::eUnsignedInt64,
+             DOC(kp, Memory, DataTypes, eUnsignedInt64))
+      .value("block_int8",
+             kp::Memory::DataTypes::eBlockInt8,
+             DOC(kp, Memory, DataTypes, eBlockInt8))
+      .value("block_int4",
+             kp::Memory::DataTypes::eBlockInt4,
+             DOC(kp, Memory, DataTypes, eBlockInt4))
       .export_values();
 
     py::enum_<kp::Memory::MemoryTypes>(m, "MemoryTypes")
@@ -110,6 +143,29 @@ PYBIND11_MODULE(kp, m)
              DOC(kp, Memory, MemoryTypes, eDeviceAndHost))
       .export_values();
 
+    py::enum_<kp::Algorithm::BindingAccess>(
+      m, "BindingAccess", DOC(kp, Algorithm, BindingAccess))
+      .value("read_write",
+             kp::Algorithm::BindingAccess::eReadWrite,
+             DOC(kp, Algorithm, BindingAccess, eReadWrite))
+      .value("read_only",
+             kp::Algorithm::BindingAccess::eReadOnly,
+             DOC(kp, Algorithm, BindingAccess, eReadOnly))
+      .value("write_only",
+             kp::Algorithm::BindingAccess::eWriteOnly,
+             DOC(kp, Algorithm, BindingAccess, eWriteOnly))
+      .export_values();
+
+    py::enum_<kp::MemoryBudget::EvictionPolicy>(
+      m, "EvictionPolicy", DOC(kp, MemoryBudget, EvictionPolicy))
+      .value("none",
+             kp::MemoryBudget::EvictionPolicy::eNone,
+             DOC(kp, MemoryBudget, EvictionPolicy, eNone))
+      .value("least_recently_used",
+             kp::MemoryBudget::EvictionPolicy::eLeastRecentlyUsed,
+             DOC(kp, MemoryBudget, EvictionPolicy, eLeastRecentlyUsed))
+      .export_values();
+
     py::class_<kp::OpBase, std::shared_ptr<kp::OpBase>>(
       m, "OpBase", DOC(kp, OpBase));
 
@@ -148,11 +204,33 @@ PYBIND11_MODULE(kp, m)
                     const std::shared_ptr<kp::Algorithm>&>(),
            DOC(kp, OpMult, OpMult));
 
+    py::class_<kp::OpDequantize, kp::OpBase, std::shared_ptr<kp::OpDequantize>>(
+      m, "OpDequantize", DOC(kp, OpDequantize))
+      .def(py::init<const std::vector<std::shared_ptr<kp::Memory>>&,
+                    const std::shared_ptr<kp::Algorithm>&>(),
+           DOC(kp, OpDequantize, OpDequantize));
+
     py::class_<kp::Algorithm, std::shared_ptr<kp::Algorithm>>(
       m, "Algorithm", DOC(kp, Algorithm, Algorithm))
       .def("get_mem_objects",
            &kp::Algorithm::getMemObjects,
            DOC(kp, Algorithm, getMemObjects))
+      .def("rebind", &kp::Algorithm::rebind, DOC(kp, Algorithm, rebind))
+      .def("add_descriptor_set",
+           &kp::Algorithm::addDescriptorSet,
+           DOC(kp, Algorithm, addDescriptorSet))
+      .def("set_descriptor_set",
+           &kp::Algorithm::setDescriptorSet,
+           DOC(kp, Algorithm, setDescriptorSet))
+      .def("get_descriptor_set_count",
+           &kp::Algorithm::getDescriptorSetCount,
+           DOC(kp, Algorithm, getDescriptorSetCount))
+      .def("set_binding_access",
+           &kp::Algorithm::setBindingAccess,
+           DOC(kp, Algorithm, setBindingAccess))
+      .def("get_binding_access",
+           &kp::Algorithm::getBindingAccess,
+           DOC(kp, Algorithm, getBindingAccess))
       .def("destroy", &kp::Algorithm::destroy, DOC(kp, Algorithm, destroy))
       .def("is_init", &kp::Algorithm::isInit, DOC(kp, Algorithm, isInit));
 
@@ -163,7 +241,7 @@ PYBIND11_MODULE(kp, m)
       m, "Tensor", DOC(kp, Tensor))
       .def(
         "data",
-        [](kp::Tensor& self) {
+        [blockInt8Dtype, blockInt4Dtype](kp::Tensor& self) {
             // Non-owning container exposing the underlying pointer
             switch (self.dataType()) {
                 case kp::Memory::DataTypes::eFloat:
@@ -181,6 +259,32 @@ PYBIND11_MODULE(kp, m)
                 case kp::Memory::DataTypes::eBool:
                     return py::array(
                       self.size(), self.data<bool>(), py::cast(&self));
+                case kp::Memory::DataTypes::eHalf:
+                    return py::array(py::dtype("float16"),
+                                     { self.size() },
+                                     self.data<kp::Half>(),
+                                     py::cast(&self));
+                case kp::Memory::DataTypes::eBFloat16:
+                    // NumPy has no bfloat16 type so the bits are exposed
+                    return py::array(self.size(),
+                                     (uint16_t*)self.data<kp::BFloat16>(),
+                                     py::cast(&self));
+                case kp::Memory::DataTypes::eInt64:
+                    return py::array(
+                      self.size(), self.data<int64_t>(), py::cast(&self));
+                case kp::Memory::DataTypes::eUnsignedInt64:
+                    return py::array(
+                      self.size(), self.data<uint64_t>(), py::cast(&self));
+                case kp::Memory::DataTypes::eBlockInt8:
+                    return py::array(blockInt8Dtype,
+                                     { self.size() },
+                                     self.data<kp::BlockInt8>(),
+                                     py::cast(&self));
+                case kp::Memory::DataTypes::eBlockInt4:
+                    return py::array(blockInt4Dtype,
+                                     { self.size() },
+                                     self.data<kp::BlockInt4>(),
+                                     py::cast(&self));
                 default:
                     throw std::runtime_error(
                       "Kompute Python data type not supported");
@@ -195,6 +299,15 @@ PYBIND11_MODULE(kp, m)
              &kp::Memory::dataType),
            DOC(kp, Memory, dataType))
       .def("is_init", &kp::Tensor::isInit, DOC(kp, Tensor, isInit))
+      .def("is_host_memory_imported",
+           &kp::Tensor::isHostMemoryImported,
+           DOC(kp, Tensor, isHostMemoryImported))
+      .def("evict", &kp::Tensor::evict, DOC(kp, Tensor, evict))
+      .def("restore", &kp::Tensor::restore, DOC(kp, Tensor, restore))
+      .def("is_evicted", &kp::Tensor::isEvicted, DOC(kp, Tensor, isEvicted))
+      .def("pin", &kp::Tensor::pin, DOC(kp, Tensor, pin))
+      .def("unpin", &kp::Tensor::unpin, DOC(kp, Tensor, unpin))
+      .def("is_pinned", &kp::Tensor::isPinned, DOC(kp, Tensor, isPinned))
       .def("destroy", &kp::Tensor::destroy, DOC(kp, Tensor, destroy));
     py::class_<kp::Image, std::shared_ptr<kp::Image>, kp::Memory>(
       m, "Image", DOC(kp, Image))
@@ -224,6 +337,17 @@ PYBIND11_MODULE(kp, m)
                 case kp::Memory::DataTypes::eChar:
                     return py::array(
                       self.size(), self.data<int8_t>(), py::cast(&self));
+                case kp::Memory::DataTypes::eHalf:
+                    return py::array(py::dtype("float16"),
+                                     { self.size() },
+                                     self.data<kp::Half>(),
+                                     py::cast(&self));
+                case kp::Memory::DataTypes::eInt64:
+                    return py::array(
+                      self.size(), self.data<int64_t>(), py::cast(&self));
+                case kp::Memory::DataTypes::eUnsignedInt64:
+                    return py::array(
+                      self.size(), self.data<uint64_t>(), py::cast(&self));
                 default:
                     throw std::runtime_error(
                       "Kompute Python data type not supported");
@@ -279,6 +403,22 @@ PYBIND11_MODULE(kp, m)
            &kp::Sequence::isRecording,
            DOC(kp, Sequence, isRecording))
       .def("is_running", &kp::Sequence::isRunning, DOC(kp, Sequence, isRunning))
+      .def("is_complete",
+           &kp::Sequence::isComplete,
+           DOC(kp, Sequence, isComplete))
+      .def("slot_count",
+           &kp::Sequence::slotCount,
+           DOC(kp, Sequence, slotCount))
+      .def(
+        "wait_on",
+        [](kp::Sequence& self, std::shared_ptr<kp::Sequence> sequence) {
+            return self.waitOn(sequence);
+        },
+        DOC(kp, Sequence, waitOn),
+        py::arg("sequence"))
+      .def("clear_dependencies",
+           &kp::Sequence::clearDependencies,
+           DOC(kp, Sequence, clearDependencies))
       .def("is_init", &kp::Sequence::isInit, DOC(kp, Sequence, isInit))
       .def("clear", &kp::Sequence::clear, DOC(kp, Sequence, clear))
       .def("rerecord", &kp::Sequence::rerecord, DOC(kp, Sequence, rerecord))
@@ -287,6 +427,109 @@ PYBIND11_MODULE(kp, m)
            DOC(kp, Sequence, getTimestamps))
       .def("destroy", &kp::Sequence::destroy, DOC(kp, Sequence, destroy));
 
+    py::class_<kp::StreamingExecutor::Stats>(
+      m, "StreamingStats", DOC(kp, StreamingExecutor, Stats))
+      .def_readonly("element_count",
+                    &kp::StreamingExecutor::Stats::elementCount,
+                    DOC(kp, StreamingExecutor, Stats, elementCount))
+      .def_readonly("chunk_count",
+                    &kp::StreamingExecutor::Stats::chunkCount,
+                    DOC(kp, StreamingExecutor, Stats, chunkCount))
+      .def_readonly("bytes_uploaded",
+                    &kp::StreamingExecutor::Stats::bytesUploaded,
+                    DOC(kp, StreamingExecutor, Stats, bytesUploaded))
+      .def_readonly("bytes_downloaded",
+                    &kp::StreamingExecutor::Stats::bytesDownloaded,
+                    DOC(kp, StreamingExecutor, Stats, bytesDownloaded))
+      .def_readonly("seconds",
+                    &kp::StreamingExecutor::Stats::seconds,
+                    DOC(kp, StreamingExecutor, Stats, seconds))
+      .def("throughput",
+           &kp::StreamingExecutor::Stats::throughput,
+           DOC(kp, StreamingExecutor, Stats, throughput));
+
+    py::class_<kp::StreamingExecutor, std::shared_ptr<kp::StreamingExecutor>>(
+      m, "StreamingExecutor", DOC(kp, StreamingExecutor))
+      .def(
+        "run",
+        [](kp::StreamingExecutor& self,
+           const std::vector<py::array>& inputs,
+           const std::vector<py::array>& outputs) {
+            const std::vector<std::shared_ptr<kp::Memory>>& memObjects =
+              self.getMemObjects(0);
+            uint64_t elementCount =
+              inputs.empty() ? outputs.at(0).size() : inputs[0].size();
+
+            // The buffers are read and written as they are, so they have to
+            // match the element count and element size of the bindings
+            auto checkArray = [&](const py::array& array, uint32_t binding) {
+                if (!(array.flags() & py::array::c_style)) {
+                    throw std::runtime_error(
+                      "Kompute Python StreamingExecutor run requires C "
+                      "contiguous arrays");
+                }
+                if (static_cast<uint64_t>(array.size()) != elementCount ||
+                    static_cast<uint32_t>(array.itemsize()) !=
+                      memObjects[binding]->dataTypeMemorySize()) {
+                    throw std::runtime_error(
+                      "Kompute Python StreamingExecutor run arrays have to "
+                      "hold the same number of elements of the size of "
+                      "their binding");
+                }
+            };
+
+            std::vector<const void*> inputData;
+            for (size_t i = 0; i < inputs.size(); i++) {
+                checkArray(inputs[i], self.getInputBindings().at(i));
+                inputData.push_back(inputs[i].data());
+            }
+            std::vector<void*> outputData;
+            for (size_t i = 0; i < outputs.size(); i++) {
+                checkArray(outputs[i], self.getOutputBindings().at(i));
+                outputData.push_back(outputs[i].mutable_data());
+            }
+
+            return self.run(inputData, outputData, elementCount);
+        },
+        DOC(kp, StreamingExecutor, run),
+        py::arg("inputs"),
+        py::arg("outputs"))
+      .def("chunk_size",
+           &kp::StreamingExecutor::chunkSize,
+           DOC(kp, StreamingExecutor, chunkSize))
+      .def("slot_count",
+           &kp::StreamingExecutor::slotCount,
+           DOC(kp, StreamingExecutor, slotCount));
+
+    py::class_<kp::MemoryBudget, std::shared_ptr<kp::MemoryBudget>>(
+      m, "MemoryBudget", DOC(kp, MemoryBudget))
+      .def("has_budget_extension",
+           &kp::MemoryBudget::hasBudgetExtension,
+           DOC(kp, MemoryBudget, hasBudgetExtension))
+      .def("budget", &kp::MemoryBudget::budget, DOC(kp, MemoryBudget, budget))
+      .def("usage", &kp::MemoryBudget::usage, DOC(kp, MemoryBudget, usage))
+      .def("set_limit",
+           &kp::MemoryBudget::setLimit,
+           DOC(kp, MemoryBudget, setLimit),
+           py::arg("limit"))
+      .def("limit", &kp::MemoryBudget::limit, DOC(kp, MemoryBudget, limit))
+      .def("tracked_size",
+           &kp::MemoryBudget::trackedSize,
+           DOC(kp, MemoryBudget, trackedSize))
+      .def("tensor_count",
+           &kp::MemoryBudget::tensorCount,
+           DOC(kp, MemoryBudget, tensorCount))
+      .def("eviction_count",
+           &kp::MemoryBudget::evictionCount,
+           DOC(kp, MemoryBudget, evictionCount))
+      .def("set_eviction_policy",
+           &kp::MemoryBudget::setEvictionPolicy,
+           DOC(kp, MemoryBudget, setEvictionPolicy),
+           py::arg("eviction_policy"))
+      .def("get_eviction_policy",
+           &kp::MemoryBudget::getEvictionPolicy,
+           DOC(kp, MemoryBudget, getEvictionPolicy));
+
     py::class_<kp::Manager, std::shared_ptr<kp::Manager>>(
       m, "Manager", DOC(kp, Manager))
       .def(py::init(), DOC(kp, Manager, Manager))
@@ -303,7 +546,27 @@ PYBIND11_MODULE(kp, m)
            &kp::Manager::sequence,
            DOC(kp, Manager, sequence),
            py::arg("queue_index") = 0,
-           py::arg("total_timestamps") = 0)
+           py::arg("total_timestamps") = 0,
+           py::arg("slot_count") = 1)
+      .def("eval_async",
+           &kp::Manager::evalAsync,
+           DOC(kp, Manager, evalAsync),
+           py::arg("sequences"))
+      .def("eval_await",
+           &kp::Manager::evalAwait,
+           DOC(kp, Manager, evalAwait),
+           py::arg("sequences"),
+           py::arg("wait_for") = UINT64_MAX)
+      .def("wait_any",
+           &kp::Manager::waitAny,
+           DOC(kp, Manager, waitAny),
+           py::arg("sequences"),
+           py::arg("wait_for") = UINT64_MAX)
+      .def("wait_all",
+           &kp::Manager::waitAll,
+           DOC(kp, Manager, waitAll),
+           py::arg("sequences"),
+           py::arg("wait_for") = UINT64_MAX)
       .def(
         "tensor",
         [np](kp::Manager& self,
@@ -325,7 +588,7 @@ PYBIND11_MODULE(kp, m)
         py::arg("memory_type") = kp::Memory::MemoryTypes::eDevice)
       .def(
         "tensor_t",
-        [np](kp::Manager& self,
+        [np, blockInt8Dtype, blockInt4Dtype](kp::Manager& self,
              const py::array& data,
              kp::Memory::MemoryTypes memory_type) {
             // TODO: Suppport strides in numpy format
@@ -365,6 +628,36 @@ PYBIND11_MODULE(kp, m)
                                    sizeof(bool),
                                    kp::Memory::DataTypes::eBool,
                                    memory_type);
+            } else if (flatdata.dtype().is(py::dtype("float16"))) {
+                return self.tensor(info.ptr,
+                                   flatdata.size(),
+                                   sizeof(kp::Half),
+                                   kp::Memory::DataTypes::eHalf,
+                                   memory_type);
+            } else if (flatdata.dtype().is(py::dtype::of<std::int64_t>())) {
+                return self.tensor(info.ptr,
+                                   flatdata.size(),
+                                   sizeof(int64_t),
+                                   kp::Memory::DataTypes::eInt64,
+                                   memory_type);
+            } else if (flatdata.dtype().is(py::dtype::of<std::uint64_t>())) {
+                return self.tensor(info.ptr,
+                                   flatdata.size(),
+                                   sizeof(uint64_t),
+                                   kp::Memory::DataTypes::eUnsignedInt64,
+                                   memory_type);
+            } else if (flatdata.dtype().equal(blockInt8Dtype)) {
+                return self.tensor(info.ptr,
+                                   flatdata.size(),
+                                   sizeof(kp::BlockInt8),
+                                   kp::Memory::DataTypes::eBlockInt8,
+                                   memory_type);
+            } else if (flatdata.dtype().equal(blockInt4Dtype)) {
+                return self.tensor(info.ptr,
+                                   flatdata.size(),
+                                   sizeof(kp::BlockInt4),
+                                   kp::Memory::DataTypes::eBlockInt4,
+                                   memory_type);
             } else {
                 throw std::runtime_error(
                   "Kompute Python no valid dtype supported");
@@ -373,6 +666,98 @@ PYBIND11_MODULE(kp, m)
         DOC(kp, Manager, tensorT),
         py::arg("data"),
         py::arg("memory_type") = kp::Memory::MemoryTypes::eDevice)
+      .def(
+        "import_tensor",
+        [blockInt8Dtype, blockInt4Dtype](kp::Manager& self,
+                                          const py::array& data) {
+            // The memory of the array is imported as it is, so it can not be
+            // raveled into a copy
+            if (!(data.flags() & py::array::c_style)) {
+                throw std::runtime_error(
+                  "Kompute Python import_tensor requires a C contiguous "
+                  "array");
+            }
+            const py::buffer_info info = data.request();
+            KP_LOG_DEBUG("Kompute Python Manager importing tensor with data "
+                         "size {} dtype {}",
+                         data.size(),
+                         std::string(py::str(data.dtype())));
+            kp::Memory::DataTypes dataType;
+            if (data.dtype().is(py::dtype::of<std::float_t>())) {
+                dataType = kp::Memory::DataTypes::eFloat;
+            } else if (data.dtype().is(py::dtype::of<std::uint32_t>())) {
+                dataType = kp::Memory::DataTypes::eUnsignedInt;
+            } else if (data.dtype().is(py::dtype::of<std::int32_t>())) {
+                dataType = kp::Memory::DataTypes::eInt;
+            } else if (data.dtype().is(py::dtype::of<std::double_t>())) {
+                dataType = kp::Memory::DataTypes::eDouble;
+            } else if (data.dtype().is(py::dtype::of<bool>())) {
+                dataType = kp::Memory::DataTypes::eBool;
+            } else if (data.dtype().is(py::dtype("float16"))) {
+                dataType = kp::Memory::DataTypes::eHalf;
+            } else if (data.dtype().is(py::dtype::of<std::int64_t>())) {
+                dataType = kp::Memory::DataTypes::eInt64;
+            } else if (data.dtype().is(py::dtype::of<std::uint64_t>())) {
+                dataType = kp::Memory::DataTypes::eUnsignedInt64;
+            } else if (data.dtype().equal(blockInt8Dtype)) {
+                dataType = kp::Memory::DataTypes::eBlockInt8;
+            } else if (data.dtype().equal(blockInt4Dtype)) {
+                dataType = kp::Memory::DataTypes::eBlockInt4;
+            } else {
+                throw std::runtime_error(
+                  "Kompute Python no valid dtype supported");
+            }
+            return self.importTensor(
+              info.ptr, data.size(), data.itemsize(), dataType);
+        },
+        DOC(kp, Manager, importTensor),
+        py::arg("data"),
+        // The array is kept alive while the tensor or the manager may use it
+        py::keep_alive<0, 2>(),
+        py::keep_alive<1, 2>())
+      .def(
+        "tensor_from_file",
+        [](kp::Manager& self,
+           const std::string& path,
+           kp::Memory::DataTypes data_type,
+           uint64_t count,
+           uint64_t offset,
+           kp::Memory::MemoryTypes memory_type) {
+            uint32_t elementMemorySize =
+              kp::Memory::dataTypeMemorySize(data_type);
+            if (elementMemorySize == 0) {
+                throw std::runtime_error(
+                  "Kompute Python tensor_from_file requires a data type with "
+                  "a known size");
+            }
+            return self.tensorFromFile(path,
+                                       offset,
+                                       count,
+                                       elementMemorySize,
+                                       data_type,
+                                       memory_type);
+        },
+        DOC(kp, Manager, tensorFromFile),
+        py::arg("path"),
+        py::arg("data_type"),
+        py::arg("count"),
+        py::arg("offset") = 0,
+        py::arg("memory_type") = kp::Memory::MemoryTypes::eDevice)
+      .def("load_tensor",
+           &kp::Manager::loadTensor,
+           DOC(kp, Manager, loadTensor),
+           py::arg("tensor"),
+           py::arg("path"),
+           py::arg("offset") = 0)
+      .def("save_tensors",
+           &kp::Manager::saveTensors,
+           DOC(kp, Manager, saveTensors),
+           py::arg("path"),
+           py::arg("tensors"))
+      .def("load_tensors",
+           &kp::Manager::loadTensors,
+           DOC(kp, Manager, loadTensors),
+           py::arg("path"))
       .def(
         "image",
         [np](kp::Manager& self,
@@ -471,6 +856,14 @@ PYBIND11_MODULE(kp, m)
                                   num_channels,
                                   kp::Memory::DataTypes::eChar,
                                   memory_type);
+            } else if (flatdata.dtype().is(py::dtype("float16"))) {
+                return self.image(info.ptr,
+                                  flatdata.size(),
+                                  width,
+                                  height,
+                                  num_channels,
+                                  kp::Memory::DataTypes::eHalf,
+                                  memory_type);
             } else {
                 throw std::runtime_error(
                   "Kompute Python no valid dtype supported");
@@ -710,6 +1103,21 @@ PYBIND11_MODULE(kp, m)
         py::arg("workgroup") = kp::Workgroup(),
         py::arg("spec_consts") = std::vector<float>(),
         py::arg("push_consts") = std::vector<float>())
+      .def("get_memory_budget",
+           &kp::Manager::getMemoryBudget,
+           DOC(kp, Manager, getMemoryBudget))
+      .def("set_eviction_policy",
+           &kp::Manager::setEvictionPolicy,
+           DOC(kp, Manager, setEvictionPolicy),
+           py::arg("eviction_policy"))
+      .def("streaming_executor",
+           &kp::Manager::streamingExecutor,
+           DOC(kp, Manager, streamingExecutor),
+           py::arg("algorithm"),
+           py::arg("input_bindings"),
+           py::arg("output_bindings"),
+           py::arg("slot_count") = KP_DEFAULT_STREAMING_SLOT_COUNT,
+           py::arg("queue_index") = 0)
       .def(
         "list_devices",
         [](kp::Manager& self) {
@@ -731,6 +1139,64 @@ PYBIND11_MODULE(kp, m)
         },
         "Return a dict containing information about the device");
 
+    m.def(
+      "quantize",
+      [blockInt8Dtype, blockInt4Dtype](
+        const py::array_t<float, py::array::c_style | py::array::forcecast>&
+          data,
+        kp::Memory::DataTypes data_type) {
+          const float* values = data.data();
+          uint64_t count = data.size();
+          if (data_type == kp::Memory::DataTypes::eBlockInt8) {
+              py::array blocks(blockInt8Dtype,
+                               { kp::BlockInt8::blockCount(count) });
+              kp::BlockInt8::quantize(
+                values, count, (kp::BlockInt8*)blocks.mutable_data());
+              return blocks;
+          } else if (data_type == kp::Memory::DataTypes::eBlockInt4) {
+              py::array blocks(blockInt4Dtype,
+                               { kp::BlockInt4::blockCount(count) });
+              kp::BlockInt4::quantize(
+                values, count, (kp::BlockInt4*)blocks.mutable_data());
+              return blocks;
+          }
+          throw std::runtime_error(
+            "Kompute Python quantize data type has to be block_int8 or "
+            "block_int4");
+      },
+      DOC(kp, BlockInt8, quantize),
+      py::arg("data"),
+      py::arg("data_type"));
+
+    m.def(
+      "dequantize",
+      [np, blockInt8Dtype, blockInt4Dtype](const py::array& blocks) {
+          const py::array& flatblocks =
+            np.attr("ascontiguousarray")(np.attr("ravel")(blocks));
+          if (flatblocks.dtype().equal(blockInt8Dtype)) {
+              py::array_t<float> data(flatblocks.size() *
+                                      kp::BlockInt8::blockSize);
+              kp::BlockInt8::dequantize(
+                (const kp::BlockInt8*)flatblocks.data(),
+                flatblocks.size(),
+                data.mutable_data());
+              return data;
+          } else if (flatblocks.dtype().equal(blockInt4Dtype)) {
+              py::array_t<float> data(flatblocks.size() *
+                                      kp::BlockInt4::blockSize);
+              kp::BlockInt4::dequantize(
+                (const kp::BlockInt4*)flatblocks.data(),
+                flatblocks.size(),
+                data.mutable_data());
+              return data;
+          }
+          throw std::runtime_error(
+            "Kompute Python dequantize expected block_int8 or block_int4 "
+            "blocks");
+      },
+      DOC(kp, BlockInt8, dequantize),
+      py::arg("blocks"));
+
     auto atexit = py::module_::import("atexit");
     atexit.attr("register")(py::cpp_function([]() {
         kp_trace = py::none();
@@ -169,6 +169,187 @@ def test_sequence():
     assert tensor_out.is_init() == False
 
 
+def test_batched_sequences():
+    """
+    Test submitting several sequences in a single submission
+    """
+
+    shader = """
+        #version 450
+        layout(set = 0, binding = 0) buffer tensorA { float valuesA[]; };
+        layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+        void main()
+        {
+            uint index = gl_GlobalInvocationID.x;
+            valuesA[index] = valuesA[index] + 1.0;
+        }
+    """
+
+    spirv = compile_source(shader)
+
+    mgr = kp.Manager()
+
+    tensors = [mgr.tensor([i, i, i]) for i in range(3)]
+    mgr.sequence().eval(kp.OpSyncDevice(tensors))
+
+    sequences = []
+    for tensor in tensors:
+        sq = mgr.sequence()
+        sq.record(kp.OpAlgoDispatch(mgr.algorithm([tensor], spirv)))
+        sq.record(kp.OpSyncLocal([tensor]))
+        sequences.append(sq)
+
+    mgr.eval_async(sequences)
+
+    assert all(sq.is_running() for sq in sequences)
+
+    mgr.eval_await(sequences)
+
+    assert not any(sq.is_running() for sq in sequences)
+
+    for i, tensor in enumerate(tensors):
+        assert tensor.data().tolist() == [i + 1] * 3
+
+
+def test_sequence_wait_on():
+    """
+    Test submitting dependent sequences up front and awaiting the last one
+    """
+
+    shader = """
+        #version 450
+        layout(set = 0, binding = 0) buffer tensorA { float valuesA[]; };
+        layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+        void main()
+        {
+            uint index = gl_GlobalInvocationID.x;
+            valuesA[index] = valuesA[index] * 2.0;
+        }
+    """
+
+    spirv = compile_source(shader)
+
+    mgr = kp.Manager()
+
+    tensor = mgr.tensor([1, 2, 3])
+
+    sq_upload = mgr.sequence()
+    sq_upload.record(kp.OpSyncDevice([tensor]))
+
+    sq_double = mgr.sequence()
+    sq_double.record(kp.OpAlgoDispatch(mgr.algorithm([tensor], spirv)))
+    sq_double.record(kp.OpSyncLocal([tensor]))
+    sq_double.wait_on(sq_upload)
+
+    sq_upload.eval_async()
+    sq_double.eval_async()
+
+    sq_double.eval_await()
+    sq_upload.eval_await()
+
+    assert tensor.data().tolist() == [2, 4, 6]
+
+    sq_double.clear_dependencies()
+
+
+def test_sequence_slots():
+    """
+    Test evaluating a sequence with several slots in a steady-state loop
+    """
+
+    shader = """
+        #version 450
+        layout(set = 0, binding = 0) buffer tensorA { float valuesA[]; };
+        layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+        void main()
+        {
+            uint index = gl_GlobalInvocationID.x;
+            valuesA[index] = valuesA[index] + 1.0;
+        }
+    """
+
+    spirv = compile_source(shader)
+
+    mgr = kp.Manager()
+
+    tensor = mgr.tensor([0, 0, 0])
+
+    mgr.sequence().eval(kp.OpSyncDevice([tensor]))
+
+    sq = mgr.sequence(slot_count=3)
+    sq.record(kp.OpAlgoDispatch(mgr.algorithm([tensor], spirv)))
+
+    assert sq.slot_count() == 3
+
+    for _ in range(10):
+        sq.eval_async()
+
+    sq.eval_await()
+
+    assert not sq.is_running()
+
+    mgr.sequence().eval(kp.OpSyncLocal([tensor]))
+
+    assert tensor.data().tolist() == [10, 10, 10]
+
+
+def test_sequence_wait_any():
+    """
+    Test waiting for whichever of several sequences completes first
+    """
+
+    shader = """
+        #version 450
+        layout(set = 0, binding = 0) buffer tensorA { float valuesA[]; };
+        layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+        void main()
+        {
+            uint index = gl_GlobalInvocationID.x;
+            valuesA[index] = valuesA[index] + 1.0;
+        }
+    """
+
+    spirv = compile_source(shader)
+
+    mgr = kp.Manager()
+
+    tensor_a = mgr.tensor([0, 1])
+    tensor_b = mgr.tensor([2, 3])
+
+    mgr.sequence().eval(kp.OpSyncDevice([tensor_a, tensor_b]))
+
+    sequences = [mgr.sequence(), mgr.sequence()]
+
+    assert sequences[0].is_complete()
+    assert mgr.wait_any(sequences) == -1
+
+    sequences[0].eval_async(
+        kp.OpAlgoDispatch(mgr.algorithm([tensor_a], spirv)))
+    sequences[1].eval_async(
+        kp.OpAlgoDispatch(mgr.algorithm([tensor_b], spirv)))
+
+    index = mgr.wait_any(sequences)
+
+    assert index in [0, 1]
+    assert sequences[index].is_complete()
+    assert sequences[index].is_running()
+
+    sequences[index].eval_await()
+
+    assert mgr.wait_all(sequences)
+
+    sequences[1 - index].eval_await()
+
+    mgr.sequence().eval(kp.OpSyncLocal([tensor_a, tensor_b]))
+
+    assert tensor_a.data().tolist() == [1, 2]
+    assert tensor_b.data().tolist() == [3, 4]
+
+
 def test_pushconsts():
 
     spirv = compile_source("""
@@ -284,3 +465,83 @@ def test_mgr_utils():
 
     assert len(devices) > 0
     assert "device_name" in devices[0]
+
+
+def test_streaming_executor():
+    """
+    Test streaming arrays larger than the bound tensors through an algorithm
+    """
+
+    shader = """
+        #version 450
+        layout(set = 0, binding = 0) buffer tensorIn { float valuesIn[]; };
+        layout(set = 0, binding = 1) buffer tensorOut { float valuesOut[]; };
+        layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+        void main()
+        {
+            uint index = gl_GlobalInvocationID.x;
+            valuesOut[index] = valuesIn[index] * 2.0;
+        }
+    """
+
+    mgr = kp.Manager()
+
+    tensor_in = mgr.tensor(np.zeros(256, dtype=np.float32))
+    tensor_out = mgr.tensor(np.zeros(256, dtype=np.float32))
+
+    algo = mgr.algorithm([tensor_in, tensor_out], compile_source(shader))
+
+    executor = mgr.streaming_executor(algo, [0], [1])
+
+    assert executor.chunk_size() == 256
+    assert executor.slot_count() == 3
+
+    data_in = np.arange(5000, dtype=np.float32)
+    data_out = np.zeros(5000, dtype=np.float32)
+
+    stats = executor.run([data_in], [data_out])
+
+    assert np.all(data_out == data_in * 2)
+    assert stats.chunk_count == 20
+    assert stats.bytes_uploaded == data_in.nbytes
+    assert stats.bytes_downloaded == data_out.nbytes
+    assert stats.throughput() > 0
+
+
+def test_memory_budget():
+    """
+    Test evicting the least recently used tensors when exceeding the limit
+    """
+
+    mgr = kp.Manager()
+
+    budget = mgr.get_memory_budget()
+
+    assert budget.budget() > 0
+    assert budget.get_eviction_policy() == kp.EvictionPolicy.none
+
+    data = np.arange(16, dtype=np.float32)
+
+    budget.set_limit(2 * data.nbytes)
+    mgr.set_eviction_policy(kp.EvictionPolicy.least_recently_used)
+
+    tensor_a = mgr.tensor(data)
+    tensor_b = mgr.tensor(data)
+
+    tensor_b.pin()
+    tensor_c = mgr.tensor(data)
+
+    assert tensor_a.is_evicted()
+    assert not tensor_b.is_evicted()
+    assert budget.eviction_count() == 1
+    assert budget.tensor_count() == 3
+    assert budget.tracked_size() == 2 * data.nbytes
+
+    tensor_b.unpin()
+
+    mgr.sequence().eval(kp.OpSyncLocal([tensor_a]))
+
+    assert not tensor_a.is_evicted()
+    assert tensor_b.is_evicted()
+    assert np.all(tensor_a.data() == data)
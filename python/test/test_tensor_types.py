@@ -1,3 +1,4 @@
+import mmap
 import os
 import pytest
 import kp
@@ -230,3 +231,152 @@ def test_tensor_numpy_ownership():
     m.destroy()
 
     assert td.base.is_init() == False
+
+def test_type_half():
+
+    arr = np.array([1.5, -2.25, 65504., 0.], dtype=np.float16)
+
+    mgr = kp.Manager()
+
+    tensor = mgr.tensor_t(arr)
+
+    assert tensor.data_type() == kp.DataTypes.half
+    assert tensor.data().dtype == np.float16
+
+    mgr.sequence().eval(kp.OpSyncDevice([tensor]))
+
+    tensor.data()[:] = 0
+
+    mgr.sequence().eval(kp.OpSyncLocal([tensor]))
+
+    assert np.all(tensor.data() == arr)
+
+def test_type_int64():
+
+    arr = np.array([2**40, -2**40, 1], dtype=np.int64)
+
+    mgr = kp.Manager()
+
+    tensor = mgr.tensor_t(arr)
+
+    assert tensor.data_type() == kp.DataTypes.int64
+
+    mgr.sequence().eval(kp.OpSyncDevice([tensor]))
+
+    tensor.data()[:] = 0
+
+    mgr.sequence().eval(kp.OpSyncLocal([tensor]))
+
+    assert np.all(tensor.data() == arr)
+
+def test_type_block_int8():
+
+    arr = np.sin(np.arange(100, dtype=np.float32))
+
+    mgr = kp.Manager()
+
+    blocks = kp.quantize(arr, kp.DataTypes.block_int8)
+
+    assert blocks.dtype == kp.block_int8
+    assert len(blocks) == 4
+
+    tensor_in = mgr.tensor_t(blocks)
+    tensor_out = mgr.tensor(np.zeros(len(blocks) * 32, dtype=np.float32))
+
+    assert tensor_in.data_type() == kp.DataTypes.block_int8
+
+    (mgr.sequence()
+        .record(kp.OpSyncDevice([tensor_in]))
+        .record(kp.OpDequantize([tensor_in, tensor_out], mgr.algorithm([], b"")))
+        .record(kp.OpSyncLocal([tensor_out]))
+        .eval())
+
+    assert np.all(tensor_out.data() == kp.dequantize(blocks))
+    assert np.allclose(tensor_out.data()[:100], arr, atol=0.01)
+
+def test_type_block_int4():
+
+    arr = np.sin(np.arange(100, dtype=np.float32))
+
+    mgr = kp.Manager()
+
+    blocks = kp.quantize(arr, kp.DataTypes.block_int4)
+
+    assert blocks.dtype == kp.block_int4
+
+    tensor_in = mgr.tensor_t(blocks)
+    tensor_out = mgr.tensor(np.zeros(len(blocks) * 32, dtype=np.float32))
+
+    assert tensor_in.data_type() == kp.DataTypes.block_int4
+
+    (mgr.sequence()
+        .record(kp.OpSyncDevice([tensor_in]))
+        .record(kp.OpDequantize([tensor_in, tensor_out], mgr.algorithm([], b"")))
+        .record(kp.OpSyncLocal([tensor_out]))
+        .eval())
+
+    assert np.all(tensor_out.data() == kp.dequantize(blocks))
+    assert np.allclose(tensor_out.data()[:100], arr, atol=0.15)
+
+def test_import_tensor():
+
+    # Anonymous memory maps are page aligned
+    buffer = mmap.mmap(-1, 65536)
+    arr = np.frombuffer(buffer, dtype=np.float32)
+    arr[:] = np.arange(len(arr), dtype=np.float32)
+
+    mgr = kp.Manager()
+
+    tensor = mgr.import_tensor(arr)
+
+    assert tensor.memory_type() == kp.MemoryTypes.host
+    assert np.all(tensor.data() == arr)
+
+    if tensor.is_host_memory_imported():
+        tensor.data()[0] = 100
+        assert arr[0] == 100
+
+    with pytest.raises(RuntimeError):
+        mgr.import_tensor(np.zeros((4, 4), dtype=np.float32)[:, 0])
+
+def test_tensor_from_file(tmp_path):
+
+    arr = np.arange(1000, dtype=np.float32)
+    path = str(tmp_path / "data.bin")
+    arr.tofile(path)
+
+    mgr = kp.Manager()
+
+    tensor = mgr.tensor_from_file(path, kp.DataTypes.float, 990, offset=40)
+
+    assert np.all(tensor.data() == arr[10:])
+
+    tensor_loaded = mgr.tensor_t(np.zeros(1000, dtype=np.float32))
+    mgr.load_tensor(tensor_loaded, path)
+    mgr.sequence().eval(kp.OpSyncLocal([tensor_loaded]))
+
+    assert np.all(tensor_loaded.data() == arr)
+
+def test_save_and_load_tensors(tmp_path):
+
+    arr_a = np.array([1, 2, 3], dtype=np.float32)
+    arr_b = np.array([4, -5], dtype=np.int32)
+    path = str(tmp_path / "checkpoint.bin")
+
+    mgr = kp.Manager()
+
+    tensor_a = mgr.tensor_t(arr_a)
+    tensor_b = mgr.tensor_t(arr_b, kp.MemoryTypes.host)
+
+    mgr.save_tensors(path, [tensor_a, tensor_b])
+
+    tensors = mgr.load_tensors(path)
+
+    assert len(tensors) == 2
+    assert tensors[0].data_type() == kp.DataTypes.float
+    assert tensors[1].memory_type() == kp.MemoryTypes.host
+
+    mgr.sequence().eval(kp.OpSyncLocal([tensors[0]]))
+
+    assert np.all(tensors[0].data() == arr_a)
+    assert np.all(tensors[1].data() == arr_b)
@@ -1,8 +1,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #include <fstream>
+#include <limits>
 
 #include "kompute/Algorithm.hpp"
 #include "kompute/Image.hpp"
+#if KOMPUTE_OPT_USE_SPDLOG
+#include <spdlog/fmt/fmt.h>
+#else
+#include <fmt/core.h>
+#endif
 
 namespace kp {
 
@@ -17,7 +23,8 @@ bool
 Algorithm::isInit()
 {
     return this->mPipeline && this->mPipelineCache && this->mPipelineLayout &&
-           this->mDescriptorPool && this->mDescriptorSet &&
+           (this->mDescriptorPool || this->mDescriptorAllocations.size()) &&
+           this->mDescriptorSet &&
            this->mDescriptorSetLayout && this->mShaderModule;
 }
 
@@ -38,6 +45,17 @@ Algorithm::destroy()
         return;
     }
 
+    if (this->mRegisteredPipeline) {
+        KP_LOG_DEBUG("Kompute Algorithm releasing registered pipeline");
+        // The registry destroys the shared objects with the last reference
+        this->mPipelineRegistry->release(this->mPipelineKey);
+        this->mRegisteredPipeline = false;
+        this->mPipeline = nullptr;
+        this->mPipelineLayout = nullptr;
+        this->mShaderModule = nullptr;
+        this->mDescriptorSetLayout = nullptr;
+    }
+
     if (this->mFreePipeline && this->mPipeline) {
         KP_LOG_DEBUG("Kompute Algorithm Destroying pipeline");
         if (!this->mPipeline) {
@@ -100,6 +118,30 @@ Algorithm::destroy()
     //    this->mDescriptorSet = nullptr;
     //}
 
+    if (this->mDescriptorAllocations.size()) {
+        KP_LOG_DEBUG("Kompute Algorithm freeing allocated Descriptor Sets");
+        for (const DescriptorAllocator::Allocation& allocation :
+             this->mDescriptorAllocations) {
+            this->mDescriptorAllocator->free(allocation);
+        }
+        this->mDescriptorAllocations.clear();
+    }
+
+    if (this->mExtraDescriptorPools.size()) {
+        KP_LOG_DEBUG("Kompute Algorithm Destroying extra Descriptor Pools");
+        for (const std::shared_ptr<vk::DescriptorPool>& descriptorPool :
+             this->mExtraDescriptorPools) {
+            this->mDevice->destroy(
+              *descriptorPool,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        }
+        this->mExtraDescriptorPools.clear();
+    }
+    this->mDescriptorSets.clear();
+    this->mDescriptorSetMemObjects.clear();
+    this->mDescriptorSetGenerations.clear();
+    this->mDescriptorSetIndex = 0;
+
     if (this->mFreeDescriptorSetLayout && this->mDescriptorSetLayout) {
         KP_LOG_DEBUG("Kompute Algorithm Destroying Descriptor Set Layout");
         if (!this->mDescriptorSetLayout) {
@@ -127,12 +169,96 @@ Algorithm::destroy()
 
 void
 Algorithm::createParameters()
+{
+    KP_LOG_DEBUG("Kompute Algorithm createParameters started");
+
+    // The descriptor set layout is already set when it is shared through the
+    // pipeline registry
+    if (!this->mDescriptorSetLayout) {
+        std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
+        for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+            descriptorSetBindings.push_back(vk::DescriptorSetLayoutBinding(
+              i, // Binding index
+              mMemObjects[i]->getDescriptorType(),
+              1, // Descriptor count
+              vk::ShaderStageFlagBits::eCompute));
+        }
+
+        // This is the component that is fed into the pipeline
+        vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutInfo(
+          vk::DescriptorSetLayoutCreateFlags(),
+          static_cast<uint32_t>(descriptorSetBindings.size()),
+          descriptorSetBindings.data());
+
+        KP_LOG_DEBUG("Kompute Algorithm creating descriptor set layout");
+        this->mDescriptorSetLayout =
+          std::make_shared<vk::DescriptorSetLayout>();
+        this->mDevice->createDescriptorSetLayout(
+          &descriptorSetLayoutInfo, nullptr, this->mDescriptorSetLayout.get());
+        this->mFreeDescriptorSetLayout = true;
+    }
+
+    KP_LOG_DEBUG("Kompute Algorithm allocating descriptor sets");
+    this->mDescriptorSet = this->allocateDescriptorSet();
+    this->mFreeDescriptorSet = true;
+
+    KP_LOG_DEBUG("Kompute Algorithm updating descriptor sets");
+    this->updateDescriptorSet(*this->mDescriptorSet, this->mMemObjects);
+
+    this->mDescriptorSets = { this->mDescriptorSet };
+    this->mDescriptorSetMemObjects = { this->mMemObjects };
+    this->mDescriptorSetGenerations = {
+        Algorithm::primaryBufferGenerations(this->mMemObjects)
+    };
+    this->mDescriptorSetIndex = 0;
+
+    KP_LOG_DEBUG("Kompute Algorithm successfully run init");
+}
+
+std::shared_ptr<vk::DescriptorSet>
+Algorithm::allocateDescriptorSet()
+{
+    std::shared_ptr<vk::DescriptorSet> descriptorSet =
+      std::make_shared<vk::DescriptorSet>();
+
+    if (this->mDescriptorAllocator) {
+        DescriptorAllocator::Allocation allocation =
+          this->mDescriptorAllocator->allocate(*this->mDescriptorSetLayout,
+                                               this->getDescriptorCounts());
+        *descriptorSet = allocation.descriptorSet;
+        this->mDescriptorAllocations.push_back(allocation);
+        return descriptorSet;
+    }
+
+    // Without a descriptor allocator every descriptor set gets a descriptor
+    // pool of its own
+    KP_LOG_DEBUG("Kompute Algorithm creating descriptor pool");
+    std::shared_ptr<vk::DescriptorPool> descriptorPool =
+      this->createDescriptorPool();
+    if (!this->mDescriptorPool) {
+        this->mDescriptorPool = descriptorPool;
+        this->mFreeDescriptorPool = true;
+    } else {
+        this->mExtraDescriptorPools.push_back(descriptorPool);
+    }
+
+    vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
+      *descriptorPool,
+      1, // Descriptor set layout count
+      this->mDescriptorSetLayout.get());
+
+    this->mDevice->allocateDescriptorSets(&descriptorSetAllocateInfo,
+                                          descriptorSet.get());
+
+    return descriptorSet;
+}
+
+std::vector<vk::DescriptorPoolSize>
+Algorithm::getDescriptorCounts()
 {
     uint32_t numImages = 0;
     uint32_t numTensors = 0;
 
-    KP_LOG_DEBUG("Kompute Algorithm createParameters started");
-
     for (const std::shared_ptr<Memory>& mem : this->mMemObjects) {
         if (mem->type() == Memory::Type::eImage) {
             numImages++;
@@ -157,65 +283,186 @@ Algorithm::createParameters()
           ));
     };
 
+    return descriptorPoolSizes;
+}
+
+std::shared_ptr<vk::DescriptorPool>
+Algorithm::createDescriptorPool()
+{
+    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes =
+      this->getDescriptorCounts();
+
     vk::DescriptorPoolCreateInfo descriptorPoolInfo(
       vk::DescriptorPoolCreateFlags(),
       1, // Max sets
       static_cast<uint32_t>(descriptorPoolSizes.size()),
       descriptorPoolSizes.data());
 
-    KP_LOG_DEBUG("Kompute Algorithm creating descriptor pool");
-    this->mDescriptorPool = std::make_shared<vk::DescriptorPool>();
+    std::shared_ptr<vk::DescriptorPool> descriptorPool =
+      std::make_shared<vk::DescriptorPool>();
     this->mDevice->createDescriptorPool(
-      &descriptorPoolInfo, nullptr, this->mDescriptorPool.get());
-    this->mFreeDescriptorPool = true;
-
-    std::vector<vk::DescriptorSetLayoutBinding> descriptorSetBindings;
-    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
-        descriptorSetBindings.push_back(
-          vk::DescriptorSetLayoutBinding(i, // Binding index
-                                         mMemObjects[i]->getDescriptorType(),
-                                         1, // Descriptor count
-                                         vk::ShaderStageFlagBits::eCompute));
-    }
-
-    // This is the component that is fed into the pipeline
-    vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutInfo(
-      vk::DescriptorSetLayoutCreateFlags(),
-      static_cast<uint32_t>(descriptorSetBindings.size()),
-      descriptorSetBindings.data());
-
-    KP_LOG_DEBUG("Kompute Algorithm creating descriptor set layout");
-    this->mDescriptorSetLayout = std::make_shared<vk::DescriptorSetLayout>();
-    this->mDevice->createDescriptorSetLayout(
-      &descriptorSetLayoutInfo, nullptr, this->mDescriptorSetLayout.get());
-    this->mFreeDescriptorSetLayout = true;
-
-    vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
-      *this->mDescriptorPool,
-      1, // Descriptor set layout count
-      this->mDescriptorSetLayout.get());
+      &descriptorPoolInfo, nullptr, descriptorPool.get());
 
-    KP_LOG_DEBUG("Kompute Algorithm allocating descriptor sets");
-    this->mDescriptorSet = std::make_shared<vk::DescriptorSet>();
-    this->mDevice->allocateDescriptorSets(&descriptorSetAllocateInfo,
-                                          this->mDescriptorSet.get());
-    this->mFreeDescriptorSet = true;
+    return descriptorPool;
+}
 
-    KP_LOG_DEBUG("Kompute Algorithm updating descriptor sets");
-    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+void
+Algorithm::updateDescriptorSet(
+  const vk::DescriptorSet& descriptorSet,
+  const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    for (size_t i = 0; i < memObjects.size(); i++) {
         std::vector<vk::WriteDescriptorSet> computeWriteDescriptorSets;
 
-        vk::WriteDescriptorSet descriptorSet =
-          this->mMemObjects[i]->constructDescriptorSet(*this->mDescriptorSet,
-                                                       i);
+        vk::WriteDescriptorSet writeDescriptorSet =
+          memObjects[i]->constructDescriptorSet(descriptorSet, i);
 
-        computeWriteDescriptorSets.push_back(descriptorSet);
+        computeWriteDescriptorSets.push_back(writeDescriptorSet);
 
         this->mDevice->updateDescriptorSets(computeWriteDescriptorSets,
                                             nullptr);
     }
+}
 
-    KP_LOG_DEBUG("Kompute Algorithm successfully run init");
+std::vector<uint64_t>
+Algorithm::primaryBufferGenerations(
+  const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    std::vector<uint64_t> generations;
+    for (const std::shared_ptr<Memory>& memObject : memObjects) {
+        if (memObject->type() == Memory::Type::eTensor) {
+            generations.push_back(std::static_pointer_cast<Tensor>(memObject)
+                                    ->getPrimaryBufferGeneration());
+        } else {
+            generations.push_back(0);
+        }
+    }
+    return generations;
+}
+
+void
+Algorithm::checkCompatibleMemObjects(
+  const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    if (memObjects.size() != this->mMemObjects.size()) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Algorithm expected {} memory objects but {} were provided",
+          this->mMemObjects.size(),
+          memObjects.size()));
+    }
+
+    for (size_t i = 0; i < memObjects.size(); i++) {
+        if (!memObjects[i]) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Algorithm memory object at binding {} is null", i));
+        }
+        if (memObjects[i]->getDescriptorType() !=
+            this->mMemObjects[i]->getDescriptorType()) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Algorithm memory object at binding {} has descriptor "
+              "type {} but the algorithm was built with {}",
+              i,
+              vk::to_string(memObjects[i]->getDescriptorType()),
+              vk::to_string(this->mMemObjects[i]->getDescriptorType())));
+        }
+    }
+}
+
+void
+Algorithm::rebind(const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    KP_LOG_DEBUG("Kompute Algorithm rebinding descriptor set {}",
+                 this->mDescriptorSetIndex);
+
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute Algorithm rebind called on an algorithm not initialised");
+    }
+
+    this->checkCompatibleMemObjects(memObjects);
+
+    this->updateDescriptorSet(*this->mDescriptorSet, memObjects);
+
+    this->mMemObjects = memObjects;
+    this->mDescriptorSetMemObjects[this->mDescriptorSetIndex] = memObjects;
+    this->mDescriptorSetGenerations[this->mDescriptorSetIndex] =
+      Algorithm::primaryBufferGenerations(memObjects);
+}
+
+uint32_t
+Algorithm::addDescriptorSet(
+  const std::vector<std::shared_ptr<Memory>>& memObjects)
+{
+    KP_LOG_DEBUG("Kompute Algorithm adding descriptor set");
+
+    if (!this->isInit()) {
+        throw std::runtime_error("Kompute Algorithm addDescriptorSet called "
+                                 "on an algorithm not initialised");
+    }
+
+    this->checkCompatibleMemObjects(memObjects);
+
+    std::shared_ptr<vk::DescriptorSet> descriptorSet =
+      this->allocateDescriptorSet();
+
+    this->updateDescriptorSet(*descriptorSet, memObjects);
+
+    this->mDescriptorSets.push_back(descriptorSet);
+    this->mDescriptorSetMemObjects.push_back(memObjects);
+    this->mDescriptorSetGenerations.push_back(
+      Algorithm::primaryBufferGenerations(memObjects));
+
+    return static_cast<uint32_t>(this->mDescriptorSets.size() - 1);
+}
+
+void
+Algorithm::setDescriptorSet(uint32_t index)
+{
+    if (index >= this->mDescriptorSets.size()) {
+        throw std::runtime_error(
+          fmt::format("Kompute Algorithm descriptor set index {} out of "
+                      "range, the algorithm has {} descriptor sets",
+                      index,
+                      this->mDescriptorSets.size()));
+    }
+
+    this->mDescriptorSetIndex = index;
+    this->mDescriptorSet = this->mDescriptorSets[index];
+    this->mMemObjects = this->mDescriptorSetMemObjects[index];
+}
+
+uint32_t
+Algorithm::getDescriptorSetCount()
+{
+    return static_cast<uint32_t>(this->mDescriptorSets.size());
+}
+
+void
+Algorithm::setBindingAccess(uint32_t binding, BindingAccess access)
+{
+    if (binding >= this->mMemObjects.size()) {
+        throw std::runtime_error(
+          fmt::format("Kompute Algorithm binding {} out of range, the "
+                      "algorithm has {} bindings",
+                      binding,
+                      this->mMemObjects.size()));
+    }
+
+    if (this->mBindingAccesses.size() < this->mMemObjects.size()) {
+        this->mBindingAccesses.resize(this->mMemObjects.size(),
+                                      BindingAccess::eReadWrite);
+    }
+
+    this->mBindingAccesses[binding] = access;
+}
+
+Algorithm::BindingAccess
+Algorithm::getBindingAccess(uint32_t binding)
+{
+    if (binding >= this->mBindingAccesses.size()) {
+        return BindingAccess::eReadWrite;
+    }
+    return this->mBindingAccesses[binding];
 }
 
 void
@@ -223,6 +470,11 @@ Algorithm::createShaderModule()
 {
     KP_LOG_DEBUG("Kompute Algorithm createShaderModule started");
 
+    if (this->mShaderModule) {
+        KP_LOG_DEBUG("Kompute Algorithm reusing registered shader module");
+        return;
+    }
+
     vk::ShaderModuleCreateInfo shaderModuleInfo(vk::ShaderModuleCreateFlags(),
                                                 sizeof(uint32_t) *
                                                   this->mSpirv.size(),
@@ -244,6 +496,22 @@ Algorithm::createPipeline()
 {
     KP_LOG_DEBUG("Kompute Algorithm calling create Pipeline");
 
+    // A pipeline cache shared through the constructor is kept across
+    // rebuilds, otherwise the algorithm creates and owns its own
+    if (!this->mPipelineCache) {
+        vk::PipelineCacheCreateInfo pipelineCacheInfo =
+          vk::PipelineCacheCreateInfo();
+        this->mPipelineCache = std::make_shared<vk::PipelineCache>();
+        this->mDevice->createPipelineCache(
+          &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
+        this->mFreePipelineCache = true;
+    }
+
+    if (this->mPipeline) {
+        KP_LOG_DEBUG("Kompute Algorithm reusing registered pipeline");
+        return;
+    }
+
     vk::PipelineLayoutCreateInfo pipelineLayoutInfo(
       vk::PipelineLayoutCreateFlags(),
       1, // Set layout count
@@ -299,13 +567,6 @@ Algorithm::createPipeline()
                                                vk::Pipeline(),
                                                0);
 
-    vk::PipelineCacheCreateInfo pipelineCacheInfo =
-      vk::PipelineCacheCreateInfo();
-    this->mPipelineCache = std::make_shared<vk::PipelineCache>();
-    this->mDevice->createPipelineCache(
-      &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
-    this->mFreePipelineCache = true;
-
 #ifdef KOMPUTE_CREATE_PIPELINE_RESULT_VALUE
     vk::ResultValue<vk::Pipeline> pipelineResult =
       this->mDevice->createComputePipeline(*this->mPipelineCache, pipelineInfo);
@@ -335,6 +596,70 @@ Algorithm::createPipeline()
     KP_LOG_DEBUG("Kompute Algorithm Create Pipeline Success");
 }
 
+void
+Algorithm::acquireRegisteredPipeline()
+{
+    if (!this->mPipelineRegistry) {
+        return;
+    }
+
+    std::vector<vk::DescriptorType> descriptorTypes;
+    for (const std::shared_ptr<Memory>& mem : this->mMemObjects) {
+        descriptorTypes.push_back(mem->getDescriptorType());
+    }
+
+    this->mPipelineKey = PipelineRegistry::createKey(
+      this->mSpirv,
+      descriptorTypes,
+      this->mSpecializationConstantsData,
+      this->mSpecializationConstantsDataTypeMemorySize,
+      this->mSpecializationConstantsSize,
+      this->mPushConstantsDataTypeMemorySize * this->mPushConstantsSize);
+
+    PipelineRegistry::Entry entry;
+    if (!this->mPipelineRegistry->acquire(this->mPipelineKey, entry)) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Algorithm acquired registered pipeline");
+
+    this->mDescriptorSetLayout = entry.descriptorSetLayout;
+    this->mFreeDescriptorSetLayout = false;
+    this->mShaderModule = entry.shaderModule;
+    this->mFreeShaderModule = false;
+    this->mPipelineLayout = entry.pipelineLayout;
+    this->mFreePipelineLayout = false;
+    this->mPipeline = entry.pipeline;
+    this->mFreePipeline = false;
+    this->mRegisteredPipeline = true;
+}
+
+void
+Algorithm::registerPipeline()
+{
+    if (!this->mPipelineRegistry || this->mRegisteredPipeline) {
+        return;
+    }
+
+    PipelineRegistry::Entry entry;
+    entry.descriptorSetLayout = this->mDescriptorSetLayout;
+    entry.shaderModule = this->mShaderModule;
+    entry.pipelineLayout = this->mPipelineLayout;
+    entry.pipeline = this->mPipeline;
+
+    // If another algorithm registered the same key in the meantime this
+    // algorithm simply keeps ownership of the objects it created
+    if (!this->mPipelineRegistry->insert(this->mPipelineKey, entry)) {
+        return;
+    }
+
+    this->mFreeDescriptorSetLayout = false;
+    this->mFreeShaderModule = false;
+    this->mFreePipelineLayout = false;
+    this->mFreePipeline = false;
+    this->mRegisteredPipeline = true;
+}
+
 void
 Algorithm::recordBindCore(const vk::CommandBuffer& commandBuffer)
 {
@@ -343,6 +668,20 @@ Algorithm::recordBindCore(const vk::CommandBuffer& commandBuffer)
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute,
                                *this->mPipeline);
 
+    // Tensors restored after being evicted have a new buffer, which the
+    // descriptor set has to refer to before being bound
+    std::vector<uint64_t> generations =
+      Algorithm::primaryBufferGenerations(this->mMemObjects);
+    if (generations !=
+        this->mDescriptorSetGenerations[this->mDescriptorSetIndex]) {
+        KP_LOG_DEBUG("Kompute Algorithm updating descriptor set {} with "
+                     "restored tensors",
+                     this->mDescriptorSetIndex);
+        this->updateDescriptorSet(*this->mDescriptorSet, this->mMemObjects);
+        this->mDescriptorSetGenerations[this->mDescriptorSetIndex] =
+          generations;
+    }
+
     KP_LOG_DEBUG("Kompute Algorithm binding descriptor sets");
 
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
@@ -380,7 +719,7 @@ Algorithm::recordDispatch(const vk::CommandBuffer& commandBuffer)
 }
 
 void
-Algorithm::setWorkgroup(const Workgroup& workgroup, uint32_t minSize)
+Algorithm::setWorkgroup(const Workgroup& workgroup, uint64_t minSize)
 {
 
     KP_LOG_INFO("Kompute OpAlgoCreate setting dispatch size");
@@ -393,8 +732,13 @@ Algorithm::setWorkgroup(const Workgroup& workgroup, uint32_t minSize)
         this->mWorkgroup = { workgroup[0],
                              workgroup[1] > 0 ? workgroup[1] : 1,
                              workgroup[2] > 0 ? workgroup[2] : 1 };
+    } else if (minSize > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Algorithm default workgroup of {} elements exceeds the "
+          "maximum dispatch size, a workgroup has to be provided",
+          minSize));
     } else {
-        this->mWorkgroup = { minSize, 1, 1 };
+        this->mWorkgroup = { static_cast<uint32_t>(minSize), 1, 1 };
     }
 
     KP_LOG_INFO("Kompute OpAlgoCreate set dispatch size X: {}, Y: {}, Z: {}",
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/BarrierBatch.hpp"
+
+namespace kp {
+
+void
+BarrierBatch::addBufferMemoryBarrier(
+  const vk::BufferMemoryBarrier& bufferMemoryBarrier,
+  vk::PipelineStageFlags srcStageMask,
+  vk::PipelineStageFlags dstStageMask)
+{
+    this->mBufferMemoryBarriers.push_back(bufferMemoryBarrier);
+    this->mSrcStageMask |= srcStageMask;
+    this->mDstStageMask |= dstStageMask;
+}
+
+void
+BarrierBatch::addImageMemoryBarrier(
+  const vk::ImageMemoryBarrier& imageMemoryBarrier,
+  vk::PipelineStageFlags srcStageMask,
+  vk::PipelineStageFlags dstStageMask)
+{
+    this->mImageMemoryBarriers.push_back(imageMemoryBarrier);
+    this->mSrcStageMask |= srcStageMask;
+    this->mDstStageMask |= dstStageMask;
+}
+
+void
+BarrierBatch::flush(const vk::CommandBuffer& commandBuffer)
+{
+    if (this->empty()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute BarrierBatch recording {} buffer and {} image "
+                 "memory barriers",
+                 this->mBufferMemoryBarriers.size(),
+                 this->mImageMemoryBarriers.size());
+
+    commandBuffer.pipelineBarrier(this->mSrcStageMask,
+                                  this->mDstStageMask,
+                                  vk::DependencyFlags(),
+                                  nullptr,
+                                  this->mBufferMemoryBarriers,
+                                  this->mImageMemoryBarriers);
+
+    this->clear();
+}
+
+void
+BarrierBatch::clear()
+{
+    this->mBufferMemoryBarriers.clear();
+    this->mImageMemoryBarriers.clear();
+    this->mSrcStageMask = vk::PipelineStageFlags();
+    this->mDstStageMask = vk::PipelineStageFlags();
+}
+
+bool
+BarrierBatch::empty() const
+{
+    return this->mBufferMemoryBarriers.empty() &&
+           this->mImageMemoryBarriers.empty();
+}
+
+uint32_t
+BarrierBatch::size() const
+{
+    return static_cast<uint32_t>(this->mBufferMemoryBarriers.size() +
+                                 this->mImageMemoryBarriers.size());
+}
+
+} // End namespace kp
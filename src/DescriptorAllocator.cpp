@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/DescriptorAllocator.hpp"
+
+#include <algorithm>
+
+namespace kp {
+
+DescriptorAllocator::DescriptorAllocator(std::shared_ptr<vk::Device> device,
+                                         uint32_t pageSize)
+{
+    if (!device) {
+        throw std::runtime_error("Kompute DescriptorAllocator device is null");
+    }
+    if (pageSize == 0) {
+        throw std::runtime_error(
+          "Kompute DescriptorAllocator page size must be greater than zero");
+    }
+
+    this->mDevice = device;
+    this->mPageSize = pageSize;
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator created with page size {}",
+                 this->mPageSize);
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+    KP_LOG_DEBUG("Kompute DescriptorAllocator destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator destructor success");
+}
+
+DescriptorAllocator::Allocation
+DescriptorAllocator::allocate(
+  const vk::DescriptorSetLayout& descriptorSetLayout,
+  const std::vector<vk::DescriptorPoolSize>& descriptorCounts)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute DescriptorAllocator allocate called "
+                                 "after allocator was destroyed");
+    }
+
+    Allocation allocation;
+    allocation.descriptorCounts = descriptorCounts;
+
+    Page* target = nullptr;
+    for (auto& pagePair : this->mPages) {
+        Page& page = *pagePair.second;
+        if (this->hasCapacity(page, descriptorCounts) &&
+            this->allocateFromPage(
+              page, descriptorSetLayout, allocation.descriptorSet)) {
+            target = &page;
+            break;
+        }
+    }
+
+    if (!target) {
+        target = this->createPage(descriptorCounts);
+        if (!this->allocateFromPage(
+              *target, descriptorSetLayout, allocation.descriptorSet)) {
+            throw std::runtime_error("Kompute DescriptorAllocator failed to "
+                                     "allocate from a new page");
+        }
+    }
+
+    target->setCount++;
+    for (const vk::DescriptorPoolSize& poolSize : descriptorCounts) {
+        target->used[poolSize.type] += poolSize.descriptorCount;
+    }
+    this->mSetCount++;
+    this->mTotalSetCount++;
+
+    allocation.pageId = target->id;
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator allocated descriptor set from "
+                 "page {} with {} sets in use",
+                 target->id,
+                 target->setCount);
+
+    return allocation;
+}
+
+void
+DescriptorAllocator::free(const Allocation& allocation)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto pageIt = this->mPages.find(allocation.pageId);
+    if (pageIt == this->mPages.end()) {
+        KP_LOG_WARN("Kompute DescriptorAllocator free called with descriptor "
+                    "set of unknown page {}, ignoring",
+                    allocation.pageId);
+        return;
+    }
+
+    Page& page = *pageIt->second;
+
+    this->mDevice->freeDescriptorSets(page.descriptorPool,
+                                      allocation.descriptorSet);
+
+    page.setCount--;
+    for (const vk::DescriptorPoolSize& poolSize :
+         allocation.descriptorCounts) {
+        page.used[poolSize.type] -= poolSize.descriptorCount;
+    }
+    this->mSetCount--;
+
+    if (page.setCount > 0) {
+        return;
+    }
+
+    if (this->mPages.size() > 1) {
+        this->destroyPage(page.id);
+    } else {
+        // Resetting the last page undoes any fragmentation left by freeing
+        // descriptor sets individually
+        this->mDevice->resetDescriptorPool(page.descriptorPool);
+    }
+}
+
+void
+DescriptorAllocator::destroy()
+{
+    KP_LOG_DEBUG("Kompute DescriptorAllocator started destroy()");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN("Kompute DescriptorAllocator destroy called with null "
+                    "Device pointer");
+        return;
+    }
+
+    if (this->mSetCount > 0) {
+        KP_LOG_WARN("Kompute DescriptorAllocator destroying {} pages with {} "
+                    "descriptor sets still in use",
+                    this->mPages.size(),
+                    this->mSetCount);
+    }
+
+    while (!this->mPages.empty()) {
+        this->destroyPage(this->mPages.begin()->first);
+    }
+    this->mSetCount = 0;
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator successful destroy()");
+}
+
+uint32_t
+DescriptorAllocator::pageSize()
+{
+    return this->mPageSize;
+}
+
+uint32_t
+DescriptorAllocator::pageCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return static_cast<uint32_t>(this->mPages.size());
+}
+
+uint32_t
+DescriptorAllocator::setCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mSetCount;
+}
+
+uint64_t
+DescriptorAllocator::totalSetCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mTotalSetCount;
+}
+
+DescriptorAllocator::Page*
+DescriptorAllocator::createPage(
+  const std::vector<vk::DescriptorPoolSize>& descriptorCounts)
+{
+    std::unique_ptr<Page> page{ new Page() };
+    page->id = this->mNextPageId++;
+    page->maxSets = this->mPageSize;
+
+    // Every page can hold page size descriptor sets of the types used by
+    // algorithms, unless a single descriptor set needs more descriptors
+    uint32_t defaultCount =
+      this->mPageSize * KP_DESCRIPTOR_ALLOCATOR_DESCRIPTORS_PER_SET;
+    page->capacity[vk::DescriptorType::eStorageBuffer] = defaultCount;
+    page->capacity[vk::DescriptorType::eStorageImage] = defaultCount;
+    for (const vk::DescriptorPoolSize& poolSize : descriptorCounts) {
+        page->capacity[poolSize.type] =
+          std::max(page->capacity[poolSize.type], poolSize.descriptorCount);
+    }
+
+    std::vector<vk::DescriptorPoolSize> descriptorPoolSizes;
+    for (const auto& capacityPair : page->capacity) {
+        descriptorPoolSizes.push_back(
+          vk::DescriptorPoolSize(capacityPair.first, capacityPair.second));
+    }
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator creating page {} for {} "
+                 "descriptor sets",
+                 page->id,
+                 page->maxSets);
+
+    vk::DescriptorPoolCreateInfo descriptorPoolInfo(
+      vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet,
+      page->maxSets,
+      static_cast<uint32_t>(descriptorPoolSizes.size()),
+      descriptorPoolSizes.data());
+
+    this->mDevice->createDescriptorPool(
+      &descriptorPoolInfo, nullptr, &page->descriptorPool);
+
+    Page* pagePtr = page.get();
+    this->mPages[page->id] = std::move(page);
+    return pagePtr;
+}
+
+void
+DescriptorAllocator::destroyPage(uint64_t pageId)
+{
+    auto pageIt = this->mPages.find(pageId);
+    if (pageIt == this->mPages.end()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute DescriptorAllocator destroying page {}", pageId);
+
+    this->mDevice->destroy(
+      pageIt->second->descriptorPool,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    this->mPages.erase(pageIt);
+}
+
+bool
+DescriptorAllocator::hasCapacity(
+  const Page& page,
+  const std::vector<vk::DescriptorPoolSize>& descriptorCounts)
+{
+    if (page.setCount >= page.maxSets) {
+        return false;
+    }
+
+    for (const vk::DescriptorPoolSize& poolSize : descriptorCounts) {
+        auto capacityIt = page.capacity.find(poolSize.type);
+        if (capacityIt == page.capacity.end()) {
+            return false;
+        }
+        auto usedIt = page.used.find(poolSize.type);
+        uint32_t used = usedIt == page.used.end() ? 0 : usedIt->second;
+        if (used + poolSize.descriptorCount > capacityIt->second) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool
+DescriptorAllocator::allocateFromPage(
+  Page& page,
+  const vk::DescriptorSetLayout& descriptorSetLayout,
+  vk::DescriptorSet& descriptorSet)
+{
+    vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo(
+      page.descriptorPool,
+      1, // Descriptor set layout count
+      &descriptorSetLayout);
+
+    vk::Result result = this->mDevice->allocateDescriptorSets(
+      &descriptorSetAllocateInfo, &descriptorSet);
+
+    // Freeing descriptor sets individually can fragment the pool, in which
+    // case the allocation is attempted from another page
+    if (result == vk::Result::eErrorFragmentedPool ||
+        result == vk::Result::eErrorOutOfPoolMemory) {
+        KP_LOG_DEBUG("Kompute DescriptorAllocator page {} could not allocate "
+                     "descriptor set: {}",
+                     page.id,
+                     vk::to_string(result));
+        return false;
+    }
+
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error(
+          "Kompute DescriptorAllocator failed to allocate descriptor set: " +
+          vk::to_string(result));
+    }
+
+    return true;
+}
+
+} // End namespace kp
@@ -0,0 +1,284 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/FenceWaiter.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace kp {
+
+FenceWaiter::FenceWaiter(std::shared_ptr<vk::Device> device,
+                         bool hostTimelineSemaphores,
+                         uint64_t timeout)
+{
+    if (!device) {
+        throw std::runtime_error("Kompute FenceWaiter device is null");
+    }
+
+    this->mDevice = device;
+    this->mTimeout = timeout;
+
+    if (hostTimelineSemaphores) {
+        vk::SemaphoreTypeCreateInfo semaphoreTypeInfo(
+          vk::SemaphoreType::eTimeline, 0);
+        vk::SemaphoreCreateInfo semaphoreInfo;
+        semaphoreInfo.setPNext(&semaphoreTypeInfo);
+        this->mWakeSemaphore = this->mDevice->createSemaphore(semaphoreInfo);
+    }
+
+    KP_LOG_DEBUG("Kompute FenceWaiter created with timeout of {} ns, waiting "
+                 "on timeline semaphores: {}",
+                 this->mTimeout,
+                 hostTimelineSemaphores);
+}
+
+FenceWaiter::~FenceWaiter()
+{
+    KP_LOG_DEBUG("Kompute FenceWaiter destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute FenceWaiter destructor success");
+}
+
+std::future<void>
+FenceWaiter::add(std::shared_ptr<Sequence> sequence,
+                 std::function<void()> callback)
+{
+    if (!sequence || !sequence->isRunning()) {
+        throw std::runtime_error(
+          "Kompute FenceWaiter add called with a sequence that is not running");
+    }
+
+    Entry entry;
+    entry.sequence = sequence;
+    entry.fences = sequence->getRunningFences();
+    entry.semaphore = sequence->getTimelineSemaphore();
+    entry.value = sequence->getTimelineValue();
+    entry.callback = callback;
+    std::future<void> future = entry.promise.get_future();
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+
+        if (this->mStopping) {
+            throw std::runtime_error(
+              "Kompute FenceWaiter add called after destroy");
+        }
+
+        this->mEntries.push_back(std::move(entry));
+        this->mPendingCount++;
+
+        if (!this->mThread.joinable()) {
+            KP_LOG_DEBUG("Kompute FenceWaiter starting thread");
+            this->mThread = std::thread(&FenceWaiter::run, this);
+        }
+
+        this->wake();
+    }
+    this->mCondition.notify_one();
+
+    return future;
+}
+
+uint32_t
+FenceWaiter::pendingCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mPendingCount;
+}
+
+void
+FenceWaiter::destroy()
+{
+    KP_LOG_DEBUG("Kompute FenceWaiter started destroy()");
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mStopping = true;
+        this->wake();
+    }
+    this->mCondition.notify_all();
+
+    if (this->mThread.joinable()) {
+        this->mThread.join();
+    }
+
+    if (this->mWakeSemaphore) {
+        this->mDevice->destroy(
+          this->mWakeSemaphore,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mWakeSemaphore = vk::Semaphore();
+    }
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute FenceWaiter successful destroy()");
+}
+
+void
+FenceWaiter::run()
+{
+    std::unique_lock<std::mutex> lock(this->mMutex);
+
+    while (true) {
+        this->mCondition.wait(lock, [this]() {
+            return this->mStopping || !this->mEntries.empty();
+        });
+
+        // Only stops once the pending sequences were awaited
+        if (this->mEntries.empty()) {
+            return;
+        }
+
+        // The sequences of a batch share the same fence
+        std::vector<vk::Fence> fences;
+        std::vector<vk::Semaphore> semaphores;
+        std::vector<uint64_t> values;
+        for (const Entry& entry : this->mEntries) {
+            for (const vk::Fence& fence : entry.fences) {
+                if (std::find(fences.begin(), fences.end(), fence) ==
+                    fences.end()) {
+                    fences.push_back(fence);
+                }
+            }
+            semaphores.push_back(entry.semaphore);
+            values.push_back(entry.value);
+        }
+        // Woken up by the next signal from the host
+        if (this->mWakeSemaphore) {
+            semaphores.push_back(this->mWakeSemaphore);
+            values.push_back(this->mWakeValue + 1);
+        }
+
+        lock.unlock();
+
+        std::list<Entry> completed;
+        try {
+            bool signalled = this->wait(fences, semaphores, values);
+
+            lock.lock();
+
+            if (!signalled) {
+                continue;
+            }
+
+            // Several sequences may have completed during the wait
+            auto entryIt = this->mEntries.begin();
+            while (entryIt != this->mEntries.end()) {
+                auto nextIt = std::next(entryIt);
+                bool signalled = true;
+                for (const vk::Fence& fence : entryIt->fences) {
+                    if (this->mDevice->getFenceStatus(fence) !=
+                        vk::Result::eSuccess) {
+                        signalled = false;
+                        break;
+                    }
+                }
+                if (signalled) {
+                    completed.splice(completed.end(), this->mEntries, entryIt);
+                }
+                entryIt = nextIt;
+            }
+        } catch (const std::exception& e) {
+            // A lost device fails every sequence waited on
+            KP_LOG_ERROR("Kompute FenceWaiter failed waiting for fences: {}",
+                         e.what());
+            if (!lock.owns_lock()) {
+                lock.lock();
+            }
+            this->mEntries.splice(this->mEntries.end(), completed);
+            for (Entry& entry : this->mEntries) {
+                entry.promise.set_exception(std::current_exception());
+            }
+            this->mPendingCount -=
+              static_cast<uint32_t>(this->mEntries.size());
+            this->mEntries.clear();
+            continue;
+        }
+
+        lock.unlock();
+
+        // Callbacks run without holding the lock so they can add sequences
+        for (Entry& entry : completed) {
+            this->complete(entry);
+        }
+
+        lock.lock();
+    }
+}
+
+bool
+FenceWaiter::wait(const std::vector<vk::Fence>& fences,
+                  std::vector<vk::Semaphore>& semaphores,
+                  std::vector<uint64_t>& values)
+{
+    // Waiting on the timeline semaphores requires all the sequences to have
+    // one, and is pointless if one was reached while its fence is not yet
+    // signalled, in which case the fences are waited on with the timeout
+    bool waitSemaphores = static_cast<bool>(this->mWakeSemaphore);
+    for (size_t i = 0; waitSemaphores && i + 1 < semaphores.size(); i++) {
+        waitSemaphores =
+          semaphores[i] &&
+          this->mDevice->getSemaphoreCounterValue(semaphores[i]) < values[i];
+    }
+
+    if (waitSemaphores) {
+        vk::SemaphoreWaitInfo waitInfo(vk::SemaphoreWaitFlagBits::eAny,
+                                       static_cast<uint32_t>(semaphores.size()),
+                                       semaphores.data(),
+                                       values.data());
+        vk::Result result = this->mDevice->waitSemaphores(waitInfo, UINT64_MAX);
+        return result != vk::Result::eTimeout;
+    }
+
+    vk::Result result =
+      this->mDevice->waitForFences(static_cast<uint32_t>(fences.size()),
+                                   fences.data(),
+                                   VK_FALSE,
+                                   this->mTimeout);
+    return result != vk::Result::eTimeout;
+}
+
+void
+FenceWaiter::wake()
+{
+    if (!this->mWakeSemaphore) {
+        return;
+    }
+
+    this->mWakeValue++;
+    this->mDevice->signalSemaphore(
+      vk::SemaphoreSignalInfo(this->mWakeSemaphore, this->mWakeValue));
+}
+
+void
+FenceWaiter::complete(Entry& entry)
+{
+    std::exception_ptr exception;
+    try {
+        entry.sequence->evalAwait(0);
+        if (entry.callback) {
+            entry.callback();
+        }
+    } catch (...) {
+        exception = std::current_exception();
+    }
+
+    // No longer pending once the future is ready
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+        this->mPendingCount--;
+    }
+
+    if (exception) {
+        entry.promise.set_exception(exception);
+    } else {
+        entry.promise.set_value();
+    }
+}
+
+} // End namespace kp
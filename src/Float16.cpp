@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/Float16.hpp"
+
+#include <cstring>
+
+namespace kp {
+
+uint16_t
+Half::fromFloat(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7fffffff;
+
+    if (magnitude > 0x7f800000) {
+        return sign | 0x7e00;
+    }
+    // Values from 65520 round to infinity rather than to the largest half
+    if (magnitude >= 0x477ff000) {
+        return sign | 0x7c00;
+    }
+    // Values below 2^-14 are halves without an implicit leading bit
+    if (magnitude < 0x38800000) {
+        // Values up to 2^-25 round to zero
+        if (magnitude <= 0x33000000) {
+            return sign;
+        }
+        uint32_t shift = 126 - (magnitude >> 23);
+        uint32_t mantissa = (magnitude & 0x7fffff) | 0x800000;
+        uint32_t result = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (result & 1))) {
+            result++;
+        }
+        return sign | result;
+    }
+
+    // Rebias the exponent, a carry of the rounding into the exponent is valid
+    uint32_t result = (magnitude - 0x38000000) >> 13;
+    uint32_t remainder = magnitude & 0x1fff;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (result & 1))) {
+        result++;
+    }
+    return sign | result;
+}
+
+float
+Half::toFloat(uint16_t bits)
+{
+    uint32_t sign = (uint32_t)(bits & 0x8000) << 16;
+    uint32_t exponent = (bits >> 10) & 0x1f;
+    uint32_t mantissa = bits & 0x3ff;
+
+    uint32_t result;
+    if (exponent == 0x1f) {
+        result = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        result = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        result = sign;
+    } else {
+        // Subnormal halves are normal floats
+        exponent = 113;
+        while (!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            exponent--;
+        }
+        result = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+
+    float value;
+    memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+uint16_t
+BFloat16::fromFloat(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t upper = bits >> 16;
+    if ((bits & 0x7fffffff) > 0x7f800000) {
+        return upper | 0x40;
+    }
+    return (bits + 0x7fff + (upper & 1)) >> 16;
+}
+
+float
+BFloat16::toFloat(uint16_t bits)
+{
+    uint32_t result = (uint32_t)bits << 16;
+
+    float value;
+    memcpy(&value, &result, sizeof(value));
+    return value;
+}
+
+} // End namespace kp
@@ -22,7 +22,7 @@ Image::init(void* data,
     }
 
     if (data != nullptr &&
-        dataSize < this->getX() * this->getY() * numChannels) {
+        dataSize < (uint64_t)this->getX() * this->getY() * numChannels) {
         throw std::runtime_error(
           "Kompute Image data is smaller than the requested image size");
     }
@@ -43,10 +43,17 @@ Image::init(void* data,
     }
 
     this->mNumChannels = numChannels;
+
+    if (this->getFormat() == vk::Format::eUndefined) {
+        throw std::runtime_error("Kompute Image has no format for data type " +
+                                 Memory::toString(this->dataType()));
+    }
+
     this->mDescriptorType = vk::DescriptorType::eStorageImage;
     this->mTiling = tiling;
-    this->mSize = this->getX() * this->getY() * this->mNumChannels;
+    this->mSize = (uint64_t)this->getX() * this->getY() * this->mNumChannels;
 
+    this->checkMemorySize();
     this->reserve();
     this->updateRawData(data);
 }
@@ -66,8 +73,7 @@ Image::~Image()
 void
 Image::reserve()
 {
-    KP_LOG_DEBUG("Reserving {} bytes for memory",
-                 this->mSize * this->mDataTypeMemorySize);
+    KP_LOG_DEBUG("Reserving {} bytes for memory", this->memorySize());
 
     if (this->mPrimaryImage || this->mPrimaryMemory) {
         KP_LOG_DEBUG(
@@ -106,21 +112,25 @@ Image::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
     KP_LOG_DEBUG(
       "Kompute Image recordCopyFrom size {},{}.", size.width, size.height);
 
+    BarrierBatch barrierBatch;
+
     copyFromImage->recordPrimaryImageBarrier(
-      commandBuffer,
+      barrierBatch,
       vk::AccessFlagBits::eMemoryRead,
       vk::AccessFlagBits::eMemoryWrite,
       vk::PipelineStageFlagBits::eTransfer,
       vk::PipelineStageFlagBits::eTransfer,
       vk::ImageLayout::eTransferSrcOptimal);
 
-    this->recordPrimaryImageBarrier(commandBuffer,
+    this->recordPrimaryImageBarrier(barrierBatch,
                                     vk::AccessFlagBits::eMemoryRead,
                                     vk::AccessFlagBits::eMemoryWrite,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::ImageLayout::eTransferDstOptimal);
 
+    barrierBatch.flush(commandBuffer);
+
     this->recordCopyImage(commandBuffer,
                           copyFromImage->mPrimaryImage,
                           this->mPrimaryImage,
@@ -140,7 +150,8 @@ Image::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 
     vk::Extent3D size = { this->getX(), this->getY(), 1 };
 
-    vk::BufferImageCopy copyRegion(0, 0, 0, layer, offset, size);
+    vk::BufferImageCopy copyRegion(
+      copyFromTensor->getMemoryOffset(), 0, 0, layer, offset, size);
 
     KP_LOG_DEBUG(
       "Kompute Image recordCopyFrom size {},{}.", size.width, size.height);
@@ -162,6 +173,14 @@ Image::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 void
 Image::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 {
+    this->ensureStagingMemory();
+
+    if (!this->mStagingImage) {
+        throw std::runtime_error(
+          "Kompute Image recordCopyFromStagingToDevice called without staging "
+          "image");
+    }
+
     vk::ImageSubresourceLayers layer = {};
     layer.aspectMask = vk::ImageAspectFlagBits::eColor;
     layer.layerCount = 1;
@@ -173,20 +192,24 @@ Image::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 
     KP_LOG_DEBUG("Kompute Image copying size {},{}.", size.width, size.height);
 
-    this->recordStagingImageBarrier(commandBuffer,
+    BarrierBatch barrierBatch;
+
+    this->recordStagingImageBarrier(barrierBatch,
                                     vk::AccessFlagBits::eMemoryRead,
                                     vk::AccessFlagBits::eMemoryWrite,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::ImageLayout::eTransferSrcOptimal);
 
-    this->recordPrimaryImageBarrier(commandBuffer,
+    this->recordPrimaryImageBarrier(barrierBatch,
                                     vk::AccessFlagBits::eMemoryRead,
                                     vk::AccessFlagBits::eMemoryWrite,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::ImageLayout::eTransferDstOptimal);
 
+    barrierBatch.flush(commandBuffer);
+
     this->recordCopyImage(commandBuffer,
                           this->mStagingImage,
                           this->mPrimaryImage,
@@ -198,6 +221,14 @@ Image::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 void
 Image::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
 {
+    this->ensureStagingMemory();
+
+    if (!this->mStagingImage) {
+        throw std::runtime_error(
+          "Kompute Image recordCopyFromDeviceToStaging called without staging "
+          "image");
+    }
+
     vk::ImageSubresourceLayers layer;
     layer.aspectMask = vk::ImageAspectFlagBits::eColor;
     layer.layerCount = 1;
@@ -209,20 +240,24 @@ Image::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
 
     KP_LOG_DEBUG("Kompute Image copying size {},{}.", size.width, size.height);
 
-    this->recordPrimaryImageBarrier(commandBuffer,
+    BarrierBatch barrierBatch;
+
+    this->recordPrimaryImageBarrier(barrierBatch,
                                     vk::AccessFlagBits::eMemoryRead,
                                     vk::AccessFlagBits::eMemoryWrite,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::ImageLayout::eTransferSrcOptimal);
 
-    this->recordStagingImageBarrier(commandBuffer,
+    this->recordStagingImageBarrier(barrierBatch,
                                     vk::AccessFlagBits::eMemoryRead,
                                     vk::AccessFlagBits::eMemoryWrite,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::PipelineStageFlagBits::eTransfer,
                                     vk::ImageLayout::eTransferDstOptimal);
 
+    barrierBatch.flush(commandBuffer);
+
     this->recordCopyImage(commandBuffer,
                           this->mPrimaryImage,
                           this->mStagingImage,
@@ -231,6 +266,155 @@ Image::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
                           copyRegion);
 }
 
+void
+Image::streamToDevice()
+{
+    if (!this->mStagingRing) {
+        throw std::runtime_error(
+          "Kompute Image streamToDevice called without a staging ring");
+    }
+
+    KP_LOG_DEBUG("Kompute Image streaming {} bytes to device",
+                 this->memorySize());
+
+    vk::DeviceSize rowSize =
+      (vk::DeviceSize)this->getX() * this->mNumChannels *
+      this->mDataTypeMemorySize;
+
+    this->mStagingRing->upload(
+      this->mHostData.data(),
+      this->memorySize(),
+      rowSize,
+      [this, rowSize](const vk::CommandBuffer& commandBuffer,
+                      const vk::Buffer& stagingBuffer,
+                      vk::DeviceSize stagingOffset,
+                      vk::DeviceSize offset,
+                      vk::DeviceSize size) {
+          vk::ImageLayout layout = this->mPrimaryImageLayout;
+          if (layout == vk::ImageLayout::eUndefined) {
+              layout = vk::ImageLayout::eGeneral;
+          }
+
+          BarrierBatch barrierBatch;
+
+          // The transfers are submitted outside of any sequence, so they
+          // have to wait for previous shader and transfer accesses, and make
+          // their writes visible to the ones that follow
+          this->recordPrimaryImageBarrier(
+            barrierBatch,
+            vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::AccessFlagBits::eTransferWrite,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::ImageLayout::eTransferDstOptimal);
+          barrierBatch.flush(commandBuffer);
+
+          vk::ImageSubresourceLayers layer = {};
+          layer.aspectMask = vk::ImageAspectFlagBits::eColor;
+          layer.layerCount = 1;
+          vk::Offset3D imageOffset = { 0, (int32_t)(offset / rowSize), 0 };
+          vk::Extent3D imageExtent = { this->getX(),
+                                       (uint32_t)(size / rowSize),
+                                       1 };
+
+          vk::BufferImageCopy copyRegion(
+            stagingOffset, 0, 0, layer, imageOffset, imageExtent);
+          commandBuffer.copyBufferToImage(stagingBuffer,
+                                          *this->mPrimaryImage,
+                                          this->mPrimaryImageLayout,
+                                          1,
+                                          &copyRegion);
+
+          this->recordPrimaryImageBarrier(
+            barrierBatch,
+            vk::AccessFlagBits::eTransferWrite,
+            vk::AccessFlagBits::eShaderRead |
+              vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferRead |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer,
+            layout);
+          barrierBatch.flush(commandBuffer);
+      });
+}
+
+void
+Image::streamFromDevice()
+{
+    if (!this->mStagingRing) {
+        throw std::runtime_error(
+          "Kompute Image streamFromDevice called without a staging ring");
+    }
+
+    KP_LOG_DEBUG("Kompute Image streaming {} bytes from device",
+                 this->memorySize());
+
+    vk::DeviceSize rowSize =
+      (vk::DeviceSize)this->getX() * this->mNumChannels *
+      this->mDataTypeMemorySize;
+
+    this->mStagingRing->download(
+      this->mHostData.data(),
+      this->memorySize(),
+      rowSize,
+      [this, rowSize](const vk::CommandBuffer& commandBuffer,
+                      const vk::Buffer& stagingBuffer,
+                      vk::DeviceSize stagingOffset,
+                      vk::DeviceSize offset,
+                      vk::DeviceSize size) {
+          vk::ImageLayout layout = this->mPrimaryImageLayout;
+          if (layout == vk::ImageLayout::eUndefined) {
+              layout = vk::ImageLayout::eGeneral;
+          }
+
+          BarrierBatch barrierBatch;
+
+          this->recordPrimaryImageBarrier(
+            barrierBatch,
+            vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::AccessFlagBits::eTransferRead,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::ImageLayout::eTransferSrcOptimal);
+          barrierBatch.flush(commandBuffer);
+
+          vk::ImageSubresourceLayers layer = {};
+          layer.aspectMask = vk::ImageAspectFlagBits::eColor;
+          layer.layerCount = 1;
+          vk::Offset3D imageOffset = { 0, (int32_t)(offset / rowSize), 0 };
+          vk::Extent3D imageExtent = { this->getX(),
+                                       (uint32_t)(size / rowSize),
+                                       1 };
+
+          vk::BufferImageCopy copyRegion(
+            stagingOffset, 0, 0, layer, imageOffset, imageExtent);
+          commandBuffer.copyImageToBuffer(*this->mPrimaryImage,
+                                          this->mPrimaryImageLayout,
+                                          stagingBuffer,
+                                          1,
+                                          &copyRegion);
+
+          this->recordPrimaryImageBarrier(
+            barrierBatch,
+            vk::AccessFlags(),
+            vk::AccessFlagBits::eShaderRead |
+              vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferRead |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer,
+            layout);
+          barrierBatch.flush(commandBuffer);
+      });
+}
+
 void
 Image::recordCopyImage(const vk::CommandBuffer& commandBuffer,
                        std::shared_ptr<vk::Image> srcImage,
@@ -287,6 +471,8 @@ Image::recordStagingMemoryBarrier(const vk::CommandBuffer& commandBuffer,
                                   vk::PipelineStageFlagBits srcStageMask,
                                   vk::PipelineStageFlagBits dstStageMask)
 {
+    this->ensureStagingMemory();
+
     vk::ImageLayout dstImageLayout;
 
     // Ideally the image would be set to eGeneral as soon as it was created
@@ -362,6 +548,118 @@ Image::recordImageMemoryBarrier(const vk::CommandBuffer& commandBuffer,
 {
     KP_LOG_DEBUG("Kompute Image recording image memory barrier");
 
+    vk::ImageMemoryBarrier imageMemoryBarrier = this->createImageMemoryBarrier(
+      image, srcAccessMask, dstAccessMask, srcLayout, dstLayout);
+
+    commandBuffer.pipelineBarrier(srcStageMask,
+                                  dstStageMask,
+                                  vk::DependencyFlags(),
+                                  nullptr,
+                                  nullptr,
+                                  imageMemoryBarrier);
+}
+
+void
+Image::recordPrimaryMemoryBarrier(BarrierBatch& barrierBatch,
+                                  vk::AccessFlags srcAccessMask,
+                                  vk::AccessFlags dstAccessMask,
+                                  vk::PipelineStageFlags srcStageMask,
+                                  vk::PipelineStageFlags dstStageMask)
+{
+    vk::ImageLayout dstImageLayout;
+
+    // Same as when recording the barrier straight away, the first barrier
+    // also transitions the image out of its undefined layout
+    if (this->mPrimaryImageLayout == vk::ImageLayout::eUndefined)
+        dstImageLayout = vk::ImageLayout::eGeneral;
+    else
+        dstImageLayout = this->mPrimaryImageLayout;
+
+    this->recordPrimaryImageBarrier(barrierBatch,
+                                    srcAccessMask,
+                                    dstAccessMask,
+                                    srcStageMask,
+                                    dstStageMask,
+                                    dstImageLayout);
+}
+
+void
+Image::recordStagingMemoryBarrier(BarrierBatch& barrierBatch,
+                                  vk::AccessFlags srcAccessMask,
+                                  vk::AccessFlags dstAccessMask,
+                                  vk::PipelineStageFlags srcStageMask,
+                                  vk::PipelineStageFlags dstStageMask)
+{
+    this->ensureStagingMemory();
+
+    vk::ImageLayout dstImageLayout;
+
+    // Same as when recording the barrier straight away, the first barrier
+    // also transitions the image out of its undefined layout
+    if (this->mStagingImageLayout == vk::ImageLayout::eUndefined)
+        dstImageLayout = vk::ImageLayout::eGeneral;
+    else
+        dstImageLayout = this->mStagingImageLayout;
+
+    this->recordStagingImageBarrier(barrierBatch,
+                                    srcAccessMask,
+                                    dstAccessMask,
+                                    srcStageMask,
+                                    dstStageMask,
+                                    dstImageLayout);
+}
+
+void
+Image::recordPrimaryImageBarrier(BarrierBatch& barrierBatch,
+                                 vk::AccessFlags srcAccessMask,
+                                 vk::AccessFlags dstAccessMask,
+                                 vk::PipelineStageFlags srcStageMask,
+                                 vk::PipelineStageFlags dstStageMask,
+                                 vk::ImageLayout dstLayout)
+{
+    KP_LOG_DEBUG("Kompute Image adding PRIMARY image memory barrier");
+
+    barrierBatch.addImageMemoryBarrier(
+      this->createImageMemoryBarrier(*this->mPrimaryImage,
+                                     srcAccessMask,
+                                     dstAccessMask,
+                                     this->mPrimaryImageLayout,
+                                     dstLayout),
+      srcStageMask,
+      dstStageMask);
+
+    this->mPrimaryImageLayout = dstLayout;
+}
+
+void
+Image::recordStagingImageBarrier(BarrierBatch& barrierBatch,
+                                 vk::AccessFlags srcAccessMask,
+                                 vk::AccessFlags dstAccessMask,
+                                 vk::PipelineStageFlags srcStageMask,
+                                 vk::PipelineStageFlags dstStageMask,
+                                 vk::ImageLayout dstLayout)
+{
+    KP_LOG_DEBUG("Kompute Image adding STAGING image memory barrier");
+
+    barrierBatch.addImageMemoryBarrier(
+      this->createImageMemoryBarrier(*this->mStagingImage,
+                                     srcAccessMask,
+                                     dstAccessMask,
+                                     this->mStagingImageLayout,
+                                     dstLayout),
+      srcStageMask,
+      dstStageMask);
+
+    this->mStagingImageLayout = dstLayout;
+}
+
+vk::ImageMemoryBarrier
+Image::createImageMemoryBarrier(const vk::Image& image,
+                                vk::AccessFlags srcAccessMask,
+                                vk::AccessFlags dstAccessMask,
+                                vk::ImageLayout oldLayout,
+                                vk::ImageLayout newLayout)
+{
     vk::ImageMemoryBarrier imageMemoryBarrier;
     imageMemoryBarrier.image = image;
 
@@ -377,15 +675,10 @@ Image::recordImageMemoryBarrier(const vk::CommandBuffer& commandBuffer,
     imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
-    imageMemoryBarrier.oldLayout = srcLayout;
-    imageMemoryBarrier.newLayout = dstLayout;
+    imageMemoryBarrier.oldLayout = oldLayout;
+    imageMemoryBarrier.newLayout = newLayout;
 
-    commandBuffer.pipelineBarrier(srcStageMask,
-                                  dstStageMask,
-                                  vk::DependencyFlags(),
-                                  nullptr,
-                                  nullptr,
-                                  imageMemoryBarrier);
+    return imageMemoryBarrier;
 }
 
 vk::DescriptorImageInfo
@@ -511,27 +804,66 @@ Image::allocateMemoryCreateGPUResources()
     this->mPrimaryMemory = std::make_shared<vk::DeviceMemory>();
     this->allocateBindMemory(this->mPrimaryImage,
                              this->mPrimaryMemory,
-                             this->getPrimaryMemoryPropertyFlags());
-    this->mFreePrimaryMemory = true;
-
-    if (this->mMemoryType == MemoryTypes::eDevice) {
-        KP_LOG_DEBUG("Kompute Image creating staging image and memory");
-
-        this->mStagingImage = std::make_shared<vk::Image>();
-        this->createImage(this->mStagingImage,
-                          this->getStagingImageUsageFlags(),
-                          vk::ImageTiling::eLinear);
-        this->mFreeStagingImage = true;
-        this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
-        this->allocateBindMemory(this->mStagingImage,
-                                 this->mStagingMemory,
-                                 this->getStagingMemoryPropertyFlags());
-        this->mFreeStagingMemory = true;
+                             this->mPrimaryAllocation,
+                             this->getPrimaryMemoryPropertyFlags(),
+                             this->mTiling);
+    this->mFreePrimaryMemory = !this->mPrimaryAllocation;
+
+    if (this->mMemoryType == MemoryTypes::eDevice && this->mStagingRing) {
+        KP_LOG_DEBUG("Kompute Image keeping data in host memory to stream "
+                     "through the staging ring");
+
+        this->mHostData.resize(this->memorySize());
+    } else if (this->mMemoryType == MemoryTypes::eDevice &&
+               this->mStagingPolicy == StagingPolicy::eEager) {
+        this->allocateStagingMemory();
     }
 
     KP_LOG_DEBUG("Kompute Image image & memory creation successful");
 }
 
+void
+Image::allocateStagingMemory()
+{
+    KP_LOG_DEBUG("Kompute Image creating staging image and memory");
+
+    this->mStagingImage = std::make_shared<vk::Image>();
+    this->createImage(this->mStagingImage,
+                      this->getStagingImageUsageFlags(),
+                      vk::ImageTiling::eLinear);
+    this->mFreeStagingImage = true;
+    this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
+    this->allocateBindMemory(this->mStagingImage,
+                             this->mStagingMemory,
+                             this->mStagingAllocation,
+                             this->getStagingMemoryPropertyFlags(),
+                             vk::ImageTiling::eLinear);
+    this->mFreeStagingMemory = !this->mStagingAllocation;
+}
+
+void
+Image::destroyStagingMemory()
+{
+    if (this->mFreeStagingImage) {
+        if (!this->mStagingImage) {
+            KP_LOG_WARN("Kompose Image expected to destroy staging image "
+                        "but got null image");
+        } else {
+            KP_LOG_DEBUG("Kompose Image destroying staging image");
+            this->mDevice->destroy(
+              *this->mStagingImage,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            this->mStagingImage = nullptr;
+            this->mFreeStagingImage = false;
+        }
+    }
+
+    // A staging image allocated again starts with an undefined layout
+    this->mStagingImageLayout = vk::ImageLayout::eUndefined;
+
+    this->freeStagingMemory();
+}
+
 void
 Image::createImage(std::shared_ptr<vk::Image> image,
                    vk::ImageUsageFlags imageUsageFlags,
@@ -568,17 +900,33 @@ Image::createImage(std::shared_ptr<vk::Image> image,
 void
 Image::allocateBindMemory(std::shared_ptr<vk::Image> image,
                           std::shared_ptr<vk::DeviceMemory> memory,
-                          vk::MemoryPropertyFlags memoryPropertyFlags)
+                          MemoryPool::Allocation& allocation,
+                          vk::MemoryPropertyFlags memoryPropertyFlags,
+                          vk::ImageTiling imageTiling)
 {
 
     KP_LOG_DEBUG("Kompute Image allocating and binding memory");
 
-    vk::PhysicalDeviceMemoryProperties memoryProperties =
-      this->mPhysicalDevice->getMemoryProperties();
-
     vk::MemoryRequirements memoryRequirements =
       this->mDevice->getImageMemoryRequirements(*image);
 
+    if (this->mMemoryPool) {
+        allocation = this->mMemoryPool->allocate(
+          memoryRequirements,
+          memoryPropertyFlags,
+          imageTiling == vk::ImageTiling::eLinear);
+        *memory = allocation.memory;
+
+        KP_LOG_DEBUG("Kompute Image binding pooled memory at offset {}",
+                     allocation.offset);
+
+        this->mDevice->bindImageMemory(*image, *memory, allocation.offset);
+        return;
+    }
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
     uint32_t memoryTypeIndex = -1;
     bool memoryTypeIndexFound = false;
     for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
@@ -635,19 +983,7 @@ Image::destroy()
         }
     }
 
-    if (this->mFreeStagingImage) {
-        if (!this->mStagingImage) {
-            KP_LOG_WARN("Kompose Image expected to destroy staging image "
-                        "but got null image");
-        } else {
-            KP_LOG_DEBUG("Kompose Image destroying staging image");
-            this->mDevice->destroy(
-              *this->mStagingImage,
-              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-            this->mStagingImage = nullptr;
-            this->mFreeStagingImage = false;
-        }
-    }
+    this->destroyStagingMemory();
 
     if (this->mImageView) {
         KP_LOG_DEBUG("Kompose Image freeing image view");
@@ -748,6 +1084,43 @@ Image::getFormat()
                     return vk::Format::eUndefined;
             }
         }
+        case Memory::DataTypes::eHalf: {
+            switch (this->mNumChannels) {
+                case 1:
+                    return vk::Format::eR16Sfloat;
+                case 2:
+                    return vk::Format::eR16G16Sfloat;
+                case 4:
+                    return vk::Format::eR16G16B16A16Sfloat;
+                default:
+                    return vk::Format::eUndefined;
+            }
+        }
+        case Memory::DataTypes::eUnsignedInt64: {
+            switch (this->mNumChannels) {
+                case 1:
+                    return vk::Format::eR64Uint;
+                case 2:
+                    return vk::Format::eR64G64Uint;
+                case 4:
+                    return vk::Format::eR64G64B64A64Uint;
+                default:
+                    return vk::Format::eUndefined;
+            }
+        }
+        case Memory::DataTypes::eInt64: {
+            switch (this->mNumChannels) {
+                case 1:
+                    return vk::Format::eR64Sint;
+                case 2:
+                    return vk::Format::eR64G64Sint;
+                case 4:
+                    return vk::Format::eR64G64B64A64Sint;
+                default:
+                    return vk::Format::eUndefined;
+            }
+        }
+        // There are no bfloat16 or block quantized formats
         default:
             return vk::Format::eUndefined;
     }
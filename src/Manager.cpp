@@ -9,6 +9,9 @@
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 #endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iterator>
 #include <set>
 #include <sstream>
@@ -44,6 +47,27 @@ debugMessageCallback(VkDebugReportFlagsEXT /*flags*/,
 }
 #endif
 
+// Header written in front of the pipeline cache data by savePipelineCache.
+// The Vulkan pipeline cache header does not contain the driver version, so it
+// is stored here to discard data from a previous driver before it reaches it.
+struct PipelineCacheFileHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t vendorID;
+    uint32_t deviceID;
+    uint32_t driverVersion;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+    uint64_t dataSize;
+};
+
+static const char KP_PIPELINE_CACHE_FILE_MAGIC[4] = { 'K', 'P', 'P', 'C' };
+static const uint32_t KP_PIPELINE_CACHE_FILE_VERSION = 1;
+
+// Size of the header version one defined by the Vulkan specification, which
+// precedes the implementation specific pipeline cache data
+static const uint32_t KP_PIPELINE_CACHE_HEADER_SIZE = 16 + VK_UUID_SIZE;
+
 Manager::Manager()
   : Manager(0)
 {
@@ -79,6 +103,15 @@ Manager::Manager(std::shared_ptr<vk::Instance> instance,
 #if !KOMPUTE_OPT_LOG_LEVEL_DISABLED
     logger::setupLogger();
 #endif
+
+    this->createPipelineCache();
+    this->mPipelineRegistry = std::make_shared<PipelineRegistry>(this->mDevice);
+    this->mDescriptorAllocator =
+      std::make_shared<DescriptorAllocator>(this->mDevice);
+    // Without a queue of its own the manager cannot evict tensors
+    this->mMemoryBudget =
+      std::make_shared<MemoryBudget>(this->mPhysicalDevice, this->mDevice);
+    this->mFenceWaiter = std::make_shared<FenceWaiter>(this->mDevice);
 }
 
 Manager::~Manager()
@@ -99,6 +132,13 @@ Manager::destroy()
         return;
     }
 
+    if (this->mFenceWaiter) {
+        // The sequences still pending are awaited before being destroyed
+        KP_LOG_DEBUG("Kompute Manager explicitly freeing fence waiter");
+        this->mFenceWaiter->destroy();
+        this->mFenceWaiter = nullptr;
+    }
+
     if (this->mManageResources && this->mManagedSequences.size()) {
         KP_LOG_DEBUG("Kompute Manager explicitly running destructor for "
                      "managed sequences");
@@ -132,6 +172,70 @@ Manager::destroy()
         this->mManagedMemObjects.clear();
     }
 
+    if (this->mPipelineRegistry) {
+        // Registered pipelines still used by algorithms not managed by this
+        // manager are left to them unless the device is going away
+        if (this->mFreeDevice) {
+            KP_LOG_DEBUG(
+              "Kompute Manager explicitly freeing pipeline registry");
+            this->mPipelineRegistry->destroy();
+        }
+        this->mPipelineRegistry = nullptr;
+    }
+
+    if (this->mDescriptorAllocator) {
+        // Same as the pipeline registry, descriptor sets of algorithms not
+        // managed by this manager are only freed with the device
+        if (this->mFreeDevice) {
+            KP_LOG_DEBUG(
+              "Kompute Manager explicitly freeing descriptor allocator");
+            this->mDescriptorAllocator->destroy();
+        }
+        this->mDescriptorAllocator = nullptr;
+    }
+
+    if (this->mPipelineCache) {
+        // Algorithms not managed by this manager still create their pipelines
+        // with the cache, so it is only freed together with the device
+        if (this->mFreeDevice) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing pipeline cache");
+            this->mDevice->destroy(
+              *this->mPipelineCache,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        }
+        this->mPipelineCache = nullptr;
+    }
+
+    if (this->mMemoryBudget) {
+        // Same as the staging ring, tensors not managed by this manager may
+        // still be evicted through the ring of the budget
+        if (this->mFreeDevice) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing memory budget");
+            this->mMemoryBudget->destroy();
+        }
+        this->mMemoryBudget = nullptr;
+    }
+
+    if (this->mStagingRing) {
+        // Memory objects not managed by this manager may still stream
+        // through the ring, so it is only freed together with the device
+        if (this->mFreeDevice) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing staging ring");
+            this->mStagingRing->destroy();
+        }
+        this->mStagingRing = nullptr;
+    }
+
+    if (this->mMemoryPool) {
+        // Blocks can only be freed while the device is alive, otherwise the
+        // pool is left to the memory objects still holding allocations
+        if (this->mFreeDevice) {
+            KP_LOG_DEBUG("Kompute Manager explicitly freeing memory pool");
+            this->mMemoryPool->destroy();
+        }
+        this->mMemoryPool = nullptr;
+    }
+
     if (this->mFreeDevice) {
         KP_LOG_INFO("Destroying device");
         this->mDevice->destroy(
@@ -446,6 +550,69 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
                      fmt::join(validExtensions, ", "));
     }
 
+    // Enabled when available so tensors can import host memory, which relies
+    // on the external memory support of Vulkan 1.1
+    std::string externalMemoryHostName =
+      VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME;
+    if (KOMPUTE_VK_API_VERSION >= VK_MAKE_VERSION(1, 1, 0) &&
+        physicalDevice.getProperties().apiVersion >=
+          VK_MAKE_VERSION(1, 1, 0) &&
+        uniqueExtensionNames.count(externalMemoryHostName) != 0 &&
+        std::find(desiredExtensions.begin(),
+                  desiredExtensions.end(),
+                  externalMemoryHostName) == desiredExtensions.end()) {
+        KP_LOG_DEBUG("Kompute Manager enabling {}", externalMemoryHostName);
+        validExtensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+    }
+
+    // Enabled when available so the memory budget can query the memory
+    // available to the process rather than the size of the heaps
+    std::string memoryBudgetName = VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+    if (KOMPUTE_VK_API_VERSION >= VK_MAKE_VERSION(1, 1, 0) &&
+        physicalDevice.getProperties().apiVersion >=
+          VK_MAKE_VERSION(1, 1, 0) &&
+        uniqueExtensionNames.count(memoryBudgetName) != 0 &&
+        std::find(desiredExtensions.begin(),
+                  desiredExtensions.end(),
+                  memoryBudgetName) == desiredExtensions.end()) {
+        KP_LOG_DEBUG("Kompute Manager enabling {}", memoryBudgetName);
+        validExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
+    // Enabled when available so sequences can wait on each other on the
+    // device, which is core in Vulkan 1.2 and provided by
+    // VK_KHR_timeline_semaphore on Vulkan 1.1
+    vk::PhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures;
+    uint32_t deviceApiVersion = std::min<uint32_t>(
+      KOMPUTE_VK_API_VERSION, physicalDevice.getProperties().apiVersion);
+    std::string timelineSemaphoreName =
+      VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME;
+    bool timelineSemaphoreExtension =
+      deviceApiVersion < VK_MAKE_VERSION(1, 2, 0) &&
+      uniqueExtensionNames.count(timelineSemaphoreName) != 0;
+    if (deviceApiVersion >= VK_MAKE_VERSION(1, 2, 0) ||
+        (deviceApiVersion >= VK_MAKE_VERSION(1, 1, 0) &&
+         timelineSemaphoreExtension)) {
+        vk::StructureChain<vk::PhysicalDeviceFeatures2,
+                           vk::PhysicalDeviceTimelineSemaphoreFeatures>
+          featuresChain = physicalDevice.getFeatures2<
+            vk::PhysicalDeviceFeatures2,
+            vk::PhysicalDeviceTimelineSemaphoreFeatures>();
+        if (featuresChain.get<vk::PhysicalDeviceTimelineSemaphoreFeatures>()
+              .timelineSemaphore) {
+            KP_LOG_DEBUG("Kompute Manager enabling timeline semaphores");
+            timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+            this->mTimelineSemaphores = true;
+            if (timelineSemaphoreExtension &&
+                std::find(desiredExtensions.begin(),
+                          desiredExtensions.end(),
+                          timelineSemaphoreName) == desiredExtensions.end()) {
+                validExtensions.push_back(
+                  VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+            }
+        }
+    }
+
     vk::DeviceCreateInfo deviceCreateInfo(vk::DeviceCreateFlags(),
                                           deviceQueueCreateInfos.size(),
                                           deviceQueueCreateInfos.data(),
@@ -453,6 +620,9 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
                                           {},
                                           validExtensions.size(),
                                           validExtensions.data());
+    if (this->mTimelineSemaphores) {
+        deviceCreateInfo.setPNext(&timelineSemaphoreFeatures);
+    }
 
     this->mDevice = std::make_shared<vk::Device>();
     physicalDevice.createDevice(
@@ -469,13 +639,614 @@ Manager::createDevice(const std::vector<uint32_t>& familyQueueIndices,
         familyQueueIndexCount[familyQueueIndex]++;
 
         this->mComputeQueues.push_back(currQueue);
+        this->mComputeQueueMutexes.push_back(std::make_shared<std::mutex>());
     }
 
     KP_LOG_DEBUG("Kompute Manager compute queue obtained");
+
+    this->createPipelineCache();
+    this->mPipelineRegistry = std::make_shared<PipelineRegistry>(this->mDevice);
+    this->mDescriptorAllocator =
+      std::make_shared<DescriptorAllocator>(this->mDevice);
+    this->mMemoryBudget =
+      std::make_shared<MemoryBudget>(this->mPhysicalDevice,
+                                     this->mDevice,
+                                     this->mComputeQueues[0],
+                                     this->mComputeQueueFamilyIndices[0],
+                                     this->mComputeQueueMutexes[0]);
+    // The host functions of timeline semaphores are only core in Vulkan 1.2
+    this->mFenceWaiter = std::make_shared<FenceWaiter>(
+      this->mDevice,
+      this->mTimelineSemaphores &&
+        deviceApiVersion >= VK_MAKE_VERSION(1, 2, 0));
+}
+
+void
+Manager::createPipelineCache()
+{
+    KP_LOG_DEBUG("Kompute Manager creating pipeline cache");
+
+    vk::PipelineCacheCreateInfo pipelineCacheInfo =
+      vk::PipelineCacheCreateInfo();
+    this->mPipelineCache = std::make_shared<vk::PipelineCache>();
+    this->mDevice->createPipelineCache(
+      &pipelineCacheInfo, nullptr, this->mPipelineCache.get());
+}
+
+bool
+Manager::loadPipelineCache(const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute Manager loading pipeline cache from {}", path);
+
+    if (!this->mPipelineCache) {
+        throw std::runtime_error("Kompute Manager pipeline cache is null");
+    }
+
+    std::ifstream fileStream(path, std::ios::binary | std::ios::ate);
+    if (!fileStream.is_open()) {
+        KP_LOG_INFO("Kompute Manager no pipeline cache found at {}", path);
+        return false;
+    }
+
+    size_t fileSize = static_cast<size_t>(fileStream.tellg());
+    fileStream.seekg(0, std::ios::beg);
+
+    PipelineCacheFileHeader fileHeader;
+    if (fileSize < sizeof(fileHeader) ||
+        !fileStream.read((char*)&fileHeader, sizeof(fileHeader))) {
+        KP_LOG_WARN("Kompute Manager pipeline cache file {} is truncated, "
+                    "ignoring",
+                    path);
+        return false;
+    }
+
+    if (std::memcmp(fileHeader.magic,
+                    KP_PIPELINE_CACHE_FILE_MAGIC,
+                    sizeof(fileHeader.magic)) != 0 ||
+        fileHeader.version != KP_PIPELINE_CACHE_FILE_VERSION ||
+        fileHeader.dataSize != fileSize - sizeof(fileHeader)) {
+        KP_LOG_WARN("Kompute Manager pipeline cache file {} is not valid, "
+                    "ignoring",
+                    path);
+        return false;
+    }
+
+    vk::PhysicalDeviceProperties properties =
+      this->mPhysicalDevice->getProperties();
+
+    if (fileHeader.vendorID != properties.vendorID ||
+        fileHeader.deviceID != properties.deviceID ||
+        fileHeader.driverVersion != properties.driverVersion ||
+        std::memcmp(fileHeader.pipelineCacheUUID,
+                    properties.pipelineCacheUUID.data(),
+                    VK_UUID_SIZE) != 0) {
+        KP_LOG_WARN("Kompute Manager pipeline cache file {} was created by a "
+                    "different device or driver version, ignoring",
+                    path);
+        return false;
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(fileHeader.dataSize));
+    if (!fileStream.read((char*)data.data(), data.size())) {
+        KP_LOG_WARN("Kompute Manager failed to read pipeline cache data from "
+                    "{}, ignoring",
+                    path);
+        return false;
+    }
+
+    // The data is also checked against the header defined by Vulkan, as
+    // drivers are not required to reject incompatible data gracefully
+    uint32_t cacheHeader[4];
+    if (data.size() < KP_PIPELINE_CACHE_HEADER_SIZE) {
+        KP_LOG_WARN("Kompute Manager pipeline cache data from {} is "
+                    "truncated, ignoring",
+                    path);
+        return false;
+    }
+    std::memcpy(cacheHeader, data.data(), sizeof(cacheHeader));
+    if (cacheHeader[0] < KP_PIPELINE_CACHE_HEADER_SIZE ||
+        cacheHeader[1] != static_cast<uint32_t>(
+                            vk::PipelineCacheHeaderVersion::eOne) ||
+        cacheHeader[2] != properties.vendorID ||
+        cacheHeader[3] != properties.deviceID ||
+        std::memcmp(data.data() + sizeof(cacheHeader),
+                    properties.pipelineCacheUUID.data(),
+                    VK_UUID_SIZE) != 0) {
+        KP_LOG_WARN("Kompute Manager pipeline cache data from {} does not "
+                    "match the device, ignoring",
+                    path);
+        return false;
+    }
+
+    // Algorithms may already hold the shared pipeline cache, so the loaded
+    // data is merged into it rather than replacing it
+    vk::PipelineCacheCreateInfo pipelineCacheInfo(
+      vk::PipelineCacheCreateFlags(), data.size(), data.data());
+    vk::PipelineCache loadedPipelineCache;
+    this->mDevice->createPipelineCache(
+      &pipelineCacheInfo, nullptr, &loadedPipelineCache);
+
+    this->mDevice->mergePipelineCaches(*this->mPipelineCache,
+                                       loadedPipelineCache);
+
+    this->mDevice->destroy(
+      loadedPipelineCache,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    KP_LOG_INFO("Kompute Manager loaded {} bytes of pipeline cache data from "
+                "{}",
+                data.size(),
+                path);
+
+    return true;
+}
+
+void
+Manager::savePipelineCache(const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute Manager saving pipeline cache to {}", path);
+
+    if (!this->mPipelineCache) {
+        throw std::runtime_error("Kompute Manager pipeline cache is null");
+    }
+
+    std::vector<uint8_t> data =
+      this->mDevice->getPipelineCacheData(*this->mPipelineCache);
+
+    vk::PhysicalDeviceProperties properties =
+      this->mPhysicalDevice->getProperties();
+
+    PipelineCacheFileHeader fileHeader;
+    std::memset(&fileHeader, 0, sizeof(fileHeader));
+    std::memcpy(fileHeader.magic,
+                KP_PIPELINE_CACHE_FILE_MAGIC,
+                sizeof(fileHeader.magic));
+    fileHeader.version = KP_PIPELINE_CACHE_FILE_VERSION;
+    fileHeader.vendorID = properties.vendorID;
+    fileHeader.deviceID = properties.deviceID;
+    fileHeader.driverVersion = properties.driverVersion;
+    std::memcpy(fileHeader.pipelineCacheUUID,
+                properties.pipelineCacheUUID.data(),
+                VK_UUID_SIZE);
+    fileHeader.dataSize = data.size();
+
+    std::ofstream fileStream(path, std::ios::binary | std::ios::trunc);
+    if (!fileStream.is_open()) {
+        throw std::runtime_error(
+          "Kompute Manager could not open pipeline cache file for writing: " +
+          path);
+    }
+
+    fileStream.write((const char*)&fileHeader, sizeof(fileHeader));
+    fileStream.write((const char*)data.data(), data.size());
+
+    if (!fileStream) {
+        throw std::runtime_error(
+          "Kompute Manager failed to write pipeline cache file: " + path);
+    }
+
+    KP_LOG_INFO("Kompute Manager saved {} bytes of pipeline cache data to {}",
+                data.size(),
+                path);
+}
+
+std::shared_ptr<vk::PipelineCache>
+Manager::getPipelineCache() const
+{
+    return this->mPipelineCache;
+}
+
+std::shared_ptr<PipelineRegistry>
+Manager::getPipelineRegistry() const
+{
+    return this->mPipelineRegistry;
+}
+
+std::shared_ptr<DescriptorAllocator>
+Manager::getDescriptorAllocator() const
+{
+    return this->mDescriptorAllocator;
+}
+
+void
+Manager::enableMemoryPool(vk::DeviceSize blockSize)
+{
+    KP_LOG_DEBUG("Kompute Manager enabling memory pool with block size {}",
+                 blockSize);
+
+    if (this->mMemoryPool) {
+        KP_LOG_WARN("Kompute Manager memory pool already enabled with block "
+                    "size {}, ignoring",
+                    this->mMemoryPool->blockSize());
+        return;
+    }
+
+    this->mMemoryPool = std::make_shared<MemoryPool>(
+      this->mPhysicalDevice, this->mDevice, blockSize);
+}
+
+std::shared_ptr<MemoryPool>
+Manager::getMemoryPool() const
+{
+    return this->mMemoryPool;
+}
+
+std::shared_ptr<MemoryBudget>
+Manager::getMemoryBudget() const
+{
+    return this->mMemoryBudget;
+}
+
+std::shared_ptr<FenceWaiter>
+Manager::getFenceWaiter() const
+{
+    return this->mFenceWaiter;
+}
+
+void
+Manager::setEvictionPolicy(MemoryBudget::EvictionPolicy evictionPolicy)
+{
+    if (!this->mMemoryBudget) {
+        throw std::runtime_error("Kompute Manager memory budget is null");
+    }
+
+    this->mMemoryBudget->setEvictionPolicy(evictionPolicy);
+}
+
+void
+Manager::enableStagingRing(vk::DeviceSize size)
+{
+    KP_LOG_DEBUG("Kompute Manager enabling staging ring with size {}", size);
+
+    if (this->mStagingRing) {
+        KP_LOG_WARN("Kompute Manager staging ring already enabled with size "
+                    "{}, ignoring",
+                    this->mStagingRing->size());
+        return;
+    }
+
+    if (this->mComputeQueues.empty()) {
+        throw std::runtime_error(
+          "Kompute Manager staging ring requires a compute queue");
+    }
+
+    this->mStagingRing =
+      std::make_shared<StagingRing>(this->mPhysicalDevice,
+                                    this->mDevice,
+                                    this->mComputeQueues[0],
+                                    this->mComputeQueueFamilyIndices[0],
+                                    size,
+                                    this->mComputeQueueMutexes[0]);
+}
+
+void
+Manager::loadTensor(std::shared_ptr<Tensor> tensor,
+                    const std::string& path,
+                    uint64_t offset)
+{
+    KP_LOG_DEBUG("Kompute Manager loading tensor from {}", path);
+
+    if (!tensor) {
+        throw std::runtime_error(
+          "Kompute Manager loadTensor called with null tensor");
+    }
+
+    std::shared_ptr<StagingRing> stagingRing = nullptr;
+    if (tensor->memoryType() == Memory::MemoryTypes::eDevice ||
+        tensor->memoryType() == Memory::MemoryTypes::eStorage) {
+        stagingRing = this->transferStagingRing();
+    }
+
+    tensor->loadFile(path, offset, stagingRing);
+}
+
+void
+Manager::saveTensors(const std::string& path,
+                     const std::vector<std::shared_ptr<Tensor>>& tensors)
+{
+    KP_LOG_DEBUG("Kompute Manager saving {} tensors to {}",
+                 tensors.size(),
+                 path);
+
+    CheckpointHeader header;
+    header.magic = CheckpointHeader::magicNumber;
+    header.version = CheckpointHeader::currentVersion;
+    header.tensorCount = tensors.size();
+
+    const uint64_t alignment = CheckpointHeader::alignment;
+    std::vector<CheckpointEntry> entries(tensors.size());
+    uint64_t offset =
+      sizeof(CheckpointHeader) + tensors.size() * sizeof(CheckpointEntry);
+    bool streamFromDevice = false;
+    for (size_t i = 0; i < tensors.size(); i++) {
+        if (!tensors[i]) {
+            throw std::runtime_error(
+              "Kompute Manager saveTensors called with null tensor");
+        }
+
+        offset = (offset + alignment - 1) / alignment * alignment;
+        entries[i].dataType = static_cast<uint32_t>(tensors[i]->dataType());
+        entries[i].memoryType =
+          static_cast<uint32_t>(tensors[i]->memoryType());
+        entries[i].elementMemorySize = tensors[i]->dataTypeMemorySize();
+        entries[i].reserved = 0;
+        entries[i].size = tensors[i]->size();
+        entries[i].offset = offset;
+        offset += tensors[i]->memorySize();
+
+        streamFromDevice =
+          streamFromDevice ||
+          tensors[i]->memoryType() == Memory::MemoryTypes::eStorage ||
+          tensors[i]->residency() == Memory::Residency::eDeviceDirty;
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("Kompute Manager failed to open " + path +
+                                 " to save tensors");
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               entries.size() * sizeof(CheckpointEntry));
+
+    // Reads back device data through chunks of the size of the ring
+    std::shared_ptr<StagingRing> stagingRing =
+      streamFromDevice ? this->transferStagingRing() : nullptr;
+    uint64_t chunkSize =
+      stagingRing ? stagingRing->size() : KP_DEFAULT_FILE_CHUNK_SIZE;
+
+    const std::vector<char> padding(alignment, 0);
+    for (size_t i = 0; i < tensors.size(); i++) {
+        uint64_t position = static_cast<uint64_t>(file.tellp());
+        file.write(padding.data(), entries[i].offset - position);
+
+        tensors[i]->saveToStream(file, stagingRing, chunkSize);
+    }
+
+    file.flush();
+    if (!file) {
+        throw std::runtime_error("Kompute Manager failed to write " + path);
+    }
+}
+
+std::vector<std::shared_ptr<Tensor>>
+Manager::loadTensors(const std::string& path)
+{
+    KP_LOG_DEBUG("Kompute Manager loading tensors from {}", path);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Kompute Manager failed to open " + path +
+                                 " to load tensors");
+    }
+
+    CheckpointHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != CheckpointHeader::magicNumber) {
+        throw std::runtime_error("Kompute Manager " + path +
+                                 " is not a tensor checkpoint");
+    }
+    if (header.version != CheckpointHeader::currentVersion) {
+        throw std::runtime_error(
+          "Kompute Manager unsupported tensor checkpoint version " +
+          std::to_string(header.version));
+    }
+
+    uint64_t fileSize = MappedFile::fileSize(path);
+    if (header.tensorCount >
+        (fileSize - sizeof(header)) / sizeof(CheckpointEntry)) {
+        throw std::runtime_error("Kompute Manager tensor checkpoint " + path +
+                                 " is truncated");
+    }
+
+    std::vector<CheckpointEntry> entries(header.tensorCount);
+    file.read(reinterpret_cast<char*>(entries.data()),
+              entries.size() * sizeof(CheckpointEntry));
+    if (!file) {
+        throw std::runtime_error("Kompute Manager failed to read " + path);
+    }
+    file.close();
+
+    // Checked before creating any tensor so a corrupted checkpoint does not
+    // leave some of its tensors created
+    for (size_t i = 0; i < entries.size(); i++) {
+        const CheckpointEntry& entry = entries[i];
+
+        if (entry.dataType >
+              static_cast<uint32_t>(Memory::DataTypes::eBlockInt4) ||
+            entry.memoryType >
+              static_cast<uint32_t>(Memory::MemoryTypes::eDeviceAndHost)) {
+            throw std::runtime_error(
+              fmt::format("Kompute Manager tensor checkpoint {} has invalid "
+                          "data type {} or memory type {} for tensor {}",
+                          path,
+                          entry.dataType,
+                          entry.memoryType,
+                          i));
+        }
+
+        Memory::DataTypes dataType =
+          static_cast<Memory::DataTypes>(entry.dataType);
+        if (entry.elementMemorySize == 0 ||
+            (dataType != Memory::DataTypes::eCustom &&
+             entry.elementMemorySize !=
+               Memory::dataTypeMemorySize(dataType))) {
+            throw std::runtime_error(
+              fmt::format("Kompute Manager tensor checkpoint {} has invalid "
+                          "element size {} for tensor {} of type {}",
+                          path,
+                          entry.elementMemorySize,
+                          i,
+                          Memory::toString(dataType)));
+        }
+
+        // Written so that neither the size nor the offset can overflow
+        if (entry.size > fileSize / entry.elementMemorySize ||
+            entry.offset >
+              fileSize - entry.size * entry.elementMemorySize) {
+            throw std::runtime_error(
+              fmt::format("Kompute Manager tensor checkpoint {} is truncated, "
+                          "the data of tensor {} is past the end of the file",
+                          path,
+                          i));
+        }
+    }
+
+    std::vector<std::shared_ptr<Tensor>> tensors;
+    std::shared_ptr<StagingRing> stagingRing = nullptr;
+    for (const CheckpointEntry& entry : entries) {
+        Memory::MemoryTypes memoryType =
+          static_cast<Memory::MemoryTypes>(entry.memoryType);
+
+        std::shared_ptr<Tensor> tensor =
+          this->tensor(entry.size,
+                       entry.elementMemorySize,
+                       static_cast<Memory::DataTypes>(entry.dataType),
+                       memoryType);
+
+        if (!stagingRing && (memoryType == Memory::MemoryTypes::eDevice ||
+                             memoryType == Memory::MemoryTypes::eStorage)) {
+            stagingRing = this->transferStagingRing();
+        }
+
+        tensor->loadFile(path, entry.offset, stagingRing);
+        tensors.push_back(tensor);
+    }
+
+    return tensors;
+}
+
+std::shared_ptr<StreamingExecutor>
+Manager::streamingExecutor(std::shared_ptr<Algorithm> algorithm,
+                           const std::vector<uint32_t>& inputBindings,
+                           const std::vector<uint32_t>& outputBindings,
+                           uint32_t slotCount,
+                           uint32_t queueIndex)
+{
+    KP_LOG_DEBUG("Kompute Manager streaming executor creation triggered");
+
+    if (!algorithm || !algorithm->isInit()) {
+        throw std::runtime_error("Kompute Manager streamingExecutor called "
+                                 "with null or uninitialised algorithm");
+    }
+    if (slotCount == 0) {
+        throw std::runtime_error(
+          "Kompute Manager streamingExecutor requires at least one slot");
+    }
+
+    const std::vector<std::shared_ptr<Memory>>& memObjects =
+      algorithm->getMemObjects();
+
+    std::vector<uint32_t> streamedBindings = inputBindings;
+    streamedBindings.insert(
+      streamedBindings.end(), outputBindings.begin(), outputBindings.end());
+
+    std::vector<std::shared_ptr<Sequence>> sequences;
+    std::vector<std::vector<std::shared_ptr<Memory>>> slotMemObjects;
+
+    for (uint32_t slot = 0; slot < slotCount; slot++) {
+        std::vector<std::shared_ptr<Memory>> slotMemObject = memObjects;
+
+        for (uint32_t binding : streamedBindings) {
+            if (binding >= memObjects.size()) {
+                throw std::runtime_error(
+                  fmt::format("Kompute Manager streamingExecutor binding {} "
+                              "out of range, the algorithm has {} bindings",
+                              binding,
+                              memObjects.size()));
+            }
+
+            const std::shared_ptr<Memory>& memObject = memObjects[binding];
+
+            // Bindings listed as input and output are only replaced once
+            if (slotMemObject[binding] != memObject) {
+                continue;
+            }
+
+            // Tensors using the staging ring are streamed synchronously
+            // before the sequence is submitted, which would serialise the
+            // chunks
+            if (slot == 0 &&
+                memObject->memoryType() == Memory::MemoryTypes::eDevice &&
+                !memObject->usesStagingRing()) {
+                continue;
+            }
+
+            std::shared_ptr<Tensor> tensor{ new kp::Tensor(
+              this->mPhysicalDevice,
+              this->mDevice,
+              memObject->size(),
+              memObject->dataTypeMemorySize(),
+              memObject->dataType(),
+              Memory::MemoryTypes::eDevice,
+              this->mMemoryPool,
+              nullptr,
+              Memory::StagingPolicy::eEager,
+              this->mMemoryBudget) };
+
+            if (this->mManageResources) {
+                this->mManagedMemObjects.push_back(tensor);
+            }
+
+            slotMemObject[binding] = tensor;
+        }
+
+        sequences.push_back(this->sequence(queueIndex));
+        slotMemObjects.push_back(slotMemObject);
+    }
+
+    return std::make_shared<StreamingExecutor>(
+      algorithm, inputBindings, outputBindings, sequences, slotMemObjects);
+}
+
+std::shared_ptr<StagingRing>
+Manager::transferStagingRing()
+{
+    if (this->mStagingRing) {
+        return this->mStagingRing;
+    }
+
+    if (this->mComputeQueues.empty()) {
+        throw std::runtime_error(
+          "Kompute Manager staging ring requires a compute queue");
+    }
+
+    // Destroyed by the caller once done, after its transfers completed
+    return std::make_shared<StagingRing>(this->mPhysicalDevice,
+                                         this->mDevice,
+                                         this->mComputeQueues[0],
+                                         this->mComputeQueueFamilyIndices[0],
+                                         KP_DEFAULT_STAGING_RING_SIZE,
+                                         this->mComputeQueueMutexes[0]);
+}
+
+std::shared_ptr<StagingRing>
+Manager::getStagingRing() const
+{
+    return this->mStagingRing;
+}
+
+void
+Manager::setStagingPolicy(Memory::StagingPolicy stagingPolicy)
+{
+    KP_LOG_DEBUG("Kompute Manager setting staging policy to {}",
+                 stagingPolicy == Memory::StagingPolicy::eLazy ? "eLazy"
+                                                               : "eEager");
+
+    this->mStagingPolicy = stagingPolicy;
+}
+
+Memory::StagingPolicy
+Manager::getStagingPolicy() const
+{
+    return this->mStagingPolicy;
 }
 
 std::shared_ptr<Sequence>
-Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
+Manager::sequence(uint32_t queueIndex,
+                  uint32_t totalTimestamps,
+                  uint32_t slotCount)
 {
     KP_LOG_DEBUG("Kompute Manager sequence() with queueIndex: {}", queueIndex);
 
@@ -484,7 +1255,10 @@ Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
       this->mDevice,
       this->mComputeQueues[queueIndex],
       this->mComputeQueueFamilyIndices[queueIndex],
-      totalTimestamps) };
+      totalTimestamps,
+      this->mTimelineSemaphores,
+      slotCount,
+      this->mComputeQueueMutexes[queueIndex]) };
 
     if (this->mManageResources) {
         this->mManagedSequences.push_back(sq);
@@ -493,6 +1267,64 @@ Manager::sequence(uint32_t queueIndex, uint32_t totalTimestamps)
     return sq;
 }
 
+void
+Manager::evalAsync(const std::vector<std::shared_ptr<Sequence>>& sequences)
+{
+    KP_LOG_DEBUG("Kompute Manager evalAsync() with {} sequences",
+                 sequences.size());
+
+    Sequence::evalAsyncBatch(sequences);
+}
+
+void
+Manager::evalAwait(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                   uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Manager evalAwait() with {} sequences",
+                 sequences.size());
+
+    Sequence::evalAwaitBatch(sequences, waitFor);
+}
+
+int32_t
+Manager::waitAny(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                 uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Manager waitAny() with {} sequences",
+                 sequences.size());
+
+    return Sequence::waitAny(sequences, waitFor);
+}
+
+bool
+Manager::waitAll(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                 uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Manager waitAll() with {} sequences",
+                 sequences.size());
+
+    return Sequence::waitAll(sequences, waitFor);
+}
+
+std::future<void>
+Manager::evalAsyncFuture(std::shared_ptr<Sequence> sequence,
+                         std::function<void()> callback)
+{
+    KP_LOG_DEBUG("Kompute Manager evalAsyncFuture() called");
+
+    if (!this->mFenceWaiter) {
+        throw std::runtime_error("Kompute Manager fence waiter is null");
+    }
+    if (!sequence) {
+        throw std::runtime_error(
+          "Kompute Manager evalAsyncFuture called with a null sequence");
+    }
+
+    sequence->evalAsync();
+
+    return this->mFenceWaiter->add(sequence, callback);
+}
+
 vk::PhysicalDeviceProperties
 Manager::getDeviceProperties() const
 {
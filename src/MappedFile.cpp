@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/MappedFile.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kp {
+
+namespace {
+
+// Granularity of the file offsets mappings can start at
+uint64_t
+mappingGranularity()
+{
+#if defined(_WIN32)
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return systemInfo.dwAllocationGranularity;
+#else
+    return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+uint64_t
+pageGranularity()
+{
+#if defined(_WIN32)
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return systemInfo.dwPageSize;
+#else
+    return (uint64_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
+std::string
+lastError()
+{
+#if defined(_WIN32)
+    return "error " + std::to_string(GetLastError());
+#else
+    return strerror(errno);
+#endif
+}
+
+} // End anonymous namespace
+
+MappedFile::MappedFile(const std::string& path, uint64_t offset, uint64_t size)
+{
+    KP_LOG_DEBUG("Kompute MappedFile mapping {} bytes at offset {} of {}",
+                 size,
+                 offset,
+                 path);
+
+    uint64_t fileSize = MappedFile::fileSize(path);
+    if (offset > fileSize || size > fileSize - offset) {
+        throw std::runtime_error("Kompute MappedFile region of " +
+                                 std::to_string(size) + " bytes at offset " +
+                                 std::to_string(offset) +
+                                 " is out of the bounds of " + path + " of " +
+                                 std::to_string(fileSize) + " bytes");
+    }
+    if (size == 0) {
+        size = fileSize - offset;
+    }
+    if (size == 0) {
+        throw std::runtime_error(
+          "Kompute MappedFile attempted to map a zero-sized region of " +
+          path);
+    }
+    if (size > std::numeric_limits<size_t>::max()) {
+        throw std::runtime_error("Kompute MappedFile region of " +
+                                 std::to_string(size) +
+                                 " bytes is not addressable by the host");
+    }
+
+    // Mappings start at a multiple of the granularity before the region
+    uint64_t mappingOffset = offset / mappingGranularity() *
+                             mappingGranularity();
+    this->mMappingSize = size + (offset - mappingOffset);
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Kompute MappedFile failed to open " + path +
+                                 ": " + lastError());
+    }
+    HANDLE fileMapping =
+      CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (fileMapping) {
+        this->mMapping = MapViewOfFile(fileMapping,
+                                       FILE_MAP_COPY,
+                                       (DWORD)(mappingOffset >> 32),
+                                       (DWORD)(mappingOffset & 0xffffffff),
+                                       (SIZE_T)this->mMappingSize);
+    }
+    std::string error = lastError();
+    // The view keeps the file mapped once the handles are closed
+    if (fileMapping) {
+        CloseHandle(fileMapping);
+    }
+    CloseHandle(file);
+    if (!this->mMapping) {
+        throw std::runtime_error("Kompute MappedFile failed to map " + path +
+                                 ": " + error);
+    }
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error("Kompute MappedFile failed to open " + path +
+                                 ": " + lastError());
+    }
+    void* mapping = mmap(nullptr,
+                         (size_t)this->mMappingSize,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE,
+                         file,
+                         (off_t)mappingOffset);
+    std::string error = lastError();
+    // The mapping keeps the file mapped once the descriptor is closed
+    close(file);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Kompute MappedFile failed to map " + path +
+                                 ": " + error);
+    }
+    this->mMapping = mapping;
+#endif
+
+    this->mData = static_cast<uint8_t*>(this->mMapping) +
+                  (offset - mappingOffset);
+    this->mSize = size;
+}
+
+MappedFile::~MappedFile()
+{
+    KP_LOG_DEBUG("Kompute MappedFile unmapping {} bytes", this->mMappingSize);
+
+    if (!this->mMapping) {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(this->mMapping);
+#else
+    munmap(this->mMapping, (size_t)this->mMappingSize);
+#endif
+    this->mMapping = nullptr;
+    this->mData = nullptr;
+}
+
+void*
+MappedFile::data()
+{
+    return this->mData;
+}
+
+uint64_t
+MappedFile::size()
+{
+    return this->mSize;
+}
+
+void
+MappedFile::prefetch(uint64_t offset, uint64_t size)
+{
+    uint8_t* pageStart;
+    uint64_t pageSize;
+    if (!this->pageRange(offset, size, false, &pageStart, &pageSize)) {
+        return;
+    }
+
+#if defined(_WIN32) && _WIN32_WINNT >= 0x0602
+    WIN32_MEMORY_RANGE_ENTRY range = { pageStart, (SIZE_T)pageSize };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#elif !defined(_WIN32)
+    // Only a hint, the pages are still read on access if it fails
+    madvise(pageStart, (size_t)pageSize, MADV_WILLNEED);
+#endif
+}
+
+void
+MappedFile::release(uint64_t offset, uint64_t size)
+{
+    uint8_t* pageStart;
+    uint64_t pageSize;
+    if (!this->pageRange(offset, size, true, &pageStart, &pageSize)) {
+        return;
+    }
+
+#if defined(_WIN32)
+    // Unlocking pages that are not locked removes them from the working set
+    VirtualUnlock(pageStart, (SIZE_T)pageSize);
+#else
+    madvise(pageStart, (size_t)pageSize, MADV_DONTNEED);
+#endif
+}
+
+uint64_t
+MappedFile::fileSize(const std::string& path)
+{
+#if defined(_WIN32)
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(
+          path.c_str(), GetFileExInfoStandard, &attributes)) {
+        throw std::runtime_error("Kompute MappedFile failed to open " + path +
+                                 ": " + lastError());
+    }
+    return ((uint64_t)attributes.nFileSizeHigh << 32) |
+           attributes.nFileSizeLow;
+#else
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0) {
+        throw std::runtime_error("Kompute MappedFile failed to open " + path +
+                                 ": " + lastError());
+    }
+    return (uint64_t)fileStat.st_size;
+#endif
+}
+
+bool
+MappedFile::pageRange(uint64_t offset,
+                      uint64_t size,
+                      bool inner,
+                      uint8_t** pageStart,
+                      uint64_t* pageSize)
+{
+    if (!this->mMapping || offset >= this->mSize) {
+        return false;
+    }
+    size = std::min(size, this->mSize - offset);
+
+    // Offsets in the mapping, which starts at a page boundary
+    uint64_t page = pageGranularity();
+    uint64_t start = (this->mData - static_cast<uint8_t*>(this->mMapping)) +
+                     offset;
+    uint64_t end = start + size;
+    if (inner) {
+        start = (start + page - 1) / page * page;
+        end = end / page * page;
+        // The last page of the mapping is only partially in the file
+        if (offset + size == this->mSize) {
+            end = this->mMappingSize;
+        }
+    } else {
+        start = start / page * page;
+        end = std::min((end + page - 1) / page * page, this->mMappingSize);
+    }
+    if (end <= start) {
+        return false;
+    }
+
+    *pageStart = static_cast<uint8_t*>(this->mMapping) + start;
+    *pageSize = end - start;
+    return true;
+}
+
+} // End namespace kp
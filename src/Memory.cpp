@@ -3,6 +3,8 @@
 #include "kompute/Memory.hpp"
 #include "kompute/Image.hpp"
 #include "kompute/Tensor.hpp"
+#include <atomic>
+#include <limits>
 #if KOMPUTE_OPT_USE_SPDLOG
 #include <spdlog/fmt/fmt.h>
 #else
@@ -11,12 +13,19 @@
 
 namespace kp {
 
+// Incremented each time the residency of all the memory objects is
+// invalidated, which only affects the residency set before
+static std::atomic<uint64_t> residencyEpoch{ 0 };
+
 Memory::Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                std::shared_ptr<vk::Device> device,
                const DataTypes& dataType,
                const MemoryTypes& memoryType,
                uint32_t x,
-               uint32_t y)
+               uint32_t y,
+               std::shared_ptr<MemoryPool> memoryPool,
+               std::shared_ptr<StagingRing> stagingRing,
+               const StagingPolicy& stagingPolicy)
 {
     if (x == 0 || y == 0) {
         throw std::runtime_error(
@@ -30,6 +39,13 @@ Memory::Memory(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
     this->mDataTypeMemorySize = Memory::dataTypeMemorySize(dataType);
     this->mX = x;
     this->mY = y;
+    this->mMemoryPool = memoryPool;
+
+    // Only device memory objects have staging memory to replace
+    if (memoryType == MemoryTypes::eDevice) {
+        this->mStagingRing = stagingRing;
+    }
+    this->mStagingPolicy = stagingPolicy;
 }
 
 std::string
@@ -69,6 +85,18 @@ Memory::toString(Memory::DataTypes dt)
             return "eFloat";
         case DataTypes::eDouble:
             return "eDouble";
+        case DataTypes::eHalf:
+            return "eHalf";
+        case DataTypes::eBFloat16:
+            return "eBFloat16";
+        case DataTypes::eInt64:
+            return "eInt64";
+        case DataTypes::eUnsignedInt64:
+            return "eUnsignedInt64";
+        case DataTypes::eBlockInt8:
+            return "eBlockInt8";
+        case DataTypes::eBlockInt4:
+            return "eBlockInt4";
         default:
             return "unknown";
     }
@@ -80,7 +108,65 @@ Memory::memoryType()
     return this->mMemoryType;
 }
 
-uint32_t
+bool
+Memory::usesStagingRing()
+{
+    return this->mStagingRing != nullptr;
+}
+
+bool
+Memory::hasStagingMemory()
+{
+    return this->mStagingMemory != nullptr;
+}
+
+void
+Memory::releaseStagingMemory()
+{
+    if (!this->hasStagingMemory()) {
+        KP_LOG_DEBUG("Kompute Memory has no staging memory to release");
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Memory releasing staging memory of {} bytes",
+                 this->memorySize());
+
+    this->destroyStagingMemory();
+
+    // The host data has to be synced back from the device before being read
+    this->setResidency(Residency::eDeviceDirty);
+}
+
+Memory::Residency
+Memory::residency()
+{
+    if (this->mMemoryType != MemoryTypes::eDevice) {
+        return Residency::eCoherent;
+    }
+    if (this->mResidency == Residency::eCoherent &&
+        this->mResidencyEpoch != residencyEpoch.load()) {
+        return Residency::eDeviceDirty;
+    }
+    return this->mResidency;
+}
+
+void
+Memory::setResidency(Residency residency)
+{
+    this->mResidency = residency;
+    this->mResidencyEpoch = residencyEpoch.load();
+}
+
+void
+Memory::invalidateResidency()
+{
+    KP_LOG_DEBUG("Kompute Memory invalidating the residency of all memory "
+                 "objects");
+
+    residencyEpoch++;
+}
+
+uint64_t
 Memory::size()
 {
     return this->mSize;
@@ -114,6 +200,18 @@ Memory::dataTypeMemorySize(DataTypes dt)
             return sizeof(float);
         case DataTypes::eDouble:
             return sizeof(double);
+        case DataTypes::eHalf:
+            return sizeof(Half);
+        case DataTypes::eBFloat16:
+            return sizeof(BFloat16);
+        case DataTypes::eInt64:
+            return sizeof(int64_t);
+        case DataTypes::eUnsignedInt64:
+            return sizeof(uint64_t);
+        case DataTypes::eBlockInt8:
+            return sizeof(BlockInt8);
+        case DataTypes::eBlockInt4:
+            return sizeof(BlockInt4);
         default:
             return 0;
     }
@@ -125,7 +223,7 @@ Memory::dataType()
     return this->mDataType;
 }
 
-uint32_t
+uint64_t
 Memory::memorySize()
 {
     return this->mSize * this->mDataTypeMemorySize;
@@ -137,6 +235,10 @@ Memory::rawData()
     if (!this->mRawData) {
         this->mapRawData();
     }
+
+    // The data may be written through the pointer returned
+    this->setResidency(Residency::eHostDirty);
+
     return this->mRawData;
 }
 
@@ -152,6 +254,28 @@ Memory::setData(const void* data, size_t size)
         this->mapRawData();
     }
     memcpy(this->mRawData, data, this->memorySize());
+
+    this->setResidency(Residency::eHostDirty);
+}
+
+void
+Memory::setData(size_t offset, const void* data, size_t size)
+{
+    if (offset > this->memorySize() || size > this->memorySize() - offset) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Memory cannot set {} bytes at offset {} of memory of "
+          "size {}",
+          size,
+          offset,
+          this->memorySize()));
+    }
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+    memcpy(static_cast<uint8_t*>(this->mRawData) + offset, data, size);
+
+    this->setResidency(Residency::eHostDirty);
 }
 
 void
@@ -160,18 +284,35 @@ Memory::mapRawData()
     KP_LOG_DEBUG("Kompute Memory mapping data from host buffer");
 
     std::shared_ptr<vk::DeviceMemory> hostVisibleMemory = nullptr;
+    void* hostVisibleMappedData = nullptr;
 
     if (this->mMemoryType == MemoryTypes::eHost ||
         this->mMemoryType == MemoryTypes::eDeviceAndHost) {
         hostVisibleMemory = this->mPrimaryMemory;
+        hostVisibleMappedData = this->mPrimaryAllocation.mappedData;
+    } else if (this->mMemoryType == MemoryTypes::eDevice &&
+               this->mStagingRing) {
+        // The data is kept in host memory and only streamed through the
+        // staging ring when syncing, so there is nothing to map
+        this->mRawData = this->mHostData.data();
+        return;
     } else if (this->mMemoryType == MemoryTypes::eDevice) {
+        this->ensureStagingMemory();
         hostVisibleMemory = this->mStagingMemory;
+        hostVisibleMappedData = this->mStagingAllocation.mappedData;
     } else {
         KP_LOG_WARN("Kompute Memory mapping data not supported on {} memory",
                     Memory::toString(this->memoryType()));
         return;
     }
 
+    // Pooled memory blocks are kept mapped by the pool as a device memory
+    // object can only be mapped once, so there is nothing to unmap later
+    if (hostVisibleMappedData) {
+        this->mRawData = hostVisibleMappedData;
+        return;
+    }
+
     vk::DeviceSize size = this->memorySize();
 
     // Given we request coherent host memory we don't need to invalidate /
@@ -221,6 +362,48 @@ Memory::updateRawData(void* data)
     }
 }
 
+void
+Memory::checkMemorySize()
+{
+    if (this->mSize == 0 || this->mDataTypeMemorySize == 0) {
+        throw std::runtime_error(
+          "Kompute Memory attempted to create a zero-sized memory object");
+    }
+
+    // The size in bytes has to be addressable by the host
+    uint64_t maxSize = std::numeric_limits<size_t>::max();
+    if (this->mSize > maxSize / this->mDataTypeMemorySize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Memory of {} elements of {} bytes overflows its size in "
+          "bytes",
+          this->mSize,
+          this->mDataTypeMemorySize));
+    }
+
+    // The limit is only reported by Vulkan 1.1 devices
+    vk::PhysicalDeviceProperties properties =
+      this->mPhysicalDevice->getProperties();
+    if (KOMPUTE_VK_API_VERSION < VK_MAKE_VERSION(1, 1, 0) ||
+        properties.apiVersion < VK_MAKE_VERSION(1, 1, 0)) {
+        return;
+    }
+
+    vk::DeviceSize maxMemoryAllocationSize =
+      this->mPhysicalDevice
+        ->getProperties2<vk::PhysicalDeviceProperties2,
+                         vk::PhysicalDeviceMaintenance3Properties>()
+        .get<vk::PhysicalDeviceMaintenance3Properties>()
+        .maxMemoryAllocationSize;
+    if (maxMemoryAllocationSize > 0 &&
+        this->memorySize() > maxMemoryAllocationSize) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Memory of {} bytes exceeds the maxMemoryAllocationSize of "
+          "{} bytes",
+          this->memorySize(),
+          maxMemoryAllocationSize));
+    }
+}
+
 vk::MemoryPropertyFlags
 Memory::getPrimaryMemoryPropertyFlags()
 {
@@ -257,6 +440,61 @@ Memory::getStagingMemoryPropertyFlags()
     }
 }
 
+bool
+Memory::requiresStagingMemory()
+{
+    return this->mMemoryType == MemoryTypes::eDevice && !this->mStagingRing;
+}
+
+void
+Memory::ensureStagingMemory()
+{
+    if (!this->requiresStagingMemory() || this->mStagingMemory) {
+        return;
+    }
+
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute Memory cannot allocate staging "
+                                 "memory with null Device pointer");
+    }
+
+    KP_LOG_DEBUG("Kompute Memory allocating staging memory on first use");
+
+    this->allocateStagingMemory();
+}
+
+void
+Memory::freeStagingMemory()
+{
+    // The staging memory is the memory mapped for the host data of device
+    // memory objects, so it has to be unmapped before being freed
+    if (this->mMemoryType == MemoryTypes::eDevice) {
+        this->unmapRawData();
+        this->mRawData = nullptr;
+    }
+
+    if (this->mFreeStagingMemory) {
+        if (!this->mStagingMemory) {
+            KP_LOG_WARN("Kompose Memory expected to free staging memory but "
+                        "got null memory");
+        } else {
+            KP_LOG_DEBUG("Kompose Memory freeing staging memory");
+            this->mDevice->freeMemory(
+              *this->mStagingMemory,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            this->mStagingMemory = nullptr;
+            this->mFreeStagingMemory = false;
+        }
+    }
+
+    if (this->mStagingAllocation) {
+        KP_LOG_DEBUG("Kompose Memory releasing staging memory to pool");
+        this->mMemoryPool->free(this->mStagingAllocation);
+        this->mStagingAllocation = MemoryPool::Allocation();
+        this->mStagingMemory = nullptr;
+    }
+}
+
 void
 Memory::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
                        std::shared_ptr<Memory> copyFromMemory)
@@ -314,18 +552,23 @@ Memory::destroy(void)
         }
     }
 
-    if (this->mFreeStagingMemory) {
-        if (!this->mStagingMemory) {
-            KP_LOG_WARN("Kompose Memory expected to free staging memory but "
-                        "got null memory");
-        } else {
-            KP_LOG_DEBUG("Kompose Memory freeing staging memory");
-            this->mDevice->freeMemory(
-              *this->mStagingMemory,
-              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-            this->mStagingMemory = nullptr;
-            this->mFreeStagingMemory = false;
-        }
+    this->freeStagingMemory();
+
+    if (this->mPrimaryAllocation) {
+        KP_LOG_DEBUG("Kompose Memory releasing primary memory to pool");
+        this->mMemoryPool->free(this->mPrimaryAllocation);
+        this->mPrimaryAllocation = MemoryPool::Allocation();
+        this->mPrimaryMemory = nullptr;
+    }
+
+    // The pool outlives the manager that created it for as long as memory
+    // objects hold allocations from it, and frees its blocks once the last
+    // of them is destroyed, rather than when the last one is released
+    this->mMemoryPool = nullptr;
+
+    if (!this->mHostData.empty()) {
+        KP_LOG_DEBUG("Kompose Memory releasing host data");
+        std::vector<uint8_t>().swap(this->mHostData);
     }
 
     if (this->mDevice) {
@@ -0,0 +1,354 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/MemoryBudget.hpp"
+#include "kompute/Tensor.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace kp {
+
+MemoryBudget::MemoryBudget(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                           std::shared_ptr<vk::Device> device,
+                           std::shared_ptr<vk::Queue> queue,
+                           uint32_t queueIndex,
+                           std::shared_ptr<std::mutex> queueMutex)
+{
+    if (!physicalDevice) {
+        throw std::runtime_error(
+          "Kompute MemoryBudget physical device is null");
+    }
+    if (!device) {
+        throw std::runtime_error("Kompute MemoryBudget device is null");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mQueue = queue;
+    this->mQueueIndex = queueIndex;
+    this->mQueueMutex = queueMutex;
+
+    // The budget is queried through vkGetPhysicalDeviceMemoryProperties2,
+    // which is only part of Vulkan 1.1
+    if (KOMPUTE_VK_API_VERSION >= VK_MAKE_VERSION(1, 1, 0) &&
+        this->mPhysicalDevice->getProperties().apiVersion >=
+          VK_MAKE_VERSION(1, 1, 0)) {
+        std::string memoryBudgetName = VK_EXT_MEMORY_BUDGET_EXTENSION_NAME;
+        for (const vk::ExtensionProperties& ext :
+             this->mPhysicalDevice->enumerateDeviceExtensionProperties()) {
+            if (memoryBudgetName == ext.extensionName.data()) {
+                this->mBudgetExtension = true;
+                break;
+            }
+        }
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryBudget created, budget extension: {}",
+                 this->mBudgetExtension);
+}
+
+MemoryBudget::~MemoryBudget()
+{
+    KP_LOG_DEBUG("Kompute MemoryBudget destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryBudget destructor success");
+}
+
+bool
+MemoryBudget::hasBudgetExtension()
+{
+    return this->mBudgetExtension;
+}
+
+vk::DeviceSize
+MemoryBudget::budget()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    vk::DeviceSize budget;
+    vk::DeviceSize usage;
+    this->queryHeaps(&budget, &usage);
+    return budget;
+}
+
+vk::DeviceSize
+MemoryBudget::usage()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    vk::DeviceSize budget;
+    vk::DeviceSize usage;
+    this->queryHeaps(&budget, &usage);
+    return usage;
+}
+
+void
+MemoryBudget::setLimit(vk::DeviceSize limit)
+{
+    KP_LOG_DEBUG("Kompute MemoryBudget setting limit to {} bytes", limit);
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mLimit = limit;
+}
+
+vk::DeviceSize
+MemoryBudget::limit()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mLimit;
+}
+
+vk::DeviceSize
+MemoryBudget::trackedSize()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mTrackedSize;
+}
+
+uint32_t
+MemoryBudget::tensorCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return static_cast<uint32_t>(this->mEntries.size());
+}
+
+uint64_t
+MemoryBudget::evictionCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mEvictionCount;
+}
+
+void
+MemoryBudget::setEvictionPolicy(EvictionPolicy evictionPolicy)
+{
+    KP_LOG_DEBUG("Kompute MemoryBudget setting eviction policy to {}",
+                 evictionPolicy == EvictionPolicy::eLeastRecentlyUsed
+                   ? "eLeastRecentlyUsed"
+                   : "eNone");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    this->mEvictionPolicy = evictionPolicy;
+}
+
+MemoryBudget::EvictionPolicy
+MemoryBudget::getEvictionPolicy()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mEvictionPolicy;
+}
+
+void
+MemoryBudget::reserve(vk::DeviceSize size)
+{
+    std::vector<Tensor*> victims;
+
+    {
+        std::lock_guard<std::mutex> lock(this->mMutex);
+
+        if (this->mEvictionPolicy == EvictionPolicy::eNone) {
+            return;
+        }
+
+        vk::DeviceSize budget;
+        vk::DeviceSize usage;
+        this->queryHeaps(&budget, &usage);
+        vk::DeviceSize trackedSize = this->mTrackedSize;
+
+        auto entryIt = this->mEntries.rbegin();
+        while ((usage + size > budget ||
+                (this->mLimit && trackedSize + size > this->mLimit)) &&
+               entryIt != this->mEntries.rend()) {
+            const Entry& entry = *entryIt++;
+            if (!entry.resident || entry.tensor->isPinned()) {
+                continue;
+            }
+
+            victims.push_back(entry.tensor);
+            usage -= std::min(usage, entry.size);
+            trackedSize -= entry.size;
+        }
+
+        if (usage + size > budget ||
+            (this->mLimit && trackedSize + size > this->mLimit)) {
+            KP_LOG_WARN("Kompute MemoryBudget allocating {} bytes exceeds "
+                        "the budget of {} bytes with {} bytes in use, and no "
+                        "other tensor can be evicted",
+                        size,
+                        this->mLimit ? std::min(budget, this->mLimit) : budget,
+                        usage);
+        }
+    }
+
+    // Evicting transfers the data of the tensors, which is done without
+    // holding the lock as the tensors report back to the budget
+    for (Tensor* victim : victims) {
+        KP_LOG_DEBUG("Kompute MemoryBudget evicting least recently used "
+                     "tensor of {} bytes",
+                     victim->memorySize());
+        victim->evict();
+    }
+}
+
+void
+MemoryBudget::add(Tensor* tensor, vk::DeviceSize size)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (this->mEntryIterators.count(tensor)) {
+        return;
+    }
+
+    this->mEntries.push_front({ tensor, size, true });
+    this->mEntryIterators[tensor] = this->mEntries.begin();
+    this->mTrackedSize += size;
+}
+
+void
+MemoryBudget::remove(Tensor* tensor)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto iteratorIt = this->mEntryIterators.find(tensor);
+    if (iteratorIt == this->mEntryIterators.end()) {
+        return;
+    }
+
+    if (iteratorIt->second->resident) {
+        this->mTrackedSize -= iteratorIt->second->size;
+    }
+    this->mEntries.erase(iteratorIt->second);
+    this->mEntryIterators.erase(iteratorIt);
+}
+
+void
+MemoryBudget::setResident(Tensor* tensor, bool resident)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto iteratorIt = this->mEntryIterators.find(tensor);
+    if (iteratorIt == this->mEntryIterators.end() ||
+        iteratorIt->second->resident == resident) {
+        return;
+    }
+
+    Entry& entry = *iteratorIt->second;
+    entry.resident = resident;
+    if (resident) {
+        this->mTrackedSize += entry.size;
+    } else {
+        this->mTrackedSize -= entry.size;
+        this->mEvictionCount++;
+    }
+}
+
+void
+MemoryBudget::touch(Tensor* tensor)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto iteratorIt = this->mEntryIterators.find(tensor);
+    if (iteratorIt == this->mEntryIterators.end()) {
+        return;
+    }
+
+    this->mEntries.splice(
+      this->mEntries.begin(), this->mEntries, iteratorIt->second);
+}
+
+std::shared_ptr<StagingRing>
+MemoryBudget::stagingRing()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (this->mStagingRing) {
+        return this->mStagingRing;
+    }
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute MemoryBudget staging ring requested after destroy");
+    }
+    if (!this->mQueue) {
+        throw std::runtime_error(
+          "Kompute MemoryBudget eviction requires a queue to transfer the "
+          "data of the tensors");
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryBudget creating staging ring for evictions");
+
+    this->mStagingRing =
+      std::make_shared<StagingRing>(this->mPhysicalDevice,
+                                    this->mDevice,
+                                    this->mQueue,
+                                    this->mQueueIndex,
+                                    KP_DEFAULT_STAGING_RING_SIZE,
+                                    this->mQueueMutex);
+
+    return this->mStagingRing;
+}
+
+void
+MemoryBudget::destroy()
+{
+    KP_LOG_DEBUG("Kompute MemoryBudget started destroy()");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (this->mStagingRing) {
+        this->mStagingRing->destroy();
+        this->mStagingRing = nullptr;
+    }
+
+    this->mQueue = nullptr;
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute MemoryBudget successful destroy()");
+}
+
+void
+MemoryBudget::queryHeaps(vk::DeviceSize* budget, vk::DeviceSize* usage)
+{
+    *budget = 0;
+    *usage = 0;
+
+    if (this->mBudgetExtension) {
+        vk::StructureChain<vk::PhysicalDeviceMemoryProperties2,
+                           vk::PhysicalDeviceMemoryBudgetPropertiesEXT>
+          propertiesChain = this->mPhysicalDevice->getMemoryProperties2<
+            vk::PhysicalDeviceMemoryProperties2,
+            vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+        const vk::PhysicalDeviceMemoryProperties& memoryProperties =
+          propertiesChain.get<vk::PhysicalDeviceMemoryProperties2>()
+            .memoryProperties;
+        const vk::PhysicalDeviceMemoryBudgetPropertiesEXT& budgetProperties =
+          propertiesChain.get<vk::PhysicalDeviceMemoryBudgetPropertiesEXT>();
+
+        for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+            if (memoryProperties.memoryHeaps[i].flags &
+                vk::MemoryHeapFlagBits::eDeviceLocal) {
+                *budget += budgetProperties.heapBudget[i];
+                *usage += budgetProperties.heapUsage[i];
+            }
+        }
+        return;
+    }
+
+    // Without the extension only the memory of the tracked tensors is known
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++) {
+        if (memoryProperties.memoryHeaps[i].flags &
+            vk::MemoryHeapFlagBits::eDeviceLocal) {
+            *budget += memoryProperties.memoryHeaps[i].size;
+        }
+    }
+    *usage = this->mTrackedSize;
+}
+
+} // End namespace kp
@@ -0,0 +1,383 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/MemoryPool.hpp"
+
+#include <algorithm>
+
+namespace kp {
+
+// Smallest buddy node handed out by the pool, which also bounds the number of
+// free lists per block to log2(blockSize / KP_MEMORY_POOL_MIN_NODE_SIZE)
+static const vk::DeviceSize KP_MEMORY_POOL_MIN_NODE_SIZE = 256;
+
+MemoryPool::MemoryPool(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                       std::shared_ptr<vk::Device> device,
+                       vk::DeviceSize blockSize)
+{
+    if (!physicalDevice) {
+        throw std::runtime_error("Kompute MemoryPool physical device is null");
+    }
+    if (!device) {
+        throw std::runtime_error("Kompute MemoryPool device is null");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+
+    this->mMemoryProperties = this->mPhysicalDevice->getMemoryProperties();
+
+    // Linear and non-linear resources must not share a page of
+    // bufferImageGranularity bytes, which is guaranteed by never placing
+    // them in the same block
+    this->mSeparateLinear = this->mPhysicalDevice->getProperties()
+                              .limits.bufferImageGranularity > 1;
+
+    // Buddy nodes are powers of two so the block size is rounded up
+    this->mBlockSize = KP_MEMORY_POOL_MIN_NODE_SIZE;
+    this->mMaxOrder = 0;
+    while (this->mBlockSize < blockSize) {
+        this->mBlockSize <<= 1;
+        this->mMaxOrder++;
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryPool created with block size {}, separate "
+                 "linear blocks: {}",
+                 this->mBlockSize,
+                 this->mSeparateLinear);
+}
+
+MemoryPool::~MemoryPool()
+{
+    KP_LOG_DEBUG("Kompute MemoryPool destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryPool destructor success");
+}
+
+MemoryPool::Allocation
+MemoryPool::allocate(const vk::MemoryRequirements& memoryRequirements,
+                     vk::MemoryPropertyFlags memoryPropertyFlags,
+                     bool linear)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute MemoryPool allocate called after pool was destroyed");
+    }
+
+    uint32_t memoryTypeIndex = this->findMemoryTypeIndex(
+      memoryRequirements.memoryTypeBits, memoryPropertyFlags);
+    bool blockLinear = linear || !this->mSeparateLinear;
+
+    // Buddy nodes are aligned to their own size, so requesting a node at
+    // least as big as the alignment satisfies it
+    vk::DeviceSize nodeSize =
+      std::max(memoryRequirements.size, memoryRequirements.alignment);
+
+    Allocation allocation;
+    allocation.size = memoryRequirements.size;
+
+    if (nodeSize > this->mBlockSize) {
+        KP_LOG_DEBUG("Kompute MemoryPool creating dedicated block of size {}",
+                     memoryRequirements.size);
+
+        Block* block = this->createBlock(
+          memoryTypeIndex, blockLinear, memoryRequirements.size, true);
+        block->allocationCount++;
+        this->mAllocationCount++;
+
+        allocation.memory = block->memory;
+        allocation.offset = 0;
+        allocation.mappedData = block->mappedData;
+        allocation.blockId = block->id;
+        return allocation;
+    }
+
+    uint32_t order = 0;
+    while ((KP_MEMORY_POOL_MIN_NODE_SIZE << order) < nodeSize) {
+        order++;
+    }
+
+    vk::DeviceSize offset = 0;
+    Block* target = nullptr;
+    for (auto& blockPair : this->mBlocks) {
+        Block& block = *blockPair.second;
+        if (block.dedicated || block.memoryTypeIndex != memoryTypeIndex ||
+            block.linear != blockLinear) {
+            continue;
+        }
+        if (this->allocateFromBlock(block, order, offset)) {
+            target = &block;
+            break;
+        }
+    }
+
+    if (!target) {
+        target = this->createBlock(
+          memoryTypeIndex, blockLinear, this->mBlockSize, false);
+        if (!this->allocateFromBlock(*target, order, offset)) {
+            throw std::runtime_error(
+              "Kompute MemoryPool failed to allocate from a new block");
+        }
+    }
+
+    target->allocationCount++;
+    this->mAllocationCount++;
+
+    allocation.memory = target->memory;
+    allocation.offset = offset;
+    allocation.blockId = target->id;
+    if (target->mappedData) {
+        allocation.mappedData = (uint8_t*)target->mappedData + offset;
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryPool allocated size {} at offset {} of block "
+                 "{} with memory type index {}",
+                 allocation.size,
+                 allocation.offset,
+                 allocation.blockId,
+                 memoryTypeIndex);
+
+    return allocation;
+}
+
+void
+MemoryPool::free(const Allocation& allocation)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto blockIt = this->mBlocks.find(allocation.blockId);
+    if (blockIt == this->mBlocks.end()) {
+        KP_LOG_WARN("Kompute MemoryPool free called with allocation of "
+                    "unknown block {}, ignoring",
+                    allocation.blockId);
+        return;
+    }
+
+    Block& block = *blockIt->second;
+
+    if (!block.dedicated) {
+        auto nodeIt = block.allocatedNodes.find(allocation.offset);
+        if (nodeIt == block.allocatedNodes.end()) {
+            KP_LOG_WARN("Kompute MemoryPool free called with unknown offset "
+                        "{} in block {}, ignoring",
+                        allocation.offset,
+                        allocation.blockId);
+            return;
+        }
+
+        uint32_t order = nodeIt->second;
+        vk::DeviceSize offset = nodeIt->first;
+        block.allocatedNodes.erase(nodeIt);
+
+        // Merge the node with its buddy for as long as the buddy is free
+        while (order < this->mMaxOrder) {
+            vk::DeviceSize buddy =
+              offset ^ (KP_MEMORY_POOL_MIN_NODE_SIZE << order);
+            auto buddyIt = block.freeNodes[order].find(buddy);
+            if (buddyIt == block.freeNodes[order].end()) {
+                break;
+            }
+            block.freeNodes[order].erase(buddyIt);
+            offset = std::min(offset, buddy);
+            order++;
+        }
+        block.freeNodes[order].insert(offset);
+    }
+
+    block.allocationCount--;
+    this->mAllocationCount--;
+
+    if (block.allocationCount > 0) {
+        return;
+    }
+
+    bool keepBlock = !block.dedicated;
+    if (keepBlock) {
+        for (auto& blockPair : this->mBlocks) {
+            const Block& other = *blockPair.second;
+            if (other.id != block.id && !other.dedicated &&
+                other.memoryTypeIndex == block.memoryTypeIndex &&
+                other.linear == block.linear) {
+                keepBlock = false;
+                break;
+            }
+        }
+    }
+
+    if (!keepBlock) {
+        this->destroyBlock(block.id);
+    }
+}
+
+void
+MemoryPool::destroy()
+{
+    KP_LOG_DEBUG("Kompute MemoryPool started destroy()");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN(
+          "Kompute MemoryPool destroy called with null Device pointer");
+        return;
+    }
+
+    if (this->mAllocationCount > 0) {
+        KP_LOG_WARN("Kompute MemoryPool destroying {} blocks with {} "
+                    "allocations still in use",
+                    this->mBlocks.size(),
+                    this->mAllocationCount);
+    }
+
+    while (!this->mBlocks.empty()) {
+        this->destroyBlock(this->mBlocks.begin()->first);
+    }
+    this->mAllocationCount = 0;
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute MemoryPool successful destroy()");
+}
+
+vk::DeviceSize
+MemoryPool::blockSize()
+{
+    return this->mBlockSize;
+}
+
+uint32_t
+MemoryPool::blockCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return static_cast<uint32_t>(this->mBlocks.size());
+}
+
+uint32_t
+MemoryPool::allocationCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mAllocationCount;
+}
+
+vk::DeviceSize
+MemoryPool::allocatedSize()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    vk::DeviceSize totalSize = 0;
+    for (const auto& blockPair : this->mBlocks) {
+        totalSize += blockPair.second->size;
+    }
+    return totalSize;
+}
+
+uint32_t
+MemoryPool::findMemoryTypeIndex(uint32_t memoryTypeBits,
+                                vk::MemoryPropertyFlags memoryPropertyFlags)
+{
+    for (uint32_t i = 0; i < this->mMemoryProperties.memoryTypeCount; i++) {
+        if (memoryTypeBits & (1 << i)) {
+            if (((this->mMemoryProperties.memoryTypes[i]).propertyFlags &
+                 memoryPropertyFlags) == memoryPropertyFlags) {
+                return i;
+            }
+        }
+    }
+
+    throw std::runtime_error(
+      "Kompute MemoryPool memory type index for allocation not found");
+}
+
+MemoryPool::Block*
+MemoryPool::createBlock(uint32_t memoryTypeIndex,
+                        bool linear,
+                        vk::DeviceSize size,
+                        bool dedicated)
+{
+    KP_LOG_DEBUG("Kompute MemoryPool allocating block of size {} with memory "
+                 "type index {}",
+                 size,
+                 memoryTypeIndex);
+
+    std::unique_ptr<Block> block{ new Block() };
+    block->id = this->mNextBlockId++;
+    block->memoryTypeIndex = memoryTypeIndex;
+    block->linear = linear;
+    block->dedicated = dedicated;
+    block->size = size;
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(size, memoryTypeIndex);
+    block->memory = this->mDevice->allocateMemory(memoryAllocateInfo);
+
+    if (this->mMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags &
+        vk::MemoryPropertyFlagBits::eHostVisible) {
+        block->mappedData = this->mDevice->mapMemory(
+          block->memory, 0, size, vk::MemoryMapFlags());
+    }
+
+    if (!dedicated) {
+        block->freeNodes.resize(this->mMaxOrder + 1);
+        block->freeNodes[this->mMaxOrder].insert(0);
+    }
+
+    Block* blockPtr = block.get();
+    this->mBlocks[block->id] = std::move(block);
+    return blockPtr;
+}
+
+void
+MemoryPool::destroyBlock(uint64_t blockId)
+{
+    auto blockIt = this->mBlocks.find(blockId);
+    if (blockIt == this->mBlocks.end()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute MemoryPool freeing block {} of size {}",
+                 blockId,
+                 blockIt->second->size);
+
+    if (blockIt->second->mappedData) {
+        this->mDevice->unmapMemory(blockIt->second->memory);
+    }
+    this->mDevice->freeMemory(
+      blockIt->second->memory,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    this->mBlocks.erase(blockIt);
+}
+
+bool
+MemoryPool::allocateFromBlock(Block& block,
+                              uint32_t order,
+                              vk::DeviceSize& offset)
+{
+    uint32_t currentOrder = order;
+    while (currentOrder <= this->mMaxOrder &&
+           block.freeNodes[currentOrder].empty()) {
+        currentOrder++;
+    }
+    if (currentOrder > this->mMaxOrder) {
+        return false;
+    }
+
+    auto nodeIt = block.freeNodes[currentOrder].begin();
+    offset = *nodeIt;
+    block.freeNodes[currentOrder].erase(nodeIt);
+
+    // Split the node down to the requested order, keeping the upper halves
+    while (currentOrder > order) {
+        currentOrder--;
+        block.freeNodes[currentOrder].insert(
+          offset + (KP_MEMORY_POOL_MIN_NODE_SIZE << currentOrder));
+    }
+
+    block.allocatedNodes[offset] = order;
+    return true;
+}
+
+} // End namespace kp
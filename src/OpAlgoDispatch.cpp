@@ -19,6 +19,8 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpAlgoDispatch record called");
 
+    BarrierBatch barrierBatch;
+
     // Barrier to ensure the data is finished writing to buffer memory
     for (const std::shared_ptr<Memory>& mem :
          this->mAlgorithm->getMemObjects()) {
@@ -29,7 +31,7 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
             std::shared_ptr<Image> image = std::static_pointer_cast<Image>(mem);
 
             image->recordPrimaryImageBarrier(
-              commandBuffer,
+              barrierBatch,
               vk::AccessFlagBits::eTransferWrite,
               vk::AccessFlagBits::eShaderRead,
               vk::PipelineStageFlagBits::eTransfer,
@@ -37,7 +39,7 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
               vk::ImageLayout::eGeneral);
         } else {
             mem->recordPrimaryMemoryBarrier(
-              commandBuffer,
+              barrierBatch,
               vk::AccessFlagBits::eTransferWrite,
               vk::AccessFlagBits::eShaderRead,
               vk::PipelineStageFlagBits::eTransfer,
@@ -45,6 +47,57 @@ OpAlgoDispatch::record(const vk::CommandBuffer& commandBuffer)
         }
     }
 
+    barrierBatch.flush(commandBuffer);
+
+    if (this->mPushConstantsSize) {
+        this->mAlgorithm->setPushConstants(
+          this->mPushConstantsData,
+          this->mPushConstantsSize,
+          this->mPushConstantsDataTypeMemorySize);
+    }
+
+    this->mAlgorithm->recordBindCore(commandBuffer);
+    this->mAlgorithm->recordBindPush(commandBuffer);
+    this->mAlgorithm->recordDispatch(commandBuffer);
+}
+
+void
+OpAlgoDispatch::recordTracked(const vk::CommandBuffer& commandBuffer,
+                              ResourceStateTracker& tracker)
+{
+    KP_LOG_DEBUG("Kompute OpAlgoDispatch recordTracked called");
+
+    const std::vector<std::shared_ptr<Memory>>& memObjects =
+      this->mAlgorithm->getMemObjects();
+
+    for (size_t i = 0; i < memObjects.size(); i++) {
+        vk::AccessFlags accessMask;
+        bool write = true;
+
+        switch (this->mAlgorithm->getBindingAccess(i)) {
+            case Algorithm::BindingAccess::eReadOnly:
+                accessMask = vk::AccessFlagBits::eShaderRead;
+                write = false;
+                break;
+            case Algorithm::BindingAccess::eWriteOnly:
+                accessMask = vk::AccessFlagBits::eShaderWrite;
+                break;
+            default:
+                accessMask = vk::AccessFlagBits::eShaderRead |
+                             vk::AccessFlagBits::eShaderWrite;
+                break;
+        }
+
+        // Images have to be in the eGeneral layout for imageLoad/imageStore
+        tracker.access(memObjects[i],
+                       vk::PipelineStageFlagBits::eComputeShader,
+                       accessMask,
+                       write,
+                       vk::ImageLayout::eGeneral);
+    }
+
+    tracker.flush(commandBuffer);
+
     if (this->mPushConstantsSize) {
         this->mAlgorithm->setPushConstants(
           this->mPushConstantsData,
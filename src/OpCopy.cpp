@@ -35,6 +35,34 @@ OpCopy::record(const vk::CommandBuffer& commandBuffer)
     }
 }
 
+void
+OpCopy::recordTracked(const vk::CommandBuffer& commandBuffer,
+                      ResourceStateTracker& tracker)
+{
+    KP_LOG_DEBUG("Kompute OpCopy recordTracked called");
+
+    tracker.access(this->mMemObjects[0],
+                   vk::PipelineStageFlagBits::eTransfer,
+                   vk::AccessFlagBits::eTransferRead,
+                   false,
+                   vk::ImageLayout::eTransferSrcOptimal);
+
+    for (size_t i = 1; i < this->mMemObjects.size(); i++) {
+        tracker.access(this->mMemObjects[i],
+                       vk::PipelineStageFlagBits::eTransfer,
+                       vk::AccessFlagBits::eTransferWrite,
+                       true,
+                       vk::ImageLayout::eTransferDstOptimal);
+    }
+
+    tracker.flush(commandBuffer);
+
+    for (size_t i = 1; i < this->mMemObjects.size(); i++) {
+        this->mMemObjects[i]->recordCopyFrom(commandBuffer,
+                                             this->mMemObjects[0]);
+    }
+}
+
 void
 OpCopy::preEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
@@ -45,26 +73,6 @@ void
 OpCopy::postEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
     KP_LOG_DEBUG("Kompute OpCopy postEval called");
-
-    // Do not copy on CPU side if source is storage memory
-    if (this->mMemObjects[0]->memoryType() ==
-        kp::Memory::MemoryTypes::eStorage) {
-        KP_LOG_DEBUG("Kompute OpCopy not copying tensor source given "
-                     "it's of eStorage type");
-        return;
-    }
-
-    // Copy the data from the first memory object into all the memory objects
-    for (size_t i = 1; i < this->mMemObjects.size(); i++) {
-        if (this->mMemObjects[i]->memoryType() ==
-            kp::Memory::MemoryTypes::eStorage) {
-            KP_LOG_DEBUG("Kompute OpCopy not copying to tensor dest "
-                         "given it's of eStorage type");
-            continue;
-        }
-        this->mMemObjects[i]->setData(this->mMemObjects[0]->rawData(),
-                                      this->mMemObjects[0]->memorySize());
-    }
 }
 
 }
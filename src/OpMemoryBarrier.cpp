@@ -31,10 +31,12 @@ OpMemoryBarrier::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpMemoryBarrier record called");
 
+    BarrierBatch barrierBatch;
+
     // Barrier to ensure the data is finished writing to buffer memory
     if (this->mBarrierOnPrimary) {
         for (const std::shared_ptr<Memory>& tensor : this->mMemObjects) {
-            tensor->recordPrimaryMemoryBarrier(commandBuffer,
+            tensor->recordPrimaryMemoryBarrier(barrierBatch,
                                                this->mSrcAccessMask,
                                                this->mDstAccessMask,
                                                this->mSrcStageMask,
@@ -42,13 +44,27 @@ OpMemoryBarrier::record(const vk::CommandBuffer& commandBuffer)
         }
     } else {
         for (const std::shared_ptr<Memory>& tensor : this->mMemObjects) {
-            tensor->recordStagingMemoryBarrier(commandBuffer,
+            tensor->recordStagingMemoryBarrier(barrierBatch,
                                                this->mSrcAccessMask,
                                                this->mDstAccessMask,
                                                this->mSrcStageMask,
                                                this->mDstStageMask);
         }
     }
+
+    // All the memory objects share the same masks so a single barrier
+    // command is recorded for all of them
+    barrierBatch.flush(commandBuffer);
+}
+
+void
+OpMemoryBarrier::recordTracked(const vk::CommandBuffer& commandBuffer,
+                               ResourceStateTracker& tracker)
+{
+    KP_LOG_DEBUG("Kompute OpMemoryBarrier recordTracked called");
+
+    this->record(commandBuffer);
+    tracker.reset();
 }
 
 void
@@ -17,6 +17,24 @@ OpSyncDevice::OpSyncDevice(
     this->mMemObjects = memObjects;
 }
 
+OpSyncDevice::OpSyncDevice(
+  const std::vector<std::shared_ptr<Memory>>& memObjects,
+  const std::vector<Tensor::Range>& ranges)
+  : OpSyncDevice(memObjects)
+{
+    KP_LOG_DEBUG("Kompute OpSyncDevice constructor with {} ranges",
+                 ranges.size());
+
+    for (const std::shared_ptr<Memory>& memObject : memObjects) {
+        if (memObject->type() != Memory::Type::eTensor) {
+            throw std::runtime_error(
+              "Kompute OpSyncDevice ranges are only supported on tensors");
+        }
+    }
+
+    this->mRanges = ranges;
+}
+
 OpSyncDevice::~OpSyncDevice() noexcept
 {
     KP_LOG_DEBUG("Kompute OpSyncDevice destructor started");
@@ -31,9 +49,67 @@ OpSyncDevice::record(const vk::CommandBuffer& commandBuffer)
 
     for (size_t i = 0; i < this->mMemObjects.size(); i++) {
         if (this->mMemObjects[i]->memoryType() ==
+              Tensor::MemoryTypes::eDevice &&
+            !this->mMemObjects[i]->usesStagingRing()) {
+            this->recordCopy(commandBuffer, this->mMemObjects[i]);
+        }
+    }
+}
+
+void
+OpSyncDevice::recordTracked(const vk::CommandBuffer& commandBuffer,
+                            ResourceStateTracker& tracker)
+{
+    KP_LOG_DEBUG("Kompute OpSyncDevice recordTracked called");
+
+    std::vector<std::shared_ptr<Memory>> copyMemObjects;
+
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (this->mMemObjects[i]->memoryType() !=
             Tensor::MemoryTypes::eDevice) {
-            this->mMemObjects[i]->recordCopyFromStagingToDevice(commandBuffer);
+            continue;
+        }
+
+        bool usesStagingRing = this->mMemObjects[i]->usesStagingRing();
+
+        // The staging ring transfer is submitted before the sequence
+        if (usesStagingRing && tracker.accessed(this->mMemObjects[i])) {
+            throw std::runtime_error(
+              "Kompute OpSyncDevice cannot stream a memory object through the "
+              "staging ring after it was accessed in the same recording");
+        }
+
+        // Memory objects using the staging ring are checked when streamed
+        if (!usesStagingRing && tracker.residency(this->mMemObjects[i]) ==
+                                  Memory::Residency::eCoherent) {
+            KP_LOG_DEBUG("Kompute OpSyncDevice skipping coherent memory");
+            continue;
         }
+
+        // Memory objects using the staging ring are written before the
+        // sequence is submitted, which is declared as a transfer write
+        // without layout transition so later accesses wait for it
+        tracker.access(this->mMemObjects[i],
+                       vk::PipelineStageFlagBits::eTransfer,
+                       vk::AccessFlagBits::eTransferWrite,
+                       true,
+                       usesStagingRing ? vk::ImageLayout::eUndefined
+                                       : vk::ImageLayout::eTransferDstOptimal);
+
+        if (this->syncsWholeMemory(this->mMemObjects[i])) {
+            tracker.setResidency(this->mMemObjects[i],
+                                 Memory::Residency::eCoherent);
+        }
+
+        if (!usesStagingRing) {
+            copyMemObjects.push_back(this->mMemObjects[i]);
+        }
+    }
+
+    tracker.flush(commandBuffer);
+
+    for (size_t i = 0; i < copyMemObjects.size(); i++) {
+        this->recordCopy(commandBuffer, copyMemObjects[i]);
     }
 }
 
@@ -41,6 +117,25 @@ void
 OpSyncDevice::preEval(const vk::CommandBuffer& /*commandBuffer*/)
 {
     KP_LOG_DEBUG("Kompute OpSyncDevice preEval called");
+
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (!this->mMemObjects[i]->usesStagingRing() ||
+            this->mMemObjects[i]->residency() ==
+              Memory::Residency::eCoherent) {
+            continue;
+        }
+
+        if (this->mRanges.empty()) {
+            this->mMemObjects[i]->streamToDevice();
+        } else {
+            std::static_pointer_cast<Tensor>(this->mMemObjects[i])
+              ->streamToDevice(this->mRanges);
+        }
+
+        if (this->syncsWholeMemory(this->mMemObjects[i])) {
+            this->mMemObjects[i]->setResidency(Memory::Residency::eCoherent);
+        }
+    }
 }
 
 void
@@ -49,4 +144,26 @@ OpSyncDevice::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     KP_LOG_DEBUG("Kompute OpSyncDevice postEval called");
 }
 
+bool
+OpSyncDevice::syncsWholeMemory(const std::shared_ptr<Memory>& memObject)
+{
+    if (!this->mRanges.empty()) {
+        return false;
+    }
+    return memObject->type() != Memory::Type::eTensor ||
+           !std::static_pointer_cast<Tensor>(memObject)->isView();
+}
+
+void
+OpSyncDevice::recordCopy(const vk::CommandBuffer& commandBuffer,
+                         const std::shared_ptr<Memory>& memObject)
+{
+    if (this->mRanges.empty()) {
+        memObject->recordCopyFromStagingToDevice(commandBuffer);
+    } else {
+        std::static_pointer_cast<Tensor>(memObject)
+          ->recordCopyFromStagingToDevice(commandBuffer, this->mRanges);
+    }
+}
+
 }
@@ -18,6 +18,23 @@ OpSyncLocal::OpSyncLocal(const std::vector<std::shared_ptr<Memory>>& memObjects)
     this->mMemObjects = memObjects;
 }
 
+OpSyncLocal::OpSyncLocal(const std::vector<std::shared_ptr<Memory>>& memObjects,
+                         const std::vector<Tensor::Range>& ranges)
+  : OpSyncLocal(memObjects)
+{
+    KP_LOG_DEBUG("Kompute OpSyncLocal constructor with {} ranges",
+                 ranges.size());
+
+    for (const std::shared_ptr<Memory>& memObject : memObjects) {
+        if (memObject->type() != Memory::Type::eTensor) {
+            throw std::runtime_error(
+              "Kompute OpSyncLocal ranges are only supported on tensors");
+        }
+    }
+
+    this->mRanges = ranges;
+}
+
 OpSyncLocal::~OpSyncLocal() noexcept
 {
     KP_LOG_DEBUG("Kompute OpSyncLocal destructor started");
@@ -28,27 +45,95 @@ OpSyncLocal::record(const vk::CommandBuffer& commandBuffer)
 {
     KP_LOG_DEBUG("Kompute OpSyncLocal record called");
 
+    BarrierBatch barrierBatch;
+
     for (size_t i = 0; i < this->mMemObjects.size(); i++) {
         if (this->mMemObjects[i]->memoryType() ==
-            Memory::MemoryTypes::eDevice) {
-
+              Memory::MemoryTypes::eDevice &&
+            !this->mMemObjects[i]->usesStagingRing()) {
             this->mMemObjects[i]->recordPrimaryMemoryBarrier(
-              commandBuffer,
+              barrierBatch,
               vk::AccessFlagBits::eShaderWrite,
               vk::AccessFlagBits::eTransferRead,
               vk::PipelineStageFlagBits::eComputeShader,
               vk::PipelineStageFlagBits::eTransfer);
+        }
+    }
 
-            this->mMemObjects[i]->recordCopyFromDeviceToStaging(commandBuffer);
+    barrierBatch.flush(commandBuffer);
+
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (this->mMemObjects[i]->memoryType() ==
+              Memory::MemoryTypes::eDevice &&
+            !this->mMemObjects[i]->usesStagingRing()) {
+
+            this->recordCopy(commandBuffer, this->mMemObjects[i]);
 
             this->mMemObjects[i]->recordPrimaryMemoryBarrier(
-              commandBuffer,
+              barrierBatch,
               vk::AccessFlagBits::eTransferWrite,
               vk::AccessFlagBits::eHostRead,
               vk::PipelineStageFlagBits::eTransfer,
               vk::PipelineStageFlagBits::eHost);
         }
     }
+
+    barrierBatch.flush(commandBuffer);
+}
+
+void
+OpSyncLocal::recordTracked(const vk::CommandBuffer& commandBuffer,
+                           ResourceStateTracker& tracker)
+{
+    KP_LOG_DEBUG("Kompute OpSyncLocal recordTracked called");
+
+    std::vector<std::shared_ptr<Memory>> copyMemObjects;
+
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (this->mMemObjects[i]->memoryType() !=
+              Memory::MemoryTypes::eDevice ||
+            this->mMemObjects[i]->usesStagingRing()) {
+            continue;
+        }
+
+        if (tracker.residency(this->mMemObjects[i]) ==
+            Memory::Residency::eCoherent) {
+            KP_LOG_DEBUG("Kompute OpSyncLocal skipping coherent memory");
+            continue;
+        }
+
+        tracker.access(this->mMemObjects[i],
+                       vk::PipelineStageFlagBits::eTransfer,
+                       vk::AccessFlagBits::eTransferRead,
+                       false,
+                       vk::ImageLayout::eTransferSrcOptimal);
+
+        if (this->syncsWholeMemory(this->mMemObjects[i])) {
+            tracker.setResidency(this->mMemObjects[i],
+                                 Memory::Residency::eCoherent);
+        }
+
+        copyMemObjects.push_back(this->mMemObjects[i]);
+    }
+
+    tracker.flush(commandBuffer);
+
+    BarrierBatch barrierBatch;
+
+    for (size_t i = 0; i < copyMemObjects.size(); i++) {
+        this->recordCopy(commandBuffer, copyMemObjects[i]);
+
+        // The staging memory is not tracked as it is only accessed by the
+        // copies of the sync operations and by the host
+        copyMemObjects[i]->recordStagingMemoryBarrier(
+          barrierBatch,
+          vk::AccessFlagBits::eTransferWrite,
+          vk::AccessFlagBits::eHostRead,
+          vk::PipelineStageFlagBits::eTransfer,
+          vk::PipelineStageFlagBits::eHost);
+    }
+
+    barrierBatch.flush(commandBuffer);
 }
 
 void
@@ -63,6 +148,47 @@ OpSyncLocal::postEval(const vk::CommandBuffer& /*commandBuffer*/)
     KP_LOG_DEBUG("Kompute OpSyncLocal postEval called");
 
     KP_LOG_DEBUG("Kompute OpSyncLocal mapping data into tensor local");
+
+    for (size_t i = 0; i < this->mMemObjects.size(); i++) {
+        if (!this->mMemObjects[i]->usesStagingRing() ||
+            this->mMemObjects[i]->residency() ==
+              Memory::Residency::eCoherent) {
+            continue;
+        }
+
+        if (this->mRanges.empty()) {
+            this->mMemObjects[i]->streamFromDevice();
+        } else {
+            std::static_pointer_cast<Tensor>(this->mMemObjects[i])
+              ->streamFromDevice(this->mRanges);
+        }
+
+        if (this->syncsWholeMemory(this->mMemObjects[i])) {
+            this->mMemObjects[i]->setResidency(Memory::Residency::eCoherent);
+        }
+    }
+}
+
+bool
+OpSyncLocal::syncsWholeMemory(const std::shared_ptr<Memory>& memObject)
+{
+    if (!this->mRanges.empty()) {
+        return false;
+    }
+    return memObject->type() != Memory::Type::eTensor ||
+           !std::static_pointer_cast<Tensor>(memObject)->isView();
+}
+
+void
+OpSyncLocal::recordCopy(const vk::CommandBuffer& commandBuffer,
+                        const std::shared_ptr<Memory>& memObject)
+{
+    if (this->mRanges.empty()) {
+        memObject->recordCopyFromDeviceToStaging(commandBuffer);
+    } else {
+        std::static_pointer_cast<Tensor>(memObject)
+          ->recordCopyFromDeviceToStaging(commandBuffer, this->mRanges);
+    }
 }
 
 }
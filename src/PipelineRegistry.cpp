@@ -0,0 +1,245 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/PipelineRegistry.hpp"
+
+namespace kp {
+
+// 64 bit FNV-1a, which is enough to spread keys over the hash map buckets as
+// keys are compared in full on lookup
+static const uint64_t KP_PIPELINE_REGISTRY_HASH_OFFSET =
+  14695981039346656037ull;
+static const uint64_t KP_PIPELINE_REGISTRY_HASH_PRIME = 1099511628211ull;
+
+static uint64_t
+hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= KP_PIPELINE_REGISTRY_HASH_PRIME;
+    }
+    return hash;
+}
+
+bool
+PipelineRegistry::Key::operator==(const Key& other) const
+{
+    return this->hash == other.hash &&
+           this->pushConstantsMemorySize == other.pushConstantsMemorySize &&
+           this->specializationConstantsDataTypeMemorySize ==
+             other.specializationConstantsDataTypeMemorySize &&
+           this->descriptorTypes == other.descriptorTypes &&
+           this->specializationConstantsData ==
+             other.specializationConstantsData &&
+           this->spirv == other.spirv;
+}
+
+PipelineRegistry::PipelineRegistry(std::shared_ptr<vk::Device> device)
+{
+    if (!device) {
+        throw std::runtime_error("Kompute PipelineRegistry device is null");
+    }
+
+    this->mDevice = device;
+}
+
+PipelineRegistry::~PipelineRegistry()
+{
+    KP_LOG_DEBUG("Kompute PipelineRegistry destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry destructor success");
+}
+
+PipelineRegistry::Key
+PipelineRegistry::createKey(
+  const std::vector<uint32_t>& spirv,
+  const std::vector<vk::DescriptorType>& descriptorTypes,
+  const void* specializationConstantsData,
+  uint32_t specializationConstantsDataTypeMemorySize,
+  uint32_t specializationConstantsSize,
+  uint32_t pushConstantsMemorySize)
+{
+    Key key;
+    key.spirv = spirv;
+    key.descriptorTypes = descriptorTypes;
+    if (specializationConstantsData) {
+        const uint8_t* specializationConstantsBytes =
+          (const uint8_t*)specializationConstantsData;
+        key.specializationConstantsData.assign(
+          specializationConstantsBytes,
+          specializationConstantsBytes +
+            specializationConstantsDataTypeMemorySize *
+              specializationConstantsSize);
+    }
+    key.specializationConstantsDataTypeMemorySize =
+      specializationConstantsDataTypeMemorySize;
+    key.pushConstantsMemorySize = pushConstantsMemorySize;
+
+    uint64_t hash = KP_PIPELINE_REGISTRY_HASH_OFFSET;
+    hash = hashBytes(
+      hash, key.spirv.data(), key.spirv.size() * sizeof(uint32_t));
+    hash = hashBytes(hash,
+                     key.descriptorTypes.data(),
+                     key.descriptorTypes.size() * sizeof(vk::DescriptorType));
+    hash = hashBytes(hash,
+                     key.specializationConstantsData.data(),
+                     key.specializationConstantsData.size());
+    hash = hashBytes(hash,
+                     &key.specializationConstantsDataTypeMemorySize,
+                     sizeof(key.specializationConstantsDataTypeMemorySize));
+    hash = hashBytes(hash,
+                     &key.pushConstantsMemorySize,
+                     sizeof(key.pushConstantsMemorySize));
+    key.hash = hash;
+
+    return key;
+}
+
+bool
+PipelineRegistry::acquire(const Key& key, Entry& entry)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto entryIt = this->mEntries.find(key);
+    if (entryIt == this->mEntries.end()) {
+        return false;
+    }
+
+    entryIt->second.refCount++;
+    this->mHitCount++;
+    entry = entryIt->second.entry;
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry acquired pipeline with hash {}, "
+                 "references: {}",
+                 key.hash,
+                 entryIt->second.refCount);
+
+    return true;
+}
+
+bool
+PipelineRegistry::insert(const Key& key, const Entry& entry)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute PipelineRegistry insert called after registry was "
+          "destroyed");
+    }
+
+    if (this->mEntries.count(key)) {
+        KP_LOG_DEBUG("Kompute PipelineRegistry pipeline with hash {} already "
+                     "registered",
+                     key.hash);
+        return false;
+    }
+
+    RegisteredEntry& registeredEntry = this->mEntries[key];
+    registeredEntry.entry = entry;
+    registeredEntry.refCount = 1;
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry registered pipeline with hash {}",
+                 key.hash);
+
+    return true;
+}
+
+void
+PipelineRegistry::release(const Key& key)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    auto entryIt = this->mEntries.find(key);
+    if (entryIt == this->mEntries.end()) {
+        KP_LOG_WARN("Kompute PipelineRegistry release called with unknown "
+                    "pipeline with hash {}, ignoring",
+                    key.hash);
+        return;
+    }
+
+    entryIt->second.refCount--;
+    if (entryIt->second.refCount > 0) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry destroying pipeline with hash {}",
+                 key.hash);
+
+    this->destroyEntry(entryIt->second.entry);
+    this->mEntries.erase(entryIt);
+}
+
+void
+PipelineRegistry::destroy()
+{
+    KP_LOG_DEBUG("Kompute PipelineRegistry started destroy()");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN(
+          "Kompute PipelineRegistry destroy called with null Device pointer");
+        return;
+    }
+
+    if (this->mEntries.size()) {
+        KP_LOG_DEBUG("Kompute PipelineRegistry destroying {} pipelines",
+                     this->mEntries.size());
+    }
+
+    for (auto& entryPair : this->mEntries) {
+        this->destroyEntry(entryPair.second.entry);
+    }
+    this->mEntries.clear();
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute PipelineRegistry successful destroy()");
+}
+
+uint32_t
+PipelineRegistry::size()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return static_cast<uint32_t>(this->mEntries.size());
+}
+
+uint64_t
+PipelineRegistry::hitCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mHitCount;
+}
+
+void
+PipelineRegistry::destroyEntry(Entry& entry)
+{
+    if (entry.pipeline) {
+        this->mDevice->destroy(
+          *entry.pipeline,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    if (entry.pipelineLayout) {
+        this->mDevice->destroy(
+          *entry.pipelineLayout,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    if (entry.shaderModule) {
+        this->mDevice->destroy(
+          *entry.shaderModule,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    if (entry.descriptorSetLayout) {
+        this->mDevice->destroy(
+          *entry.descriptorSetLayout,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    }
+    entry = Entry();
+}
+
+} // End namespace kp
@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/Quantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define KOMPUTE_QUANTIZATION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace kp {
+
+namespace {
+
+// Copies the elements of a block, padding the elements past the end with zeros
+const float*
+loadBlock(const float* data,
+          uint64_t elementCount,
+          uint64_t block,
+          float* padded)
+{
+    uint64_t offset = block * BlockInt8::blockSize;
+    if (offset + BlockInt8::blockSize <= elementCount) {
+        return data + offset;
+    }
+    uint64_t count = offset < elementCount ? elementCount - offset : 0;
+    std::fill(padded, padded + BlockInt8::blockSize, 0.0f);
+    if (count) {
+        memcpy(padded, data + offset, count * sizeof(float));
+    }
+    return padded;
+}
+
+float
+blockAbsMax(const float* values)
+{
+#ifdef KOMPUTE_QUANTIZATION_SSE2
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 max = _mm_setzero_ps();
+    for (uint32_t i = 0; i < BlockInt8::blockSize; i += 4) {
+        max = _mm_max_ps(max, _mm_and_ps(_mm_loadu_ps(values + i), absMask));
+    }
+    max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+    max = _mm_max_ss(max, _mm_shuffle_ps(max, max, 1));
+    return _mm_cvtss_f32(max);
+#else
+    float max = 0.0f;
+    for (uint32_t i = 0; i < BlockInt8::blockSize; i++) {
+        max = std::max(max, std::fabs(values[i]));
+    }
+    return max;
+#endif
+}
+
+// Scales and rounds to nearest even the values clamped to [-127, 127]
+void
+quantizeInt8Values(const float* values, float inverse, int8_t* quantized)
+{
+#ifdef KOMPUTE_QUANTIZATION_SSE2
+    const __m128 scale = _mm_set1_ps(inverse);
+    const __m128 min = _mm_set1_ps(-127.0f);
+    const __m128 max = _mm_set1_ps(127.0f);
+    for (uint32_t i = 0; i < BlockInt8::blockSize; i += 16) {
+        __m128i rounded[4];
+        for (uint32_t j = 0; j < 4; j++) {
+            __m128 scaled = _mm_mul_ps(_mm_loadu_ps(values + i + j * 4), scale);
+            scaled = _mm_min_ps(_mm_max_ps(scaled, min), max);
+            rounded[j] = _mm_cvtps_epi32(scaled);
+        }
+        __m128i low = _mm_packs_epi32(rounded[0], rounded[1]);
+        __m128i high = _mm_packs_epi32(rounded[2], rounded[3]);
+        _mm_storeu_si128((__m128i*)(quantized + i),
+                         _mm_packs_epi16(low, high));
+    }
+#else
+    for (uint32_t i = 0; i < BlockInt8::blockSize; i++) {
+        float scaled = std::min(std::max(values[i] * inverse, -127.0f), 127.0f);
+        quantized[i] = (int8_t)std::nearbyint(scaled);
+    }
+#endif
+}
+
+// Scales and rounds to nearest even the values clamped to [-8, 7], and packs
+// them offset by 8 with the second half of the block in the high 4 bits
+void
+quantizeInt4Values(const float* values, float inverse, uint8_t* quantized)
+{
+    const uint32_t half = BlockInt4::blockSize / 2;
+#ifdef KOMPUTE_QUANTIZATION_SSE2
+    const __m128 scale = _mm_set1_ps(inverse);
+    const __m128 min = _mm_set1_ps(-8.0f);
+    const __m128 max = _mm_set1_ps(7.0f);
+    const __m128i offset = _mm_set1_epi16(8);
+    __m128i packed[2];
+    for (uint32_t i = 0; i < 2; i++) {
+        __m128i rounded[4];
+        for (uint32_t j = 0; j < 4; j++) {
+            __m128 scaled =
+              _mm_mul_ps(_mm_loadu_ps(values + i * half + j * 4), scale);
+            scaled = _mm_min_ps(_mm_max_ps(scaled, min), max);
+            rounded[j] = _mm_cvtps_epi32(scaled);
+        }
+        __m128i low =
+          _mm_add_epi16(_mm_packs_epi32(rounded[0], rounded[1]), offset);
+        __m128i high =
+          _mm_add_epi16(_mm_packs_epi32(rounded[2], rounded[3]), offset);
+        packed[i] = _mm_packus_epi16(low, high);
+    }
+    // The values are below 16 so the shift does not cross bytes
+    _mm_storeu_si128(
+      (__m128i*)quantized,
+      _mm_or_si128(packed[0], _mm_slli_epi16(packed[1], 4)));
+#else
+    for (uint32_t i = 0; i < half; i++) {
+        float low = std::min(std::max(values[i] * inverse, -8.0f), 7.0f);
+        float high =
+          std::min(std::max(values[i + half] * inverse, -8.0f), 7.0f);
+        quantized[i] = (uint8_t)((int32_t)std::nearbyint(low) + 8) |
+                       (uint8_t)(((int32_t)std::nearbyint(high) + 8) << 4);
+    }
+#endif
+}
+
+uint64_t
+evenBlockCount(uint64_t elementCount)
+{
+    const uint64_t pairSize = 2 * BlockInt8::blockSize;
+    return (elementCount + pairSize - 1) / pairSize * 2;
+}
+
+} // End anonymous namespace
+
+uint64_t
+BlockInt8::blockCount(uint64_t elementCount)
+{
+    return evenBlockCount(elementCount);
+}
+
+void
+BlockInt8::quantize(const float* data, uint64_t elementCount, BlockInt8* blocks)
+{
+    float padded[BlockInt8::blockSize];
+    for (uint64_t i = 0; i < BlockInt8::blockCount(elementCount); i++) {
+        const float* values = loadBlock(data, elementCount, i, padded);
+
+        blocks[i].scale = Half(blockAbsMax(values) / 127.0f);
+        // The rounded scale is used so the values make up for its rounding
+        float scale = blocks[i].scale;
+        quantizeInt8Values(
+          values, scale ? 1.0f / scale : 0.0f, blocks[i].values);
+    }
+}
+
+void
+BlockInt8::dequantize(const BlockInt8* blocks, uint64_t blockCount, float* data)
+{
+    for (uint64_t i = 0; i < blockCount; i++) {
+        float scale = blocks[i].scale;
+        for (uint32_t j = 0; j < BlockInt8::blockSize; j++) {
+            data[i * BlockInt8::blockSize + j] = blocks[i].values[j] * scale;
+        }
+    }
+}
+
+std::vector<BlockInt8>
+BlockInt8::quantize(const std::vector<float>& data)
+{
+    std::vector<BlockInt8> blocks(BlockInt8::blockCount(data.size()));
+    BlockInt8::quantize(data.data(), data.size(), blocks.data());
+    return blocks;
+}
+
+std::vector<float>
+BlockInt8::dequantize(const std::vector<BlockInt8>& blocks)
+{
+    std::vector<float> data(blocks.size() * BlockInt8::blockSize);
+    BlockInt8::dequantize(blocks.data(), blocks.size(), data.data());
+    return data;
+}
+
+uint64_t
+BlockInt4::blockCount(uint64_t elementCount)
+{
+    return evenBlockCount(elementCount);
+}
+
+void
+BlockInt4::quantize(const float* data, uint64_t elementCount, BlockInt4* blocks)
+{
+    float padded[BlockInt4::blockSize];
+    for (uint64_t i = 0; i < BlockInt4::blockCount(elementCount); i++) {
+        const float* values = loadBlock(data, elementCount, i, padded);
+
+        // The sign of the element of largest magnitude is kept so it maps to
+        // -8 rather than being clamped to 7
+        float absMax = blockAbsMax(values);
+        float max = 0.0f;
+        for (uint32_t j = 0; j < BlockInt4::blockSize; j++) {
+            if (std::fabs(values[j]) == absMax) {
+                max = values[j];
+                break;
+            }
+        }
+
+        blocks[i].scale = Half(max / -8.0f);
+        float scale = blocks[i].scale;
+        quantizeInt4Values(
+          values, scale ? 1.0f / scale : 0.0f, blocks[i].values);
+    }
+}
+
+void
+BlockInt4::dequantize(const BlockInt4* blocks, uint64_t blockCount, float* data)
+{
+    const uint32_t half = BlockInt4::blockSize / 2;
+    for (uint64_t i = 0; i < blockCount; i++) {
+        float scale = blocks[i].scale;
+        float* values = data + i * BlockInt4::blockSize;
+        for (uint32_t j = 0; j < half; j++) {
+            values[j] = ((blocks[i].values[j] & 0xf) - 8) * scale;
+            values[j + half] = ((blocks[i].values[j] >> 4) - 8) * scale;
+        }
+    }
+}
+
+std::vector<BlockInt4>
+BlockInt4::quantize(const std::vector<float>& data)
+{
+    std::vector<BlockInt4> blocks(BlockInt4::blockCount(data.size()));
+    BlockInt4::quantize(data.data(), data.size(), blocks.data());
+    return blocks;
+}
+
+std::vector<float>
+BlockInt4::dequantize(const std::vector<BlockInt4>& blocks)
+{
+    std::vector<float> data(blocks.size() * BlockInt4::blockSize);
+    BlockInt4::dequantize(blocks.data(), blocks.size(), data.data());
+    return data;
+}
+
+} // End namespace kp
@@ -0,0 +1,313 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/ResourceStateTracker.hpp"
+
+namespace kp {
+
+void
+ResourceStateTracker::access(const std::shared_ptr<Memory>& memory,
+                             vk::PipelineStageFlags stageMask,
+                             vk::AccessFlags accessMask,
+                             bool write,
+                             vk::ImageLayout layout)
+{
+    const void* resource = ResourceStateTracker::primaryResource(memory);
+
+    // Restores the memory object if it was evicted, before recording any
+    // command referring to its buffer
+    this->residencyState(memory);
+
+    auto stateIt = this->mStates.find(resource);
+    if (stateIt == this->mStates.end()) {
+        // Anything could have been recorded before the tracker was reset, so
+        // the memory is assumed to have been written by any transfer or shader
+        State state;
+        state.writeStageMask = vk::PipelineStageFlagBits::eTransfer |
+                               vk::PipelineStageFlagBits::eComputeShader;
+        state.writeAccessMask = vk::AccessFlagBits::eTransferWrite |
+                                vk::AccessFlagBits::eShaderWrite;
+        stateIt = this->mStates.emplace(resource, state).first;
+    }
+    State& state = stateIt->second;
+
+    bool transition = false;
+    if (memory->type() == Memory::Type::eImage &&
+        layout != vk::ImageLayout::eUndefined) {
+        std::shared_ptr<Image> image = std::static_pointer_cast<Image>(memory);
+        transition = image->getPrimaryImageLayout() != layout;
+    }
+
+    vk::PipelineStageFlags srcStageMask;
+    vk::AccessFlags srcAccessMask;
+    bool barrier = false;
+
+    if (write || transition) {
+        // Writes and layout transitions have to wait for the previous write
+        // and for all the reads since then to complete
+        srcStageMask = state.writeStageMask | state.readStageMask;
+        srcAccessMask = state.writeAccessMask;
+        barrier = transition || (bool)srcStageMask;
+    } else if (state.writeStageMask &&
+               ((bool)(stageMask & ~state.visibleStageMask) ||
+                (bool)(accessMask & ~state.visibleAccessMask))) {
+        srcStageMask = state.writeStageMask;
+        srcAccessMask = state.writeAccessMask;
+        barrier = true;
+    }
+
+    if (barrier) {
+        if (!srcStageMask) {
+            srcStageMask = vk::PipelineStageFlagBits::eTopOfPipe;
+        }
+        this->addBarrier(
+          memory, srcStageMask, srcAccessMask, stageMask, accessMask, layout);
+    }
+
+    if (write) {
+        ResidencyState& residencyState = this->residencyState(memory);
+        residencyState.residency = Memory::Residency::eDeviceDirty;
+        residencyState.changed = true;
+
+        state.writeStageMask = stageMask;
+        state.writeAccessMask = accessMask;
+        state.visibleStageMask = vk::PipelineStageFlags();
+        state.visibleAccessMask = vk::AccessFlags();
+        state.readStageMask = vk::PipelineStageFlags();
+    } else if (transition) {
+        // The layout transition is only visible to the access it was recorded
+        // for, later reads from other stages still have to wait for it
+        state.writeStageMask = stageMask;
+        state.writeAccessMask = vk::AccessFlags();
+        state.visibleStageMask = stageMask;
+        state.visibleAccessMask = accessMask;
+        state.readStageMask = stageMask;
+    } else {
+        if (barrier) {
+            state.visibleStageMask |= stageMask;
+            state.visibleAccessMask |= accessMask;
+        }
+        state.readStageMask |= stageMask;
+    }
+}
+
+void
+ResourceStateTracker::flush(const vk::CommandBuffer& commandBuffer)
+{
+    if (this->mBarrierBatch.empty()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute ResourceStateTracker recording {} memory barriers",
+                 this->mBarrierBatch.size());
+
+    this->mBarrierBatch.flush(commandBuffer);
+    this->mPipelineBarrierCount++;
+}
+
+void
+ResourceStateTracker::reset()
+{
+    KP_LOG_DEBUG("Kompute ResourceStateTracker reset");
+
+    this->mStates.clear();
+    this->mBarrierBatch.clear();
+}
+
+bool
+ResourceStateTracker::accessed(const std::shared_ptr<Memory>& memory) const
+{
+    return this->mResidencyInvalidated ||
+           this->mResidencyStates.count(
+             ResourceStateTracker::primaryResource(memory)) != 0;
+}
+
+Memory::Residency
+ResourceStateTracker::residency(const std::shared_ptr<Memory>& memory)
+{
+    ResidencyState& residencyState = this->residencyState(memory);
+
+    // Only the residency before the recording can change between evaluations
+    if (!residencyState.changed) {
+        residencyState.queried = true;
+    }
+
+    return residencyState.residency;
+}
+
+void
+ResourceStateTracker::setResidency(const std::shared_ptr<Memory>& memory,
+                                   Memory::Residency residency)
+{
+    ResidencyState& residencyState = this->residencyState(memory);
+    residencyState.residency = residency;
+    residencyState.changed = true;
+}
+
+void
+ResourceStateTracker::invalidateResidency()
+{
+    KP_LOG_DEBUG("Kompute ResourceStateTracker invalidating residency");
+
+    for (auto& residencyIt : this->mResidencyStates) {
+        ResidencyState& residencyState = residencyIt.second;
+        residencyState.residency = Memory::Residency::eDeviceDirty;
+        residencyState.changed = true;
+    }
+    this->mResidencyInvalidated = true;
+}
+
+bool
+ResourceStateTracker::residencyChanged()
+{
+    for (auto& residencyIt : this->mResidencyStates) {
+        const ResidencyState& residencyState = residencyIt.second;
+        if (residencyState.queried && residencyState.recordedResidency !=
+                                        residencyState.memory->residency()) {
+            return true;
+        }
+        if (residencyState.memory->type() == Memory::Type::eTensor) {
+            std::shared_ptr<Tensor> tensor =
+              std::static_pointer_cast<Tensor>(residencyState.memory);
+            if (tensor->isEvicted() || tensor->getPrimaryBufferGeneration() !=
+                                         residencyState.generation) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void
+ResourceStateTracker::applyResidency()
+{
+    // The memory objects written by the commands recorded without declaring
+    // their accesses may not have been accessed by the recording
+    if (this->mResidencyInvalidated) {
+        Memory::invalidateResidency();
+    }
+
+    for (auto& residencyIt : this->mResidencyStates) {
+        const ResidencyState& residencyState = residencyIt.second;
+        if (residencyState.changed) {
+            residencyState.memory->setResidency(residencyState.residency);
+        }
+    }
+}
+
+void
+ResourceStateTracker::resetResidency()
+{
+    this->unpinMemory();
+    this->mResidencyStates.clear();
+    this->mResidencyInvalidated = false;
+}
+
+void
+ResourceStateTracker::pinMemory()
+{
+    for (auto& residencyIt : this->mResidencyStates) {
+        ResidencyState& residencyState = residencyIt.second;
+        if (!residencyState.pinned &&
+            residencyState.memory->type() == Memory::Type::eTensor) {
+            std::static_pointer_cast<Tensor>(residencyState.memory)->pin();
+            residencyState.pinned = true;
+        }
+    }
+}
+
+void
+ResourceStateTracker::unpinMemory()
+{
+    for (auto& residencyIt : this->mResidencyStates) {
+        ResidencyState& residencyState = residencyIt.second;
+        if (residencyState.pinned) {
+            std::static_pointer_cast<Tensor>(residencyState.memory)->unpin();
+            residencyState.pinned = false;
+        }
+    }
+}
+
+uint32_t
+ResourceStateTracker::barrierCount() const
+{
+    return this->mBarrierCount;
+}
+
+uint32_t
+ResourceStateTracker::pipelineBarrierCount() const
+{
+    return this->mPipelineBarrierCount;
+}
+
+void
+ResourceStateTracker::addBarrier(const std::shared_ptr<Memory>& memory,
+                                 vk::PipelineStageFlags srcStageMask,
+                                 vk::AccessFlags srcAccessMask,
+                                 vk::PipelineStageFlags dstStageMask,
+                                 vk::AccessFlags dstAccessMask,
+                                 vk::ImageLayout layout)
+{
+    if (memory->type() == Memory::Type::eImage &&
+        layout != vk::ImageLayout::eUndefined) {
+        std::shared_ptr<Image> image = std::static_pointer_cast<Image>(memory);
+        image->recordPrimaryImageBarrier(this->mBarrierBatch,
+                                         srcAccessMask,
+                                         dstAccessMask,
+                                         srcStageMask,
+                                         dstStageMask,
+                                         layout);
+    } else {
+        memory->recordPrimaryMemoryBarrier(this->mBarrierBatch,
+                                           srcAccessMask,
+                                           dstAccessMask,
+                                           srcStageMask,
+                                           dstStageMask);
+    }
+
+    this->mBarrierCount++;
+}
+
+ResourceStateTracker::ResidencyState&
+ResourceStateTracker::residencyState(const std::shared_ptr<Memory>& memory)
+{
+    const void* resource = ResourceStateTracker::primaryResource(memory);
+
+    auto residencyIt = this->mResidencyStates.find(resource);
+    if (residencyIt == this->mResidencyStates.end()) {
+        ResidencyState residencyState;
+        residencyState.memory = memory;
+
+        if (memory->type() == Memory::Type::eTensor) {
+            std::shared_ptr<Tensor> tensor =
+              std::static_pointer_cast<Tensor>(memory);
+            tensor->restore();
+            tensor->pin();
+            residencyState.pinned = true;
+            residencyState.generation = tensor->getPrimaryBufferGeneration();
+        }
+
+        residencyState.recordedResidency = memory->residency();
+        residencyState.residency = residencyState.recordedResidency;
+
+        // Commands recorded without declaring their accesses may have
+        // written the memory object before the recording accessed it
+        if (this->mResidencyInvalidated) {
+            residencyState.residency = Memory::Residency::eDeviceDirty;
+            residencyState.changed = true;
+        }
+        residencyIt =
+          this->mResidencyStates.emplace(resource, residencyState).first;
+    }
+    return residencyIt->second;
+}
+
+const void*
+ResourceStateTracker::primaryResource(const std::shared_ptr<Memory>& memory)
+{
+    if (memory->type() == Memory::Type::eImage) {
+        return std::static_pointer_cast<Image>(memory)->getPrimaryImage().get();
+    }
+    return std::static_pointer_cast<Tensor>(memory)->getPrimaryBuffer().get();
+}
+
+} // End namespace kp
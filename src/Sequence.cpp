@@ -2,27 +2,53 @@
 
 #include "kompute/Sequence.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+#include <utility>
+
 namespace kp {
 
 Sequence::Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                    std::shared_ptr<vk::Device> device,
                    std::shared_ptr<vk::Queue> computeQueue,
                    uint32_t queueIndex,
-                   uint32_t totalTimestamps) noexcept
+                   uint32_t totalTimestamps,
+                   bool timelineSemaphores,
+                   uint32_t slotCount,
+                   std::shared_ptr<std::mutex> queueMutex) noexcept
 {
     KP_LOG_DEBUG("Kompute Sequence Constructor with existing device & queue");
 
     this->mPhysicalDevice = physicalDevice;
     this->mDevice = device;
     this->mComputeQueue = computeQueue;
+    this->mQueueMutex =
+      queueMutex ? queueMutex : std::make_shared<std::mutex>();
     this->mQueueIndex = queueIndex;
-    this->mFence = this->mDevice->createFence(vk::FenceCreateInfo());
+    this->mTimelineSemaphores = timelineSemaphores;
+    if (this->mTimelineSemaphores) {
+        vk::SemaphoreTypeCreateInfo semaphoreTypeInfo(
+          vk::SemaphoreType::eTimeline, 0);
+        vk::SemaphoreCreateInfo semaphoreInfo;
+        semaphoreInfo.setPNext(&semaphoreTypeInfo);
+        this->mTimelineSemaphore =
+          this->mDevice->createSemaphore(semaphoreInfo);
+    }
 
     this->createCommandPool();
-    this->createCommandBuffer();
-    if (totalTimestamps > 0)
-        this->createTimestampQueryPool(totalTimestamps +
-                                       1); //+1 for the first one
+
+    this->mSlots.resize(std::max(slotCount, 1u));
+    for (uint32_t i = 0; i < this->mSlots.size(); i++) {
+        this->activateSlot(i);
+        this->mFence = this->mDevice->createFence(vk::FenceCreateInfo());
+        this->mResourceStateTracker = std::make_shared<ResourceStateTracker>();
+        this->createCommandBuffer();
+        if (totalTimestamps > 0)
+            this->createTimestampQueryPool(totalTimestamps +
+                                           1); //+1 for the first one
+    }
+    this->activateSlot(0);
 }
 
 Sequence::~Sequence() noexcept
@@ -44,15 +70,24 @@ Sequence::begin()
         return;
     }
 
-    if (this->isRunning()) {
-        throw std::runtime_error(
-          "Kompute Sequence begin called when sequence still running");
+    if (this->mIsRunning) {
+        if (this->mSlots.size() == 1) {
+            throw std::runtime_error(
+              "Kompute Sequence begin called when sequence still running");
+        }
+        // The command buffer of the slot is reused once its previous
+        // submission completed
+        this->awaitSlot();
     }
 
     KP_LOG_INFO("Kompute Sequence command now started recording");
     this->mCommandBuffer->begin(vk::CommandBufferBeginInfo());
     this->mRecording = true;
 
+    // Accesses recorded before are not known by the new command buffer
+    this->mResourceStateTracker->reset();
+    this->mResourceStateTracker->resetResidency();
+
     // latch the first timestamp before any commands are submitted
     if (this->timestampQueryPool)
         this->mCommandBuffer->writeTimestamp(
@@ -66,7 +101,7 @@ Sequence::end()
 {
     KP_LOG_DEBUG("Kompute Sequence calling END");
 
-    if (this->isRunning()) {
+    if (this->mIsRunning) {
         throw std::runtime_error(
           "Kompute Sequence begin called when sequence still running");
     }
@@ -81,11 +116,72 @@ Sequence::end()
     }
 }
 
+std::shared_ptr<Sequence>
+Sequence::waitOn(std::shared_ptr<Sequence> sequence,
+                 vk::PipelineStageFlags waitStageMask)
+{
+    KP_LOG_DEBUG("Kompute Sequence waitOn called");
+
+    if (!sequence) {
+        throw std::runtime_error(
+          "Kompute Sequence waitOn called with a null sequence");
+    }
+    if (sequence.get() == this) {
+        throw std::runtime_error(
+          "Kompute Sequence waitOn called with the sequence itself");
+    }
+    if (!this->mDevice || sequence->mDevice != this->mDevice) {
+        throw std::runtime_error(
+          "Kompute Sequence waitOn requires both sequences to be created on "
+          "the same device");
+    }
+    if (!this->mTimelineSemaphores && sequence->mSlots.size() > 1) {
+        throw std::runtime_error(
+          "Kompute Sequence waitOn requires timeline semaphores to wait on a "
+          "sequence with more than one slot");
+    }
+
+    for (Dependency& dependency : this->mDependencies) {
+        if (dependency.sequence == sequence) {
+            dependency.waitStageMask = waitStageMask;
+            return shared_from_this();
+        }
+    }
+
+    Dependency dependency;
+    dependency.sequence = sequence;
+    dependency.waitStageMask = waitStageMask;
+    if (!this->mTimelineSemaphores) {
+        dependency.link = std::make_shared<SemaphoreLink>();
+        sequence->mSignalLinks.push_back(dependency.link);
+    }
+    this->mDependencies.push_back(dependency);
+
+    return shared_from_this();
+}
+
+void
+Sequence::clearDependencies()
+{
+    KP_LOG_DEBUG("Kompute Sequence clearDependencies called");
+
+    if (this->isRunning()) {
+        throw std::runtime_error("Kompute Sequence clearDependencies called "
+                                 "when sequence still running");
+    }
+
+    this->destroyDependencies();
+}
+
 void
 Sequence::clear()
 {
     KP_LOG_DEBUG("Kompute Sequence calling clear");
     this->mOperations.clear();
+    this->mRecorded = false;
+    for (Slot& slot : this->mSlots) {
+        slot.recorded = false;
+    }
     if (this->isRecording()) {
         this->end();
     }
@@ -109,31 +205,24 @@ Sequence::eval(std::shared_ptr<OpBase> op)
 std::shared_ptr<Sequence>
 Sequence::evalAsync()
 {
-    if (this->isRecording()) {
-        this->end();
-    }
-
-    if (this->mIsRunning) {
-        throw std::runtime_error(
-          "Kompute Sequence evalAsync called when an eval async was "
-          "called without successful wait");
-    }
-
-    this->mIsRunning = true;
+    this->acquireSlot();
+    this->prepareEval();
 
-    for (size_t i = 0; i < this->mOperations.size(); i++) {
-        this->mOperations[i]->preEval(*this->mCommandBuffer);
-    }
-
-    vk::SubmitInfo submitInfo(
-      0, nullptr, nullptr, 1, this->mCommandBuffer.get());
+    SubmitSemaphores semaphores;
+    vk::SubmitInfo submitInfo = this->createSubmitInfo(semaphores);
 
     KP_LOG_DEBUG(
       "Kompute sequence submitting command buffer into compute queue");
 
     this->mDevice->resetFences({ this->mFence });
 
-    this->mComputeQueue->submit(1, &submitInfo, this->mFence);
+    this->mSubmitFence = this->mFence;
+    {
+        std::lock_guard<std::mutex> queueLock(*this->mQueueMutex);
+        this->mComputeQueue->submit(1, &submitInfo, this->mFence);
+    }
+
+    this->advanceSlot();
 
     return shared_from_this();
 }
@@ -150,33 +239,336 @@ Sequence::evalAsync(std::shared_ptr<OpBase> op)
 std::shared_ptr<Sequence>
 Sequence::evalAwait(uint64_t waitFor)
 {
-    if (!this->mIsRunning) {
+    if (!this->isRunning()) {
         KP_LOG_WARN("Kompute Sequence evalAwait called without existing eval");
         return shared_from_this();
     }
 
-    vk::Result result =
-      this->mDevice->waitForFences(1, &this->mFence, VK_TRUE, waitFor);
-
-    this->mIsRunning = false;
+    std::vector<vk::Fence> fences = this->getRunningFences();
+    vk::Result result = this->mDevice->waitForFences(
+      static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, waitFor);
 
     if (result == vk::Result::eTimeout) {
         KP_LOG_WARN("Kompute Sequence evalAwait reached timeout of {}",
                     waitFor);
+        this->finishRunningSlots(false);
         return shared_from_this();
     }
 
-    for (size_t i = 0; i < this->mOperations.size(); i++) {
-        this->mOperations[i]->postEval(*this->mCommandBuffer);
-    }
+    this->finishRunningSlots(true);
 
     return shared_from_this();
 }
 
+void
+Sequence::evalAsyncBatch(
+  const std::vector<std::shared_ptr<Sequence>>& sequences)
+{
+    KP_LOG_DEBUG("Kompute Sequence evalAsyncBatch called with {} sequences",
+                 sequences.size());
+
+    if (sequences.empty()) {
+        KP_LOG_WARN(
+          "Kompute Sequence evalAsyncBatch called without sequences");
+        return;
+    }
+
+    // Checked before preparing any sequence so an invalid batch leaves all
+    // the sequences untouched
+    std::unordered_set<const Sequence*> batched;
+    for (const std::shared_ptr<Sequence>& sequence : sequences) {
+        if (!sequence || !sequence->isInit()) {
+            throw std::runtime_error(
+              "Kompute Sequence evalAsyncBatch called with a sequence that is "
+              "not initialised");
+        }
+        if (sequence->mComputeQueue != sequences[0]->mComputeQueue) {
+            throw std::runtime_error(
+              "Kompute Sequence evalAsyncBatch requires all the sequences to "
+              "submit to the same queue");
+        }
+        // Sequences with several slots await the next slot if needed
+        if (sequence->mSlots.size() == 1 && sequence->mIsRunning) {
+            throw std::runtime_error(
+              "Kompute Sequence evalAsyncBatch called with a sequence that "
+              "is still running");
+        }
+        if (sequence->mPendingFollowers > 0) {
+            throw std::runtime_error(
+              "Kompute Sequence evalAsyncBatch called with a sequence whose "
+              "previous batch was not awaited");
+        }
+        if (!batched.insert(sequence.get()).second) {
+            throw std::runtime_error(
+              "Kompute Sequence evalAsyncBatch called with the same sequence "
+              "more than once");
+        }
+    }
+
+    // Prepared in order so the sequences of the batch depending on an
+    // earlier one see the residency left by its submission
+    size_t prepared = 0;
+    try {
+        for (; prepared < sequences.size(); prepared++) {
+            sequences[prepared]->acquireSlot();
+            sequences[prepared]->prepareEval();
+        }
+    } catch (...) {
+        // The sequences prepared so far are not submitted
+        for (size_t i = 0; i < prepared; i++) {
+            sequences[i]->abortEval();
+        }
+        throw;
+    }
+
+    // Created in order so the sequences of the batch waiting on an earlier
+    // one wait on its submission in this batch
+    std::vector<SubmitSemaphores> semaphores(sequences.size());
+    std::vector<vk::SubmitInfo> submitInfos;
+    submitInfos.reserve(sequences.size());
+    for (size_t i = 0; i < sequences.size(); i++) {
+        submitInfos.push_back(sequences[i]->createSubmitInfo(semaphores[i]));
+    }
+
+    const std::shared_ptr<Sequence>& leader = sequences[0];
+    vk::Fence fence = leader->mFence;
+    for (size_t i = 0; i < sequences.size(); i++) {
+        if (i > 0) {
+            sequences[i]->mSubmitLeader = leader;
+            leader->mPendingFollowers++;
+        }
+        sequences[i]->mSubmitFence = fence;
+    }
+
+    KP_LOG_DEBUG("Kompute Sequence submitting {} command buffers into compute "
+                 "queue",
+                 submitInfos.size());
+
+    leader->mDevice->resetFences({ fence });
+
+    {
+        std::lock_guard<std::mutex> queueLock(*leader->mQueueMutex);
+        leader->mComputeQueue->submit(
+          static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), fence);
+    }
+
+    for (const std::shared_ptr<Sequence>& sequence : sequences) {
+        sequence->advanceSlot();
+    }
+}
+
+void
+Sequence::evalAwaitBatch(
+  const std::vector<std::shared_ptr<Sequence>>& sequences,
+  uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Sequence evalAwaitBatch called with {} sequences",
+                 sequences.size());
+
+    std::vector<std::shared_ptr<Sequence>> running;
+    std::vector<vk::Fence> fences;
+    for (const std::shared_ptr<Sequence>& sequence : sequences) {
+        if (!sequence || !sequence->isRunning()) {
+            KP_LOG_WARN("Kompute Sequence evalAwaitBatch called with a "
+                        "sequence without existing eval");
+            continue;
+        }
+        running.push_back(sequence);
+
+        // The sequences of a batch share the fence of its first sequence
+        for (const vk::Fence& fence : sequence->getRunningFences()) {
+            if (std::find(fences.begin(), fences.end(), fence) ==
+                fences.end()) {
+                fences.push_back(fence);
+            }
+        }
+    }
+
+    if (running.empty()) {
+        return;
+    }
+
+    vk::Result result = running[0]->mDevice->waitForFences(
+      static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, waitFor);
+
+    bool completed = result != vk::Result::eTimeout;
+    if (!completed) {
+        KP_LOG_WARN("Kompute Sequence evalAwaitBatch reached timeout of {}",
+                    waitFor);
+    }
+
+    for (const std::shared_ptr<Sequence>& sequence : running) {
+        sequence->finishRunningSlots(completed);
+    }
+}
+
+int32_t
+Sequence::waitAny(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                  uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Sequence waitAny called with {} sequences",
+                 sequences.size());
+
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+    while (true) {
+        // A sequence with several running slots is only complete once its
+        // last submission completed, so the wait is on the oldest submission
+        // of each sequence that did not complete yet
+        std::shared_ptr<vk::Device> device;
+        std::vector<vk::Fence> fences;
+        for (size_t i = 0; i < sequences.size(); i++) {
+            const std::shared_ptr<Sequence>& sequence = sequences[i];
+            if (!sequence || !sequence->isRunning()) {
+                continue;
+            }
+
+            bool complete = true;
+            for (const vk::Fence& fence : sequence->getRunningFences()) {
+                if (sequence->mDevice->getFenceStatus(fence) !=
+                    vk::Result::eSuccess) {
+                    if (std::find(fences.begin(), fences.end(), fence) ==
+                        fences.end()) {
+                        fences.push_back(fence);
+                    }
+                    complete = false;
+                    break;
+                }
+            }
+            if (complete) {
+                return static_cast<int32_t>(i);
+            }
+            device = sequence->mDevice;
+        }
+
+        if (!device) {
+            KP_LOG_WARN("Kompute Sequence waitAny called without any "
+                        "sequence running");
+            return -1;
+        }
+
+        uint64_t timeout = waitFor;
+        if (waitFor != UINT64_MAX) {
+            uint64_t elapsed = static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+            timeout = elapsed < waitFor ? waitFor - elapsed : 0;
+        }
+
+        vk::Result result =
+          device->waitForFences(static_cast<uint32_t>(fences.size()),
+                                fences.data(),
+                                VK_FALSE,
+                                timeout);
+
+        if (result == vk::Result::eTimeout) {
+            return -1;
+        }
+    }
+}
+
+bool
+Sequence::waitAll(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                  uint64_t waitFor)
+{
+    KP_LOG_DEBUG("Kompute Sequence waitAll called with {} sequences",
+                 sequences.size());
+
+    std::shared_ptr<vk::Device> device;
+    std::vector<vk::Fence> fences;
+    for (const std::shared_ptr<Sequence>& sequence : sequences) {
+        if (!sequence || !sequence->isRunning()) {
+            continue;
+        }
+        device = sequence->mDevice;
+
+        // The sequences of a batch share the fence of its first sequence
+        for (const vk::Fence& fence : sequence->getRunningFences()) {
+            if (std::find(fences.begin(), fences.end(), fence) ==
+                fences.end()) {
+                fences.push_back(fence);
+            }
+        }
+    }
+
+    if (!device) {
+        return true;
+    }
+
+    vk::Result result = device->waitForFences(
+      static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, waitFor);
+
+    return result != vk::Result::eTimeout;
+}
+
+bool
+Sequence::isComplete() const
+{
+    if (!this->isRunning()) {
+        return true;
+    }
+
+    for (const vk::Fence& fence : this->getRunningFences()) {
+        if (this->mDevice->getFenceStatus(fence) != vk::Result::eSuccess) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 Sequence::isRunning() const
 {
-    return this->mIsRunning;
+    if (this->mIsRunning) {
+        return true;
+    }
+    for (const Slot& slot : this->mSlots) {
+        if (slot.isRunning) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t
+Sequence::slotCount() const
+{
+    return static_cast<uint32_t>(this->mSlots.size());
+}
+
+std::vector<vk::Fence>
+Sequence::getRunningFences() const
+{
+    std::vector<vk::Fence> fences;
+
+    // Starts from the active slot, whose members are not in its entry
+    for (uint32_t i = 0; i < this->mSlots.size(); i++) {
+        size_t slotIndex = (this->mSlotIndex + i) % this->mSlots.size();
+        bool isRunning = i == 0 ? this->mIsRunning
+                                : this->mSlots[slotIndex].isRunning;
+        vk::Fence fence = i == 0 ? this->mSubmitFence
+                                 : this->mSlots[slotIndex].submitFence;
+        if (isRunning &&
+            std::find(fences.begin(), fences.end(), fence) == fences.end()) {
+            fences.push_back(fence);
+        }
+    }
+
+    return fences;
+}
+
+vk::Semaphore
+Sequence::getTimelineSemaphore() const
+{
+    return this->mTimelineSemaphore;
+}
+
+uint64_t
+Sequence::getTimelineValue() const
+{
+    return this->mTimelineValue;
 }
 
 bool
@@ -195,12 +587,24 @@ Sequence::isInit() const
 void
 Sequence::rerecord()
 {
-    this->end();
+    if (this->isRecording()) {
+        this->end();
+    }
     std::vector<std::shared_ptr<OpBase>> ops = this->mOperations;
     this->mOperations.clear();
+
+    // Only the command buffer of the active slot is recorded again
+    std::vector<bool> recorded;
+    for (const Slot& slot : this->mSlots) {
+        recorded.push_back(slot.recorded);
+    }
+    this->mRecorded = !ops.empty();
     for (const std::shared_ptr<kp::OpBase>& op : ops) {
         this->record(op);
     }
+    for (size_t i = 0; i < this->mSlots.size(); i++) {
+        this->mSlots[i].recorded = recorded[i];
+    }
 }
 
 void
@@ -214,25 +618,54 @@ Sequence::destroy()
         return;
     }
 
-    if (this->mFence) {
-        this->mDevice->destroy(
-          this->mFence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-    }
+    // The binary semaphores of the sequences waiting on this one are owned
+    // by them, which stop being signalled
+    this->destroyDependencies();
+    this->mSignalLinks.clear();
 
-    if (this->mFreeCommandBuffer) {
-        KP_LOG_INFO("Freeing CommandBuffer");
-        if (!this->mCommandBuffer) {
-            KP_LOG_WARN("Kompute Sequence destroy called with null "
-                        "CommandPool pointer");
-            return;
+    for (uint32_t i = 0; i < this->mSlots.size(); i++) {
+        this->activateSlot(i);
+
+        // Releases the memory objects pinned by the recorded operations
+        this->mResourceStateTracker->resetResidency();
+        this->releaseSubmitLeader();
+        this->mSubmittedOperations.clear();
+
+        if (this->mFence) {
+            this->mDevice->destroy(
+              this->mFence,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            this->mFence = vk::Fence();
+        }
+
+        if (this->mFreeCommandBuffer && this->mCommandBuffer) {
+            KP_LOG_INFO("Freeing CommandBuffer");
+            this->mDevice->freeCommandBuffers(
+              *this->mCommandPool, 1, this->mCommandBuffer.get());
+
+            this->mCommandBuffer = nullptr;
+
+            KP_LOG_DEBUG("Kompute Sequence Freed CommandBuffer");
         }
-        this->mDevice->freeCommandBuffers(
-          *this->mCommandPool, 1, this->mCommandBuffer.get());
 
-        this->mCommandBuffer = nullptr;
-        this->mFreeCommandBuffer = false;
+        if (this->timestampQueryPool) {
+            KP_LOG_INFO("Destroying QueryPool");
+            this->mDevice->destroy(
+              *this->timestampQueryPool,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
 
-        KP_LOG_DEBUG("Kompute Sequence Freed CommandBuffer");
+            this->timestampQueryPool = nullptr;
+            KP_LOG_DEBUG("Kompute Sequence Destroyed QueryPool");
+        }
+    }
+    this->activateSlot(0);
+    this->mFreeCommandBuffer = false;
+
+    if (this->mTimelineSemaphore) {
+        this->mDevice->destroy(
+          this->mTimelineSemaphore,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mTimelineSemaphore = vk::Semaphore();
     }
 
     if (this->mFreeCommandPool) {
@@ -257,16 +690,6 @@ Sequence::destroy()
         this->mOperations.clear();
     }
 
-    if (this->timestampQueryPool) {
-        KP_LOG_INFO("Destroying QueryPool");
-        this->mDevice->destroy(
-          *this->timestampQueryPool,
-          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-
-        this->timestampQueryPool = nullptr;
-        KP_LOG_DEBUG("Kompute Sequence Destroyed QueryPool");
-    }
-
     if (this->mDevice) {
         this->mDevice = nullptr;
     }
@@ -283,15 +706,29 @@ Sequence::record(std::shared_ptr<OpBase> op)
 {
     KP_LOG_DEBUG("Kompute Sequence record function started");
 
+    // The operations recorded so far are recorded again into the slot
+    // first, as the command buffers of the slots are always submitted with
+    // all the operations of the sequence
+    if (this->mSlots.size() > 1 && !this->isRecording() &&
+        !this->mOperations.empty()) {
+        this->rerecord();
+    }
+
     this->begin();
 
     KP_LOG_DEBUG(
       "Kompute Sequence running record on OpBase derived class instance");
 
-    op->record(*this->mCommandBuffer);
+    op->recordTracked(*this->mCommandBuffer, *this->mResourceStateTracker);
 
     this->mOperations.push_back(op);
 
+    // The other slots hold the operation once recorded into them as well
+    this->mRecorded = true;
+    for (Slot& slot : this->mSlots) {
+        slot.recorded = false;
+    }
+
     if (this->timestampQueryPool)
         this->mCommandBuffer->writeTimestamp(
           vk::PipelineStageFlagBits::eAllCommands,
@@ -301,6 +738,336 @@ Sequence::record(std::shared_ptr<OpBase> op)
     return shared_from_this();
 }
 
+void
+Sequence::acquireSlot()
+{
+    // The sequences of its last batch still wait on the fence of the slot
+    if (this->mPendingFollowers > 0) {
+        throw std::runtime_error(
+          "Kompute Sequence evaluated again before the sequences of its "
+          "batch were awaited");
+    }
+
+    if (this->mSlots.size() == 1) {
+        return;
+    }
+
+    // The slots are submitted in order, so the active one is the oldest and
+    // is only still running when all the slots are
+    if (this->mIsRunning) {
+        KP_LOG_DEBUG("Kompute Sequence waiting for slot {} to complete",
+                     this->mSlotIndex);
+        this->awaitSlot();
+    }
+
+    if (!this->mRecorded) {
+        KP_LOG_DEBUG("Kompute Sequence recording operations into slot {}",
+                     this->mSlotIndex);
+        this->rerecord();
+        // Submitted without operations if they were all cleared
+        this->begin();
+        this->mRecorded = true;
+    }
+}
+
+void
+Sequence::prepareEval()
+{
+    // The residency left by the sequences waited on is only applied when
+    // they are awaited, which is after this sequence is submitted
+    for (const Dependency& dependency : this->mDependencies) {
+        if (dependency.sequence->isRunning()) {
+            dependency.sequence->applyRunningResidency();
+        }
+    }
+
+    // The transfers recorded by sync operations depend on the residency of
+    // the memory objects when they were recorded
+    if (!this->isRecording() && !this->mIsRunning &&
+        this->mResourceStateTracker->residencyChanged()) {
+        KP_LOG_DEBUG("Kompute Sequence recording again as the residency of "
+                     "its memory objects changed");
+        this->rerecord();
+    }
+
+    if (this->isRecording()) {
+        this->end();
+    }
+
+    if (this->mIsRunning) {
+        throw std::runtime_error(
+          "Kompute Sequence evalAsync called when an eval async was "
+          "called without successful wait");
+    }
+
+    this->mIsRunning = true;
+    this->mSubmittedOperations = this->mOperations;
+
+    // The tensors used by the operations cannot be evicted while running
+    this->mResourceStateTracker->pinMemory();
+
+    try {
+        for (size_t i = 0; i < this->mOperations.size(); i++) {
+            this->mOperations[i]->preEval(*this->mCommandBuffer);
+        }
+    } catch (...) {
+        this->abortEval();
+        throw;
+    }
+}
+
+void
+Sequence::abortEval()
+{
+    KP_LOG_DEBUG("Kompute Sequence aborting eval that was not submitted");
+
+    this->mIsRunning = false;
+    this->mSubmittedOperations.clear();
+    this->mResourceStateTracker->unpinMemory();
+}
+
+void
+Sequence::completeEval()
+{
+    this->mResourceStateTracker->applyResidency();
+
+    for (size_t i = 0; i < this->mSubmittedOperations.size(); i++) {
+        this->mSubmittedOperations[i]->postEval(*this->mCommandBuffer);
+    }
+    this->mSubmittedOperations.clear();
+
+    this->mResourceStateTracker->unpinMemory();
+
+    // The binary semaphores waited by the submission can be signalled again
+    for (const WaitedSemaphore& waited : this->mWaitedSemaphores) {
+        waited.link->available.push_back(waited.semaphore);
+    }
+    this->mWaitedSemaphores.clear();
+}
+
+void
+Sequence::abandonEval()
+{
+    KP_LOG_DEBUG("Kompute Sequence abandoning eval that did not complete");
+
+    // The submission still executes, so the residency it results in is
+    // applied, while the postEval of the operations is skipped
+    this->mResourceStateTracker->applyResidency();
+    this->mSubmittedOperations.clear();
+
+    // The tensors cannot stay pinned until the next submission of the slot
+    this->mResourceStateTracker->unpinMemory();
+}
+
+void
+Sequence::releaseSubmitLeader()
+{
+    if (this->mSubmitLeader) {
+        this->mSubmitLeader->mPendingFollowers--;
+        this->mSubmitLeader = nullptr;
+    }
+}
+
+vk::SubmitInfo
+Sequence::createSubmitInfo(SubmitSemaphores& semaphores)
+{
+    for (const Dependency& dependency : this->mDependencies) {
+        if (dependency.link) {
+            // Nothing to wait on if the sequence was not submitted since the
+            // previous submission of this one
+            if (!dependency.link->signalled) {
+                continue;
+            }
+            semaphores.waitSemaphores.push_back(dependency.link->signalled);
+            semaphores.waitValues.push_back(0);
+            this->mWaitedSemaphores.push_back(
+              { dependency.link, dependency.link->signalled });
+            dependency.link->signalled = vk::Semaphore();
+        } else {
+            const Sequence& sequence = *dependency.sequence;
+            if (!sequence.mTimelineSemaphore || !sequence.mTimelineValue) {
+                continue;
+            }
+            semaphores.waitSemaphores.push_back(sequence.mTimelineSemaphore);
+            semaphores.waitValues.push_back(sequence.mTimelineValue);
+        }
+        semaphores.waitStageMasks.push_back(dependency.waitStageMask);
+    }
+
+    if (this->mTimelineSemaphore) {
+        semaphores.signalSemaphores.push_back(this->mTimelineSemaphore);
+        semaphores.signalValues.push_back(++this->mTimelineValue);
+    }
+
+    for (const std::shared_ptr<SemaphoreLink>& link : this->mSignalLinks) {
+        // Not waited on since the previous submission, which completed as
+        // the sequence was awaited before being submitted again
+        if (link->signalled) {
+            this->mDevice->destroy(
+              link->signalled,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        }
+        if (link->available.empty()) {
+            link->signalled =
+              this->mDevice->createSemaphore(vk::SemaphoreCreateInfo());
+        } else {
+            link->signalled = link->available.back();
+            link->available.pop_back();
+        }
+        semaphores.signalSemaphores.push_back(link->signalled);
+        semaphores.signalValues.push_back(0);
+    }
+
+    vk::SubmitInfo submitInfo(
+      static_cast<uint32_t>(semaphores.waitSemaphores.size()),
+      semaphores.waitSemaphores.data(),
+      semaphores.waitStageMasks.data(),
+      1,
+      this->mCommandBuffer.get(),
+      static_cast<uint32_t>(semaphores.signalSemaphores.size()),
+      semaphores.signalSemaphores.data());
+
+    // Binary semaphores ignore the values provided for them
+    if (this->mTimelineSemaphores) {
+        semaphores.timelineSubmitInfo = vk::TimelineSemaphoreSubmitInfo(
+          static_cast<uint32_t>(semaphores.waitValues.size()),
+          semaphores.waitValues.data(),
+          static_cast<uint32_t>(semaphores.signalValues.size()),
+          semaphores.signalValues.data());
+        submitInfo.setPNext(&semaphores.timelineSubmitInfo);
+    }
+
+    return submitInfo;
+}
+
+void
+Sequence::destroyDependencies()
+{
+    // The semaphores waited by the slots belong to the links destroyed below
+    uint32_t slotIndex = this->mSlotIndex;
+    for (uint32_t i = 0; i < this->mSlots.size(); i++) {
+        this->activateSlot(i);
+        for (const WaitedSemaphore& waited : this->mWaitedSemaphores) {
+            this->mDevice->destroy(
+              waited.semaphore,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        }
+        this->mWaitedSemaphores.clear();
+    }
+    this->activateSlot(slotIndex);
+
+    for (const Dependency& dependency : this->mDependencies) {
+        if (!dependency.link) {
+            continue;
+        }
+
+        std::vector<std::shared_ptr<SemaphoreLink>>& signalLinks =
+          dependency.sequence->mSignalLinks;
+        signalLinks.erase(
+          std::remove(signalLinks.begin(), signalLinks.end(), dependency.link),
+          signalLinks.end());
+
+        std::vector<vk::Semaphore> linkSemaphores = dependency.link->available;
+        linkSemaphores.push_back(dependency.link->signalled);
+        for (const vk::Semaphore& semaphore : linkSemaphores) {
+            if (semaphore) {
+                this->mDevice->destroy(
+                  semaphore,
+                  (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            }
+        }
+    }
+    this->mDependencies.clear();
+}
+
+void
+Sequence::swapSlot(Slot& slot)
+{
+    std::swap(this->mCommandBuffer, slot.commandBuffer);
+    std::swap(this->mFence, slot.fence);
+    std::swap(this->timestampQueryPool, slot.timestampQueryPool);
+    std::swap(this->mResourceStateTracker, slot.resourceStateTracker);
+    std::swap(this->mRecording, slot.recording);
+    std::swap(this->mIsRunning, slot.isRunning);
+    std::swap(this->mSubmitLeader, slot.submitLeader);
+    std::swap(this->mSubmitFence, slot.submitFence);
+    std::swap(this->mSubmittedOperations, slot.submittedOperations);
+    std::swap(this->mRecorded, slot.recorded);
+    std::swap(this->mWaitedSemaphores, slot.waitedSemaphores);
+}
+
+void
+Sequence::activateSlot(uint32_t slotIndex)
+{
+    if (slotIndex == this->mSlotIndex) {
+        return;
+    }
+
+    // Stores the members of the active slot in its entry, which is left
+    // empty once the members of the other slot are loaded from its entry
+    this->swapSlot(this->mSlots[this->mSlotIndex]);
+    this->swapSlot(this->mSlots[slotIndex]);
+    this->mSlotIndex = slotIndex;
+}
+
+void
+Sequence::advanceSlot()
+{
+    this->activateSlot((this->mSlotIndex + 1) % this->mSlots.size());
+}
+
+void
+Sequence::awaitSlot()
+{
+    vk::Result result = this->mDevice->waitForFences(
+      1, &this->mSubmitFence, VK_TRUE, UINT64_MAX);
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error(
+          "Kompute Sequence failed to wait for the submission of a slot");
+    }
+
+    this->mIsRunning = false;
+    this->releaseSubmitLeader();
+
+    this->completeEval();
+}
+
+void
+Sequence::finishRunningSlots(bool completed)
+{
+    // Oldest submission first, which starts from the active slot
+    uint32_t slotIndex = this->mSlotIndex;
+    for (uint32_t i = 0; i < this->mSlots.size(); i++) {
+        this->activateSlot((slotIndex + i) % this->mSlots.size());
+        if (!this->mIsRunning) {
+            continue;
+        }
+
+        this->mIsRunning = false;
+        this->releaseSubmitLeader();
+
+        if (completed) {
+            this->completeEval();
+        } else {
+            this->abandonEval();
+        }
+    }
+    this->activateSlot(slotIndex);
+}
+
+void
+Sequence::applyRunningResidency()
+{
+    uint32_t slotIndex = this->mSlotIndex;
+    for (uint32_t i = 0; i < this->mSlots.size(); i++) {
+        this->activateSlot((slotIndex + i) % this->mSlots.size());
+        if (this->mIsRunning) {
+            this->mResourceStateTracker->applyResidency();
+        }
+    }
+    this->activateSlot(slotIndex);
+}
+
 void
 Sequence::createCommandPool()
 {
@@ -370,16 +1137,30 @@ Sequence::createTimestampQueryPool(uint32_t totalTimestamps)
     }
 }
 
+std::shared_ptr<ResourceStateTracker>
+Sequence::getResourceStateTracker()
+{
+    return this->mResourceStateTracker;
+}
+
 std::vector<std::uint64_t>
 Sequence::getTimestamps()
 {
     if (!this->timestampQueryPool)
         throw std::runtime_error("Timestamp latching not enabled");
 
+    // The last evaluation was submitted from the slot before the active one
+    std::shared_ptr<vk::QueryPool> queryPool = this->timestampQueryPool;
+    if (this->mSlots.size() > 1) {
+        size_t slotIndex =
+          (this->mSlotIndex + this->mSlots.size() - 1) % this->mSlots.size();
+        queryPool = this->mSlots[slotIndex].timestampQueryPool;
+    }
+
     const auto n = this->mOperations.size() + 1;
     std::vector<std::uint64_t> timestamps(n, 0);
     this->mDevice->getQueryPoolResults(
-      *this->timestampQueryPool,
+      *queryPool,
       0,
       n,
       timestamps.size() * sizeof(std::uint64_t),
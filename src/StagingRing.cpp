@@ -0,0 +1,387 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/StagingRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace kp {
+
+// Number of segments the staging buffer is split in, two being enough for the
+// host to fill a segment while the transfer of the other one is executing
+static const uint32_t KP_STAGING_RING_SEGMENT_COUNT = 2;
+
+// Segments are aligned so that chunk offsets in the staging buffer satisfy the
+// offset alignment of buffer to image copies for any texel size
+static const vk::DeviceSize KP_STAGING_RING_SEGMENT_ALIGNMENT = 256;
+
+StagingRing::StagingRing(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                         std::shared_ptr<vk::Device> device,
+                         std::shared_ptr<vk::Queue> queue,
+                         uint32_t queueIndex,
+                         vk::DeviceSize size,
+                         std::shared_ptr<std::mutex> queueMutex)
+{
+    if (!physicalDevice) {
+        throw std::runtime_error(
+          "Kompute StagingRing physical device is null");
+    }
+    if (!device) {
+        throw std::runtime_error("Kompute StagingRing device is null");
+    }
+    if (!queue) {
+        throw std::runtime_error("Kompute StagingRing queue is null");
+    }
+
+    this->mSegmentSize = (size / KP_STAGING_RING_SEGMENT_COUNT) /
+                         KP_STAGING_RING_SEGMENT_ALIGNMENT *
+                         KP_STAGING_RING_SEGMENT_ALIGNMENT;
+    if (this->mSegmentSize == 0) {
+        throw std::runtime_error(
+          "Kompute StagingRing size must be at least " +
+          std::to_string(KP_STAGING_RING_SEGMENT_COUNT *
+                         KP_STAGING_RING_SEGMENT_ALIGNMENT) +
+          " bytes");
+    }
+
+    this->mPhysicalDevice = physicalDevice;
+    this->mDevice = device;
+    this->mQueue = queue;
+    this->mQueueMutex =
+      queueMutex ? queueMutex : std::make_shared<std::mutex>();
+    this->mSize = this->mSegmentSize * KP_STAGING_RING_SEGMENT_COUNT;
+
+    this->createBuffer();
+    this->createSegments(queueIndex);
+
+    KP_LOG_DEBUG("Kompute StagingRing created with size {} and {} segments",
+                 this->mSize,
+                 this->mSegments.size());
+}
+
+StagingRing::~StagingRing()
+{
+    KP_LOG_DEBUG("Kompute StagingRing destructor started");
+
+    if (this->mDevice) {
+        this->destroy();
+    }
+
+    KP_LOG_DEBUG("Kompute StagingRing destructor success");
+}
+
+void
+StagingRing::upload(const void* data,
+                    vk::DeviceSize size,
+                    vk::DeviceSize granularity,
+                    const RecordChunk& recordChunk)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute StagingRing upload called after ring was destroyed");
+    }
+
+    vk::DeviceSize chunkSize = this->alignedChunkSize(granularity);
+
+    KP_LOG_DEBUG("Kompute StagingRing uploading {} bytes in chunks of {}",
+                 size,
+                 chunkSize);
+
+    const uint8_t* srcData = (const uint8_t*)data;
+    for (vk::DeviceSize offset = 0; offset < size; offset += chunkSize) {
+        vk::DeviceSize currentSize = std::min(chunkSize, size - offset);
+
+        Segment& segment = this->acquireSegment();
+        std::memcpy(
+          this->mMappedData + segment.offset, srcData + offset, currentSize);
+        this->submitSegment(segment, false, offset, currentSize, recordChunk);
+    }
+
+    this->waitAll();
+}
+
+void
+StagingRing::download(void* data,
+                      vk::DeviceSize size,
+                      vk::DeviceSize granularity,
+                      const RecordChunk& recordChunk)
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        throw std::runtime_error(
+          "Kompute StagingRing download called after ring was destroyed");
+    }
+
+    vk::DeviceSize chunkSize = this->alignedChunkSize(granularity);
+
+    KP_LOG_DEBUG("Kompute StagingRing downloading {} bytes in chunks of {}",
+                 size,
+                 chunkSize);
+
+    uint8_t* dstData = (uint8_t*)data;
+    for (vk::DeviceSize offset = 0; offset < size; offset += chunkSize) {
+        vk::DeviceSize currentSize = std::min(chunkSize, size - offset);
+
+        // The chunk is copied into the host memory when the segment is
+        // waited on, either to be reused or at the end of the download
+        Segment& segment = this->acquireSegment();
+        segment.downloadData = dstData + offset;
+        segment.downloadSize = currentSize;
+        this->submitSegment(segment, true, offset, currentSize, recordChunk);
+    }
+
+    this->waitAll();
+}
+
+void
+StagingRing::destroy()
+{
+    KP_LOG_DEBUG("Kompute StagingRing started destroy()");
+
+    std::lock_guard<std::mutex> lock(this->mMutex);
+
+    if (!this->mDevice) {
+        KP_LOG_WARN(
+          "Kompute StagingRing destroy called with null Device pointer");
+        return;
+    }
+
+    this->waitAll();
+
+    for (Segment& segment : this->mSegments) {
+        this->mDevice->destroy(
+          segment.fence, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mDevice->freeCommandBuffers(
+          this->mCommandPool, 1, &segment.commandBuffer);
+    }
+    this->mSegments.clear();
+
+    this->mDevice->destroy(
+      this->mCommandPool,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    this->mDevice->unmapMemory(this->mMemory);
+    this->mMappedData = nullptr;
+
+    this->mDevice->destroy(
+      this->mBuffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    this->mDevice->freeMemory(
+      this->mMemory, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+
+    this->mDevice = nullptr;
+
+    KP_LOG_DEBUG("Kompute StagingRing successful destroy()");
+}
+
+vk::DeviceSize
+StagingRing::size()
+{
+    return this->mSize;
+}
+
+vk::DeviceSize
+StagingRing::chunkSize()
+{
+    return this->mSegmentSize;
+}
+
+uint64_t
+StagingRing::chunkCount()
+{
+    std::lock_guard<std::mutex> lock(this->mMutex);
+    return this->mChunkCount;
+}
+
+void
+StagingRing::createBuffer()
+{
+    KP_LOG_DEBUG("Kompute StagingRing creating staging buffer of size {}",
+                 this->mSize);
+
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    this->mSize,
+                                    vk::BufferUsageFlagBits::eTransferSrc |
+                                      vk::BufferUsageFlagBits::eTransferDst,
+                                    vk::SharingMode::eExclusive);
+
+    this->mDevice->createBuffer(&bufferInfo, nullptr, &this->mBuffer);
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(this->mBuffer);
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    vk::MemoryPropertyFlags memoryPropertyFlags =
+      vk::MemoryPropertyFlagBits::eHostVisible |
+      vk::MemoryPropertyFlagBits::eHostCoherent;
+
+    uint32_t memoryTypeIndex = -1;
+    bool memoryTypeIndexFound = false;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if (memoryRequirements.memoryTypeBits & (1 << i)) {
+            if (((memoryProperties.memoryTypes[i]).propertyFlags &
+                 memoryPropertyFlags) == memoryPropertyFlags) {
+                memoryTypeIndex = i;
+                memoryTypeIndexFound = true;
+                break;
+            }
+        }
+    }
+    if (!memoryTypeIndexFound) {
+        throw std::runtime_error(
+          "Kompute StagingRing memory type index for staging buffer not found");
+    }
+
+    vk::MemoryAllocateInfo memoryAllocateInfo(memoryRequirements.size,
+                                              memoryTypeIndex);
+
+    this->mDevice->allocateMemory(
+      &memoryAllocateInfo, nullptr, &this->mMemory);
+
+    this->mDevice->bindBufferMemory(this->mBuffer, this->mMemory, 0);
+
+    // The staging buffer is kept mapped for the whole lifetime of the ring
+    this->mMappedData = (uint8_t*)this->mDevice->mapMemory(
+      this->mMemory, 0, this->mSize, vk::MemoryMapFlags());
+}
+
+void
+StagingRing::createSegments(uint32_t queueIndex)
+{
+    vk::CommandPoolCreateInfo commandPoolInfo(
+      vk::CommandPoolCreateFlagBits::eResetCommandBuffer, queueIndex);
+    this->mDevice->createCommandPool(
+      &commandPoolInfo, nullptr, &this->mCommandPool);
+
+    this->mSegments.resize(KP_STAGING_RING_SEGMENT_COUNT);
+    for (uint32_t i = 0; i < KP_STAGING_RING_SEGMENT_COUNT; i++) {
+        Segment& segment = this->mSegments[i];
+        segment.offset = i * this->mSegmentSize;
+
+        vk::CommandBufferAllocateInfo commandBufferAllocateInfo(
+          this->mCommandPool, vk::CommandBufferLevel::ePrimary, 1);
+        this->mDevice->allocateCommandBuffers(&commandBufferAllocateInfo,
+                                              &segment.commandBuffer);
+
+        segment.fence = this->mDevice->createFence(vk::FenceCreateInfo());
+    }
+}
+
+vk::DeviceSize
+StagingRing::alignedChunkSize(vk::DeviceSize granularity)
+{
+    if (granularity == 0) {
+        granularity = 1;
+    }
+
+    vk::DeviceSize chunkSize = this->mSegmentSize / granularity * granularity;
+    if (chunkSize == 0) {
+        throw std::runtime_error(
+          "Kompute StagingRing chunk granularity of " +
+          std::to_string(granularity) +
+          " bytes is larger than the ring chunk size of " +
+          std::to_string(this->mSegmentSize) + " bytes");
+    }
+
+    return chunkSize;
+}
+
+StagingRing::Segment&
+StagingRing::acquireSegment()
+{
+    Segment& segment = this->mSegments[this->mNextSegment];
+    this->mNextSegment = (this->mNextSegment + 1) % this->mSegments.size();
+
+    this->waitSegment(segment);
+
+    return segment;
+}
+
+void
+StagingRing::submitSegment(Segment& segment,
+                           bool download,
+                           vk::DeviceSize offset,
+                           vk::DeviceSize size,
+                           const RecordChunk& recordChunk)
+{
+    segment.commandBuffer.begin(vk::CommandBufferBeginInfo(
+      vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+
+    recordChunk(
+      segment.commandBuffer, this->mBuffer, segment.offset, offset, size);
+
+    if (download) {
+        vk::BufferMemoryBarrier bufferMemoryBarrier;
+        bufferMemoryBarrier.buffer = this->mBuffer;
+        bufferMemoryBarrier.offset = segment.offset;
+        bufferMemoryBarrier.size = size;
+        bufferMemoryBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        bufferMemoryBarrier.dstAccessMask = vk::AccessFlagBits::eHostRead;
+        bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+        segment.commandBuffer.pipelineBarrier(
+          vk::PipelineStageFlagBits::eTransfer,
+          vk::PipelineStageFlagBits::eHost,
+          vk::DependencyFlags(),
+          nullptr,
+          bufferMemoryBarrier,
+          nullptr);
+    }
+
+    segment.commandBuffer.end();
+
+    vk::SubmitInfo submitInfo(
+      0, nullptr, nullptr, 1, &segment.commandBuffer);
+
+    this->mDevice->resetFences(1, &segment.fence);
+    {
+        std::lock_guard<std::mutex> queueLock(*this->mQueueMutex);
+        this->mQueue->submit(1, &submitInfo, segment.fence);
+    }
+
+    segment.inFlight = true;
+    this->mChunkCount++;
+}
+
+void
+StagingRing::waitSegment(Segment& segment)
+{
+    if (!segment.inFlight) {
+        return;
+    }
+
+    vk::Result result = this->mDevice->waitForFences(
+      1, &segment.fence, VK_TRUE, UINT64_MAX);
+    if (result != vk::Result::eSuccess) {
+        throw std::runtime_error(
+          "Kompute StagingRing failed to wait for transfer: " +
+          vk::to_string(result));
+    }
+
+    segment.inFlight = false;
+
+    if (segment.downloadData) {
+        std::memcpy(segment.downloadData,
+                    this->mMappedData + segment.offset,
+                    segment.downloadSize);
+        segment.downloadData = nullptr;
+        segment.downloadSize = 0;
+    }
+}
+
+void
+StagingRing::waitAll()
+{
+    // Segments are waited on in submission order starting from the oldest one
+    for (size_t i = 0; i < this->mSegments.size(); i++) {
+        this->waitSegment(
+          this->mSegments[(this->mNextSegment + i) % this->mSegments.size()]);
+    }
+}
+
+} // End namespace kp
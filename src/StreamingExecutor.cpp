@@ -0,0 +1,303 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "kompute/StreamingExecutor.hpp"
+
+#include "kompute/operations/OpSyncDevice.hpp"
+#include "kompute/operations/OpSyncLocal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace kp {
+
+double
+StreamingExecutor::Stats::throughput() const
+{
+    if (this->seconds <= 0) {
+        return 0;
+    }
+    return (this->bytesUploaded + this->bytesDownloaded) / this->seconds;
+}
+
+StreamingExecutor::StreamingExecutor(
+  std::shared_ptr<Algorithm> algorithm,
+  const std::vector<uint32_t>& inputBindings,
+  const std::vector<uint32_t>& outputBindings,
+  const std::vector<std::shared_ptr<Sequence>>& sequences,
+  const std::vector<std::vector<std::shared_ptr<Memory>>>& slotMemObjects)
+{
+    KP_LOG_DEBUG("Kompute StreamingExecutor constructor with {} slots",
+                 sequences.size());
+
+    if (!algorithm || !algorithm->isInit()) {
+        throw std::runtime_error(
+          "Kompute StreamingExecutor algorithm is null or not initialised");
+    }
+    if (sequences.empty() || sequences.size() != slotMemObjects.size()) {
+        throw std::runtime_error(
+          fmt::format("Kompute StreamingExecutor requires a sequence and "
+                      "memory objects for each slot, got {} sequences and "
+                      "{} memory object lists",
+                      sequences.size(),
+                      slotMemObjects.size()));
+    }
+    if (inputBindings.empty() && outputBindings.empty()) {
+        throw std::runtime_error(
+          "Kompute StreamingExecutor requires at least one streamed binding");
+    }
+
+    std::vector<uint32_t> streamedBindings = inputBindings;
+    streamedBindings.insert(
+      streamedBindings.end(), outputBindings.begin(), outputBindings.end());
+
+    size_t bindingCount = algorithm->getMemObjects().size();
+
+    for (const std::vector<std::shared_ptr<Memory>>& memObjects :
+         slotMemObjects) {
+        if (memObjects.size() != bindingCount) {
+            throw std::runtime_error(
+              fmt::format("Kompute StreamingExecutor slot has {} memory "
+                          "objects but the algorithm has {} bindings",
+                          memObjects.size(),
+                          bindingCount));
+        }
+
+        for (uint32_t binding : streamedBindings) {
+            if (binding >= bindingCount) {
+                throw std::runtime_error(
+                  fmt::format("Kompute StreamingExecutor binding {} out of "
+                              "range, the algorithm has {} bindings",
+                              binding,
+                              bindingCount));
+            }
+
+            const std::shared_ptr<Memory>& memObject = memObjects[binding];
+            if (memObject->type() != Memory::Type::eTensor ||
+                memObject->memoryType() != Memory::MemoryTypes::eDevice) {
+                throw std::runtime_error(
+                  fmt::format("Kompute StreamingExecutor binding {} has to "
+                              "be bound to an eDevice tensor",
+                              binding));
+            }
+
+            if (this->mChunkSize == 0) {
+                this->mChunkSize = memObject->size();
+            } else if (memObject->size() != this->mChunkSize) {
+                throw std::runtime_error(
+                  fmt::format("Kompute StreamingExecutor binding {} has {} "
+                              "elements but the chunks have {} elements",
+                              binding,
+                              memObject->size(),
+                              this->mChunkSize));
+            }
+        }
+    }
+
+    this->mAlgorithm = algorithm;
+    this->mInputBindings = inputBindings;
+    this->mOutputBindings = outputBindings;
+    this->mSequences = sequences;
+    this->mSlotMemObjects = slotMemObjects;
+
+    for (size_t slot = 0; slot < sequences.size(); slot++) {
+        const std::vector<std::shared_ptr<Memory>>& memObjects =
+          slotMemObjects[slot];
+
+        std::vector<std::shared_ptr<Memory>> inputs;
+        for (uint32_t binding : inputBindings) {
+            // The inputs are written by the host before each chunk, which
+            // is the residency the upload is recorded for
+            memObjects[binding]->setResidency(Memory::Residency::eHostDirty);
+            inputs.push_back(memObjects[binding]);
+        }
+
+        std::vector<std::shared_ptr<Memory>> outputs;
+        for (uint32_t binding : outputBindings) {
+            outputs.push_back(memObjects[binding]);
+        }
+
+        this->mDescriptorSetIndices.push_back(
+          algorithm->addDescriptorSet(memObjects));
+        algorithm->setDescriptorSet(this->mDescriptorSetIndices.back());
+
+        if (!inputs.empty()) {
+            sequences[slot]->record<OpSyncDevice>(inputs);
+        }
+        sequences[slot]->record<OpAlgoDispatch>(algorithm);
+        if (!outputs.empty()) {
+            sequences[slot]->record<OpSyncLocal>(outputs);
+        }
+    }
+}
+
+StreamingExecutor::Stats
+StreamingExecutor::run(const std::vector<const void*>& inputs,
+                       const std::vector<void*>& outputs,
+                       uint64_t elementCount)
+{
+    if (inputs.size() != this->mInputBindings.size() ||
+        outputs.size() != this->mOutputBindings.size()) {
+        throw std::runtime_error(
+          fmt::format("Kompute StreamingExecutor run requires {} inputs and "
+                      "{} outputs, got {} inputs and {} outputs",
+                      this->mInputBindings.size(),
+                      this->mOutputBindings.size(),
+                      inputs.size(),
+                      outputs.size()));
+    }
+
+    uint32_t slotCount = this->slotCount();
+    uint64_t chunkCount =
+      (elementCount + this->mChunkSize - 1) / this->mChunkSize;
+
+    Stats stats;
+    stats.elementCount = elementCount;
+    stats.chunkCount = chunkCount;
+
+    std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+
+    for (uint64_t chunk = 0; chunk < chunkCount; chunk++) {
+        uint32_t slot = chunk % slotCount;
+
+        // The slot is only waited on once it is reused, which leaves the
+        // chunks submitted to the other slots in flight
+        if (chunk >= slotCount) {
+            this->completeChunk(
+              slot, chunk - slotCount, outputs, elementCount, stats);
+        }
+
+        this->submitChunk(slot, chunk, inputs, elementCount, stats);
+    }
+
+    uint64_t firstPending = chunkCount > slotCount ? chunkCount - slotCount : 0;
+    for (uint64_t chunk = firstPending; chunk < chunkCount; chunk++) {
+        this->completeChunk(
+          chunk % slotCount, chunk, outputs, elementCount, stats);
+    }
+
+    stats.seconds = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+
+    KP_LOG_INFO("Kompute StreamingExecutor streamed {} elements in {} chunks "
+                "in {} s, {} MB/s",
+                stats.elementCount,
+                stats.chunkCount,
+                stats.seconds,
+                stats.throughput() / (1024 * 1024));
+
+    return stats;
+}
+
+uint64_t
+StreamingExecutor::chunkSize()
+{
+    return this->mChunkSize;
+}
+
+uint32_t
+StreamingExecutor::slotCount()
+{
+    return static_cast<uint32_t>(this->mSequences.size());
+}
+
+const std::vector<std::shared_ptr<Memory>>&
+StreamingExecutor::getMemObjects(uint32_t slot)
+{
+    if (slot >= this->mSlotMemObjects.size()) {
+        throw std::runtime_error(
+          fmt::format("Kompute StreamingExecutor slot {} out of range, the "
+                      "executor has {} slots",
+                      slot,
+                      this->mSlotMemObjects.size()));
+    }
+    return this->mSlotMemObjects[slot];
+}
+
+const std::vector<uint32_t>&
+StreamingExecutor::getInputBindings()
+{
+    return this->mInputBindings;
+}
+
+const std::vector<uint32_t>&
+StreamingExecutor::getOutputBindings()
+{
+    return this->mOutputBindings;
+}
+
+void
+StreamingExecutor::submitChunk(uint32_t slot,
+                               uint64_t chunk,
+                               const std::vector<const void*>& inputs,
+                               uint64_t elementCount,
+                               Stats& stats)
+{
+    KP_LOG_DEBUG("Kompute StreamingExecutor submitting chunk {} to slot {}",
+                 chunk,
+                 slot);
+
+    uint64_t elementOffset = chunk * this->mChunkSize;
+    uint64_t chunkElements =
+      std::min(this->mChunkSize, elementCount - elementOffset);
+
+    for (size_t i = 0; i < this->mInputBindings.size(); i++) {
+        const std::shared_ptr<Memory>& memObject =
+          this->mSlotMemObjects[slot][this->mInputBindings[i]];
+        uint64_t elementSize = memObject->dataTypeMemorySize();
+        uint8_t* data = static_cast<uint8_t*>(memObject->rawData());
+
+        memcpy(data,
+               static_cast<const uint8_t*>(inputs[i]) +
+                 elementOffset * elementSize,
+               chunkElements * elementSize);
+
+        // The algorithm is dispatched over whole chunks, so the elements
+        // past the end of the last chunk are cleared
+        memset(data + chunkElements * elementSize,
+               0,
+               (this->mChunkSize - chunkElements) * elementSize);
+
+        stats.bytesUploaded += chunkElements * elementSize;
+    }
+
+    // Sequences record the algorithm again if the residency of their memory
+    // objects changed, which binds the active descriptor set
+    this->mAlgorithm->setDescriptorSet(this->mDescriptorSetIndices[slot]);
+
+    this->mSequences[slot]->evalAsync();
+}
+
+void
+StreamingExecutor::completeChunk(uint32_t slot,
+                                 uint64_t chunk,
+                                 const std::vector<void*>& outputs,
+                                 uint64_t elementCount,
+                                 Stats& stats)
+{
+    KP_LOG_DEBUG("Kompute StreamingExecutor completing chunk {} of slot {}",
+                 chunk,
+                 slot);
+
+    this->mSequences[slot]->evalAwait();
+
+    uint64_t elementOffset = chunk * this->mChunkSize;
+    uint64_t chunkElements =
+      std::min(this->mChunkSize, elementCount - elementOffset);
+
+    for (size_t i = 0; i < this->mOutputBindings.size(); i++) {
+        const std::shared_ptr<Memory>& memObject =
+          this->mSlotMemObjects[slot][this->mOutputBindings[i]];
+        uint64_t elementSize = memObject->dataTypeMemorySize();
+
+        memcpy(static_cast<uint8_t*>(outputs[i]) + elementOffset * elementSize,
+               memObject->rawData(),
+               chunkElements * elementSize);
+
+        stats.bytesDownloaded += chunkElements * elementSize;
+    }
+}
+
+} // End namespace kp
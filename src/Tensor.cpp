@@ -2,46 +2,98 @@
 
 #include "kompute/Tensor.hpp"
 #include "kompute/Image.hpp"
+#include <algorithm>
+#include <cstring>
+#include <future>
+#include <limits>
+#if KOMPUTE_OPT_USE_SPDLOG
+#include <spdlog/fmt/fmt.h>
+#else
+#include <fmt/core.h>
+#endif
 
 namespace kp {
 
 Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                std::shared_ptr<vk::Device> device,
                void* data,
-               uint32_t elementTotalCount,
+               uint64_t elementTotalCount,
                uint32_t elementMemorySize,
                const DataTypes& dataType,
-               const MemoryTypes& memoryType)
-  : Memory(physicalDevice, device, dataType, memoryType, elementTotalCount, 1)
+               const MemoryTypes& memoryType,
+               std::shared_ptr<MemoryPool> memoryPool,
+               std::shared_ptr<StagingRing> stagingRing,
+               const StagingPolicy& stagingPolicy,
+               const HostMemoryPolicy& hostMemoryPolicy,
+               std::shared_ptr<MemoryBudget> memoryBudget)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           memoryType,
+           Tensor::dimensionX(elementTotalCount),
+           1,
+           memoryPool,
+           stagingRing,
+           stagingPolicy)
 {
     this->mSize = elementTotalCount;
+    this->mMemoryBudget = memoryBudget;
 
     // This is required if dataType is eCustom
     this->mDataTypeMemorySize = elementMemorySize;
 
+    this->checkMemorySize();
+
     KP_LOG_DEBUG("Kompute Tensor constructor data length: {}, and type: {}",
                  elementTotalCount,
                  Memory::toString(memoryType));
 
     this->mDescriptorType = vk::DescriptorType::eStorageBuffer;
 
+    if (hostMemoryPolicy == HostMemoryPolicy::eImport) {
+        if (memoryType != MemoryTypes::eHost) {
+            throw std::runtime_error(
+              "Kompute Tensor can only import host memory into tensors of "
+              "type eHost but got " +
+              Memory::toString(memoryType));
+        }
+        if (this->importHostMemory(data)) {
+            return;
+        }
+    }
+
     this->reserve();
     this->updateRawData(data);
 }
 
 Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
                std::shared_ptr<vk::Device> device,
-               uint32_t elementTotalCount,
+               uint64_t elementTotalCount,
                uint32_t elementMemorySize,
                const DataTypes& dataType,
-               const MemoryTypes& memoryType)
-  : Memory(physicalDevice, device, dataType, memoryType, elementTotalCount, 1)
+               const MemoryTypes& memoryType,
+               std::shared_ptr<MemoryPool> memoryPool,
+               std::shared_ptr<StagingRing> stagingRing,
+               const StagingPolicy& stagingPolicy,
+               std::shared_ptr<MemoryBudget> memoryBudget)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           memoryType,
+           Tensor::dimensionX(elementTotalCount),
+           1,
+           memoryPool,
+           stagingRing,
+           stagingPolicy)
 {
     this->mSize = elementTotalCount;
+    this->mMemoryBudget = memoryBudget;
 
     // This is required if dataType is eCustom
     this->mDataTypeMemorySize = elementMemorySize;
 
+    this->checkMemorySize();
+
     KP_LOG_DEBUG("Kompute Tensor constructor data length: {}, and type: {}",
                  elementTotalCount,
                  Memory::toString(memoryType));
@@ -51,6 +103,128 @@ Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
     this->reserve();
 }
 
+Tensor::Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               std::shared_ptr<MappedFile> mappedFile,
+               uint64_t elementTotalCount,
+               uint32_t elementMemorySize,
+               const DataTypes& dataType,
+               const MemoryTypes& memoryType,
+               std::shared_ptr<MemoryPool> memoryPool,
+               std::shared_ptr<StagingRing> stagingRing,
+               const StagingPolicy& stagingPolicy,
+               std::shared_ptr<MemoryBudget> memoryBudget)
+  : Memory(physicalDevice,
+           device,
+           dataType,
+           memoryType,
+           Tensor::dimensionX(elementTotalCount),
+           1,
+           memoryPool,
+           stagingRing,
+           stagingPolicy)
+{
+    this->mSize = elementTotalCount;
+    this->mMemoryBudget = memoryBudget;
+
+    // This is required if dataType is eCustom
+    this->mDataTypeMemorySize = elementMemorySize;
+
+    this->checkMemorySize();
+
+    if (!mappedFile) {
+        throw std::runtime_error("Kompute Tensor mapped file is null");
+    }
+    if (mappedFile->size() < this->memorySize()) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Tensor of {} bytes created from a mapped file of {} bytes",
+          this->memorySize(),
+          mappedFile->size()));
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor constructor from mapped file data length: "
+                 "{}, and type: {}",
+                 elementTotalCount,
+                 Memory::toString(memoryType));
+
+    this->mDescriptorType = vk::DescriptorType::eStorageBuffer;
+
+    if (memoryType == MemoryTypes::eHost &&
+        this->importHostMemory(mappedFile->data())) {
+        this->mMappedFile = mappedFile;
+        return;
+    }
+
+    if (memoryType == MemoryTypes::eDevice && stagingRing) {
+        // The mapping is streamed through the staging ring when syncing
+        this->mMappedFile = mappedFile;
+        this->reserve();
+        return;
+    }
+
+    this->reserve();
+    this->updateRawData(mappedFile->data());
+}
+
+Tensor::Tensor(std::shared_ptr<Tensor> parent,
+               uint64_t elementOffset,
+               uint64_t elementCount)
+  : Memory(parent->mPhysicalDevice,
+           parent->mDevice,
+           parent->mDataType,
+           parent->mMemoryType,
+           Tensor::dimensionX(elementCount),
+           1,
+           nullptr,
+           parent->mStagingRing,
+           StagingPolicy::eLazy)
+{
+    if (!parent->isInit()) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to create a view of an uninitialised "
+          "tensor");
+    }
+    if (elementCount == 0) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to create a zero-sized view");
+    }
+    if (elementOffset > parent->size() ||
+        elementCount > parent->size() - elementOffset) {
+        throw std::runtime_error(
+          "Kompute Tensor attempted to create a view out of the bounds of the "
+          "tensor");
+    }
+
+    this->mSize = elementCount;
+    this->mDataTypeMemorySize = parent->mDataTypeMemorySize;
+
+    // Views of views share the buffers of the tensor they were created from
+    this->mParent = parent->mParent ? parent->mParent : parent;
+    this->mOffset = parent->mOffset + (vk::DeviceSize)elementOffset *
+                                        this->mDataTypeMemorySize;
+
+    vk::DeviceSize offsetAlignment = this->mPhysicalDevice->getProperties()
+                                       .limits.minStorageBufferOffsetAlignment;
+    if (offsetAlignment > 0 && this->mOffset % offsetAlignment != 0) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Tensor view offset of {} bytes is not a multiple of the "
+          "minStorageBufferOffsetAlignment of {} bytes",
+          this->mOffset,
+          offsetAlignment));
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor view constructor offset: {}, length: {}",
+                 this->mOffset,
+                 elementCount);
+
+    this->mDescriptorType = vk::DescriptorType::eStorageBuffer;
+
+    this->mPrimaryBuffer = this->mParent->mPrimaryBuffer;
+    this->mPrimaryMemory = this->mParent->mPrimaryMemory;
+    this->mStagingBuffer = this->mParent->mStagingBuffer;
+    this->mStagingMemory = this->mParent->mStagingMemory;
+}
+
 Tensor::~Tensor()
 {
     KP_LOG_DEBUG("Kompute Tensor destructor started. Type: {}",
@@ -66,8 +240,7 @@ Tensor::~Tensor()
 void
 Tensor::reserve()
 {
-    KP_LOG_DEBUG("Reserving {} bytes for memory",
-                 this->mSize * this->mDataTypeMemorySize);
+    KP_LOG_DEBUG("Reserving {} bytes for memory", this->memorySize());
 
     if (this->mPrimaryBuffer || this->mPrimaryMemory) {
         KP_LOG_DEBUG(
@@ -90,7 +263,8 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 {
 
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(
+      copyFromTensor->mOffset, this->mOffset, bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor recordCopyFrom data size {}.", bufferSize);
 
@@ -115,7 +289,7 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 
     vk::Extent3D size = { copyFromImage->getX(), copyFromImage->getY(), 1 };
 
-    vk::BufferImageCopy copyRegion(0, 0, 0, layer, offset, size);
+    vk::BufferImageCopy copyRegion(this->mOffset, 0, 0, layer, offset, size);
 
     KP_LOG_DEBUG("Kompute Tensor recordCopyFrom data size {}.", bufferSize);
 
@@ -138,8 +312,16 @@ Tensor::recordCopyFrom(const vk::CommandBuffer& commandBuffer,
 void
 Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 {
+    this->ensureStagingMemory();
+
+    if (!this->mStagingBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor recordCopyFromStagingToDevice called without staging "
+          "buffer");
+    }
+
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(this->mOffset, this->mOffset, bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
 
@@ -153,8 +335,16 @@ Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer)
 void
 Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
 {
+    this->ensureStagingMemory();
+
+    if (!this->mStagingBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor recordCopyFromDeviceToStaging called without staging "
+          "buffer");
+    }
+
     vk::DeviceSize bufferSize(this->memorySize());
-    vk::BufferCopy copyRegion(0, 0, bufferSize);
+    vk::BufferCopy copyRegion(this->mOffset, this->mOffset, bufferSize);
 
     KP_LOG_DEBUG("Kompute Tensor copying data size {}.", bufferSize);
 
@@ -165,6 +355,389 @@ Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer)
                            copyRegion);
 }
 
+void
+Tensor::recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer,
+                                      const std::vector<Range>& ranges)
+{
+    this->ensureStagingMemory();
+
+    if (!this->mStagingBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor recordCopyFromStagingToDevice called without staging "
+          "buffer");
+    }
+
+    std::vector<vk::BufferCopy> copyRegions = this->createCopyRegions(ranges);
+    if (copyRegions.empty()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor copying {} ranges to device",
+                 copyRegions.size());
+
+    commandBuffer.copyBuffer(
+      *this->mStagingBuffer, *this->mPrimaryBuffer, copyRegions);
+}
+
+void
+Tensor::recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer,
+                                      const std::vector<Range>& ranges)
+{
+    this->ensureStagingMemory();
+
+    if (!this->mStagingBuffer) {
+        throw std::runtime_error(
+          "Kompute Tensor recordCopyFromDeviceToStaging called without staging "
+          "buffer");
+    }
+
+    std::vector<vk::BufferCopy> copyRegions = this->createCopyRegions(ranges);
+    if (copyRegions.empty()) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor copying {} ranges to staging",
+                 copyRegions.size());
+
+    commandBuffer.copyBuffer(
+      *this->mPrimaryBuffer, *this->mStagingBuffer, copyRegions);
+}
+
+void
+Tensor::streamToDevice()
+{
+    this->streamRangeToDevice(0, this->memorySize());
+}
+
+void
+Tensor::streamFromDevice()
+{
+    this->streamRangeFromDevice(0, this->memorySize());
+}
+
+void
+Tensor::streamToDevice(const std::vector<Range>& ranges)
+{
+    for (const vk::BufferCopy& copyRegion : this->createCopyRegions(ranges)) {
+        this->streamRangeToDevice(copyRegion.srcOffset - this->mOffset,
+                                  copyRegion.size);
+    }
+}
+
+void
+Tensor::streamFromDevice(const std::vector<Range>& ranges)
+{
+    for (const vk::BufferCopy& copyRegion : this->createCopyRegions(ranges)) {
+        this->streamRangeFromDevice(copyRegion.srcOffset - this->mOffset,
+                                    copyRegion.size);
+    }
+}
+
+void
+Tensor::streamRangeToDevice(vk::DeviceSize rangeOffset,
+                            vk::DeviceSize rangeSize)
+{
+    if (!this->mStagingRing) {
+        throw std::runtime_error(
+          "Kompute Tensor streamToDevice called without a staging ring");
+    }
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
+    this->streamRangeToDevice(*this->mStagingRing,
+                              static_cast<uint8_t*>(this->mRawData) +
+                                rangeOffset,
+                              rangeOffset,
+                              rangeSize);
+}
+
+void
+Tensor::streamRangeToDevice(StagingRing& stagingRing,
+                            const void* data,
+                            vk::DeviceSize rangeOffset,
+                            vk::DeviceSize rangeSize)
+{
+    KP_LOG_DEBUG("Kompute Tensor streaming {} bytes to device", rangeSize);
+
+    vk::DeviceSize bufferOffset = this->mOffset + rangeOffset;
+
+    stagingRing.upload(
+      data,
+      rangeSize,
+      this->mDataTypeMemorySize,
+      [this, bufferOffset](const vk::CommandBuffer& commandBuffer,
+                           const vk::Buffer& stagingBuffer,
+                           vk::DeviceSize stagingOffset,
+                           vk::DeviceSize offset,
+                           vk::DeviceSize size) {
+          BarrierBatch barrierBatch;
+
+          // The transfers are submitted outside of any sequence, so they
+          // have to wait for previous shader and transfer accesses, and make
+          // their writes visible to the ones that follow
+          this->recordPrimaryMemoryBarrier(
+            barrierBatch,
+            vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::AccessFlagBits::eTransferWrite,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer);
+          barrierBatch.flush(commandBuffer);
+
+          vk::BufferCopy copyRegion(
+            stagingOffset, bufferOffset + offset, size);
+          commandBuffer.copyBuffer(
+            stagingBuffer, *this->mPrimaryBuffer, copyRegion);
+
+          this->recordPrimaryMemoryBarrier(
+            barrierBatch,
+            vk::AccessFlagBits::eTransferWrite,
+            vk::AccessFlagBits::eShaderRead |
+              vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferRead |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer);
+          barrierBatch.flush(commandBuffer);
+      });
+}
+
+void
+Tensor::streamRangeFromDevice(vk::DeviceSize rangeOffset,
+                              vk::DeviceSize rangeSize)
+{
+    if (!this->mStagingRing) {
+        throw std::runtime_error(
+          "Kompute Tensor streamFromDevice called without a staging ring");
+    }
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
+    this->streamRangeFromDevice(*this->mStagingRing,
+                                static_cast<uint8_t*>(this->mRawData) +
+                                  rangeOffset,
+                                rangeOffset,
+                                rangeSize);
+}
+
+void
+Tensor::streamRangeFromDevice(StagingRing& stagingRing,
+                              void* data,
+                              vk::DeviceSize rangeOffset,
+                              vk::DeviceSize rangeSize)
+{
+    KP_LOG_DEBUG("Kompute Tensor streaming {} bytes from device", rangeSize);
+
+    vk::DeviceSize bufferOffset = this->mOffset + rangeOffset;
+
+    stagingRing.download(
+      data,
+      rangeSize,
+      this->mDataTypeMemorySize,
+      [this, bufferOffset](const vk::CommandBuffer& commandBuffer,
+                           const vk::Buffer& stagingBuffer,
+                           vk::DeviceSize stagingOffset,
+                           vk::DeviceSize offset,
+                           vk::DeviceSize size) {
+          BarrierBatch barrierBatch;
+
+          this->recordPrimaryMemoryBarrier(
+            barrierBatch,
+            vk::AccessFlagBits::eShaderWrite |
+              vk::AccessFlagBits::eTransferWrite,
+            vk::AccessFlagBits::eTransferRead,
+            vk::PipelineStageFlagBits::eComputeShader |
+              vk::PipelineStageFlagBits::eTransfer,
+            vk::PipelineStageFlagBits::eTransfer);
+          barrierBatch.flush(commandBuffer);
+
+          vk::BufferCopy copyRegion(
+            bufferOffset + offset, stagingOffset, size);
+          commandBuffer.copyBuffer(
+            *this->mPrimaryBuffer, stagingBuffer, copyRegion);
+      });
+}
+
+void
+Tensor::loadFile(const std::string& path,
+                 uint64_t offset,
+                 std::shared_ptr<StagingRing> stagingRing,
+                 uint64_t chunkSize)
+{
+    KP_LOG_DEBUG("Kompute Tensor loading {} bytes at offset {} of {}",
+                 this->memorySize(),
+                 offset,
+                 path);
+
+    // Tensors of type eStorage have no host data to write into
+    bool streamToDevice = this->mMemoryType == MemoryTypes::eDevice ||
+                          this->mMemoryType == MemoryTypes::eStorage;
+    if (streamToDevice && !stagingRing) {
+        throw std::runtime_error(
+          "Kompute Tensor loadFile requires a staging ring to load a file "
+          "into a tensor of type " +
+          Memory::toString(this->mMemoryType));
+    }
+
+    // The data is streamed into the primary buffer of the tensor
+    if (streamToDevice) {
+        this->restore();
+    }
+
+    MappedFile mappedFile(path, offset, this->memorySize());
+    const uint8_t* data = static_cast<const uint8_t*>(mappedFile.data());
+
+    // Chunks hold whole elements so they can be streamed on their own
+    uint64_t elementSize = this->mDataTypeMemorySize;
+    chunkSize = std::max(chunkSize / elementSize, (uint64_t)1) * elementSize;
+
+    if (!streamToDevice && !this->mRawData) {
+        this->mapRawData();
+    }
+
+    uint64_t size = this->memorySize();
+    mappedFile.prefetch(0, chunkSize);
+    for (uint64_t chunkOffset = 0; chunkOffset < size;
+         chunkOffset += chunkSize) {
+        uint64_t currentSize = std::min(chunkSize, size - chunkOffset);
+
+        // Reads the next chunk from the file while this one is written
+        mappedFile.prefetch(chunkOffset + currentSize, chunkSize);
+
+        if (streamToDevice) {
+            this->streamRangeToDevice(
+              *stagingRing, data + chunkOffset, chunkOffset, currentSize);
+        } else {
+            memcpy(static_cast<uint8_t*>(this->mRawData) + chunkOffset,
+                   data + chunkOffset,
+                   currentSize);
+        }
+
+        mappedFile.release(chunkOffset, currentSize);
+    }
+
+    if (streamToDevice) {
+        this->setResidency(Residency::eDeviceDirty);
+    }
+}
+
+void
+Tensor::saveToStream(std::ostream& stream,
+                     std::shared_ptr<StagingRing> stagingRing,
+                     uint64_t chunkSize)
+{
+    KP_LOG_DEBUG("Kompute Tensor saving {} bytes", this->memorySize());
+
+    // The host data is written as it is unless the device holds newer data
+    bool streamFromDevice =
+      this->mMemoryType == MemoryTypes::eStorage ||
+      (this->mMemoryType == MemoryTypes::eDevice &&
+       this->residency() == Residency::eDeviceDirty);
+    if (streamFromDevice && !stagingRing) {
+        throw std::runtime_error(
+          "Kompute Tensor saveToStream requires a staging ring to save a "
+          "tensor whose data is only current in device memory");
+    }
+
+    uint64_t size = this->memorySize();
+
+    if (!streamFromDevice) {
+        if (!this->mRawData) {
+            this->mapRawData();
+        }
+        stream.write(static_cast<const char*>(this->mRawData), size);
+    } else {
+        // Chunks hold whole elements so they can be streamed on their own
+        uint64_t elementSize = this->mDataTypeMemorySize;
+        chunkSize =
+          std::max(chunkSize / elementSize, (uint64_t)1) * elementSize;
+
+        // Chunks are downloaded into a buffer while the other one is written
+        std::vector<uint8_t> buffers[2];
+        std::future<void> pendingWrite;
+        uint64_t chunkIndex = 0;
+        for (uint64_t chunkOffset = 0; chunkOffset < size;
+             chunkOffset += chunkSize, chunkIndex++) {
+            uint64_t currentSize = std::min(chunkSize, size - chunkOffset);
+
+            std::vector<uint8_t>& buffer = buffers[chunkIndex % 2];
+            buffer.resize(currentSize);
+            this->streamRangeFromDevice(
+              *stagingRing, buffer.data(), chunkOffset, currentSize);
+
+            if (pendingWrite.valid()) {
+                pendingWrite.get();
+            }
+            pendingWrite =
+              std::async(std::launch::async, [&stream, &buffer]() {
+                  stream.write(reinterpret_cast<const char*>(buffer.data()),
+                               buffer.size());
+              });
+        }
+        if (pendingWrite.valid()) {
+            pendingWrite.get();
+        }
+    }
+
+    if (!stream) {
+        throw std::runtime_error(
+          "Kompute Tensor failed to write the data of the tensor");
+    }
+}
+
+std::vector<vk::BufferCopy>
+Tensor::createCopyRegions(const std::vector<Range>& ranges)
+{
+    std::vector<Range> sortedRanges(ranges);
+    std::sort(sortedRanges.begin(),
+              sortedRanges.end(),
+              [](const Range& a, const Range& b) {
+                  return a.offset < b.offset;
+              });
+
+    std::vector<vk::BufferCopy> copyRegions;
+
+    for (const Range& range : sortedRanges) {
+        if (range.offset > this->size() ||
+            range.count > this->size() - range.offset) {
+            throw std::runtime_error(fmt::format(
+              "Kompute Tensor range of {} elements at offset {} is out of "
+              "the bounds of the tensor of size {}",
+              range.count,
+              range.offset,
+              this->size()));
+        }
+        if (range.count == 0) {
+            continue;
+        }
+
+        vk::DeviceSize offset =
+          this->mOffset +
+          (vk::DeviceSize)range.offset * this->mDataTypeMemorySize;
+        vk::DeviceSize size =
+          (vk::DeviceSize)range.count * this->mDataTypeMemorySize;
+
+        // Overlapping and adjacent ranges are merged into a single region
+        if (!copyRegions.empty() &&
+            offset <= copyRegions.back().srcOffset + copyRegions.back().size) {
+            vk::BufferCopy& copyRegion = copyRegions.back();
+            copyRegion.size =
+              std::max(copyRegion.srcOffset + copyRegion.size, offset + size) -
+              copyRegion.srcOffset;
+        } else {
+            copyRegions.push_back(vk::BufferCopy(offset, offset, size));
+        }
+    }
+
+    return copyRegions;
+}
+
 void
 Tensor::recordCopyBuffer(const vk::CommandBuffer& commandBuffer,
                          std::shared_ptr<vk::Buffer> bufferFrom,
@@ -214,6 +787,8 @@ Tensor::recordStagingMemoryBarrier(const vk::CommandBuffer& commandBuffer,
 {
     KP_LOG_DEBUG("Kompute Tensor recording STAGING buffer memory barrier");
 
+    this->ensureStagingMemory();
+
     this->recordBufferMemoryBarrier(commandBuffer,
                                     *this->mStagingBuffer,
                                     srcAccessMask,
@@ -232,22 +807,68 @@ Tensor::recordBufferMemoryBarrier(const vk::CommandBuffer& commandBuffer,
 {
     KP_LOG_DEBUG("Kompute Tensor recording buffer memory barrier");
 
-    vk::DeviceSize bufferSize = this->memorySize();
+    vk::BufferMemoryBarrier bufferMemoryBarrier =
+      this->createBufferMemoryBarrier(buffer, srcAccessMask, dstAccessMask);
+
+    commandBuffer.pipelineBarrier(srcStageMask,
+                                  dstStageMask,
+                                  vk::DependencyFlags(),
+                                  nullptr,
+                                  bufferMemoryBarrier,
+                                  nullptr);
+}
+
+void
+Tensor::recordPrimaryMemoryBarrier(BarrierBatch& barrierBatch,
+                                   vk::AccessFlags srcAccessMask,
+                                   vk::AccessFlags dstAccessMask,
+                                   vk::PipelineStageFlags srcStageMask,
+                                   vk::PipelineStageFlags dstStageMask)
+{
+    KP_LOG_DEBUG("Kompute Tensor adding PRIMARY buffer memory barrier");
+
+    barrierBatch.addBufferMemoryBarrier(
+      this->createBufferMemoryBarrier(
+        *this->mPrimaryBuffer, srcAccessMask, dstAccessMask),
+      srcStageMask,
+      dstStageMask);
+}
+
+void
+Tensor::recordStagingMemoryBarrier(BarrierBatch& barrierBatch,
+                                   vk::AccessFlags srcAccessMask,
+                                   vk::AccessFlags dstAccessMask,
+                                   vk::PipelineStageFlags srcStageMask,
+                                   vk::PipelineStageFlags dstStageMask)
+{
+    KP_LOG_DEBUG("Kompute Tensor adding STAGING buffer memory barrier");
 
+    this->ensureStagingMemory();
+
+    barrierBatch.addBufferMemoryBarrier(
+      this->createBufferMemoryBarrier(
+        *this->mStagingBuffer, srcAccessMask, dstAccessMask),
+      srcStageMask,
+      dstStageMask);
+}
+
+vk::BufferMemoryBarrier
+Tensor::createBufferMemoryBarrier(const vk::Buffer& buffer,
+                                  vk::AccessFlags srcAccessMask,
+                                  vk::AccessFlags dstAccessMask)
+{
     vk::BufferMemoryBarrier bufferMemoryBarrier;
     bufferMemoryBarrier.buffer = buffer;
-    bufferMemoryBarrier.size = bufferSize;
+    // Views share the state of the whole buffer of their parent, so their
+    // barriers cover all of it rather than their own range
+    bufferMemoryBarrier.size =
+      this->mParent ? VK_WHOLE_SIZE : (vk::DeviceSize)this->memorySize();
     bufferMemoryBarrier.srcAccessMask = srcAccessMask;
     bufferMemoryBarrier.dstAccessMask = dstAccessMask;
     bufferMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     bufferMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 
-    commandBuffer.pipelineBarrier(srcStageMask,
-                                  dstStageMask,
-                                  vk::DependencyFlags(),
-                                  nullptr,
-                                  bufferMemoryBarrier,
-                                  nullptr);
+    return bufferMemoryBarrier;
 }
 
 vk::DescriptorBufferInfo
@@ -256,9 +877,20 @@ Tensor::constructDescriptorBufferInfo()
     KP_LOG_DEBUG("Kompute Tensor construct descriptor buffer info size {}",
                  this->memorySize());
     vk::DeviceSize bufferSize = this->memorySize();
-    return vk::DescriptorBufferInfo(*this->mPrimaryBuffer,
-                                    0, // offset
-                                    bufferSize);
+
+    // Larger tensors can only be bound through views of up to this size
+    vk::DeviceSize maxStorageBufferRange =
+      this->mPhysicalDevice->getProperties().limits.maxStorageBufferRange;
+    if (bufferSize > maxStorageBufferRange) {
+        throw std::runtime_error(fmt::format(
+          "Kompute Tensor of {} bytes exceeds the maxStorageBufferRange of {} "
+          "bytes and has to be bound through views",
+          bufferSize,
+          maxStorageBufferRange));
+    }
+
+    return vk::DescriptorBufferInfo(
+      *this->mPrimaryBuffer, this->mOffset, bufferSize);
 }
 
 vk::WriteDescriptorSet
@@ -325,6 +957,251 @@ Tensor::getPrimaryBuffer()
     return this->mPrimaryBuffer;
 }
 
+vk::DeviceSize
+Tensor::getMemoryOffset()
+{
+    return this->mOffset;
+}
+
+uint32_t
+Tensor::dimensionX(uint64_t elementCount)
+{
+    return static_cast<uint32_t>(std::min<uint64_t>(
+      elementCount, std::numeric_limits<uint32_t>::max()));
+}
+
+void
+Tensor::mapRawData()
+{
+    // Imported host memory is the host allocation itself
+    if (this->mImportedHostData) {
+        this->mRawData = this->mImportedHostData;
+        return;
+    }
+
+    // File backed tensors stream the mapping of the file instead of a copy
+    if (this->mMappedFile) {
+        this->mRawData = this->mMappedFile->data();
+        return;
+    }
+
+    if (!this->mParent) {
+        Memory::mapRawData();
+        return;
+    }
+
+    // The parent owns the mapping of the host data the view points into
+    if (!this->mParent->mRawData) {
+        this->mParent->mapRawData();
+    }
+    if (this->mParent->mRawData) {
+        this->mRawData =
+          static_cast<uint8_t*>(this->mParent->mRawData) + this->mOffset;
+    }
+}
+
+bool
+Tensor::isView()
+{
+    return this->mParent != nullptr;
+}
+
+bool
+Tensor::isHostMemoryImported()
+{
+    if (this->mParent) {
+        return this->mParent->isHostMemoryImported();
+    }
+    return this->mImportedHostData != nullptr;
+}
+
+Memory::Residency
+Tensor::residency()
+{
+    // Views share the host data and device memory of their parent
+    if (this->mParent) {
+        return this->mParent->residency();
+    }
+    return Memory::residency();
+}
+
+void
+Tensor::setResidency(Residency residency)
+{
+    if (this->mParent) {
+        this->mParent->setResidency(residency);
+        return;
+    }
+    Memory::setResidency(residency);
+}
+
+void
+Tensor::evict()
+{
+    if (this->mParent) {
+        this->mParent->evict();
+        return;
+    }
+
+    if (this->mEvicted) {
+        KP_LOG_DEBUG("Kompute Tensor evict called on an evicted tensor");
+        return;
+    }
+
+    if (this->mMemoryType != MemoryTypes::eDevice) {
+        throw std::runtime_error(
+          "Kompute Tensor can only evict tensors of type eDevice but got " +
+          Memory::toString(this->mMemoryType));
+    }
+    if (!this->isInit()) {
+        throw std::runtime_error(
+          "Kompute Tensor evict called on an uninitialised tensor");
+    }
+    if (this->mPinCount > 0) {
+        throw std::runtime_error(
+          "Kompute Tensor evict called on a pinned tensor");
+    }
+    if (!this->mMemoryBudget) {
+        throw std::runtime_error(
+          "Kompute Tensor evict requires a memory budget to transfer the "
+          "data through");
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor evicting {} bytes of device memory",
+                 this->memorySize());
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
+    // The host data becomes the only copy of the data of the tensor
+    if (this->residency() == Residency::eDeviceDirty) {
+        this->streamRangeFromDevice(*this->mMemoryBudget->stagingRing(),
+                                    this->mRawData,
+                                    0,
+                                    this->memorySize());
+    }
+
+    // The buffer and memory objects are kept, as views share them, and only
+    // the handles they hold are released
+    this->mDevice->destroy(
+      *this->mPrimaryBuffer,
+      (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    *this->mPrimaryBuffer = vk::Buffer();
+
+    if (this->mPrimaryAllocation) {
+        this->mMemoryPool->free(this->mPrimaryAllocation);
+        this->mPrimaryAllocation = MemoryPool::Allocation();
+    } else if (this->mFreePrimaryMemory) {
+        this->mDevice->freeMemory(
+          *this->mPrimaryMemory,
+          (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        this->mFreePrimaryMemory = false;
+    }
+    *this->mPrimaryMemory = vk::DeviceMemory();
+
+    this->mEvicted = true;
+    this->setResidency(Residency::eHostDirty);
+    this->mMemoryBudget->setResident(this, false);
+}
+
+void
+Tensor::restore()
+{
+    if (this->mParent) {
+        this->mParent->restore();
+        return;
+    }
+
+    if (!this->mEvicted) {
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor restoring {} bytes of device memory",
+                 this->memorySize());
+
+    this->mMemoryBudget->reserve(this->memorySize());
+
+    this->createBuffer(this->mPrimaryBuffer,
+                       this->getPrimaryBufferUsageFlags());
+    this->allocateBindMemory(this->mPrimaryBuffer,
+                             this->mPrimaryMemory,
+                             this->mPrimaryAllocation,
+                             this->getPrimaryMemoryPropertyFlags());
+    this->mFreePrimaryMemory = !this->mPrimaryAllocation;
+
+    this->mEvicted = false;
+    this->mPrimaryBufferGeneration++;
+    this->mMemoryBudget->setResident(this, true);
+
+    if (!this->mRawData) {
+        this->mapRawData();
+    }
+
+    this->streamRangeToDevice(*this->mMemoryBudget->stagingRing(),
+                              this->mRawData,
+                              0,
+                              this->memorySize());
+    this->setResidency(Residency::eCoherent);
+}
+
+bool
+Tensor::isEvicted()
+{
+    if (this->mParent) {
+        return this->mParent->isEvicted();
+    }
+    return this->mEvicted;
+}
+
+void
+Tensor::pin()
+{
+    if (this->mParent) {
+        this->mParent->pin();
+        return;
+    }
+
+    this->mPinCount++;
+
+    if (this->mMemoryBudget) {
+        this->mMemoryBudget->touch(this);
+    }
+}
+
+void
+Tensor::unpin()
+{
+    if (this->mParent) {
+        this->mParent->unpin();
+        return;
+    }
+
+    if (this->mPinCount == 0) {
+        KP_LOG_WARN("Kompute Tensor unpin called on a tensor not pinned");
+        return;
+    }
+    this->mPinCount--;
+}
+
+bool
+Tensor::isPinned()
+{
+    if (this->mParent) {
+        return this->mParent->isPinned();
+    }
+    return this->mPinCount > 0;
+}
+
+uint64_t
+Tensor::getPrimaryBufferGeneration()
+{
+    if (this->mParent) {
+        return this->mParent->getPrimaryBufferGeneration();
+    }
+    return this->mPrimaryBufferGeneration;
+}
+
 void
 Tensor::allocateMemoryCreateGPUResources()
 {
@@ -339,6 +1216,14 @@ Tensor::allocateMemoryCreateGPUResources()
 
     KP_LOG_DEBUG("Kompute Tensor creating primary buffer and memory");
 
+    // Only the device memory of tensors of type eDevice is tracked, as it is
+    // the only memory that can be evicted to host memory
+    bool tracked =
+      this->mMemoryBudget && this->mMemoryType == MemoryTypes::eDevice;
+    if (tracked) {
+        this->mMemoryBudget->reserve(this->memorySize());
+    }
+
     this->mPrimaryBuffer = std::make_shared<vk::Buffer>();
     this->createBuffer(this->mPrimaryBuffer,
                        this->getPrimaryBufferUsageFlags());
@@ -346,26 +1231,213 @@ Tensor::allocateMemoryCreateGPUResources()
     this->mPrimaryMemory = std::make_shared<vk::DeviceMemory>();
     this->allocateBindMemory(this->mPrimaryBuffer,
                              this->mPrimaryMemory,
+                             this->mPrimaryAllocation,
                              this->getPrimaryMemoryPropertyFlags());
-    this->mFreePrimaryMemory = true;
+    this->mFreePrimaryMemory = !this->mPrimaryAllocation;
 
-    if (this->mMemoryType == MemoryTypes::eDevice) {
-        KP_LOG_DEBUG("Kompute Tensor creating staging buffer and memory");
+    if (tracked) {
+        this->mMemoryBudget->add(this, this->memorySize());
+    }
 
-        this->mStagingBuffer = std::make_shared<vk::Buffer>();
-        this->createBuffer(this->mStagingBuffer,
-                           this->getStagingBufferUsageFlags());
-        this->mFreeStagingBuffer = true;
-        this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
-        this->allocateBindMemory(this->mStagingBuffer,
-                                 this->mStagingMemory,
-                                 this->getStagingMemoryPropertyFlags());
-        this->mFreeStagingMemory = true;
+    if (this->mMemoryType == MemoryTypes::eDevice && this->mStagingRing &&
+        this->mMappedFile) {
+        KP_LOG_DEBUG("Kompute Tensor keeping data in the mapped file to "
+                     "stream through the staging ring");
+    } else if (this->mMemoryType == MemoryTypes::eDevice &&
+               this->mStagingRing) {
+        KP_LOG_DEBUG("Kompute Tensor keeping data in host memory to stream "
+                     "through the staging ring");
+
+        this->mHostData.resize(this->memorySize());
+    } else if (this->mMemoryType == MemoryTypes::eDevice &&
+               this->mStagingPolicy == StagingPolicy::eEager) {
+        this->allocateStagingMemory();
     }
 
     KP_LOG_DEBUG("Kompute Tensor buffer & memory creation successful");
 }
 
+bool
+Tensor::importHostMemory(void* data)
+{
+    if (!this->mPhysicalDevice) {
+        throw std::runtime_error("Kompute Tensor phyisical device is null");
+    }
+    if (!this->mDevice) {
+        throw std::runtime_error("Kompute Tensor device is null");
+    }
+    if (!data) {
+        return false;
+    }
+
+    // Only resolves if VK_EXT_external_memory_host is enabled on the device
+    PFN_vkGetMemoryHostPointerPropertiesEXT getMemoryHostPointerProperties =
+      reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+        this->mDevice->getProcAddr("vkGetMemoryHostPointerPropertiesEXT"));
+    vk::PhysicalDeviceProperties properties =
+      this->mPhysicalDevice->getProperties();
+    if (!getMemoryHostPointerProperties ||
+        KOMPUTE_VK_API_VERSION < VK_MAKE_VERSION(1, 1, 0) ||
+        properties.apiVersion < VK_MAKE_VERSION(1, 1, 0)) {
+        KP_LOG_INFO("Kompute Tensor VK_EXT_external_memory_host not enabled, "
+                    "copying host memory instead of importing it");
+        return false;
+    }
+
+    vk::DeviceSize alignment =
+      this->mPhysicalDevice
+        ->getProperties2<vk::PhysicalDeviceProperties2,
+                         vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+        .get<vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>()
+        .minImportedHostPointerAlignment;
+    vk::DeviceSize size = this->memorySize();
+    if (reinterpret_cast<uintptr_t>(data) % alignment != 0 ||
+        size % alignment != 0) {
+        KP_LOG_INFO("Kompute Tensor host memory of {} bytes is not aligned to "
+                    "the minImportedHostPointerAlignment of {} bytes, copying "
+                    "host memory instead of importing it",
+                    size,
+                    alignment);
+        return false;
+    }
+
+    VkMemoryHostPointerPropertiesEXT hostPointerProperties = {};
+    hostPointerProperties.sType =
+      VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT;
+    if (getMemoryHostPointerProperties(
+          *this->mDevice,
+          VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+          data,
+          &hostPointerProperties) != VK_SUCCESS) {
+        KP_LOG_INFO("Kompute Tensor host memory can not be imported, copying "
+                    "host memory instead of importing it");
+        return false;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor importing {} bytes of host memory", size);
+
+    vk::ExternalMemoryBufferCreateInfo externalMemoryInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT);
+    vk::BufferCreateInfo bufferInfo(vk::BufferCreateFlags(),
+                                    size,
+                                    this->getPrimaryBufferUsageFlags(),
+                                    vk::SharingMode::eExclusive);
+    bufferInfo.setPNext(&externalMemoryInfo);
+
+    std::shared_ptr<vk::Buffer> buffer = std::make_shared<vk::Buffer>();
+    this->mDevice->createBuffer(&bufferInfo, nullptr, buffer.get());
+
+    vk::MemoryRequirements memoryRequirements =
+      this->mDevice->getBufferMemoryRequirements(*buffer);
+    vk::MemoryPropertyFlags memoryPropertyFlags =
+      this->getPrimaryMemoryPropertyFlags();
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
+    uint32_t memoryTypeBits =
+      memoryRequirements.memoryTypeBits & hostPointerProperties.memoryTypeBits;
+    uint32_t memoryTypeIndex = -1;
+    bool memoryTypeIndexFound = false;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if (memoryTypeBits & (1 << i)) {
+            if (((memoryProperties.memoryTypes[i]).propertyFlags &
+                 memoryPropertyFlags) == memoryPropertyFlags) {
+                memoryTypeIndex = i;
+                memoryTypeIndexFound = true;
+                break;
+            }
+        }
+    }
+    if (!memoryTypeIndexFound || memoryRequirements.size > size) {
+        KP_LOG_INFO("Kompute Tensor no memory type can import the host "
+                    "memory, copying host memory instead of importing it");
+        this->mDevice->destroy(
+          *buffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        return false;
+    }
+
+    vk::ImportMemoryHostPointerInfoEXT importInfo(
+      vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT, data);
+    vk::MemoryAllocateInfo memoryAllocateInfo(size, memoryTypeIndex);
+    memoryAllocateInfo.setPNext(&importInfo);
+
+    std::shared_ptr<vk::DeviceMemory> memory =
+      std::make_shared<vk::DeviceMemory>();
+    if (this->mDevice->allocateMemory(
+          &memoryAllocateInfo, nullptr, memory.get()) != vk::Result::eSuccess) {
+        KP_LOG_INFO("Kompute Tensor failed to import host memory, copying "
+                    "host memory instead of importing it");
+        this->mDevice->destroy(
+          *buffer, (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+        return false;
+    }
+
+    this->mDevice->bindBufferMemory(*buffer, *memory, 0);
+
+    this->mPrimaryBuffer = buffer;
+    this->mFreePrimaryBuffer = true;
+    this->mPrimaryMemory = memory;
+    this->mFreePrimaryMemory = true;
+
+    // The host allocation is the memory of the tensor, so it is never mapped
+    this->mImportedHostData = data;
+    this->mRawData = data;
+
+    return true;
+}
+
+void
+Tensor::allocateStagingMemory()
+{
+    if (this->mParent) {
+        KP_LOG_DEBUG("Kompute Tensor view sharing staging buffer of parent");
+
+        this->mParent->ensureStagingMemory();
+        this->mStagingBuffer = this->mParent->mStagingBuffer;
+        this->mStagingMemory = this->mParent->mStagingMemory;
+        return;
+    }
+
+    KP_LOG_DEBUG("Kompute Tensor creating staging buffer and memory");
+
+    this->mStagingBuffer = std::make_shared<vk::Buffer>();
+    this->createBuffer(this->mStagingBuffer,
+                       this->getStagingBufferUsageFlags());
+    this->mFreeStagingBuffer = true;
+    this->mStagingMemory = std::make_shared<vk::DeviceMemory>();
+    this->allocateBindMemory(this->mStagingBuffer,
+                             this->mStagingMemory,
+                             this->mStagingAllocation,
+                             this->getStagingMemoryPropertyFlags());
+    this->mFreeStagingMemory = !this->mStagingAllocation;
+}
+
+void
+Tensor::destroyStagingMemory()
+{
+    if (this->mFreeStagingBuffer) {
+        if (!this->mStagingBuffer) {
+            KP_LOG_WARN("Kompose Tensor expected to destroy staging buffer "
+                        "but got null buffer");
+        } else {
+            KP_LOG_DEBUG("Kompose Tensor destroying staging buffer");
+            this->mDevice->destroy(
+              *this->mStagingBuffer,
+              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+            this->mStagingBuffer = nullptr;
+            this->mFreeStagingBuffer = false;
+        }
+    }
+
+    this->freeStagingMemory();
+
+    // Views only drop their reference to the staging buffer of the parent
+    if (this->mParent) {
+        this->mStagingBuffer = nullptr;
+        this->mStagingMemory = nullptr;
+    }
+}
+
 void
 Tensor::createBuffer(std::shared_ptr<vk::Buffer> buffer,
                      vk::BufferUsageFlags bufferUsageFlags)
@@ -395,17 +1467,30 @@ Tensor::createBuffer(std::shared_ptr<vk::Buffer> buffer,
 void
 Tensor::allocateBindMemory(std::shared_ptr<vk::Buffer> buffer,
                            std::shared_ptr<vk::DeviceMemory> memory,
+                           MemoryPool::Allocation& allocation,
                            vk::MemoryPropertyFlags memoryPropertyFlags)
 {
 
     KP_LOG_DEBUG("Kompute Tensor allocating and binding memory");
 
-    vk::PhysicalDeviceMemoryProperties memoryProperties =
-      this->mPhysicalDevice->getMemoryProperties();
-
     vk::MemoryRequirements memoryRequirements =
       this->mDevice->getBufferMemoryRequirements(*buffer);
 
+    if (this->mMemoryPool) {
+        allocation = this->mMemoryPool->allocate(
+          memoryRequirements, memoryPropertyFlags, true);
+        *memory = allocation.memory;
+
+        KP_LOG_DEBUG("Kompute Tensor binding pooled memory at offset {}",
+                     allocation.offset);
+
+        this->mDevice->bindBufferMemory(*buffer, *memory, allocation.offset);
+        return;
+    }
+
+    vk::PhysicalDeviceMemoryProperties memoryProperties =
+      this->mPhysicalDevice->getMemoryProperties();
+
     uint32_t memoryTypeIndex = -1;
     bool memoryTypeIndexFound = false;
     for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
@@ -448,6 +1533,11 @@ Tensor::destroy()
         return;
     }
 
+    if (this->mMemoryBudget) {
+        this->mMemoryBudget->remove(this);
+    }
+    this->mEvicted = false;
+
     if (this->mFreePrimaryBuffer) {
         if (!this->mPrimaryBuffer) {
             KP_LOG_WARN("Kompose Tensor expected to destroy primary buffer "
@@ -462,18 +1552,17 @@ Tensor::destroy()
         }
     }
 
-    if (this->mFreeStagingBuffer) {
-        if (!this->mStagingBuffer) {
-            KP_LOG_WARN("Kompose Tensor expected to destroy staging buffer "
-                        "but got null buffer");
-        } else {
-            KP_LOG_DEBUG("Kompose Tensor destroying staging buffer");
-            this->mDevice->destroy(
-              *this->mStagingBuffer,
-              (vk::Optional<const vk::AllocationCallbacks>)nullptr);
-            this->mStagingBuffer = nullptr;
-            this->mFreeStagingBuffer = false;
-        }
+    this->destroyStagingMemory();
+
+    // The imported host allocation is owned by the user
+    this->mImportedHostData = nullptr;
+    this->mMappedFile = nullptr;
+
+    if (this->mParent) {
+        KP_LOG_DEBUG("Kompute Tensor view releasing buffer of parent");
+        this->mPrimaryBuffer = nullptr;
+        this->mPrimaryMemory = nullptr;
+        this->mParent = nullptr;
     }
 
     Memory::destroy();
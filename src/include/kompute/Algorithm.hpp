@@ -9,6 +9,8 @@
 #include <fmt/format.h>
 #endif
 
+#include "kompute/DescriptorAllocator.hpp"
+#include "kompute/PipelineRegistry.hpp"
 #include "kompute/Tensor.hpp"
 #include "logger/Logger.hpp"
 
@@ -21,6 +23,18 @@ namespace kp {
 class Algorithm
 {
   public:
+    /**
+     * Access performed by the shader on the memory object bound to a
+     * binding, which sequences use to record only the barriers required
+     * between operations.
+     */
+    enum class BindingAccess
+    {
+        eReadWrite = 0, ///< The shader may read and write the memory object
+        eReadOnly = 1,  ///< The shader only reads the memory object
+        eWriteOnly = 2, ///< The shader only writes the memory object
+    };
+
     /**
      *  Main constructor for algorithm with configuration parameters to create
      *  the underlying resources.
@@ -38,6 +52,15 @@ class Algorithm
      * when initializing the pipeline, which set the size of the push constants
      * - these can be modified but all new values must have the same data type
      * and length as otherwise it will result in errors.
+     *  @param pipelineCache (optional) Pipeline cache shared with other
+     * algorithms, which is not destroyed by the algorithm. If not provided a
+     * pipeline cache owned by the algorithm is created.
+     *  @param pipelineRegistry (optional) Registry used to share the shader
+     * module, pipeline layout and pipeline with other algorithms built with
+     * the same parameters.
+     *  @param descriptorAllocator (optional) Allocator to allocate the
+     * descriptor sets from. If not provided a descriptor pool owned by the
+     * algorithm is created for each descriptor set.
      */
     template<typename S = float, typename P = float>
     Algorithm(std::shared_ptr<vk::Device> device,
@@ -45,11 +68,22 @@ class Algorithm
               const std::vector<uint32_t>& spirv = {},
               const Workgroup& workgroup = {},
               const std::vector<S>& specializationConstants = {},
-              const std::vector<P>& pushConstants = {}) noexcept
+              const std::vector<P>& pushConstants = {},
+              std::shared_ptr<vk::PipelineCache> pipelineCache = nullptr,
+              std::shared_ptr<PipelineRegistry> pipelineRegistry = nullptr,
+              std::shared_ptr<DescriptorAllocator> descriptorAllocator =
+                nullptr) noexcept
     {
         KP_LOG_DEBUG("Kompute Algorithm Constructor with device");
 
         this->mDevice = device;
+        this->mPipelineRegistry = pipelineRegistry;
+        this->mDescriptorAllocator = descriptorAllocator;
+
+        if (pipelineCache) {
+            this->mPipelineCache = pipelineCache;
+            this->mFreePipelineCache = false;
+        }
 
         if (memObjects.size() && spirv.size()) {
             KP_LOG_INFO(
@@ -96,6 +130,8 @@ class Algorithm
 
         this->mMemObjects = memObjects;
         this->mSpirv = spirv;
+        // Annotations of a previous shader may not apply to the new one
+        this->mBindingAccesses.clear();
 
         if (specializationConstants.size()) {
             if (this->mSpecializationConstantsData) {
@@ -136,9 +172,11 @@ class Algorithm
             this->destroy();
         }
 
+        this->acquireRegisteredPipeline();
         this->createParameters();
         this->createShaderModule();
         this->createPipeline();
+        this->registerPipeline();
     }
 
     /**
@@ -198,8 +236,10 @@ class Algorithm
      * It must have a value greater than 1 on the x value (index 1) otherwise it
      * will be initialized on the size of the first tensor (ie.
      * this->mTensor[0]->size())
+     * @param minSize The x value used when none is provided, which has to fit
+     * in the 32-bit dispatch size
      */
-    void setWorkgroup(const Workgroup& workgroup, uint32_t minSize = 1);
+    void setWorkgroup(const Workgroup& workgroup, uint64_t minSize = 1);
     /**
      * Sets the push constants to the new value provided to use in the next
      * bindPush()
@@ -289,6 +329,73 @@ class Algorithm
      */
     const std::vector<std::shared_ptr<Memory>>& getMemObjects();
 
+    /**
+     * Points the active descriptor set to the memory objects provided without
+     * rebuilding the shader module or the pipeline. The memory objects must
+     * match the ones the algorithm was built with in number and descriptor
+     * type. The descriptor set is updated in place, so it must not be in use
+     * by a running sequence and sequences that recorded this algorithm have to
+     * record it again.
+     *
+     * @param memObjects The memory objects to bind to the active descriptor
+     * set
+     */
+    void rebind(const std::vector<std::shared_ptr<Memory>>& memObjects);
+
+    /**
+     * Allocates an additional descriptor set pointing to the memory objects
+     * provided, which is compatible with the pipeline of this algorithm.
+     * Switching between pre-built descriptor sets with setDescriptorSet, for
+     * example to swap ping-pong buffers between dispatches, does not require
+     * any descriptor update.
+     *
+     * @param memObjects The memory objects to bind to the new descriptor set,
+     * which must match the ones the algorithm was built with in number and
+     * descriptor type
+     * @returns The index of the new descriptor set
+     */
+    uint32_t addDescriptorSet(
+      const std::vector<std::shared_ptr<Memory>>& memObjects);
+
+    /**
+     * Selects the descriptor set bound by recordBindCore. The memory objects
+     * of the selected descriptor set become the ones returned by
+     * getMemObjects, which operations use to record their barriers.
+     *
+     * @param index The index of the descriptor set, where 0 is the descriptor
+     * set created when the algorithm was built
+     */
+    void setDescriptorSet(uint32_t index);
+
+    /**
+     * Gets the number of descriptor sets available to setDescriptorSet.
+     *
+     * @returns The number of descriptor sets of the algorithm
+     */
+    uint32_t getDescriptorSetCount();
+
+    /**
+     * Annotates how the shader accesses the memory object bound to a
+     * binding. Bindings that are not annotated are assumed to be read and
+     * written, and annotating read only bindings allows sequences to skip the
+     * barriers between dispatches that only read the same memory object. The
+     * annotations are cleared when the algorithm is rebuilt.
+     *
+     * @param binding The index of the binding in the memory objects
+     * @param access The access the shader performs on the binding
+     */
+    void setBindingAccess(uint32_t binding, BindingAccess access);
+
+    /**
+     * Gets the access the shader performs on the memory object bound to a
+     * binding.
+     *
+     * @param binding The index of the binding in the memory objects
+     * @returns The access annotated for the binding, or eReadWrite if the
+     * binding was not annotated
+     */
+    BindingAccess getBindingAccess(uint32_t binding);
+
     void destroy();
 
   private:
@@ -312,6 +419,21 @@ class Algorithm
     std::shared_ptr<vk::Pipeline> mPipeline;
     bool mFreePipeline = false;
 
+    // -------------- ALWAYS OWNED DESCRIPTOR SETS
+    std::vector<std::shared_ptr<vk::DescriptorPool>> mExtraDescriptorPools;
+    std::vector<DescriptorAllocator::Allocation> mDescriptorAllocations;
+    std::vector<std::shared_ptr<vk::DescriptorSet>> mDescriptorSets;
+    std::vector<std::vector<std::shared_ptr<Memory>>> mDescriptorSetMemObjects;
+    // Generations of the tensor buffers each descriptor set was updated with
+    std::vector<std::vector<uint64_t>> mDescriptorSetGenerations;
+    uint32_t mDescriptorSetIndex = 0;
+
+    // -------------- SHARED RESOURCES
+    std::shared_ptr<DescriptorAllocator> mDescriptorAllocator;
+    std::shared_ptr<PipelineRegistry> mPipelineRegistry;
+    PipelineRegistry::Key mPipelineKey;
+    bool mRegisteredPipeline = false;
+
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<uint32_t> mSpirv;
     void* mSpecializationConstantsData = nullptr;
@@ -321,13 +443,26 @@ class Algorithm
     uint32_t mPushConstantsDataTypeMemorySize = 0;
     uint32_t mPushConstantsSize = 0;
     Workgroup mWorkgroup;
+    std::vector<BindingAccess> mBindingAccesses;
 
     // Create util functions
     void createShaderModule();
     void createPipeline();
+    void acquireRegisteredPipeline();
+    void registerPipeline();
 
     // Parameters
     void createParameters();
+    std::shared_ptr<vk::DescriptorSet> allocateDescriptorSet();
+    std::vector<vk::DescriptorPoolSize> getDescriptorCounts();
+    std::shared_ptr<vk::DescriptorPool> createDescriptorPool();
+    void updateDescriptorSet(
+      const vk::DescriptorSet& descriptorSet,
+      const std::vector<std::shared_ptr<Memory>>& memObjects);
+    void checkCompatibleMemObjects(
+      const std::vector<std::shared_ptr<Memory>>& memObjects);
+    static std::vector<uint64_t> primaryBufferGenerations(
+      const std::vector<std::shared_ptr<Memory>>& memObjects);
 };
 
 } // End namespace kp
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <vector>
+
+namespace kp {
+
+/**
+ * Collection of buffer and image memory barriers that are recorded together
+ * with a single pipelineBarrier call.
+ *
+ * Memory objects add their barriers to the batch instead of recording them
+ * one at a time, and the operation recording them flushes the batch before
+ * the commands that depend on the barriers. The source and destination stage
+ * masks of the pipelineBarrier call are the union of the stage masks of all
+ * the barriers in the batch.
+ */
+class BarrierBatch
+{
+  public:
+    /**
+     * Default constructor for an empty batch.
+     */
+    BarrierBatch() = default;
+
+    /**
+     * Adds a buffer memory barrier to the batch.
+     *
+     * @param bufferMemoryBarrier The buffer memory barrier to record
+     * @param srcStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void addBufferMemoryBarrier(
+      const vk::BufferMemoryBarrier& bufferMemoryBarrier,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask);
+
+    /**
+     * Adds an image memory barrier to the batch.
+     *
+     * @param imageMemoryBarrier The image memory barrier to record
+     * @param srcStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void addImageMemoryBarrier(const vk::ImageMemoryBarrier& imageMemoryBarrier,
+                               vk::PipelineStageFlags srcStageMask,
+                               vk::PipelineStageFlags dstStageMask);
+
+    /**
+     * Records all the barriers of the batch into the command buffer with a
+     * single pipelineBarrier call and clears the batch. Nothing is recorded if
+     * the batch is empty.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the barriers into
+     */
+    void flush(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Drops all the barriers of the batch without recording them.
+     */
+    void clear();
+
+    /**
+     * Returns true if there are no barriers in the batch.
+     *
+     * @return Boolean stating whether the batch is empty
+     */
+    bool empty() const;
+
+    /**
+     * Returns the number of buffer and image barriers in the batch.
+     *
+     * @return Number of barriers waiting to be flushed
+     */
+    uint32_t size() const;
+
+  private:
+    std::vector<vk::BufferMemoryBarrier> mBufferMemoryBarriers;
+    std::vector<vk::ImageMemoryBarrier> mImageMemoryBarriers;
+    vk::PipelineStageFlags mSrcStageMask;
+    vk::PipelineStageFlags mDstStageMask;
+};
+
+} // End namespace kp
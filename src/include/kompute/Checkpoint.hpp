@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+
+namespace kp {
+
+/**
+ * Header of the tensor checkpoints written by Manager::saveTensors and read
+ * by Manager::loadTensors. A checkpoint starts with this header, followed by
+ * a CheckpointEntry for each tensor, followed by the raw data of each tensor
+ * at the offset of its entry. The offsets are aligned to the alignment of the
+ * checkpoint, so the data can be memory mapped and imported as it is.
+ *
+ * All the fields are stored in the byte order of the host, which is little
+ * endian on all the platforms supported.
+ */
+struct CheckpointHeader
+{
+    // "KPCK" stored in little endian
+    static constexpr uint32_t magicNumber = 0x4b43504b;
+    static constexpr uint32_t currentVersion = 1;
+    // Alignment in bytes of the offsets of the data of the tensors
+    static constexpr uint64_t alignment = 4096;
+
+    uint32_t magic;
+    uint32_t version;
+    uint64_t tensorCount;
+};
+
+/**
+ * Description of a tensor stored in a checkpoint, see CheckpointHeader.
+ */
+struct CheckpointEntry
+{
+    uint32_t dataType;          ///< Memory::DataTypes of the tensor
+    uint32_t memoryType;        ///< Memory::MemoryTypes of the tensor
+    uint32_t elementMemorySize; ///< Size in bytes of each element
+    uint32_t reserved;          ///< Always 0
+    uint64_t size;              ///< Number of elements of the tensor
+    uint64_t offset;            ///< Offset in bytes of the data in the file
+};
+
+static_assert(sizeof(CheckpointHeader) == 16,
+              "kp::CheckpointHeader has to be stored as 16 bytes");
+static_assert(sizeof(CheckpointEntry) == 32,
+              "kp::CheckpointEntry has to be stored as 32 bytes");
+
+} // End namespace kp
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Number of descriptor sets each descriptor pool page can hold
+#define KP_DEFAULT_DESCRIPTOR_ALLOCATOR_PAGE_SIZE 64
+
+// Descriptors of each type reserved per descriptor set in a page
+#define KP_DESCRIPTOR_ALLOCATOR_DESCRIPTORS_PER_SET 8
+
+namespace kp {
+
+/**
+ * Descriptor set allocator shared by the Algorithms of a Manager.
+ *
+ * Instead of creating one descriptor pool sized for a single descriptor set
+ * per algorithm, the allocator hands out descriptor sets from pages of
+ * descriptor pools which are created on demand. Descriptor sets are returned
+ * to their page when algorithms are destroyed so they can be reused. Pages
+ * are destroyed as soon as they become empty, except for the last one which
+ * is reset instead to avoid re-creating it when algorithms are created and
+ * destroyed in a loop.
+ */
+class DescriptorAllocator
+{
+  public:
+    /**
+     * Descriptor set handed out by the allocator together with the page and
+     * descriptors it was allocated from.
+     */
+    struct Allocation
+    {
+        vk::DescriptorSet descriptorSet = nullptr;
+        uint64_t pageId = 0;
+        std::vector<vk::DescriptorPoolSize> descriptorCounts;
+
+        explicit operator bool() const { return (bool)this->descriptorSet; }
+    };
+
+    /**
+     * Constructor for the descriptor allocator.
+     *
+     * @param device The device to create the descriptor pools from
+     * @param pageSize The number of descriptor sets of each descriptor pool
+     */
+    DescriptorAllocator(
+      std::shared_ptr<vk::Device> device,
+      uint32_t pageSize = KP_DEFAULT_DESCRIPTOR_ALLOCATOR_PAGE_SIZE);
+
+    /**
+     * @brief Make DescriptorAllocator uncopyable
+     *
+     */
+    DescriptorAllocator(const DescriptorAllocator&) = delete;
+    DescriptorAllocator(const DescriptorAllocator&&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&) = delete;
+    DescriptorAllocator& operator=(const DescriptorAllocator&&) = delete;
+
+    /**
+     * Destructor which destroys all the descriptor pools of the allocator.
+     */
+    ~DescriptorAllocator();
+
+    /**
+     * Allocates a descriptor set with the layout provided.
+     *
+     * @param descriptorSetLayout The layout of the descriptor set
+     * @param descriptorCounts The number of descriptors of each type in the
+     * layout
+     * @return The allocated descriptor set
+     */
+    Allocation allocate(
+      const vk::DescriptorSetLayout& descriptorSetLayout,
+      const std::vector<vk::DescriptorPoolSize>& descriptorCounts);
+
+    /**
+     * Returns the descriptor set provided back to its page. The descriptor
+     * set must not be in use by any command buffer pending execution.
+     *
+     * @param allocation The descriptor set to release
+     */
+    void free(const Allocation& allocation);
+
+    /**
+     * Destroys all the descriptor pools. Any descriptor set still in use
+     * becomes invalid.
+     */
+    void destroy();
+
+    /**
+     * Returns the number of descriptor sets each page can hold.
+     *
+     * @return Page size in descriptor sets
+     */
+    uint32_t pageSize();
+
+    /**
+     * Returns the number of descriptor pools currently created.
+     *
+     * @return Number of pages alive in the allocator
+     */
+    uint32_t pageCount();
+
+    /**
+     * Returns the number of descriptor sets currently handed out.
+     *
+     * @return Number of live descriptor sets
+     */
+    uint32_t setCount();
+
+    /**
+     * Returns the number of descriptor sets allocated since the allocator
+     * was created, including the ones already released.
+     *
+     * @return Number of descriptor set allocations
+     */
+    uint64_t totalSetCount();
+
+  private:
+    struct Page
+    {
+        uint64_t id = 0;
+        vk::DescriptorPool descriptorPool = nullptr;
+        uint32_t maxSets = 0;
+        uint32_t setCount = 0;
+        std::map<vk::DescriptorType, uint32_t> capacity;
+        std::map<vk::DescriptorType, uint32_t> used;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint32_t mPageSize;
+    std::map<uint64_t, std::unique_ptr<Page>> mPages;
+    uint64_t mNextPageId = 1;
+    uint32_t mSetCount = 0;
+    uint64_t mTotalSetCount = 0;
+    std::mutex mMutex;
+
+    Page* createPage(
+      const std::vector<vk::DescriptorPoolSize>& descriptorCounts);
+    void destroyPage(uint64_t pageId);
+    bool hasCapacity(
+      const Page& page,
+      const std::vector<vk::DescriptorPoolSize>& descriptorCounts);
+    bool allocateFromPage(Page& page,
+                          const vk::DescriptorSetLayout& descriptorSetLayout,
+                          vk::DescriptorSet& descriptorSet);
+};
+
+} // End namespace kp
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/Sequence.hpp"
+#include "logger/Logger.hpp"
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Nanoseconds the waiter thread waits on the fences of the pending sequences
+// before picking up the sequences added in the meantime, when it cannot wait
+// on their timeline semaphores instead
+#define KP_DEFAULT_FENCE_WAITER_TIMEOUT 1000000
+
+namespace kp {
+
+/**
+ * Waits on a single thread for the submissions of many sequences to complete,
+ * so the threads submitting them do not have to block on their fences.
+ *
+ * The thread is started when the first sequence is added, and waits on the
+ * fences of all the pending sequences at once with vkWaitForFences without
+ * waiting for all of them. Once all the running submissions of a sequence
+ * completed, the thread awaits the sequence, which runs the postEval of its
+ * operations, then runs the callback provided with the sequence, if any, and
+ * makes the future of the sequence ready, or stores the exception thrown by
+ * either in the future.
+ *
+ * The thread sleeps on a condition variable while no sequence is pending.
+ * When timeline semaphores can be waited on from the host, the thread waits
+ * without timeout on the timeline semaphores of the pending sequences
+ * together with a timeline semaphore of its own, which is signalled from the
+ * host when a sequence is added so the thread picks it up straight away.
+ * Otherwise, since vkWaitForFences cannot be interrupted, the thread waits on
+ * the fences with a short timeout, after which it picks up the sequences
+ * added in the meantime.
+ */
+class FenceWaiter
+{
+  public:
+    /**
+     * Constructor for the fence waiter, which does not start the thread yet.
+     *
+     * @param device The device the fences of the sequences are created on
+     * @param hostTimelineSemaphores Whether timeline semaphores can be waited
+     * on and signalled from the host, which is core in Vulkan 1.2
+     * @param timeout Nanoseconds the thread waits on the fences before
+     * picking up the sequences added in the meantime, when it cannot wait on
+     * the timeline semaphores of the sequences instead
+     */
+    FenceWaiter(std::shared_ptr<vk::Device> device,
+                bool hostTimelineSemaphores = false,
+                uint64_t timeout = KP_DEFAULT_FENCE_WAITER_TIMEOUT);
+
+    /**
+     * @brief Make FenceWaiter uncopyable
+     *
+     */
+    FenceWaiter(const FenceWaiter&) = delete;
+    FenceWaiter(const FenceWaiter&&) = delete;
+    FenceWaiter& operator=(const FenceWaiter&) = delete;
+    FenceWaiter& operator=(const FenceWaiter&&) = delete;
+
+    /**
+     * Destructor which waits for the pending sequences and stops the thread.
+     */
+    ~FenceWaiter();
+
+    /**
+     * Adds a sequence whose submissions are running to be awaited by the
+     * thread. The sequence must not be evaluated, awaited or recorded again
+     * until its future is ready.
+     *
+     * @param sequence The sequence to await, which has to be running
+     * @param callback Function run on the thread once the sequence was
+     * awaited, before the future is ready
+     * @return Future that is ready once the sequence was awaited and the
+     * callback ran
+     */
+    std::future<void> add(std::shared_ptr<Sequence> sequence,
+                          std::function<void()> callback = nullptr);
+
+    /**
+     * The number of sequences added whose future is not ready yet.
+     *
+     * @return Number of pending sequences
+     */
+    uint32_t pendingCount();
+
+    /**
+     * Waits for the pending sequences to be awaited and stops the thread. No
+     * sequence can be added after this call. Callbacks must not call this
+     * function, as it would wait for the thread running them.
+     */
+    void destroy();
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<Sequence> sequence;
+        std::vector<vk::Fence> fences;
+        // Timeline semaphore value signalled by the last submission
+        vk::Semaphore semaphore;
+        uint64_t value = 0;
+        std::function<void()> callback;
+        std::promise<void> promise;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    uint64_t mTimeout = KP_DEFAULT_FENCE_WAITER_TIMEOUT;
+    // Signalled from the host to wake the thread up, if supported
+    vk::Semaphore mWakeSemaphore;
+    uint64_t mWakeValue = 0;
+    std::list<Entry> mEntries;
+    uint32_t mPendingCount = 0;
+    std::thread mThread;
+    bool mStopping = false;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+
+    // Loop of the thread, which returns once stopping without any entry left
+    void run();
+    // Waits until an entry may have completed or the thread was woken up,
+    // returning false on timeout, called without holding the lock
+    bool wait(const std::vector<vk::Fence>& fences,
+              std::vector<vk::Semaphore>& semaphores,
+              std::vector<uint64_t>& values);
+    // Wakes the thread up if it is waiting on the timeline semaphores,
+    // called while holding the lock
+    void wake();
+    // Awaits the sequence of an entry and fulfils its promise
+    void complete(Entry& entry);
+};
+
+} // End namespace kp
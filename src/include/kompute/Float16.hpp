@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+
+namespace kp {
+
+/**
+ * IEEE 754 half precision float, stored as its 16 bits. It is converted to
+ * and from float on the host with round to nearest even, and can be used as
+ * the element type of tensors and images of type eHalf.
+ */
+struct Half
+{
+    uint16_t bits = 0;
+
+    Half() = default;
+    Half(float value)
+      : bits(Half::fromFloat(value))
+    {
+    }
+
+    operator float() const { return Half::toFloat(this->bits); }
+
+    /**
+     * Converts a float to the bits of the closest half, overflowing to
+     * infinity and keeping NaNs as quiet NaNs.
+     *
+     * @param value The float to convert
+     * @return The bits of the half
+     */
+    static uint16_t fromFloat(float value);
+
+    /**
+     * Converts the bits of a half to a float, which is always exact.
+     *
+     * @param bits The bits of the half
+     * @return The float with the same value
+     */
+    static float toFloat(uint16_t bits);
+};
+
+/**
+ * Brain float, which keeps the 8-bit exponent of a float with a 7-bit
+ * mantissa, stored as its 16 bits. It is converted to and from float on the
+ * host with round to nearest even, and can be used as the element type of
+ * tensors of type eBFloat16.
+ */
+struct BFloat16
+{
+    uint16_t bits = 0;
+
+    BFloat16() = default;
+    BFloat16(float value)
+      : bits(BFloat16::fromFloat(value))
+    {
+    }
+
+    operator float() const { return BFloat16::toFloat(this->bits); }
+
+    /**
+     * Converts a float to the bits of the closest bfloat16, keeping NaNs as
+     * quiet NaNs.
+     *
+     * @param value The float to convert
+     * @return The bits of the bfloat16
+     */
+    static uint16_t fromFloat(float value);
+
+    /**
+     * Converts the bits of a bfloat16 to a float, which is always exact.
+     *
+     * @param bits The bits of the bfloat16
+     * @return The float with the same value
+     */
+    static float toFloat(uint16_t bits);
+};
+
+static_assert(sizeof(Half) == sizeof(uint16_t),
+              "kp::Half has to be stored as 16 bits");
+static_assert(sizeof(BFloat16) == sizeof(uint16_t),
+              "kp::BFloat16 has to be stored as 16 bits");
+
+} // End namespace kp
@@ -34,6 +34,10 @@ class Image : public Memory
      *  @param dataType Data type for the image which is of type DataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
      *  @param tiling Tiling mode to use for the image.
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -44,8 +48,19 @@ class Image : public Memory
           uint32_t numChannels,
           const DataTypes& dataType,
           vk::ImageTiling tiling,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
-      : Memory(physicalDevice, device, dataType, memoryType, x, y)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          std::shared_ptr<StagingRing> stagingRing = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
+      : Memory(physicalDevice,
+               device,
+               dataType,
+               memoryType,
+               x,
+               y,
+               memoryPool,
+               stagingRing,
+               stagingPolicy)
     {
         if (dataType == DataTypes::eCustom) {
             throw std::runtime_error(
@@ -65,6 +80,10 @@ class Image : public Memory
      *  @param dataType Data type for the image which is of type ImageDataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
      *  @param tiling Tiling mode to use for the image.
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -73,7 +92,10 @@ class Image : public Memory
           uint32_t numChannels,
           const DataTypes& dataType,
           vk::ImageTiling tiling,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          std::shared_ptr<StagingRing> stagingRing = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
       : Image(physicalDevice,
               device,
               nullptr,
@@ -83,7 +105,10 @@ class Image : public Memory
               numChannels,
               dataType,
               tiling,
-              memoryType)
+              memoryType,
+              memoryPool,
+              stagingRing,
+              stagingPolicy)
     {
     }
 
@@ -101,6 +126,10 @@ class Image : public Memory
      *  @param numChannels The number of channels in the image
      *  @param dataType Data type for the image which is of type DataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -110,8 +139,19 @@ class Image : public Memory
           uint32_t y,
           uint32_t numChannels,
           const DataTypes& dataType,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
-      : Memory(physicalDevice, device, dataType, memoryType, x, y)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          std::shared_ptr<StagingRing> stagingRing = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
+      : Memory(physicalDevice,
+               device,
+               dataType,
+               memoryType,
+               x,
+               y,
+               memoryPool,
+               stagingRing,
+               stagingPolicy)
     {
         vk::ImageTiling tiling;
 
@@ -144,6 +184,10 @@ class Image : public Memory
      *  @param y Height of the image in pixels
      *  @param dataType Data type for the image which is of type ImageDataTypes
      *  @param memoryType Type for the image which is of type MemoryTypes
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
      */
     Image(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
           std::shared_ptr<vk::Device> device,
@@ -151,7 +195,10 @@ class Image : public Memory
           uint32_t y,
           uint32_t numChannels,
           const DataTypes& dataType,
-          const MemoryTypes& memoryType = MemoryTypes::eDevice)
+          const MemoryTypes& memoryType = MemoryTypes::eDevice,
+          std::shared_ptr<MemoryPool> memoryPool = nullptr,
+          std::shared_ptr<StagingRing> stagingRing = nullptr,
+          const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
       : Image(physicalDevice,
               device,
               nullptr,
@@ -160,7 +207,10 @@ class Image : public Memory
               y,
               numChannels,
               dataType,
-              memoryType)
+              memoryType,
+              memoryPool,
+              stagingRing,
+              stagingPolicy)
     {
     }
 
@@ -234,6 +284,22 @@ class Image : public Memory
     void recordCopyFromDeviceToStaging(
       const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Uploads the host data of the image into its primary image through the
+     * staging ring, one chunk of whole rows at a time. The image is
+     * transitioned back to its previous layout after each chunk, or to
+     * eGeneral if its layout was undefined.
+     */
+    void streamToDevice() override;
+
+    /**
+     * Downloads the primary image into the host data of the image through the
+     * staging ring, one chunk of whole rows at a time. The image is
+     * transitioned back to its previous layout after each chunk, or to
+     * eGeneral if its layout was undefined.
+     */
+    void streamFromDevice() override;
+
     /**
      * Records the image memory barrier into the primary image and command
      * buffer which ensures that relevant data transfers are carried out
@@ -288,6 +354,59 @@ class Image : public Memory
                                    vk::PipelineStageFlagBits dstStageMask,
                                    vk::ImageLayout dstLayout);
 
+    /**
+     * Adds the memory barrier of the primary image to the batch provided,
+     * keeping its current layout.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void recordPrimaryMemoryBarrier(
+      BarrierBatch& barrierBatch,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask) override;
+    /**
+     * Adds the memory barrier of the staging image to the batch provided,
+     * keeping its current layout.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void recordStagingMemoryBarrier(
+      BarrierBatch& barrierBatch,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask) override;
+
+    /**
+     * Adds the memory barrier of the primary image to the batch provided,
+     * transitioning the image to the layout provided. The layout of the image
+     * is updated straight away, so the batch has to be flushed before any
+     * command that uses the image is recorded.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     * @param dstLayout Image layout for the image after the barrier completes
+     */
+    void recordPrimaryImageBarrier(BarrierBatch& barrierBatch,
+                                   vk::AccessFlags srcAccessMask,
+                                   vk::AccessFlags dstAccessMask,
+                                   vk::PipelineStageFlags srcStageMask,
+                                   vk::PipelineStageFlags dstStageMask,
+                                   vk::ImageLayout dstLayout);
+
     /**
      * Adds this object to a Vulkan descriptor set at \p binding.
      *
@@ -328,12 +447,16 @@ class Image : public Memory
     bool mFreeStagingImage = false;
 
     void allocateMemoryCreateGPUResources(); // Creates the vulkan image
+    void allocateStagingMemory() override;
+    void destroyStagingMemory() override;
     void createImage(std::shared_ptr<vk::Image> image,
                      vk::ImageUsageFlags imageUsageFlags,
                      vk::ImageTiling imageTiling);
     void allocateBindMemory(std::shared_ptr<vk::Image> image,
                             std::shared_ptr<vk::DeviceMemory> memory,
-                            vk::MemoryPropertyFlags memoryPropertyFlags);
+                            MemoryPool::Allocation& allocation,
+                            vk::MemoryPropertyFlags memoryPropertyFlags,
+                            vk::ImageTiling imageTiling);
     void recordCopyImage(const vk::CommandBuffer& commandBuffer,
                          std::shared_ptr<vk::Image> srcImage,
                          std::shared_ptr<vk::Image> dstImage,
@@ -365,6 +488,13 @@ class Image : public Memory
                                    vk::PipelineStageFlagBits dstStageMask,
                                    vk::ImageLayout dstLayout);
 
+    void recordStagingImageBarrier(BarrierBatch& barrierBatch,
+                                   vk::AccessFlags srcAccessMask,
+                                   vk::AccessFlags dstAccessMask,
+                                   vk::PipelineStageFlags srcStageMask,
+                                   vk::PipelineStageFlags dstStageMask,
+                                   vk::ImageLayout dstLayout);
+
     void recordImageMemoryBarrier(const vk::CommandBuffer& commandBuffer,
                                   const vk::Image& image,
                                   vk::AccessFlagBits srcAccessMask,
@@ -373,6 +503,12 @@ class Image : public Memory
                                   vk::PipelineStageFlagBits dstStageMask,
                                   vk::ImageLayout oldLayout,
                                   vk::ImageLayout newLayout);
+    vk::ImageMemoryBarrier createImageMemoryBarrier(
+      const vk::Image& image,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::ImageLayout oldLayout,
+      vk::ImageLayout newLayout);
 
     // Private util functions
     vk::ImageUsageFlags getPrimaryImageUsageFlags();
@@ -405,7 +541,10 @@ class ImageT : public Image
            uint32_t y,
            uint32_t numChannels,
            vk::ImageTiling tiling,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
       : Image(physicalDevice,
               device,
               (void*)data.data(),
@@ -415,7 +554,10 @@ class ImageT : public Image
               numChannels,
               Memory::dataType<T>(),
               tiling,
-              imageType)
+              imageType,
+              memoryPool,
+              stagingRing,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -435,7 +577,10 @@ class ImageT : public Image
            uint32_t x,
            uint32_t y,
            uint32_t numChannels,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
       : Image(physicalDevice,
               device,
               (void*)data.data(),
@@ -444,7 +589,10 @@ class ImageT : public Image
               y,
               numChannels,
               Memory::dataType<T>(),
-              imageType)
+              imageType,
+              memoryPool,
+              stagingRing,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -464,7 +612,10 @@ class ImageT : public Image
            uint32_t y,
            uint32_t numChannels,
            vk::ImageTiling tiling,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
       : Image(physicalDevice,
               device,
               x,
@@ -472,7 +623,10 @@ class ImageT : public Image
               numChannels,
               Memory::dataType<T>(),
               tiling,
-              imageType)
+              imageType,
+              memoryPool,
+              stagingRing,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -490,14 +644,20 @@ class ImageT : public Image
            uint32_t x,
            uint32_t y,
            uint32_t numChannels,
-           const MemoryTypes& imageType = MemoryTypes::eDevice)
+           const MemoryTypes& imageType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager)
       : Image(physicalDevice,
               device,
               x,
               y,
               numChannels,
               Memory::dataType<T>(),
-              imageType)
+              imageType,
+              memoryPool,
+              stagingRing,
+              stagingPolicy)
     {
         // Images cannot be created with custom types
         static_assert(Memory::dataType<T>() != DataTypes::eCustom,
@@ -1,15 +1,30 @@
 #pragma once
 
 #include "Algorithm.hpp"
+#include "BarrierBatch.hpp"
+#include "Checkpoint.hpp"
 #include "Core.hpp"
+#include "DescriptorAllocator.hpp"
+#include "FenceWaiter.hpp"
+#include "Float16.hpp"
 #include "Image.hpp"
 #include "Manager.hpp"
+#include "MappedFile.hpp"
+#include "MemoryBudget.hpp"
+#include "MemoryPool.hpp"
+#include "PipelineRegistry.hpp"
+#include "Quantization.hpp"
+#include "ResourceStateTracker.hpp"
 #include "Sequence.hpp"
+#include "StagingRing.hpp"
+#include "StreamingExecutor.hpp"
 #include "Tensor.hpp"
 
 #include "operations/OpAlgoDispatch.hpp"
 #include "operations/OpBase.hpp"
+#include "operations/OpConvert.hpp"
 #include "operations/OpCopy.hpp"
+#include "operations/OpDequantize.hpp"
 #include "operations/OpMemoryBarrier.hpp"
 #include "operations/OpMult.hpp"
 #include "operations/OpSyncDevice.hpp"
@@ -17,4 +32,6 @@
 
 // Will be build by CMake and placed inside the build directory
 #include "ShaderLogisticRegression.hpp"
+#include "ShaderOpConvert.hpp"
+#include "ShaderOpDequantize.hpp"
 #include "ShaderOpMult.hpp"
@@ -3,8 +3,12 @@
 
 #include "kompute/Core.hpp"
 
+#include "kompute/Checkpoint.hpp"
+#include "kompute/FenceWaiter.hpp"
 #include "kompute/Image.hpp"
+#include "kompute/MemoryBudget.hpp"
 #include "kompute/Sequence.hpp"
+#include "kompute/StreamingExecutor.hpp"
 #include "logger/Logger.hpp"
 
 #define KP_DEFAULT_SESSION "DEFAULT"
@@ -39,7 +43,9 @@ class Manager
 
     /**
      * Manager constructor which allows your own vulkan application to integrate
-     * with the kompute use.
+     * with the kompute use. Sequences created by this manager wait on each
+     * other with binary semaphores, as whether timeline semaphores were
+     * enabled on the device is not known.
      *
      * @param instance Vulkan compute instance to base this application
      * @param physicalDevice Vulkan physical device to use for application
@@ -73,10 +79,79 @@ class Manager
      * @param queueIndex The queue to use from the available queues
      * @param nrOfTimestamps The maximum number of timestamps to allocate.
      * If zero (default), disables latching of timestamps.
+     * @param slotCount The number of command buffer and fence slots the
+     * evaluations of the sequence cycle through, so up to that many
+     * evaluations can run while the next one is prepared
      * @returns Shared pointer with initialised sequence
      */
     std::shared_ptr<Sequence> sequence(uint32_t queueIndex = 0,
-                                       uint32_t totalTimestamps = 0);
+                                       uint32_t totalTimestamps = 0,
+                                       uint32_t slotCount = 1);
+
+    /**
+     * Submits the recorded operations of several sequences created on the
+     * same queue in a single queue submission with a single fence, which
+     * avoids the overhead of a submission per sequence when many sequences
+     * are evaluated together. The sequences have to be awaited with
+     * evalAwait, see Sequence::evalAsyncBatch.
+     *
+     * @param sequences The sequences to submit
+     */
+    void evalAsync(const std::vector<std::shared_ptr<Sequence>>& sequences);
+
+    /**
+     * Waits for sequences submitted with evalAsync to finish processing and
+     * runs the postEval of their operations, see Sequence::evalAwaitBatch.
+     *
+     * @param sequences The sequences to wait for
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     */
+    void evalAwait(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                   uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Waits until any of the sequences provided completed with a single wait
+     * on their fences, so results can be handled as soon as any submission
+     * completed, see Sequence::waitAny. The sequence found still has to be
+     * awaited, which does not block anymore.
+     *
+     * @param sequences The sequences to wait for
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     * @return The index of a completed sequence, or -1 if none completed
+     * before timing out or none is running
+     */
+    int32_t waitAny(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                    uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Waits until all the sequences provided completed with a single wait on
+     * their fences, without awaiting them, see Sequence::waitAll.
+     *
+     * @param sequences The sequences to wait for
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     * @return Boolean stating whether all the sequences completed before
+     * timing out
+     */
+    bool waitAll(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                 uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Submits the recorded operations of the sequence like
+     * Sequence::evalAsync and leaves awaiting it to the waiter thread of the
+     * manager, so the calling thread does not block on its fence. Once the
+     * submission completed, the thread runs the postEval of the operations
+     * and the callback provided, then makes the returned future ready. The
+     * sequence must not be used again until then. Submitting to the same
+     * queue from several threads has to be synchronized by the caller.
+     *
+     * @param sequence The sequence to submit, which must not be running
+     * @param callback Function run on the waiter thread once the submission
+     * completed, which must not destroy the manager
+     * @return Future that is ready once the submission completed and the
+     * callback ran, holding the exception thrown by either otherwise
+     */
+    std::future<void> evalAsyncFuture(std::shared_ptr<Sequence> sequence,
+                                      std::function<void()> callback = nullptr);
 
     /**
      * Create a managed tensor that will be destroyed by this manager
@@ -94,7 +169,14 @@ class Manager
         KP_LOG_DEBUG("Kompute Manager tensor creation triggered");
 
         std::shared_ptr<TensorT<T>> tensor{ new kp::TensorT<T>(
-          this->mPhysicalDevice, this->mDevice, data, tensorType) };
+          this->mPhysicalDevice,
+          this->mDevice,
+          data,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy,
+          this->mMemoryBudget) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
@@ -119,7 +201,14 @@ class Manager
         KP_LOG_DEBUG("Kompute Manager tensor creation triggered");
 
         std::shared_ptr<TensorT<T>> tensor{ new kp::TensorT<T>(
-          this->mPhysicalDevice, this->mDevice, size, tensorType) };
+          this->mPhysicalDevice,
+          this->mDevice,
+          size,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy,
+          this->mMemoryBudget) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
@@ -136,18 +225,48 @@ class Manager
 
     std::shared_ptr<Tensor> tensor(
       void* data,
-      uint32_t elementTotalCount,
+      uint64_t elementTotalCount,
+      uint32_t elementMemorySize,
+      const Memory::DataTypes& dataType,
+      Memory::MemoryTypes tensorType = Memory::MemoryTypes::eDevice)
+    {
+        std::shared_ptr<Tensor> tensor{ new kp::Tensor(
+          this->mPhysicalDevice,
+          this->mDevice,
+          data,
+          elementTotalCount,
+          elementMemorySize,
+          dataType,
+          tensorType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy,
+          Tensor::HostMemoryPolicy::eCopy,
+          this->mMemoryBudget) };
+
+        if (this->mManageResources) {
+            this->mManagedMemObjects.push_back(tensor);
+        }
+
+        return tensor;
+    }
+
+    std::shared_ptr<Tensor> tensor(
+      uint64_t elementTotalCount,
       uint32_t elementMemorySize,
       const Memory::DataTypes& dataType,
       Memory::MemoryTypes tensorType = Memory::MemoryTypes::eDevice)
     {
         std::shared_ptr<Tensor> tensor{ new kp::Tensor(this->mPhysicalDevice,
                                                        this->mDevice,
-                                                       data,
                                                        elementTotalCount,
                                                        elementMemorySize,
                                                        dataType,
-                                                       tensorType) };
+                                                       tensorType,
+                                                       this->mMemoryPool,
+                                                       this->mStagingRing,
+                                                       this->mStagingPolicy,
+                                                       this->mMemoryBudget) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
@@ -156,18 +275,89 @@ class Manager
         return tensor;
     }
 
-    std::shared_ptr<Tensor> tensor(
-      uint32_t elementTotalCount,
+    /**
+     * Create a managed tensor of type eHost that imports the host allocation
+     * provided instead of copying it, so for example memory mapped files can
+     * be used by the device without a copy. The allocation is imported when
+     * VK_EXT_external_memory_host is available, which the manager enables
+     * when creating the device, and the data and its size are aligned to the
+     * minImportedHostPointerAlignment of the device, and copied otherwise.
+     *
+     * @param data Host allocation to import, which has to outlive the tensor
+     * @param elementTotalCount The number of elements of the data
+     * @param elementMemorySize The size in bytes of each element
+     * @param dataType The data type of the elements
+     * @returns Shared pointer with initialised tensor
+     */
+    std::shared_ptr<Tensor> importTensor(void* data,
+                                         uint64_t elementTotalCount,
+                                         uint32_t elementMemorySize,
+                                         const Memory::DataTypes& dataType)
+    {
+        KP_LOG_DEBUG("Kompute Manager import tensor creation triggered");
+
+        // Imported memory is neither pooled nor staged
+        std::shared_ptr<Tensor> tensor{ new kp::Tensor(
+          this->mPhysicalDevice,
+          this->mDevice,
+          data,
+          elementTotalCount,
+          elementMemorySize,
+          dataType,
+          Memory::MemoryTypes::eHost,
+          nullptr,
+          nullptr,
+          this->mStagingPolicy,
+          Tensor::HostMemoryPolicy::eImport) };
+
+        if (this->mManageResources) {
+            this->mManagedMemObjects.push_back(tensor);
+        }
+
+        return tensor;
+    }
+
+    /**
+     * Create a managed tensor with its data read from a region of a file
+     * through a memory mapping instead of an intermediate copy. Tensors of
+     * type eHost import the mapping when possible, and tensors of type
+     * eDevice use the mapping as their host data when the staging ring is
+     * enabled, so the file is only read when the tensor is synced. See
+     * loadTensor to load the data of existing tensors through bounded host
+     * memory.
+     *
+     * @param path The path of the file holding the data
+     * @param offset The offset in bytes of the data in the file
+     * @param elementTotalCount The number of elements of the data
+     * @param elementMemorySize The size in bytes of each element
+     * @param dataType The data type of the elements
+     * @param tensorType The type of tensor to initialize
+     * @returns Shared pointer with initialised tensor
+     */
+    std::shared_ptr<Tensor> tensorFromFile(
+      const std::string& path,
+      uint64_t offset,
+      uint64_t elementTotalCount,
       uint32_t elementMemorySize,
       const Memory::DataTypes& dataType,
       Memory::MemoryTypes tensorType = Memory::MemoryTypes::eDevice)
     {
+        KP_LOG_DEBUG("Kompute Manager tensor from file creation triggered");
+
+        std::shared_ptr<MappedFile> mappedFile = std::make_shared<MappedFile>(
+          path, offset, elementTotalCount * elementMemorySize);
+
         std::shared_ptr<Tensor> tensor{ new kp::Tensor(this->mPhysicalDevice,
                                                        this->mDevice,
+                                                       mappedFile,
                                                        elementTotalCount,
                                                        elementMemorySize,
                                                        dataType,
-                                                       tensorType) };
+                                                       tensorType,
+                                                       this->mMemoryPool,
+                                                       this->mStagingRing,
+                                                       this->mStagingPolicy,
+                                                       this->mMemoryBudget) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(tensor);
@@ -176,6 +366,82 @@ class Manager
         return tensor;
     }
 
+    /**
+     * Loads the data of a tensor from a region of a file one chunk at a time,
+     * so the host memory used is bounded by the size of the chunks rather
+     * than the size of the tensor. The data of tensors of type eDevice is
+     * streamed into their device memory through the staging ring, or through
+     * a temporary staging ring if it is not enabled, and has to be synced
+     * with OpSyncLocal to be read on the host.
+     *
+     * @param tensor The tensor to load the data of
+     * @param path The path of the file holding the data
+     * @param offset The offset in bytes of the data in the file
+     */
+    void loadTensor(std::shared_ptr<Tensor> tensor,
+                    const std::string& path,
+                    uint64_t offset = 0);
+
+    /**
+     * Saves the data of the tensors provided into a checkpoint file, in the
+     * format described by CheckpointHeader, together with their data type,
+     * memory type and size so they can be created again with loadTensors.
+     * The data of tensors that is only current in device memory is read back
+     * through the staging ring, or through a temporary staging ring if it is
+     * not enabled, double buffered so the read back of a chunk overlaps the
+     * write of the previous one. The host data of the tensors is left
+     * unchanged.
+     *
+     * @param path The path of the file to write the checkpoint to
+     * @param tensors The tensors to save
+     */
+    void saveTensors(const std::string& path,
+                     const std::vector<std::shared_ptr<Tensor>>& tensors);
+
+    /**
+     * Creates managed tensors with the data type, memory type, size and data
+     * of the tensors saved into a checkpoint file by saveTensors. The data is
+     * loaded through bounded host memory like with loadTensor, so the data
+     * of tensors of type eDevice has to be synced with OpSyncLocal to be read
+     * on the host. The entries of the checkpoint are validated against the
+     * size of the file before any tensor is created.
+     *
+     * @param path The path of the checkpoint file
+     * @returns The tensors in the order they were saved in
+     */
+    std::vector<std::shared_ptr<Tensor>> loadTensors(const std::string& path);
+
+    /**
+     * Create a managed view of a range of elements of a tensor, which shares
+     * the buffers of the tensor instead of allocating new ones.
+     *
+     * @param parent The tensor to create the view of
+     * @param elementOffset The index of the first element of the view, whose
+     * offset in bytes has to respect minStorageBufferOffsetAlignment
+     * @param elementCount The number of elements of the view
+     * @returns Shared pointer with initialised tensor view
+     */
+    std::shared_ptr<TensorView> tensorView(std::shared_ptr<Tensor> parent,
+                                           uint64_t elementOffset,
+                                           uint64_t elementCount)
+    {
+        KP_LOG_DEBUG("Kompute Manager tensor view creation triggered");
+
+        if (!parent) {
+            throw std::runtime_error(
+              "Kompute Manager tensorView called with null parent tensor");
+        }
+
+        std::shared_ptr<TensorView> tensorView{ new kp::TensorView(
+          parent, elementOffset, elementCount) };
+
+        if (this->mManageResources) {
+            this->mManagedMemObjects.push_back(tensorView);
+        }
+
+        return tensorView;
+    }
+
     /**
      * Create a managed image that will be destroyed by this manager
      * if it hasn't been destroyed by its reference count going to zero.
@@ -203,7 +469,10 @@ class Manager
           height,
           numChannels,
           tiling,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -229,7 +498,10 @@ class Manager
           width,
           height,
           numChannels,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -255,7 +527,10 @@ class Manager
           height,
           numChannels,
           tiling,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -279,7 +554,10 @@ class Manager
           width,
           height,
           numChannels,
-          imageType) };
+          imageType,
+          this->mMemoryPool,
+          this->mStagingRing,
+          this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -348,7 +626,10 @@ class Manager
                                                     numChannels,
                                                     dataType,
                                                     tiling,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingRing,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -374,7 +655,10 @@ class Manager
                                                     height,
                                                     numChannels,
                                                     dataType,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingRing,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -398,7 +682,10 @@ class Manager
                                                     numChannels,
                                                     dataType,
                                                     tiling,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingRing,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -420,7 +707,10 @@ class Manager
                                                     height,
                                                     numChannels,
                                                     dataType,
-                                                    imageType) };
+                                                    imageType,
+                                                    this->mMemoryPool,
+                                                    this->mStagingRing,
+                                                    this->mStagingPolicy) };
 
         if (this->mManageResources) {
             this->mManagedMemObjects.push_back(image);
@@ -488,7 +778,10 @@ class Manager
           spirv,
           workgroup,
           specializationConstants,
-          pushConstants) };
+          pushConstants,
+          this->mPipelineCache,
+          this->mPipelineRegistry,
+          this->mDescriptorAllocator) };
 
         if (this->mManageResources) {
             this->mManagedAlgorithms.push_back(algorithm);
@@ -497,6 +790,179 @@ class Manager
         return algorithm;
     }
 
+    /**
+     * Create an executor streaming host buffers larger than the device memory
+     * through an algorithm chunk by chunk, with the chunks of several slots
+     * in flight at the same time. The chunk size is the number of elements of
+     * the tensors the streamed bindings of the algorithm are bound to.
+     *
+     * The bound tensors are used by the first slot if they are eDevice
+     * tensors that do not use the staging ring, and managed tensors of the
+     * same type and size are created for the other slots along with a
+     * managed sequence per slot.
+     *
+     * @param algorithm The algorithm to dispatch for each chunk
+     * @param inputBindings The bindings whose data is uploaded for each chunk
+     * @param outputBindings The bindings whose data is downloaded for each
+     * chunk
+     * @param slotCount The number of chunks in flight at the same time
+     * @param queueIndex The queue to submit the chunks to
+     * @returns Shared pointer with initialised streaming executor
+     */
+    std::shared_ptr<StreamingExecutor> streamingExecutor(
+      std::shared_ptr<Algorithm> algorithm,
+      const std::vector<uint32_t>& inputBindings,
+      const std::vector<uint32_t>& outputBindings,
+      uint32_t slotCount = KP_DEFAULT_STREAMING_SLOT_COUNT,
+      uint32_t queueIndex = 0);
+
+    /**
+     * Enables sub-allocation of the memory of tensors and images from large
+     * device memory blocks owned by this manager, which avoids one
+     * vkAllocateMemory call per buffer or image. Only memory objects created
+     * after this call are allocated from the pool. When the manager does not
+     * own the device, the pool outlives it until the memory objects not
+     * destroyed with it are destroyed.
+     *
+     * @param blockSize The size in bytes of each device memory block
+     * requested by the pool
+     */
+    void enableMemoryPool(
+      vk::DeviceSize blockSize = KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE);
+
+    /**
+     * The memory pool used to allocate tensors and images.
+     *
+     * @return a shared pointer to the memory pool, or nullptr if the memory
+     * pool has not been enabled
+     **/
+    std::shared_ptr<MemoryPool> getMemoryPool() const;
+
+    /**
+     * The budget tracking the device memory of the tensors of type eDevice
+     * created by this manager against the device memory available, through
+     * VK_EXT_memory_budget when the device supports it, which the manager
+     * enables when creating the device.
+     *
+     * @return a shared pointer to the memory budget
+     **/
+    std::shared_ptr<MemoryBudget> getMemoryBudget() const;
+
+    /**
+     * The waiter awaiting the sequences submitted with evalAsyncFuture on a
+     * thread of its own, which is started on first use.
+     *
+     * @return a shared pointer to the fence waiter
+     **/
+    std::shared_ptr<FenceWaiter> getFenceWaiter() const;
+
+    /**
+     * Sets what happens when creating or restoring a tensor of type eDevice
+     * would exceed the memory budget. With
+     * MemoryBudget::EvictionPolicy::eLeastRecentlyUsed, the tensors that were
+     * used least recently by a sequence are evicted to host memory, and
+     * restored when a sequence records an operation using them again.
+     * Tensors used by a sequence being recorded or evaluated, and tensors
+     * pinned with Tensor::pin, are never evicted.
+     *
+     * @param evictionPolicy The eviction policy of the memory budget
+     */
+    void setEvictionPolicy(MemoryBudget::EvictionPolicy evictionPolicy);
+
+    /**
+     * Enables streaming the data of device tensors and images through a
+     * staging ring owned by this manager, instead of allocating a staging
+     * buffer or image of the same size for each of them. The host visible
+     * memory used for transfers is then bounded by the size of the ring, and
+     * larger memory objects are streamed in multiple chunks. Only memory
+     * objects created after this call use the staging ring.
+     *
+     * With the staging ring, OpSyncDevice uploads the data before the
+     * sequence is submitted and OpSyncLocal downloads the data after the
+     * sequence has completed, rather than recording the copies into the
+     * sequence.
+     *
+     * @param size The size in bytes of the staging ring
+     */
+    void enableStagingRing(vk::DeviceSize size = KP_DEFAULT_STAGING_RING_SIZE);
+
+    /**
+     * The staging ring used to stream the data of device tensors and images.
+     *
+     * @return a shared pointer to the staging ring, or nullptr if the staging
+     * ring has not been enabled
+     **/
+    std::shared_ptr<StagingRing> getStagingRing() const;
+
+    /**
+     * Sets when the staging memory of the device tensors and images created
+     * by this manager is allocated. With StagingPolicy::eLazy, memory objects
+     * created without data only allocate their staging memory once their
+     * host data is accessed or a sync operation is recorded for them, so the
+     * ones only used by shaders stay in device memory. The staging memory can
+     * be freed again with Memory::releaseStagingMemory. Only memory objects
+     * created after this call use the policy provided.
+     *
+     * @param stagingPolicy The staging policy of the memory objects created
+     */
+    void setStagingPolicy(Memory::StagingPolicy stagingPolicy);
+
+    /**
+     * The staging policy of the memory objects created by this manager.
+     *
+     * @return The staging policy
+     **/
+    Memory::StagingPolicy getStagingPolicy() const;
+
+    /**
+     * Loads pipeline cache data previously written by savePipelineCache into
+     * the pipeline cache shared by all the algorithms created by this manager.
+     * Data created by a different device or driver version is ignored, as well
+     * as files that do not exist or are not valid, so the first run of a
+     * process can call this function unconditionally.
+     *
+     * @param path The path of the file to load the pipeline cache data from
+     * @return true if the pipeline cache data was loaded, false otherwise
+     **/
+    bool loadPipelineCache(const std::string& path);
+
+    /**
+     * Saves the content of the pipeline cache shared by all the algorithms
+     * created by this manager, together with the device and driver version
+     * that created it, so it can be loaded with loadPipelineCache.
+     *
+     * @param path The path of the file to write the pipeline cache data to
+     **/
+    void savePipelineCache(const std::string& path);
+
+    /**
+     * The pipeline cache shared by all the algorithms created by this manager.
+     * When the manager was created with an existing device, the cache is not
+     * freed when the manager is destroyed, as the algorithms it created may
+     * still be rebuilt with it, and freeing it is left to the owner of the
+     * device.
+     *
+     * @return a shared pointer to the pipeline cache
+     **/
+    std::shared_ptr<vk::PipelineCache> getPipelineCache() const;
+
+    /**
+     * The registry through which algorithms created by this manager share
+     * their shader modules, pipeline layouts and pipelines when they are
+     * built from the same SPIR-V, constants and descriptor types.
+     *
+     * @return a shared pointer to the pipeline registry
+     **/
+    std::shared_ptr<PipelineRegistry> getPipelineRegistry() const;
+
+    /**
+     * The allocator the descriptor sets of the algorithms created by this
+     * manager are allocated from.
+     *
+     * @return a shared pointer to the descriptor allocator
+     **/
+    std::shared_ptr<DescriptorAllocator> getDescriptorAllocator() const;
+
     /**
      * Destroy the GPU resources and all managed resources by manager.
      **/
@@ -543,10 +1009,24 @@ class Manager
     std::vector<std::weak_ptr<Sequence>> mManagedSequences;
     std::vector<std::weak_ptr<Algorithm>> mManagedAlgorithms;
 
+    std::shared_ptr<MemoryPool> mMemoryPool = nullptr;
+    std::shared_ptr<StagingRing> mStagingRing = nullptr;
+    Memory::StagingPolicy mStagingPolicy = Memory::StagingPolicy::eEager;
+    std::shared_ptr<MemoryBudget> mMemoryBudget = nullptr;
+    std::shared_ptr<FenceWaiter> mFenceWaiter = nullptr;
+    std::shared_ptr<vk::PipelineCache> mPipelineCache = nullptr;
+    std::shared_ptr<PipelineRegistry> mPipelineRegistry = nullptr;
+    std::shared_ptr<DescriptorAllocator> mDescriptorAllocator = nullptr;
+
     std::vector<uint32_t> mComputeQueueFamilyIndices;
     std::vector<std::shared_ptr<vk::Queue>> mComputeQueues;
+    // Held while submitting to the compute queue of the same index, as
+    // sequences and staging rings may submit to it from different threads
+    std::vector<std::shared_ptr<std::mutex>> mComputeQueueMutexes;
 
     bool mManageResources = false;
+    // Whether timeline semaphores were enabled when creating the device
+    bool mTimelineSemaphores = false;
 
 #ifndef KOMPUTE_DISABLE_VK_DEBUG_LAYERS
     vk::DebugReportCallbackEXT mDebugReportCallback;
@@ -562,6 +1042,11 @@ class Manager
     void createDevice(const std::vector<uint32_t>& familyQueueIndices = {},
                       uint32_t hysicalDeviceIndex = 0,
                       const std::vector<std::string>& desiredExtensions = {});
+    void createPipelineCache();
+
+    // Returns the staging ring of the manager, or a temporary staging ring
+    // for transfers outside of sequences if it is not enabled
+    std::shared_ptr<StagingRing> transferStagingRing();
 };
 
 } // End namespace kp
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Size of the chunks files are read in when streamed into memory objects
+#define KP_DEFAULT_FILE_CHUNK_SIZE (64ull * 1024ull * 1024ull)
+
+namespace kp {
+
+/**
+ * Memory mapping of a region of a file, which makes the content of the file
+ * addressable without reading it into memory first. Pages are read from the
+ * file when first accessed, and can be read ahead with prefetch() and dropped
+ * again with release(), so files larger than the host memory can be
+ * processed through a bounded amount of resident memory.
+ *
+ * The mapping is private and writable: writes through data() are only seen
+ * by this mapping and never written back to the file.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * Maps a region of the file provided, which has to be within the file.
+     *
+     * @param path The path of the file to map
+     * @param offset The offset in bytes of the region in the file
+     * @param size The size in bytes of the region, or 0 to map the rest of
+     * the file from the offset
+     */
+    MappedFile(const std::string& path, uint64_t offset = 0, uint64_t size = 0);
+
+    /**
+     * @brief Make MappedFile uncopyable
+     *
+     */
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(const MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&&) = delete;
+
+    /**
+     * Destructor which unmaps the region and closes the file.
+     */
+    ~MappedFile();
+
+    /**
+     * The start of the region mapped.
+     *
+     * @return Pointer to the first byte of the region
+     */
+    void* data();
+
+    /**
+     * The size in bytes of the region mapped.
+     *
+     * @return Size of the region
+     */
+    uint64_t size();
+
+    /**
+     * Requests the pages of a range of the region to be read from the file
+     * in the background, so they are resident by the time they are accessed.
+     *
+     * @param offset The offset in bytes of the range in the region
+     * @param size The size in bytes of the range
+     */
+    void prefetch(uint64_t offset, uint64_t size);
+
+    /**
+     * Drops the resident pages of a range of the region that is not needed
+     * anymore, which are read from the file again if accessed. Writes to the
+     * range may be discarded.
+     *
+     * @param offset The offset in bytes of the range in the region
+     * @param size The size in bytes of the range
+     */
+    void release(uint64_t offset, uint64_t size);
+
+    /**
+     * The size in bytes of a file.
+     *
+     * @param path The path of the file
+     * @return Size of the file
+     */
+    static uint64_t fileSize(const std::string& path);
+
+  private:
+    void* mMapping = nullptr;
+    uint64_t mMappingSize = 0;
+    uint8_t* mData = nullptr;
+    uint64_t mSize = 0;
+
+    // Rounds a range of the region to the pages containing it, or to the
+    // pages it fully contains if inner, as advice functions only accept page
+    // aligned addresses. Returns false if the range holds no pages.
+    bool pageRange(uint64_t offset,
+                   uint64_t size,
+                   bool inner,
+                   uint8_t** pageStart,
+                   uint64_t* pageSize);
+};
+
+} // End namespace kp
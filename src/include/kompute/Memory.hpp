@@ -1,10 +1,16 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "kompute/BarrierBatch.hpp"
 #include "kompute/Core.hpp"
+#include "kompute/Float16.hpp"
+#include "kompute/Quantization.hpp"
+#include "kompute/MemoryPool.hpp"
+#include "kompute/StagingRing.hpp"
 #include "logger/Logger.hpp"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace kp {
 
@@ -33,6 +39,31 @@ class Memory
           3, ///< Type is host-visible and host-coherent device memory
     };
 
+    /**
+     * Policy for allocating the staging memory of memory objects of type
+     * eDevice: eEager allocates it together with the device memory, while
+     * eLazy only allocates it the first time the host data is accessed or a
+     * sync operation is recorded for the memory object, so memory objects
+     * that are only used by shaders never allocate it.
+     */
+    enum class StagingPolicy
+    {
+        eEager = 0, ///< Staging memory is allocated on creation
+        eLazy = 1,  ///< Staging memory is allocated on first use
+    };
+
+    /**
+     * Which copy of the data of memory objects of type eDevice is current:
+     * the host data, the device memory or both. Memory objects of any other
+     * type share a single copy of their data and are always eCoherent.
+     */
+    enum class Residency
+    {
+        eCoherent = 0,   ///< Host data and device memory hold the same data
+        eHostDirty = 1,  ///< Host data was written since the last sync
+        eDeviceDirty = 2 ///< Device memory was written since the last sync
+    };
+
     enum class DataTypes
     {
         eBool = 0,
@@ -44,7 +75,13 @@ class Memory
         eShort = 6,
         eUnsignedShort = 7,
         eChar = 8,
-        eUnsignedChar = 9
+        eUnsignedChar = 9,
+        eHalf = 10,
+        eBFloat16 = 11,
+        eInt64 = 12,
+        eUnsignedInt64 = 13,
+        eBlockInt8 = 14,
+        eBlockInt4 = 15
     };
 
     enum class Type
@@ -61,7 +98,10 @@ class Memory
            const DataTypes& dataType,
            const MemoryTypes& memoryType,
            uint32_t x,
-           uint32_t y);
+           uint32_t y,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager);
 
 
     /**
@@ -133,6 +173,87 @@ class Memory
      */
     virtual void recordCopyFromDeviceToStaging(
       const vk::CommandBuffer& commandBuffer) = 0;
+
+    /**
+     * Whether the data of the memory object is streamed through a staging
+     * ring shared with other memory objects instead of its own staging
+     * memory. This is only the case for memory objects of type eDevice
+     * created with a staging ring, which keep their data in host memory that
+     * is not visible to the device.
+     *
+     * @return Boolean stating whether the memory object uses a staging ring
+     */
+    bool usesStagingRing();
+
+    /**
+     * Whether the staging memory of the memory object is currently
+     * allocated, which is never the case for memory objects that are not of
+     * type eDevice or that use a staging ring.
+     *
+     * @return Boolean stating whether the staging memory is allocated
+     */
+    bool hasStagingMemory();
+
+    /**
+     * Frees the staging memory of the memory object, together with the host
+     * data it holds. The staging memory is allocated again the next time the
+     * host data is accessed or a sync operation is recorded, with undefined
+     * content until the data is set or synced back from the device. Sequences
+     * that recorded sync operations for the memory object have to be
+     * recorded again before being evaluated.
+     */
+    void releaseStagingMemory();
+
+    /**
+     * Which copy of the data of the memory object is current. Host writes
+     * through setData(), data() or rawData() mark the host data as dirty,
+     * device writes recorded by the operations of a sequence mark the device
+     * memory as dirty once evaluated, and OpSyncDevice and OpSyncLocal make
+     * both coherent again. Sync operations of coherent memory objects do not
+     * transfer any data. Memory objects that were coherent when the residency
+     * was last invalidated with invalidateResidency() are device dirty.
+     *
+     * @return The residency of the data of the memory object
+     */
+    virtual Residency residency();
+
+    /**
+     * Overrides the residency of the data of the memory object, which is
+     * required after writing it with operations that do not declare their
+     * accesses to the resource state tracker of the sequence.
+     *
+     * @param residency The new residency of the data of the memory object
+     */
+    virtual void setResidency(Residency residency);
+
+    /**
+     * Assumes that the device memory of all the memory objects may have been
+     * written, which is the case once a sequence executed operations that do
+     * not declare their accesses to its resource state tracker, as the memory
+     * objects they wrote are not known. Coherent memory objects of all
+     * devices become device dirty, so the sync operations recorded for them
+     * transfer their data again.
+     */
+    static void invalidateResidency();
+
+    /**
+     * Uploads the host data of the memory object into its device memory
+     * through the staging ring, splitting it in chunks that fit the ring.
+     * The upload is submitted straight away and waited on before returning.
+     * This function is only relevant for memory objects that use a staging
+     * ring.
+     */
+    virtual void streamToDevice() = 0;
+
+    /**
+     * Downloads the device memory of the memory object into its host data
+     * through the staging ring, splitting it in chunks that fit the ring.
+     * The download is submitted straight away and waited on before
+     * returning. This function is only relevant for memory objects that use
+     * a staging ring.
+     */
+    virtual void streamFromDevice() = 0;
+
     /**
      * Records the buffer memory barrier into the primary buffer and command
      * buffer which ensures that relevant data transfers are carried out
@@ -168,6 +289,41 @@ class Memory
       vk::PipelineStageFlagBits srcStageMask,
       vk::PipelineStageFlagBits dstStageMask) = 0;
 
+    /**
+     * Adds the memory barrier of the primary memory to the batch provided,
+     * so that the barriers of multiple memory objects can be recorded with a
+     * single pipelineBarrier call when the batch is flushed.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    virtual void recordPrimaryMemoryBarrier(
+      BarrierBatch& barrierBatch,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask) = 0;
+    /**
+     * Adds the memory barrier of the staging memory to the batch provided,
+     * so that the barriers of multiple memory objects can be recorded with a
+     * single pipelineBarrier call when the batch is flushed.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    virtual void recordStagingMemoryBarrier(
+      BarrierBatch& barrierBatch,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask) = 0;
+
     /**
      * Records a copy from the memory provided to the current
      * memory. This is intended to pass memory into a processing, to perform
@@ -196,7 +352,7 @@ class Memory
      *
      * @return Unsigned integer representing the total number of elements
      */
-    uint32_t size();
+    uint64_t size();
 
     /**
      * Returns the total size of a single element of the respective data type
@@ -222,7 +378,7 @@ class Memory
      * @return Unsigned integer representing the total memory size of the data
      * contained by the image object.
      */
-    uint32_t memorySize();
+    uint64_t memorySize();
 
     vk::DescriptorType getDescriptorType() { return mDescriptorType; }
 
@@ -254,6 +410,32 @@ class Memory
         this->setData(data.data(), data.size() * sizeof(T));
     }
 
+    /**
+     * Sets the data of a range of the tensor/image starting at \p offset
+     * bytes, leaving the rest of its data untouched.
+     *
+     * @param offset The offset in bytes of the range to set
+     * @param data The data to copy into the range
+     * @param size The size in bytes of the range to set
+     */
+    void setData(size_t offset, const void* data, size_t size);
+
+    /**
+     * Sets the data of a range of elements of the tensor/image starting at
+     * the element \p elementOffset, leaving the rest of its data untouched.
+     */
+    template<typename T>
+    void setData(size_t elementOffset, const std::vector<T>& data)
+    {
+        KP_LOG_DEBUG("Kompute Memory setting data with data size {} at "
+                     "element offset {}",
+                     data.size() * sizeof(T),
+                     elementOffset);
+
+        this->setData(
+          elementOffset * sizeof(T), data.data(), data.size() * sizeof(T));
+    }
+
     /**
      * Template to return the pointer data converted by specific type, which
      * would be any of the supported types including float, double, int32,
@@ -268,6 +450,9 @@ class Memory
             this->mapRawData();
         }
 
+        // The data may be written through the pointer returned
+        this->setResidency(Residency::eHostDirty);
+
         return (T*)this->mRawData;
     }
 
@@ -289,7 +474,10 @@ class Memory
     }
 
     /***
-     * Retreive the size of the x-dimension of the memory
+     * Retreive the size of the x-dimension of the memory. Tensors are
+     * one-dimensional and report their number of elements, which saturates
+     * at 2^32 - 1 for larger tensors whose number of elements is only
+     * returned by size().
      *
      * @return Size of the x-dimension of the memory
      */
@@ -313,7 +501,7 @@ class Memory
     // -------------- ALWAYS OWNED RESOURCES
     MemoryTypes mMemoryType;
     DataTypes mDataType;
-    uint32_t mSize;
+    uint64_t mSize;
     uint32_t mDataTypeMemorySize;
     void* mRawData = nullptr;
     vk::DescriptorType mDescriptorType;
@@ -331,12 +519,35 @@ class Memory
     std::shared_ptr<vk::DeviceMemory> mStagingMemory;
     bool mFreeStagingMemory = false;
 
+    // -------------- POOLED RESOURCES
+    std::shared_ptr<MemoryPool> mMemoryPool;
+    MemoryPool::Allocation mPrimaryAllocation;
+    MemoryPool::Allocation mStagingAllocation;
+
+    // -------------- STREAMED RESOURCES
+    std::shared_ptr<StagingRing> mStagingRing;
+    std::vector<uint8_t> mHostData;
+    StagingPolicy mStagingPolicy = StagingPolicy::eEager;
+
+    // -------------- RESIDENCY
+    Residency mResidency = Residency::eHostDirty;
+    // Value of the residency epoch when the residency was last set
+    uint64_t mResidencyEpoch = 0;
+
     // Private util functions
-    void mapRawData();
+    virtual void mapRawData();
     void unmapRawData();
     void updateRawData(void* data);
+    void checkMemorySize();
     vk::MemoryPropertyFlags getPrimaryMemoryPropertyFlags();
     vk::MemoryPropertyFlags getStagingMemoryPropertyFlags();
+    bool requiresStagingMemory();
+    void ensureStagingMemory();
+    void freeStagingMemory();
+
+    // Creates or destroys the staging buffer or image and its memory
+    virtual void allocateStagingMemory() = 0;
+    virtual void destroyStagingMemory() = 0;
 
     virtual void recordCopyFrom(const vk::CommandBuffer& commandBuffer,
                                 std::shared_ptr<Tensor> copyFromMemory) = 0;
@@ -407,4 +618,46 @@ Memory::dataType<double>()
     return DataTypes::eDouble;
 }
 
+template<>
+constexpr Memory::DataTypes
+Memory::dataType<Half>()
+{
+    return DataTypes::eHalf;
+}
+
+template<>
+constexpr Memory::DataTypes
+Memory::dataType<BFloat16>()
+{
+    return DataTypes::eBFloat16;
+}
+
+template<>
+constexpr Memory::DataTypes
+Memory::dataType<int64_t>()
+{
+    return DataTypes::eInt64;
+}
+
+template<>
+constexpr Memory::DataTypes
+Memory::dataType<uint64_t>()
+{
+    return DataTypes::eUnsignedInt64;
+}
+
+template<>
+constexpr Memory::DataTypes
+Memory::dataType<BlockInt8>()
+{
+    return DataTypes::eBlockInt8;
+}
+
+template<>
+constexpr Memory::DataTypes
+Memory::dataType<BlockInt4>()
+{
+    return DataTypes::eBlockInt4;
+}
+
 } // End namespace kp
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "kompute/StagingRing.hpp"
+#include "logger/Logger.hpp"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace kp {
+
+// Forward-declare the Tensor class
+class Tensor;
+
+/**
+ * Tracks the device memory used by the device tensors of a manager against
+ * the device memory available, and optionally evicts the tensors that were
+ * used least recently to host memory when allocating a new tensor would
+ * exceed it.
+ *
+ * The budget and usage of the device local heaps are queried through
+ * VK_EXT_memory_budget when the device supports it, which accounts for the
+ * memory used by other processes. Otherwise the budget is the size of the
+ * device local heaps and the usage is the memory of the tracked tensors.
+ * A limit can also be set to cap the memory of the tracked tensors below
+ * what the device reports.
+ *
+ * Evicted tensors keep their data in host memory and have their buffer and
+ * device memory freed. Sequences restore them when recording an operation
+ * that uses them, and keep the tensors of their operations pinned from the
+ * recording until their evaluation completed, so the tensors in use are
+ * never evicted. Tensors can also be pinned explicitly with Tensor::pin.
+ */
+class MemoryBudget
+{
+  public:
+    /**
+     * What happens when allocating a tensor would exceed the budget.
+     */
+    enum class EvictionPolicy
+    {
+        eNone = 0,              ///< Tensors are allocated regardless
+        eLeastRecentlyUsed = 1, ///< Least recently used tensors are evicted
+    };
+
+    /**
+     * Constructor for the memory budget.
+     *
+     * @param physicalDevice The physical device to query the heaps of
+     * @param device The device the tracked tensors are created on
+     * @param queue The queue used to transfer the data of the tensors when
+     * evicting and restoring them, or nullptr if eviction is not used
+     * @param queueIndex The family index of the queue
+     * @param queueMutex Mutex held while submitting to the queue, shared by
+     * all the objects submitting to it
+     */
+    MemoryBudget(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                 std::shared_ptr<vk::Device> device,
+                 std::shared_ptr<vk::Queue> queue = nullptr,
+                 uint32_t queueIndex = 0,
+                 std::shared_ptr<std::mutex> queueMutex = nullptr);
+
+    /**
+     * @brief Make MemoryBudget uncopyable
+     *
+     */
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget(const MemoryBudget&&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&&) = delete;
+
+    /**
+     * Destructor which frees the staging ring used for evictions.
+     */
+    ~MemoryBudget();
+
+    /**
+     * Whether the budget and usage are queried through VK_EXT_memory_budget.
+     *
+     * @return Boolean stating whether the extension is supported
+     */
+    bool hasBudgetExtension();
+
+    /**
+     * The device local memory available to this process, which is the
+     * budget reported by VK_EXT_memory_budget or the size of the device
+     * local heaps.
+     *
+     * @return Budget in bytes of the device local heaps
+     */
+    vk::DeviceSize budget();
+
+    /**
+     * The device local memory used by this process, which is the usage
+     * reported by VK_EXT_memory_budget or the memory of the tracked tensors.
+     *
+     * @return Usage in bytes of the device local heaps
+     */
+    vk::DeviceSize usage();
+
+    /**
+     * Caps the device memory of the tracked tensors, which is checked in
+     * addition to the budget of the device when allocating tensors.
+     *
+     * @param limit The limit in bytes, or 0 to only check the budget
+     */
+    void setLimit(vk::DeviceSize limit);
+
+    /**
+     * The cap of the device memory of the tracked tensors.
+     *
+     * @return The limit in bytes, or 0 if no limit is set
+     */
+    vk::DeviceSize limit();
+
+    /**
+     * The device memory of the tracked tensors that are not evicted.
+     *
+     * @return Size in bytes of the resident tracked tensors
+     */
+    vk::DeviceSize trackedSize();
+
+    /**
+     * The number of tracked tensors, evicted or not.
+     *
+     * @return Number of tensors tracked
+     */
+    uint32_t tensorCount();
+
+    /**
+     * The number of tensors evicted since the budget was created.
+     *
+     * @return Number of evictions
+     */
+    uint64_t evictionCount();
+
+    /**
+     * Sets what happens when allocating a tensor would exceed the budget.
+     *
+     * @param evictionPolicy The eviction policy
+     */
+    void setEvictionPolicy(EvictionPolicy evictionPolicy);
+
+    /**
+     * The eviction policy of the budget.
+     *
+     * @return The eviction policy
+     */
+    EvictionPolicy getEvictionPolicy();
+
+    /**
+     * Makes room for an allocation of the size provided, evicting the least
+     * recently used tensors that are neither pinned nor already evicted if
+     * the eviction policy allows it and the allocation would exceed the
+     * budget or the limit. The allocation goes ahead regardless if not
+     * enough tensors can be evicted.
+     *
+     * @param size The size in bytes about to be allocated
+     */
+    void reserve(vk::DeviceSize size);
+
+    /**
+     * Starts tracking a tensor whose device memory was just allocated, as
+     * the most recently used one.
+     *
+     * @param tensor The tensor to track
+     * @param size The size in bytes of the device memory of the tensor
+     */
+    void add(Tensor* tensor, vk::DeviceSize size);
+
+    /**
+     * Stops tracking a tensor, which is called when it is destroyed.
+     *
+     * @param tensor The tensor to stop tracking
+     */
+    void remove(Tensor* tensor);
+
+    /**
+     * Records that the device memory of a tracked tensor was freed by
+     * evicting it, or allocated again by restoring it.
+     *
+     * @param tensor The tracked tensor
+     * @param resident Whether the tensor has device memory
+     */
+    void setResident(Tensor* tensor, bool resident);
+
+    /**
+     * Marks a tracked tensor as the most recently used one.
+     *
+     * @param tensor The tracked tensor
+     */
+    void touch(Tensor* tensor);
+
+    /**
+     * The staging ring the data of the tensors is transferred through when
+     * evicting and restoring them, which is created on first use.
+     *
+     * @return Shared pointer to the staging ring
+     */
+    std::shared_ptr<StagingRing> stagingRing();
+
+    /**
+     * Frees the staging ring used for evictions. Tensors evicted after this
+     * call fail to transfer their data.
+     */
+    void destroy();
+
+  private:
+    struct Entry
+    {
+        Tensor* tensor;
+        vk::DeviceSize size;
+        bool resident;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::Queue> mQueue;
+    uint32_t mQueueIndex = 0;
+    std::shared_ptr<std::mutex> mQueueMutex;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::shared_ptr<StagingRing> mStagingRing;
+    bool mBudgetExtension = false;
+    EvictionPolicy mEvictionPolicy = EvictionPolicy::eNone;
+    vk::DeviceSize mLimit = 0;
+    vk::DeviceSize mTrackedSize = 0;
+    uint64_t mEvictionCount = 0;
+    // Tracked tensors from the most to the least recently used
+    std::list<Entry> mEntries;
+    std::unordered_map<Tensor*, std::list<Entry>::iterator> mEntryIterators;
+    std::mutex mMutex;
+
+    // Sums the budget and usage of the device local heaps
+    void queryHeaps(vk::DeviceSize* budget, vk::DeviceSize* usage);
+};
+
+} // End namespace kp
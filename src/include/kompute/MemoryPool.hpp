@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+// Size of each device memory block requested from the driver by the pool
+#define KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE (64ull * 1024ull * 1024ull)
+
+namespace kp {
+
+/**
+ * Sub-allocating device memory pool used by Tensors and Images.
+ *
+ * Instead of calling vkAllocateMemory for every buffer and image, the pool
+ * requests large blocks of device memory per memory type and carves them up
+ * with a buddy allocator. Host visible blocks are mapped once for their
+ * whole lifetime given a device memory object can only be mapped once at a
+ * time. Blocks are released back to the driver as soon as they become empty,
+ * except for the last block of each memory type which is kept to avoid
+ * re-allocating it when memory objects are created and destroyed in a loop.
+ */
+class MemoryPool
+{
+  public:
+    /**
+     * Region of a device memory block handed out by the pool. The resource
+     * has to be bound at \p offset of \p memory.
+     */
+    struct Allocation
+    {
+        vk::DeviceMemory memory = nullptr;
+        vk::DeviceSize offset = 0;
+        vk::DeviceSize size = 0;
+        void* mappedData = nullptr;
+        uint64_t blockId = 0;
+
+        explicit operator bool() const { return (bool)this->memory; }
+    };
+
+    /**
+     * Constructor for the memory pool.
+     *
+     * @param physicalDevice The physical device to fetch memory properties
+     * @param device The device to allocate the memory blocks from
+     * @param blockSize The size in bytes of each memory block, rounded up to
+     * the next power of two
+     */
+    MemoryPool(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+               std::shared_ptr<vk::Device> device,
+               vk::DeviceSize blockSize = KP_DEFAULT_MEMORY_POOL_BLOCK_SIZE);
+
+    /**
+     * @brief Make MemoryPool uncopyable
+     *
+     */
+    MemoryPool(const MemoryPool&) = delete;
+    MemoryPool(const MemoryPool&&) = delete;
+    MemoryPool& operator=(const MemoryPool&) = delete;
+    MemoryPool& operator=(const MemoryPool&&) = delete;
+
+    /**
+     * Destructor which frees all the memory blocks owned by the pool.
+     */
+    ~MemoryPool();
+
+    /**
+     * Allocates a region that satisfies the memory requirements provided.
+     * Linear resources (buffers and linear images) and non-linear resources
+     * (optimal images) are kept in separate blocks whenever the device
+     * reports a bufferImageGranularity larger than one byte.
+     *
+     * @param memoryRequirements The requirements of the buffer or image
+     * @param memoryPropertyFlags The memory properties the region must have
+     * @param linear Whether the resource bound to the region is linear
+     * @return The allocated region
+     */
+    Allocation allocate(const vk::MemoryRequirements& memoryRequirements,
+                        vk::MemoryPropertyFlags memoryPropertyFlags,
+                        bool linear);
+
+    /**
+     * Returns the region provided back to the pool. The resource bound to it
+     * must have already been destroyed.
+     *
+     * @param allocation The region to release
+     */
+    void free(const Allocation& allocation);
+
+    /**
+     * Frees all the memory blocks. Any allocation still in use becomes
+     * invalid.
+     */
+    void destroy();
+
+    /**
+     * Returns the size of the memory blocks requested by the pool.
+     *
+     * @return Block size in bytes
+     */
+    vk::DeviceSize blockSize();
+
+    /**
+     * Returns the number of device memory blocks currently allocated.
+     *
+     * @return Number of vkAllocateMemory allocations alive in the pool
+     */
+    uint32_t blockCount();
+
+    /**
+     * Returns the number of regions currently handed out by the pool.
+     *
+     * @return Number of live allocations
+     */
+    uint32_t allocationCount();
+
+    /**
+     * Returns the total size of the device memory blocks held by the pool.
+     *
+     * @return Size in bytes of all the blocks
+     */
+    vk::DeviceSize allocatedSize();
+
+  private:
+    struct Block
+    {
+        uint64_t id = 0;
+        uint32_t memoryTypeIndex = 0;
+        bool linear = true;
+        // Dedicated blocks hold a single allocation bigger than the block size
+        bool dedicated = false;
+        vk::DeviceMemory memory = nullptr;
+        vk::DeviceSize size = 0;
+        void* mappedData = nullptr;
+        uint32_t allocationCount = 0;
+        // Free buddy nodes indexed by order (node size = min size << order)
+        std::vector<std::set<vk::DeviceSize>> freeNodes;
+        // Order of the node backing each live allocation, keyed by offset
+        std::unordered_map<vk::DeviceSize, uint32_t> allocatedNodes;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    vk::DeviceSize mBlockSize;
+    uint32_t mMaxOrder;
+    bool mSeparateLinear;
+    vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+    std::map<uint64_t, std::unique_ptr<Block>> mBlocks;
+    uint64_t mNextBlockId = 1;
+    uint32_t mAllocationCount = 0;
+    std::mutex mMutex;
+
+    uint32_t findMemoryTypeIndex(uint32_t memoryTypeBits,
+                                 vk::MemoryPropertyFlags memoryPropertyFlags);
+    Block* createBlock(uint32_t memoryTypeIndex,
+                       bool linear,
+                       vk::DeviceSize size,
+                       bool dedicated);
+    void destroyBlock(uint64_t blockId);
+    bool allocateFromBlock(Block& block,
+                           uint32_t order,
+                           vk::DeviceSize& offset);
+};
+
+} // End namespace kp
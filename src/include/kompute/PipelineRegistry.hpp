@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Reference counted registry of the immutable Vulkan objects of algorithms.
+ *
+ * Algorithms built from the same SPIR-V, specialization constants, push
+ * constant range and descriptor types end up with identical descriptor set
+ * layouts, shader modules, pipeline layouts and pipelines. The registry
+ * stores these objects under a key computed from those parameters so
+ * algorithms with the same key share them, and only their descriptor sets
+ * differ. The objects are destroyed once the last algorithm releases them.
+ */
+class PipelineRegistry
+{
+  public:
+    /**
+     * Parameters that fully determine the objects stored in the registry,
+     * together with their hash.
+     */
+    struct Key
+    {
+        std::vector<uint32_t> spirv;
+        std::vector<vk::DescriptorType> descriptorTypes;
+        std::vector<uint8_t> specializationConstantsData;
+        uint32_t specializationConstantsDataTypeMemorySize = 0;
+        uint32_t pushConstantsMemorySize = 0;
+        uint64_t hash = 0;
+
+        bool operator==(const Key& other) const;
+    };
+
+    /**
+     * Objects shared between all the algorithms with the same key.
+     */
+    struct Entry
+    {
+        std::shared_ptr<vk::DescriptorSetLayout> descriptorSetLayout;
+        std::shared_ptr<vk::ShaderModule> shaderModule;
+        std::shared_ptr<vk::PipelineLayout> pipelineLayout;
+        std::shared_ptr<vk::Pipeline> pipeline;
+    };
+
+    /**
+     * Constructor for the pipeline registry.
+     *
+     * @param device The device used to destroy the registered objects
+     */
+    PipelineRegistry(std::shared_ptr<vk::Device> device);
+
+    /**
+     * @brief Make PipelineRegistry uncopyable
+     *
+     */
+    PipelineRegistry(const PipelineRegistry&) = delete;
+    PipelineRegistry(const PipelineRegistry&&) = delete;
+    PipelineRegistry& operator=(const PipelineRegistry&) = delete;
+    PipelineRegistry& operator=(const PipelineRegistry&&) = delete;
+
+    /**
+     * Destructor which destroys the objects still held by the registry.
+     */
+    ~PipelineRegistry();
+
+    /**
+     * Creates the key of the objects built from the parameters provided.
+     *
+     * @param spirv The SPIR-V code of the shader module
+     * @param descriptorTypes The descriptor type of each binding
+     * @param specializationConstantsData Pointer to the specialization
+     * constants values
+     * @param specializationConstantsDataTypeMemorySize Size in bytes of each
+     * specialization constant
+     * @param specializationConstantsSize Number of specialization constants
+     * @param pushConstantsMemorySize Size in bytes of the push constant range
+     * @return The key with its hash computed
+     */
+    static Key createKey(const std::vector<uint32_t>& spirv,
+                         const std::vector<vk::DescriptorType>& descriptorTypes,
+                         const void* specializationConstantsData,
+                         uint32_t specializationConstantsDataTypeMemorySize,
+                         uint32_t specializationConstantsSize,
+                         uint32_t pushConstantsMemorySize);
+
+    /**
+     * Looks up the objects registered under \p key, adding a reference to
+     * them if found.
+     *
+     * @param key The key of the objects
+     * @param entry Filled with the registered objects if found
+     * @return true if the objects were found, false otherwise
+     */
+    bool acquire(const Key& key, Entry& entry);
+
+    /**
+     * Registers objects created by an algorithm under \p key with a single
+     * reference, transferring their ownership to the registry.
+     *
+     * @param key The key of the objects
+     * @param entry The objects to register
+     * @return true if registered, false if \p key was already registered in
+     * which case the ownership of the objects stays with the caller
+     */
+    bool insert(const Key& key, const Entry& entry);
+
+    /**
+     * Removes a reference to the objects registered under \p key, destroying
+     * them when no references are left.
+     *
+     * @param key The key of the objects
+     */
+    void release(const Key& key);
+
+    /**
+     * Destroys all the registered objects. Algorithms still holding a
+     * reference to them become invalid.
+     */
+    void destroy();
+
+    /**
+     * Returns the number of distinct entries currently registered.
+     *
+     * @return Number of registered entries
+     */
+    uint32_t size();
+
+    /**
+     * Returns the number of times acquire found registered objects, which
+     * is the number of pipelines that did not have to be created.
+     *
+     * @return Number of successful lookups
+     */
+    uint64_t hitCount();
+
+  private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return static_cast<size_t>(key.hash);
+        }
+    };
+
+    struct RegisteredEntry
+    {
+        Entry entry;
+        uint32_t refCount = 0;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::Device> mDevice;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::unordered_map<Key, RegisteredEntry, KeyHash> mEntries;
+    uint64_t mHitCount = 0;
+    std::mutex mMutex;
+
+    void destroyEntry(Entry& entry);
+};
+
+} // End namespace kp
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Float16.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Block of 32 elements quantized to int8 values with a shared half precision
+ * scale, so each element is dequantized as value * scale. Blocks take 34 bytes
+ * for 32 elements, about 3.8 times less than floats, and can be used as the
+ * element type of tensors of type eBlockInt8.
+ *
+ * The layout matches the Q8_0 blocks of GGML so weights quantized by other
+ * tools can be uploaded as they are.
+ */
+struct BlockInt8
+{
+    static constexpr uint32_t blockSize = 32;
+
+    Half scale;
+    int8_t values[blockSize];
+
+    /**
+     * The number of blocks used to quantize the elements provided, which is
+     * rounded up to an even number of blocks so the blocks of a tensor take a
+     * multiple of 4 bytes. The elements of the padding are quantized as zero.
+     *
+     * @param elementCount The number of elements to quantize
+     * @return The number of blocks
+     */
+    static uint64_t blockCount(uint64_t elementCount);
+
+    /**
+     * Quantizes the elements provided into blocks, using SIMD instructions when
+     * available. Each block is scaled by the largest magnitude of its elements.
+     *
+     * @param data The elements to quantize
+     * @param elementCount The number of elements to quantize
+     * @param blocks The blocks to quantize into, which have to be at least
+     * blockCount(elementCount)
+     */
+    static void quantize(const float* data,
+                         uint64_t elementCount,
+                         BlockInt8* blocks);
+
+    /**
+     * Dequantizes the blocks provided into their elements.
+     *
+     * @param blocks The blocks to dequantize
+     * @param blockCount The number of blocks to dequantize
+     * @param data The elements to dequantize into, which have to be at least
+     * blockCount * blockSize
+     */
+    static void dequantize(const BlockInt8* blocks,
+                           uint64_t blockCount,
+                           float* data);
+
+    /**
+     * Quantizes the vector of elements provided into blocks.
+     *
+     * @param data The elements to quantize
+     * @return The blocks, including the padding to an even number of blocks
+     */
+    static std::vector<BlockInt8> quantize(const std::vector<float>& data);
+
+    /**
+     * Dequantizes the vector of blocks provided into their elements.
+     *
+     * @param blocks The blocks to dequantize
+     * @return The elements, including the padding of the blocks
+     */
+    static std::vector<float> dequantize(const std::vector<BlockInt8>& blocks);
+};
+
+/**
+ * Block of 32 elements quantized to 4-bit values with a shared half precision
+ * scale, so each element is dequantized as (value - 8) * scale. The values are
+ * packed in pairs, the low 4 bits of the i-th byte holding the i-th element
+ * and the high 4 bits the (i + 16)-th element. Blocks take 18 bytes for 32
+ * elements, about 7.1 times less than floats, and can be used as the element
+ * type of tensors of type eBlockInt4.
+ *
+ * The layout matches the Q4_0 blocks of GGML so weights quantized by other
+ * tools can be uploaded as they are.
+ */
+struct BlockInt4
+{
+    static constexpr uint32_t blockSize = 32;
+
+    Half scale;
+    uint8_t values[blockSize / 2];
+
+    /**
+     * The number of blocks used to quantize the elements provided, which is
+     * rounded up to an even number of blocks so the blocks of a tensor take a
+     * multiple of 4 bytes. The elements of the padding are quantized as zero.
+     *
+     * @param elementCount The number of elements to quantize
+     * @return The number of blocks
+     */
+    static uint64_t blockCount(uint64_t elementCount);
+
+    /**
+     * Quantizes the elements provided into blocks, using SIMD instructions when
+     * available. Each block is scaled so its element of largest magnitude maps
+     * to -8, which keeps the full range of the values.
+     *
+     * @param data The elements to quantize
+     * @param elementCount The number of elements to quantize
+     * @param blocks The blocks to quantize into, which have to be at least
+     * blockCount(elementCount)
+     */
+    static void quantize(const float* data,
+                         uint64_t elementCount,
+                         BlockInt4* blocks);
+
+    /**
+     * Dequantizes the blocks provided into their elements.
+     *
+     * @param blocks The blocks to dequantize
+     * @param blockCount The number of blocks to dequantize
+     * @param data The elements to dequantize into, which have to be at least
+     * blockCount * blockSize
+     */
+    static void dequantize(const BlockInt4* blocks,
+                           uint64_t blockCount,
+                           float* data);
+
+    /**
+     * Quantizes the vector of elements provided into blocks.
+     *
+     * @param data The elements to quantize
+     * @return The blocks, including the padding to an even number of blocks
+     */
+    static std::vector<BlockInt4> quantize(const std::vector<float>& data);
+
+    /**
+     * Dequantizes the vector of blocks provided into their elements.
+     *
+     * @param blocks The blocks to dequantize
+     * @return The elements, including the padding of the blocks
+     */
+    static std::vector<float> dequantize(const std::vector<BlockInt4>& blocks);
+};
+
+static_assert(sizeof(BlockInt8) == 34,
+              "kp::BlockInt8 has to be stored as 34 bytes");
+static_assert(sizeof(BlockInt4) == 18,
+              "kp::BlockInt4 has to be stored as 18 bytes");
+
+} // End namespace kp
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/BarrierBatch.hpp"
+#include "kompute/Core.hpp"
+#include "kompute/Image.hpp"
+#include "kompute/Tensor.hpp"
+#include "logger/Logger.hpp"
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace kp {
+
+/**
+ * Tracks the last access performed on the primary resource of each memory
+ * object while a Sequence records its operations, so that only the barriers
+ * required by the accesses that follow are recorded.
+ *
+ * Operations declare the accesses they are about to perform with access()
+ * and call flush() before recording the commands that perform them, which
+ * records all the pending buffer and image barriers in a single
+ * pipelineBarrier call. Read after read accesses do not record any barrier,
+ * read after write accesses record a memory dependency unless the write was
+ * already made visible to the stage and access, and write after read
+ * accesses only record an execution dependency.
+ *
+ * Memory objects that have not been accessed since the tracker was reset are
+ * conservatively assumed to have been written by a transfer or a compute
+ * shader, as their state before the recording is not known. Tensor views are
+ * tracked together with their parent tensor, as they share its buffer.
+ *
+ * The tracker also follows the residency of the data of the memory objects
+ * through the recording, so sync operations only record the transfers of
+ * memory objects that are not already coherent. The residency resulting from
+ * the recording is applied to the memory objects once the sequence has been
+ * evaluated, and the sequence is recorded again when the residency the
+ * recorded transfers depended on has changed since.
+ *
+ * Tensors evicted by a MemoryBudget are restored when first accessed by the
+ * recording, and the tensors accessed are pinned from then until the
+ * sequence has been evaluated, so they are not evicted while in use. The
+ * sequence is also recorded again when one of the tensors has been evicted
+ * or restored since, as the recorded commands refer to its old buffer.
+ */
+class ResourceStateTracker
+{
+  public:
+    /**
+     * Default constructor for an empty tracker.
+     */
+    ResourceStateTracker() = default;
+
+    /**
+     * @brief Make ResourceStateTracker uncopyable
+     *
+     */
+    ResourceStateTracker(const ResourceStateTracker&) = delete;
+    ResourceStateTracker(const ResourceStateTracker&&) = delete;
+    ResourceStateTracker& operator=(const ResourceStateTracker&) = delete;
+    ResourceStateTracker& operator=(const ResourceStateTracker&&) = delete;
+
+    /**
+     * Declares an access to the primary resource of the memory object
+     * provided, adding the barrier required to the pending barriers if any.
+     *
+     * @param memory The memory object that is going to be accessed
+     * @param stageMask The pipeline stages performing the access
+     * @param accessMask The access types of the access
+     * @param write Whether the access writes to the memory object
+     * @param layout The image layout required by the access, which is ignored
+     * for tensors and keeps the current layout when set to eUndefined
+     */
+    void access(const std::shared_ptr<Memory>& memory,
+                vk::PipelineStageFlags stageMask,
+                vk::AccessFlags accessMask,
+                bool write,
+                vk::ImageLayout layout = vk::ImageLayout::eUndefined);
+
+    /**
+     * Records all the pending barriers into the command buffer with a single
+     * pipelineBarrier call. Nothing is recorded if there are no pending
+     * barriers.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the barriers into
+     */
+    void flush(const vk::CommandBuffer& commandBuffer);
+
+    /**
+     * Forgets the state of all memory objects and drops any pending barrier,
+     * which is required when commands are recorded without declaring their
+     * accesses to the tracker.
+     */
+    void reset();
+
+    /**
+     * Whether the commands recorded so far may have accessed the memory
+     * object, which is assumed for all memory objects once commands were
+     * recorded without declaring their accesses.
+     *
+     * @param memory The memory object to check
+     * @return Boolean stating whether the memory object may have been accessed
+     */
+    bool accessed(const std::shared_ptr<Memory>& memory) const;
+
+    /**
+     * The residency of the data of the memory object at the current point of
+     * the recording. Sync operations which depend on it have to be recorded
+     * again when the residency of the memory object changes.
+     *
+     * @param memory The memory object to get the residency of
+     * @return The residency of the data of the memory object
+     */
+    Memory::Residency residency(const std::shared_ptr<Memory>& memory);
+
+    /**
+     * Sets the residency of the data of the memory object resulting from the
+     * commands recorded so far, such as the transfers of sync operations.
+     *
+     * @param memory The memory object to set the residency of
+     * @param residency The residency of the data after the recorded commands
+     */
+    void setResidency(const std::shared_ptr<Memory>& memory,
+                      Memory::Residency residency);
+
+    /**
+     * Assumes that the device memory of all memory objects may have been
+     * written by the commands recorded so far, which is required when
+     * commands are recorded without declaring their accesses to the tracker.
+     * Until the next recording, the memory objects are treated as device
+     * dirty unless a sync operation made them coherent again, so the sync
+     * operations that follow record their transfers. Once the commands have
+     * been executed, the residency of all memory objects is invalidated when
+     * applying the residency, including the ones the recording did not
+     * access.
+     */
+    void invalidateResidency();
+
+    /**
+     * Whether the residency of any memory object the recorded commands
+     * depend on has changed since the recording.
+     *
+     * @return Boolean stating whether the commands have to be recorded again
+     */
+    bool residencyChanged();
+
+    /**
+     * Applies the residency resulting from the recorded commands to the
+     * memory objects, once the commands have been executed.
+     */
+    void applyResidency();
+
+    /**
+     * Forgets the residency of all memory objects, which is required when
+     * starting a new recording, and unpins the tensors pinned by the
+     * recording.
+     */
+    void resetResidency();
+
+    /**
+     * Pins the tensors accessed by the recorded commands again, which is
+     * required before submitting them.
+     */
+    void pinMemory();
+
+    /**
+     * Unpins the tensors accessed by the recorded commands, once the
+     * commands have been executed.
+     */
+    void unpinMemory();
+
+    /**
+     * Returns the number of buffer and image barriers recorded since the
+     * tracker was created.
+     *
+     * @return Number of buffer and image barriers recorded
+     */
+    uint32_t barrierCount() const;
+
+    /**
+     * Returns the number of pipelineBarrier calls recorded since the tracker
+     * was created.
+     *
+     * @return Number of pipeline barrier commands recorded
+     */
+    uint32_t pipelineBarrierCount() const;
+
+  private:
+    struct State
+    {
+        // Last write, which later accesses have to wait for
+        vk::PipelineStageFlags writeStageMask;
+        vk::AccessFlags writeAccessMask;
+        // Stages and accesses the last write has been made visible to
+        vk::PipelineStageFlags visibleStageMask;
+        vk::AccessFlags visibleAccessMask;
+        // Stages that read the memory since the last write
+        vk::PipelineStageFlags readStageMask;
+    };
+
+    struct ResidencyState
+    {
+        std::shared_ptr<Memory> memory;
+        // Residency of the memory object when the recording first accessed it
+        Memory::Residency recordedResidency;
+        Memory::Residency residency;
+        // Whether recorded commands depend on the recorded residency
+        bool queried = false;
+        // Whether the recorded commands change the residency
+        bool changed = false;
+        // Whether the tensor is pinned by the tracker
+        bool pinned = false;
+        // Generation of the buffer of the tensor the commands refer to
+        uint64_t generation = 0;
+    };
+
+    // Keyed by the primary resource, which views share with their parent
+    std::map<const void*, State> mStates;
+    std::map<const void*, ResidencyState> mResidencyStates;
+    // Whether commands recorded without declaring their accesses may have
+    // written memory objects not accessed by the recording yet
+    bool mResidencyInvalidated = false;
+    BarrierBatch mBarrierBatch;
+    uint32_t mBarrierCount = 0;
+    uint32_t mPipelineBarrierCount = 0;
+
+    void addBarrier(const std::shared_ptr<Memory>& memory,
+                    vk::PipelineStageFlags srcStageMask,
+                    vk::AccessFlags srcAccessMask,
+                    vk::PipelineStageFlags dstStageMask,
+                    vk::AccessFlags dstAccessMask,
+                    vk::ImageLayout layout);
+    ResidencyState& residencyState(const std::shared_ptr<Memory>& memory);
+    static const void* primaryResource(const std::shared_ptr<Memory>& memory);
+};
+
+} // End namespace kp
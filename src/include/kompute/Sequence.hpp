@@ -2,6 +2,9 @@
 #pragma once
 
 #include "kompute/Core.hpp"
+#include "kompute/ResourceStateTracker.hpp"
+#include <atomic>
+#include <mutex>
 
 #include "kompute/operations/OpAlgoDispatch.hpp"
 #include "kompute/operations/OpBase.hpp"
@@ -23,12 +26,24 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      * @param computeQueue Vulkan compute queue
      * @param queueIndex Vulkan compute queue index in device
      * @param totalTimestamps Maximum number of timestamps to allocate
+     * @param timelineSemaphores Whether timeline semaphores are enabled on the
+     * device, which sequences wait on each other with instead of binary
+     * semaphores
+     * @param slotCount Number of command buffer and fence slots the
+     * evaluations cycle through, which allows up to that many evaluations to
+     * run at the same time
+     * @param queueMutex Mutex held while submitting to the compute queue,
+     * shared by all the objects submitting to it, or nullptr to use a mutex
+     * of its own
      */
     Sequence(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
              std::shared_ptr<vk::Device> device,
              std::shared_ptr<vk::Queue> computeQueue,
              uint32_t queueIndex,
-             uint32_t totalTimestamps = 0) noexcept;
+             uint32_t totalTimestamps = 0,
+             bool timelineSemaphores = false,
+             uint32_t slotCount = 1,
+             std::shared_ptr<std::mutex> queueMutex = nullptr) noexcept;
 
     /**
      * @brief Make Sequence uncopyable
@@ -158,6 +173,11 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      * must ALWAYS be called after to ensure the sequence is terminated
      * correctly.
      *
+     * With more than one slot, each call submits the command buffer of the
+     * next slot, recording the operations into it first if it does not hold
+     * them yet, and only blocks to await the slot if its previous submission
+     * is still running. EvalAwait() then awaits every running slot.
+     *
      * @return Boolean stating whether execution was successful.
      */
     std::shared_ptr<Sequence> evalAsync();
@@ -209,13 +229,106 @@ class Sequence : public std::enable_shared_from_this<Sequence>
 
     /**
      * Eval Await waits for the fence to finish processing and then once it
-     * finishes, it runs the postEval of all operations.
+     * finishes, it runs the postEval of all operations. With more than one
+     * slot, it waits for the submissions of all the running slots. On
+     * timeout the submissions are no longer tracked as running: the postEval
+     * of the operations is skipped, and their tensors are unpinned.
      *
      * @param waitFor Number of milliseconds to wait before timing out.
      * @return shared_ptr<Sequence> of the Sequence class itself
      */
     std::shared_ptr<Sequence> evalAwait(uint64_t waitFor = UINT64_MAX);
 
+    /**
+     * Submits the recorded operations of several sequences on the same queue
+     * in a single submission signalling a single fence, which is the fence of
+     * the first sequence, instead of one submission and fence per sequence.
+     * The command buffers are submitted in the order of the sequences. Each
+     * sequence has to be awaited afterwards, either with evalAwaitBatch or
+     * with its own evalAwait, and the first sequence cannot be evaluated
+     * again before all the sequences of the batch have been awaited.
+     *
+     * The sequences are validated before any of them is prepared, and none
+     * of them is left running if preparing one of them fails.
+     *
+     * @param sequences The sequences to submit, which must not be running
+     */
+    static void evalAsyncBatch(
+      const std::vector<std::shared_ptr<Sequence>>& sequences);
+
+    /**
+     * Waits for the submissions of the sequences provided, usually submitted
+     * together with evalAsyncBatch, to finish processing with a single wait
+     * on their fences, and then runs the postEval of all their operations.
+     *
+     * @param sequences The sequences to wait for
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     */
+    static void evalAwaitBatch(
+      const std::vector<std::shared_ptr<Sequence>>& sequences,
+      uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Waits until the running submissions of any of the sequences provided
+     * completed, with a single wait on their fences that does not wait for
+     * all of them, which allows handling the sequences in the order they
+     * complete instead of the order they were submitted. The sequence found
+     * still has to be awaited to run the postEval of its operations, which
+     * does not block anymore. Sequences that are not running are ignored.
+     *
+     * @param sequences The sequences to wait for
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     * @return The index of a sequence whose submissions completed, or -1 if
+     * none completed before timing out or none is running
+     */
+    static int32_t waitAny(
+      const std::vector<std::shared_ptr<Sequence>>& sequences,
+      uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Waits until the running submissions of all the sequences provided
+     * completed, with a single wait on their fences. Unlike evalAwaitBatch,
+     * the sequences are not awaited, so the postEval of their operations
+     * only runs when awaiting them afterwards, which does not block anymore.
+     *
+     * @param sequences The sequences to wait for
+     * @param waitFor Number of nanoseconds to wait before timing out.
+     * @return Boolean stating whether all the sequences completed before
+     * timing out
+     */
+    static bool waitAll(const std::vector<std::shared_ptr<Sequence>>& sequences,
+                        uint64_t waitFor = UINT64_MAX);
+
+    /**
+     * Makes the submissions of this sequence wait on the device for the last
+     * submission of the sequence provided, so stages of a pipeline can be
+     * submitted up front without waiting on the host for each stage to
+     * complete. The dependency holds for every later submission until
+     * clearDependencies is called, and a submission only waits if the
+     * sequence provided was submitted since the previous one. The sequence
+     * provided still has to be awaited to run the postEval of its
+     * operations, which does not block once this sequence completed.
+     *
+     * Timeline semaphores are used when enabled on the device, otherwise
+     * each submission of the sequence provided signals a binary semaphore
+     * waited by the next submission of this sequence, which requires the
+     * sequence provided to have a single slot.
+     *
+     * @param sequence The sequence to wait on, created on the same device
+     * @param waitStageMask The stages of this sequence that wait
+     * @return shared_ptr<Sequence> of the Sequence class itself
+     */
+    std::shared_ptr<Sequence> waitOn(
+      std::shared_ptr<Sequence> sequence,
+      vk::PipelineStageFlags waitStageMask =
+        vk::PipelineStageFlagBits::eAllCommands);
+
+    /**
+     * Removes the dependencies added with waitOn, which cannot be done while
+     * the sequence is running.
+     */
+    void clearDependencies();
+
     /**
      * Clear function clears all operations currently recorded and starts
      * recording again.
@@ -228,6 +341,15 @@ class Sequence : public std::enable_shared_from_this<Sequence>
      */
     std::vector<std::uint64_t> getTimestamps();
 
+    /**
+     * Returns the tracker of the memory object accesses of the operations
+     * recorded, whose state is reset every time the sequence begins
+     * recording.
+     *
+     * @return Shared pointer to the resource state tracker of the sequence
+     */
+    std::shared_ptr<ResourceStateTracker> getResourceStateTracker();
+
     /**
      * Begins recording commands for commands to be submitted into the command
      * buffer.
@@ -264,12 +386,57 @@ class Sequence : public std::enable_shared_from_this<Sequence>
 
     /**
      * Returns true if the sequence is currently running - mostly used for async
-     * workloads.
+     * workloads. With more than one slot, any running slot counts.
      *
      * @return Boolean stating if currently running.
      */
     bool isRunning() const;
 
+    /**
+     * Queries the device without blocking whether the running submissions of
+     * the sequence completed, unlike isRunning which stays true until the
+     * sequence is awaited. EvalAwait() still has to be called to run the
+     * postEval of the operations, which does not block once this returns
+     * true.
+     *
+     * @return Boolean stating if all the running submissions completed, which
+     * is also the case if the sequence is not running
+     */
+    bool isComplete() const;
+
+    /**
+     * Returns the number of command buffer and fence slots the evaluations
+     * of the sequence cycle through.
+     *
+     * @return Number of slots of the sequence
+     */
+    uint32_t slotCount() const;
+
+    /**
+     * Returns the fences signalled by the submissions of the running slots,
+     * oldest submission first, which are shared by the sequences submitted
+     * in the same batch.
+     *
+     * @return Fences of the running submissions of the sequence
+     */
+    std::vector<vk::Fence> getRunningFences() const;
+
+    /**
+     * Returns the timeline semaphore signalled by the submissions of the
+     * sequence, which is only created when timeline semaphores are enabled.
+     *
+     * @return Timeline semaphore of the sequence, or a null handle
+     */
+    vk::Semaphore getTimelineSemaphore() const;
+
+    /**
+     * Returns the value signalled on the timeline semaphore by the last
+     * submission of the sequence.
+     *
+     * @return Value signalled by the last submission, or 0 if not submitted
+     */
+    uint64_t getTimelineValue() const;
+
     /**
      * Destroys and frees the GPU resources which include the buffer and memory
      * and sets the sequence as init=False.
@@ -281,6 +448,7 @@ class Sequence : public std::enable_shared_from_this<Sequence>
     std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice = nullptr;
     std::shared_ptr<vk::Device> mDevice = nullptr;
     std::shared_ptr<vk::Queue> mComputeQueue = nullptr;
+    std::shared_ptr<std::mutex> mQueueMutex = nullptr;
     uint32_t mQueueIndex = -1;
 
     // -------------- OPTIONALLY OWNED RESOURCES
@@ -291,12 +459,107 @@ class Sequence : public std::enable_shared_from_this<Sequence>
 
     // -------------- ALWAYS OWNED RESOURCES
     vk::Fence mFence;
+    vk::Semaphore mTimelineSemaphore;
     std::vector<std::shared_ptr<OpBase>> mOperations{};
     std::shared_ptr<vk::QueryPool> timestampQueryPool = nullptr;
+    std::shared_ptr<ResourceStateTracker> mResourceStateTracker;
 
     // State
     bool mRecording = false;
     bool mIsRunning = false;
+    bool mTimelineSemaphores = false;
+    // Value signalled by the last submission on the timeline semaphore
+    uint64_t mTimelineValue = 0;
+    // First sequence of the batch submitted with this one, whose fence is
+    // signalled by the submission, or nullptr if submitted on its own
+    std::shared_ptr<Sequence> mSubmitLeader = nullptr;
+    vk::Fence mSubmitFence;
+    // Sequences of the batches led by this one which were not awaited yet,
+    // decremented by the thread awaiting them, as they wait on its fence
+    std::atomic<uint32_t> mPendingFollowers{ 0 };
+    // Operations whose postEval runs once the submission completed
+    std::vector<std::shared_ptr<OpBase>> mSubmittedOperations;
+    // Whether the command buffer holds the operations currently recorded
+    bool mRecorded = true;
+
+    // Binary semaphores signalled by the submissions of a sequence and waited
+    // by the submissions of a sequence depending on it, which owns them
+    struct SemaphoreLink
+    {
+        vk::Semaphore signalled;
+        std::vector<vk::Semaphore> available;
+    };
+
+    struct Dependency
+    {
+        std::shared_ptr<Sequence> sequence;
+        vk::PipelineStageFlags waitStageMask;
+        // Null when waiting on the timeline semaphore of the sequence
+        std::shared_ptr<SemaphoreLink> link;
+    };
+
+    // Semaphores waited and signalled by a submission, which have to outlive
+    // the submit info referring to them
+    struct SubmitSemaphores
+    {
+        std::vector<vk::Semaphore> waitSemaphores;
+        std::vector<uint64_t> waitValues;
+        std::vector<vk::PipelineStageFlags> waitStageMasks;
+        std::vector<vk::Semaphore> signalSemaphores;
+        std::vector<uint64_t> signalValues;
+        vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo;
+    };
+
+    struct WaitedSemaphore
+    {
+        std::shared_ptr<SemaphoreLink> link;
+        vk::Semaphore semaphore;
+    };
+
+    std::vector<Dependency> mDependencies;
+    std::vector<std::shared_ptr<SemaphoreLink>> mSignalLinks;
+    // Binary semaphores waited by the submission, recycled once it completed
+    std::vector<WaitedSemaphore> mWaitedSemaphores;
+
+    // Command buffer, fence and state of a slot, which are swapped with the
+    // members of the sequence while the slot is the active one
+    struct Slot
+    {
+        std::shared_ptr<vk::CommandBuffer> commandBuffer = nullptr;
+        vk::Fence fence;
+        std::shared_ptr<vk::QueryPool> timestampQueryPool = nullptr;
+        std::shared_ptr<ResourceStateTracker> resourceStateTracker;
+        bool recording = false;
+        bool isRunning = false;
+        std::shared_ptr<Sequence> submitLeader = nullptr;
+        vk::Fence submitFence;
+        std::vector<std::shared_ptr<OpBase>> submittedOperations;
+        bool recorded = true;
+        std::vector<WaitedSemaphore> waitedSemaphores;
+    };
+
+    // The entry of the active slot is left empty, and the slots are
+    // submitted in order starting from the active one
+    std::vector<Slot> mSlots;
+    uint32_t mSlotIndex = 0;
+
+    // Eval functions shared by the single and batched submissions
+    void acquireSlot();
+    void prepareEval();
+    void abortEval();
+    void completeEval();
+    void abandonEval();
+    void releaseSubmitLeader();
+    vk::SubmitInfo createSubmitInfo(SubmitSemaphores& semaphores);
+    void destroyDependencies();
+
+    // Slot functions
+    void swapSlot(Slot& slot);
+    void activateSlot(uint32_t slotIndex);
+    void advanceSlot();
+    void awaitSlot();
+    void finishRunningSlots(bool completed);
+    void applyRunningResidency();
 
     // Create functions
     void createCommandPool();
@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+#include "logger/Logger.hpp"
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Size of the host visible buffer that data is streamed through
+#define KP_DEFAULT_STAGING_RING_SIZE (16ull * 1024ull * 1024ull)
+
+namespace kp {
+
+/**
+ * Host visible staging buffer shared by the memory objects of a Manager,
+ * which device memory objects stream their data through instead of keeping
+ * a staging copy of the same size for their whole lifetime.
+ *
+ * The buffer is split in segments that are filled and submitted in turn, so
+ * the host can copy the data of a chunk while the transfer of the previous
+ * chunk is still being executed. Data larger than a segment is split in
+ * multiple chunks, which bounds the host visible memory used regardless of
+ * the number and size of the device memory objects.
+ *
+ * Transfers are submitted to the queue provided and waited on before
+ * upload() and download() return, so the data provided can be reused or read
+ * straight away.
+ */
+class StagingRing
+{
+  public:
+    /**
+     * Function recording the copy of a chunk between the staging buffer and
+     * the device memory of a memory object, including the barriers required.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param stagingBuffer The staging buffer to copy the chunk from or to
+     * @param stagingOffset The offset of the chunk in the staging buffer
+     * @param offset The offset of the chunk in the memory object data
+     * @param size The size of the chunk in bytes
+     */
+    typedef std::function<void(const vk::CommandBuffer& commandBuffer,
+                               const vk::Buffer& stagingBuffer,
+                               vk::DeviceSize stagingOffset,
+                               vk::DeviceSize offset,
+                               vk::DeviceSize size)>
+      RecordChunk;
+
+    /**
+     * Constructor for the staging ring.
+     *
+     * @param physicalDevice The physical device to fetch memory properties
+     * @param device The device to allocate the staging buffer from
+     * @param queue The queue to submit the transfers to
+     * @param queueIndex The family index of the queue provided
+     * @param size The size in bytes of the staging buffer
+     * @param queueMutex Mutex held while submitting to the queue, shared by
+     * all the objects submitting to it, or nullptr to use a mutex of its own
+     */
+    StagingRing(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+                std::shared_ptr<vk::Device> device,
+                std::shared_ptr<vk::Queue> queue,
+                uint32_t queueIndex,
+                vk::DeviceSize size = KP_DEFAULT_STAGING_RING_SIZE,
+                std::shared_ptr<std::mutex> queueMutex = nullptr);
+
+    /**
+     * @brief Make StagingRing uncopyable
+     *
+     */
+    StagingRing(const StagingRing&) = delete;
+    StagingRing(const StagingRing&&) = delete;
+    StagingRing& operator=(const StagingRing&) = delete;
+    StagingRing& operator=(const StagingRing&&) = delete;
+
+    /**
+     * Destructor which frees the staging buffer and the command buffers.
+     */
+    ~StagingRing();
+
+    /**
+     * Streams data from the host into device memory, one chunk at a time.
+     *
+     * @param data The host data to upload
+     * @param size The size in bytes of the data
+     * @param granularity The size in bytes chunks have to be a multiple of
+     * @param recordChunk Function recording the copy of each chunk from the
+     * staging buffer
+     */
+    void upload(const void* data,
+                vk::DeviceSize size,
+                vk::DeviceSize granularity,
+                const RecordChunk& recordChunk);
+
+    /**
+     * Streams data from device memory into the host, one chunk at a time.
+     *
+     * @param data The host memory to download the data into
+     * @param size The size in bytes of the data
+     * @param granularity The size in bytes chunks have to be a multiple of
+     * @param recordChunk Function recording the copy of each chunk into the
+     * staging buffer
+     */
+    void download(void* data,
+                  vk::DeviceSize size,
+                  vk::DeviceSize granularity,
+                  const RecordChunk& recordChunk);
+
+    /**
+     * Destroys the staging buffer and the command buffers, after waiting for
+     * the transfers in flight.
+     */
+    void destroy();
+
+    /**
+     * The size in bytes of the staging buffer.
+     *
+     * @return Size of the staging buffer
+     */
+    vk::DeviceSize size();
+
+    /**
+     * The maximum size in bytes of a single chunk, which is the size of a
+     * segment of the staging buffer.
+     *
+     * @return Maximum size of a chunk
+     */
+    vk::DeviceSize chunkSize();
+
+    /**
+     * The total number of chunks streamed since the ring was created.
+     *
+     * @return Number of chunks streamed
+     */
+    uint64_t chunkCount();
+
+  private:
+    struct Segment
+    {
+        vk::DeviceSize offset = 0;
+        vk::CommandBuffer commandBuffer;
+        vk::Fence fence;
+        bool inFlight = false;
+        // Host memory the chunk is copied into once downloaded
+        void* downloadData = nullptr;
+        vk::DeviceSize downloadSize = 0;
+    };
+
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<vk::PhysicalDevice> mPhysicalDevice;
+    std::shared_ptr<vk::Device> mDevice;
+    std::shared_ptr<vk::Queue> mQueue;
+    std::shared_ptr<std::mutex> mQueueMutex;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    vk::Buffer mBuffer;
+    vk::DeviceMemory mMemory;
+    uint8_t* mMappedData = nullptr;
+    vk::CommandPool mCommandPool;
+    std::vector<Segment> mSegments;
+    uint32_t mNextSegment = 0;
+    vk::DeviceSize mSize = 0;
+    vk::DeviceSize mSegmentSize = 0;
+    uint64_t mChunkCount = 0;
+    std::mutex mMutex;
+
+    void createBuffer();
+    void createSegments(uint32_t queueIndex);
+    vk::DeviceSize alignedChunkSize(vk::DeviceSize granularity);
+    Segment& acquireSegment();
+    void submitSegment(Segment& segment,
+                       bool download,
+                       vk::DeviceSize offset,
+                       vk::DeviceSize size,
+                       const RecordChunk& recordChunk);
+    void waitSegment(Segment& segment);
+    void waitAll();
+};
+
+} // End namespace kp
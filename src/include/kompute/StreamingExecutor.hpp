@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Core.hpp"
+#include "kompute/Sequence.hpp"
+#include "logger/Logger.hpp"
+#include <memory>
+#include <vector>
+
+// Number of chunks in flight, so the upload of a chunk, the dispatch of the
+// previous one and the download of the one before can overlap
+#define KP_DEFAULT_STREAMING_SLOT_COUNT 3
+
+namespace kp {
+
+/**
+ * Executor running an algorithm over host buffers larger than the device
+ * memory, by splitting them in chunks of the size of the memory objects the
+ * algorithm is bound to and streaming the chunks through the device.
+ *
+ * Each slot of the executor has its own device tensors for the streamed
+ * bindings, its own descriptor set in the algorithm and its own sequence,
+ * which is recorded once with the upload, the dispatch and the download of
+ * a chunk. Chunks are submitted to the slots in turn and a slot is only
+ * waited on when it is reused, so while the device processes the chunks in
+ * flight the host copies the results of the completed chunks out and the
+ * data of the next chunks in.
+ *
+ * The bindings of the algorithm that are not streamed are shared by all the
+ * chunks in flight, so they are expected to only be read by the shader, for
+ * example weights or lookup tables that were synced to the device before.
+ */
+class StreamingExecutor
+{
+  public:
+    /**
+     * Measurements of a run of the executor.
+     */
+    struct Stats
+    {
+        uint64_t elementCount = 0;    ///< Number of elements streamed
+        uint64_t chunkCount = 0;      ///< Number of chunks dispatched
+        uint64_t bytesUploaded = 0;   ///< Bytes copied from the inputs
+        uint64_t bytesDownloaded = 0; ///< Bytes copied to the outputs
+        double seconds = 0;           ///< Wall clock duration of the run
+
+        /**
+         * The number of bytes streamed to and from the device per second.
+         *
+         * @return Throughput of the run in bytes per second
+         */
+        double throughput() const;
+    };
+
+    /**
+     * Constructor which records the sequence of each slot. The memory objects
+     * of each slot replace the ones the algorithm was built with, and only
+     * differ from them in the streamed bindings.
+     *
+     * @param algorithm The algorithm to dispatch for each chunk
+     * @param inputBindings The bindings whose data is uploaded for each chunk
+     * @param outputBindings The bindings whose data is downloaded for each
+     * chunk
+     * @param sequences The sequence of each slot
+     * @param slotMemObjects The memory objects bound to the algorithm by each
+     * slot, whose streamed bindings have to be eDevice tensors of the same
+     * number of elements
+     */
+    StreamingExecutor(
+      std::shared_ptr<Algorithm> algorithm,
+      const std::vector<uint32_t>& inputBindings,
+      const std::vector<uint32_t>& outputBindings,
+      const std::vector<std::shared_ptr<Sequence>>& sequences,
+      const std::vector<std::vector<std::shared_ptr<Memory>>>& slotMemObjects);
+
+    /**
+     * @brief Make StreamingExecutor uncopyable
+     *
+     */
+    StreamingExecutor(const StreamingExecutor&) = delete;
+    StreamingExecutor(const StreamingExecutor&&) = delete;
+    StreamingExecutor& operator=(const StreamingExecutor&) = delete;
+    StreamingExecutor& operator=(const StreamingExecutor&&) = delete;
+
+    /**
+     * Streams host buffers through the algorithm chunk by chunk and returns
+     * once the results of all the chunks were copied to the outputs. The last
+     * chunk is padded with zeros when the number of elements is not a
+     * multiple of the chunk size, and only its valid elements are copied to
+     * the outputs.
+     *
+     * @param inputs The host buffer of each input binding, in the order of
+     * the input bindings, holding elementCount elements each
+     * @param outputs The host buffer of each output binding, in the order of
+     * the output bindings, holding elementCount elements each
+     * @param elementCount The number of elements of each buffer
+     * @return The measurements of the run, which are also logged
+     */
+    Stats run(const std::vector<const void*>& inputs,
+              const std::vector<void*>& outputs,
+              uint64_t elementCount);
+
+    /**
+     * The number of elements of each streamed binding processed per chunk.
+     *
+     * @return Size of the chunks in elements
+     */
+    uint64_t chunkSize();
+
+    /**
+     * The number of chunks that can be in flight at the same time.
+     *
+     * @return Number of slots of the executor
+     */
+    uint32_t slotCount();
+
+    /**
+     * Gets the memory objects bound to the algorithm by a slot.
+     *
+     * @param slot The index of the slot
+     * @returns The memory objects of the slot, in the order of the bindings
+     */
+    const std::vector<std::shared_ptr<Memory>>& getMemObjects(uint32_t slot);
+
+    /**
+     * Gets the bindings whose data is uploaded for each chunk.
+     *
+     * @returns The input bindings, in the order of the inputs of run
+     */
+    const std::vector<uint32_t>& getInputBindings();
+
+    /**
+     * Gets the bindings whose data is downloaded for each chunk.
+     *
+     * @returns The output bindings, in the order of the outputs of run
+     */
+    const std::vector<uint32_t>& getOutputBindings();
+
+  private:
+    // -------------- NEVER OWNED RESOURCES
+    std::shared_ptr<Algorithm> mAlgorithm;
+    std::vector<std::shared_ptr<Sequence>> mSequences;
+    std::vector<std::vector<std::shared_ptr<Memory>>> mSlotMemObjects;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    std::vector<uint32_t> mInputBindings;
+    std::vector<uint32_t> mOutputBindings;
+    std::vector<uint32_t> mDescriptorSetIndices;
+    uint64_t mChunkSize = 0;
+
+    void submitChunk(uint32_t slot,
+                     uint64_t chunk,
+                     const std::vector<const void*>& inputs,
+                     uint64_t elementCount,
+                     Stats& stats);
+    void completeChunk(uint32_t slot,
+                       uint64_t chunk,
+                       const std::vector<void*>& outputs,
+                       uint64_t elementCount,
+                       Stats& stats);
+};
+
+} // End namespace kp
@@ -2,10 +2,14 @@
 #pragma once
 
 #include "kompute/Core.hpp"
+#include "kompute/MappedFile.hpp"
 #include "kompute/Memory.hpp"
+#include "kompute/MemoryBudget.hpp"
 #include "logger/Logger.hpp"
 #include <memory>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace kp {
 
@@ -22,6 +26,26 @@ class Image;
 class Tensor : public Memory
 {
   public:
+    /**
+     * Range of elements of a tensor, used to transfer only the parts of its
+     * data that changed.
+     */
+    struct Range
+    {
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    /**
+     * How the data provided on creation of tensors of type eHost becomes the
+     * memory of the tensor.
+     */
+    enum class HostMemoryPolicy
+    {
+        eCopy = 0,  ///< The data is copied into a new allocation
+        eImport = 1 ///< The allocation of the data is imported when possible
+    };
+
     /**
      *  Constructor with data provided which would be used to create the
      * respective vulkan buffer and memory.
@@ -31,14 +55,32 @@ class Tensor : public Memory
      *  @param data Non-zero-sized vector of data that will be used by the
      * tensor
      *  @param tensorTypes Type for the tensor which is of type MemoryTypes
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
+     *  @param hostMemoryPolicy (optional) Whether to import the allocation of
+     * the data instead of copying it, which is only supported for tensors of
+     * type eHost. The allocation is imported through
+     * VK_EXT_external_memory_host when the extension is enabled on the device
+     * and the data and its size are aligned to the
+     * minImportedHostPointerAlignment of the device, and copied otherwise. An
+     * imported allocation has to outlive the tensor.
+     *  @param memoryBudget (optional) Budget tracking the device memory of
+     * tensors of type eDevice, which may evict them to host memory
      */
     Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
            void* data,
-           uint32_t elementTotalCount,
+           uint64_t elementTotalCount,
            uint32_t elementMemorySize,
            const DataTypes& dataType,
-           const MemoryTypes& tensorType = MemoryTypes::eDevice);
+           const MemoryTypes& tensorType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager,
+           const HostMemoryPolicy& hostMemoryPolicy = HostMemoryPolicy::eCopy,
+           std::shared_ptr<MemoryBudget> memoryBudget = nullptr);
 
     /**
      *  Constructor with size provided which would be used to create the
@@ -49,13 +91,59 @@ class Tensor : public Memory
      *  @param elmentTotalCount the number of elements of the array
      *  @param elementMemorySize the size of the element
      *  @param tensorTypes Type for the tensor which is of type TensorTypes
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
+     *  @param memoryBudget (optional) Budget tracking the device memory of
+     * tensors of type eDevice, which may evict them to host memory
+     */
+    Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
+           std::shared_ptr<vk::Device> device,
+           uint64_t elementTotalCount,
+           uint32_t elementMemorySize,
+           const DataTypes& dataType,
+           const MemoryTypes& memoryType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager,
+           std::shared_ptr<MemoryBudget> memoryBudget = nullptr);
+
+    /**
+     *  Constructor with the data of the tensor provided by a mapped file, so
+     * the data is read from the file as the tensor memory is written rather
+     * than through an intermediate copy. Tensors of type eHost import the
+     * mapping as their memory when possible, like with
+     * HostMemoryPolicy::eImport, and tensors of type eDevice streamed through
+     * a staging ring use the mapping as their host data, keeping the mapped
+     * file alive. Other tensors copy the data of the file into their memory.
+     *
+     *  @param physicalDevice The physical device to use to fetch properties
+     *  @param device The device to use to create the buffer and memory from
+     *  @param mappedFile The mapped file region holding at least
+     * elementTotalCount elements
+     *  @param elementTotalCount the number of elements of the array
+     *  @param elementMemorySize the size of the element
+     *  @param dataType The data type of the elements
+     *  @param memoryType Type for the tensor which is of type MemoryTypes
+     *  @param memoryPool (optional) Pool to sub-allocate the memory from
+     *  @param stagingRing (optional) Ring to stream the data through instead
+     * of allocating staging memory
+     *  @param stagingPolicy (optional) When to allocate the staging memory
+     *  @param memoryBudget (optional) Budget tracking the device memory of
+     * tensors of type eDevice, which may evict them to host memory
      */
     Tensor(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
            std::shared_ptr<vk::Device> device,
-           uint32_t elementTotalCount,
+           std::shared_ptr<MappedFile> mappedFile,
+           uint64_t elementTotalCount,
            uint32_t elementMemorySize,
            const DataTypes& dataType,
-           const MemoryTypes& memoryType = MemoryTypes::eDevice);
+           const MemoryTypes& memoryType = MemoryTypes::eDevice,
+           std::shared_ptr<MemoryPool> memoryPool = nullptr,
+           std::shared_ptr<StagingRing> stagingRing = nullptr,
+           const StagingPolicy& stagingPolicy = StagingPolicy::eEager,
+           std::shared_ptr<MemoryBudget> memoryBudget = nullptr);
 
     /**
      * @brief Make Tensor uncopyable
@@ -126,6 +214,95 @@ class Tensor : public Memory
     void recordCopyFromDeviceToStaging(
       const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Records a single copy of the ranges of elements provided from the
+     * staging memory to the device memory. Overlapping and adjacent ranges
+     * are merged into one copy region.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param ranges The ranges of elements to copy
+     */
+    void recordCopyFromStagingToDevice(const vk::CommandBuffer& commandBuffer,
+                                       const std::vector<Range>& ranges);
+
+    /**
+     * Records a single copy of the ranges of elements provided from the
+     * device memory to the staging memory. Overlapping and adjacent ranges
+     * are merged into one copy region.
+     *
+     * @param commandBuffer Vulkan Command Buffer to record the commands into
+     * @param ranges The ranges of elements to copy
+     */
+    void recordCopyFromDeviceToStaging(const vk::CommandBuffer& commandBuffer,
+                                       const std::vector<Range>& ranges);
+
+    /**
+     * Uploads the host data of the tensor into its primary buffer through the
+     * staging ring, one chunk at a time.
+     */
+    void streamToDevice() override;
+
+    /**
+     * Downloads the primary buffer into the host data of the tensor through
+     * the staging ring, one chunk at a time.
+     */
+    void streamFromDevice() override;
+
+    /**
+     * Uploads the ranges of elements provided from the host data of the
+     * tensor into its primary buffer through the staging ring.
+     *
+     * @param ranges The ranges of elements to upload
+     */
+    void streamToDevice(const std::vector<Range>& ranges);
+
+    /**
+     * Downloads the ranges of elements provided from the primary buffer into
+     * the host data of the tensor through the staging ring.
+     *
+     * @param ranges The ranges of elements to download
+     */
+    void streamFromDevice(const std::vector<Range>& ranges);
+
+    /**
+     * Loads the data of the tensor from a region of a file, mapping the file
+     * and writing it into the memory of the tensor one chunk at a time. The
+     * next chunk is read ahead while the current one is written, and chunks
+     * already written are dropped from host memory, so files larger than the
+     * host memory can be loaded. The data of tensors of type eDevice and
+     * eStorage is streamed into their device memory through the staging ring
+     * provided, without going through the host data of the tensor, which is
+     * left unchanged and marked as stale.
+     *
+     * @param path The path of the file to load the data from
+     * @param offset The offset in bytes of the data of the tensor in the file
+     * @param stagingRing The staging ring to stream the data through, which
+     * is only used by tensors of type eDevice and eStorage
+     * @param chunkSize (optional) The size in bytes of the chunks to read
+     */
+    void loadFile(const std::string& path,
+                  uint64_t offset,
+                  std::shared_ptr<StagingRing> stagingRing,
+                  uint64_t chunkSize = KP_DEFAULT_FILE_CHUNK_SIZE);
+
+    /**
+     * Writes the data of the tensor into the stream provided. The host data
+     * is written as it is unless the data of the tensor is only current in
+     * its device memory, in which case it is downloaded through the staging
+     * ring provided one chunk at a time into two buffers in turn, so the
+     * download of a chunk overlaps the write of the previous one, which is
+     * done in a separate thread. The host data of the tensor is left
+     * unchanged.
+     *
+     * @param stream The stream to write the data into
+     * @param stagingRing The staging ring to download the data through,
+     * which is only used when the device memory holds the current data
+     * @param chunkSize (optional) The size in bytes of the chunks to download
+     */
+    void saveToStream(std::ostream& stream,
+                      std::shared_ptr<StagingRing> stagingRing,
+                      uint64_t chunkSize = KP_DEFAULT_FILE_CHUNK_SIZE);
+
     /**
      * Records the memory barrier into the primary buffer and command
      * buffer which ensures that relevant data transfers are carried out
@@ -161,6 +338,37 @@ class Tensor : public Memory
       vk::PipelineStageFlagBits srcStageMask,
       vk::PipelineStageFlagBits dstStageMask) override;
 
+    /**
+     * Adds the memory barrier of the primary buffer to the batch provided.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void recordPrimaryMemoryBarrier(
+      BarrierBatch& barrierBatch,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask) override;
+    /**
+     * Adds the memory barrier of the staging buffer to the batch provided.
+     *
+     * @param barrierBatch Batch to add the barrier to
+     * @param srcAccessMask Access flags for source access mask
+     * @param dstAccessMask Access flags for destination access mask
+     * @param scrStageMask Pipeline stage flags for source stage mask
+     * @param dstStageMask Pipeline stage flags for destination stage mask
+     */
+    void recordStagingMemoryBarrier(
+      BarrierBatch& barrierBatch,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask,
+      vk::PipelineStageFlags srcStageMask,
+      vk::PipelineStageFlags dstStageMask) override;
+
     /**
      * Adds this object to a Vulkan descriptor set at \p binding.
      *
@@ -174,12 +382,125 @@ class Tensor : public Memory
 
     std::shared_ptr<vk::Buffer> getPrimaryBuffer();
 
+    /**
+     * The offset in bytes of the data of the tensor in its primary buffer,
+     * which is only non-zero for views of another tensor.
+     *
+     * @return Offset of the data in the primary buffer
+     */
+    vk::DeviceSize getMemoryOffset();
+
+    /**
+     * Whether the tensor is a view of a range of another tensor.
+     *
+     * @return Boolean stating whether the tensor is a view
+     */
+    bool isView();
+
+    /**
+     * Whether the memory of the tensor is the host allocation it was created
+     * from, imported instead of copied, so the data and the host allocation
+     * are the same memory.
+     *
+     * @return Boolean stating whether the host allocation was imported
+     */
+    bool isHostMemoryImported();
+
+    /**
+     * The residency of the data of the tensor, which for views is the
+     * residency of their parent as they share its data.
+     *
+     * @return The residency of the data of the tensor
+     */
+    Residency residency() override;
+
+    /**
+     * Overrides the residency of the data of the tensor, which for views
+     * overrides the residency of their parent.
+     *
+     * @param residency The new residency of the data of the tensor
+     */
+    void setResidency(Residency residency) override;
+
+    /**
+     * Moves the data of a tensor of type eDevice to host memory and frees
+     * its buffer and device memory, which are created again by restore. The
+     * data is downloaded first if the device holds newer data than the host.
+     * Sequences restore evicted tensors when recording operations that use
+     * them, while other uses of an evicted tensor have to restore it first.
+     * Views evict the tensor they are a view of.
+     */
+    void evict();
+
+    /**
+     * Creates the buffer and device memory of an evicted tensor again and
+     * uploads its data, which does nothing if the tensor is not evicted.
+     * Views restore the tensor they are a view of.
+     */
+    void restore();
+
+    /**
+     * Whether the tensor has been evicted to host memory, which for views is
+     * whether their parent has been evicted.
+     *
+     * @return Boolean stating whether the tensor is evicted
+     */
+    bool isEvicted();
+
+    /**
+     * Prevents the memory budget from evicting the tensor until unpin is
+     * called as many times as pin, and marks the tensor as the most recently
+     * used one. Views pin the tensor they are a view of.
+     */
+    void pin();
+
+    /**
+     * Releases a pin added by pin.
+     */
+    void unpin();
+
+    /**
+     * Whether the tensor is pinned, which for views is whether their parent
+     * is pinned.
+     *
+     * @return Boolean stating whether the tensor cannot be evicted
+     */
+    bool isPinned();
+
+    /**
+     * The number of times the primary buffer was created again by restoring
+     * the tensor, so commands and descriptor sets referring to an older
+     * buffer can be detected.
+     *
+     * @return Generation of the primary buffer
+     */
+    uint64_t getPrimaryBufferGeneration();
+
     Type type() override { return Type::eTensor; }
 
   protected:
     // -------------- ALWAYS OWNED RESOURCES
     vk::DescriptorBufferInfo mDescriptorBufferInfo;
 
+    // -------------- NEVER OWNED RESOURCES
+    // Tensor owning the buffers and memory shared by this view
+    std::shared_ptr<Tensor> mParent;
+    vk::DeviceSize mOffset = 0;
+
+    /**
+     * Constructor for a view of a range of elements of the parent tensor,
+     * which shares its buffers and memory instead of creating new ones.
+     *
+     * @param parent The tensor to create the view of
+     * @param elementOffset The index of the first element of the view
+     * @param elementCount The number of elements of the view
+     */
+    Tensor(std::shared_ptr<Tensor> parent,
+           uint64_t elementOffset,
+           uint64_t elementCount);
+
+    void mapRawData() override;
+
   private:
     // -------------- OPTIONALLY OWNED RESOURCES
     std::shared_ptr<vk::Buffer> mPrimaryBuffer;
@@ -187,11 +508,30 @@ class Tensor : public Memory
     std::shared_ptr<vk::Buffer> mStagingBuffer;
     bool mFreeStagingBuffer = false;
 
+    // -------------- NEVER OWNED RESOURCES
+    // Host allocation imported as the primary memory
+    void* mImportedHostData = nullptr;
+    std::shared_ptr<MemoryBudget> mMemoryBudget;
+
+    // -------------- ALWAYS OWNED RESOURCES
+    // File mapping providing the host data of file backed tensors
+    std::shared_ptr<MappedFile> mMappedFile;
+    bool mEvicted = false;
+    uint32_t mPinCount = 0;
+    uint64_t mPrimaryBufferGeneration = 0;
+
+    // The x-dimension reported for a number of elements, which saturates
+    // as it is 32-bit
+    static uint32_t dimensionX(uint64_t elementCount);
     void allocateMemoryCreateGPUResources(); // Creates the vulkan buffer
+    bool importHostMemory(void* data);
+    void allocateStagingMemory() override;
+    void destroyStagingMemory() override;
     void createBuffer(std::shared_ptr<vk::Buffer> buffer,
                       vk::BufferUsageFlags bufferUsageFlags);
     void allocateBindMemory(std::shared_ptr<vk::Buffer> buffer,
                             std::shared_ptr<vk::DeviceMemory> memory,
+                            MemoryPool::Allocation& allocation,
                             vk::MemoryPropertyFlags memoryPropertyFlags);
     void recordCopyBuffer(const vk::CommandBuffer& commandBuffer,
                           std::shared_ptr<vk::Buffer> bufferFrom,
@@ -210,6 +550,24 @@ class Tensor : public Memory
                                    vk::AccessFlagBits dstAccessMask,
                                    vk::PipelineStageFlagBits srcStageMask,
                                    vk::PipelineStageFlagBits dstStageMask);
+    vk::BufferMemoryBarrier createBufferMemoryBarrier(
+      const vk::Buffer& buffer,
+      vk::AccessFlags srcAccessMask,
+      vk::AccessFlags dstAccessMask);
+    std::vector<vk::BufferCopy> createCopyRegions(
+      const std::vector<Range>& ranges);
+    void streamRangeToDevice(vk::DeviceSize rangeOffset,
+                             vk::DeviceSize rangeSize);
+    void streamRangeToDevice(StagingRing& stagingRing,
+                             const void* data,
+                             vk::DeviceSize rangeOffset,
+                             vk::DeviceSize rangeSize);
+    void streamRangeFromDevice(vk::DeviceSize rangeOffset,
+                               vk::DeviceSize rangeSize);
+    void streamRangeFromDevice(StagingRing& stagingRing,
+                               void* data,
+                               vk::DeviceSize rangeOffset,
+                               vk::DeviceSize rangeSize);
 
     // Private util functions
     vk::BufferUsageFlags getPrimaryBufferUsageFlags();
@@ -231,13 +589,21 @@ class TensorT : public Tensor
     TensorT(std::shared_ptr<vk::PhysicalDevice> physicalDevice,
             std::shared_ptr<vk::Device> device,
             const size_t size,
-            const MemoryTypes& tensorType = MemoryTypes::eDevice)
+            const MemoryTypes& tensorType = MemoryTypes::eDevice,
+            std::shared_ptr<MemoryPool> memoryPool = nullptr,
+            std::shared_ptr<StagingRing> stagingRing = nullptr,
+            const StagingPolicy& stagingPolicy = StagingPolicy::eEager,
+            std::shared_ptr<MemoryBudget> memoryBudget = nullptr)
       : Tensor(physicalDevice,
                device,
                size,
                sizeof(T),
                Memory::dataType<T>(),
-               tensorType)
+               tensorType,
+               memoryPool,
+               stagingRing,
+               stagingPolicy,
+               memoryBudget)
     {
         KP_LOG_DEBUG("Kompute TensorT constructor with data size {}", size);
     }
@@ -246,14 +612,23 @@ class TensorT : public Tensor
       std::shared_ptr<vk::PhysicalDevice> physicalDevice,
       std::shared_ptr<vk::Device> device,
       const std::vector<T>& data,
-      const Memory::MemoryTypes& tensorType = Memory::MemoryTypes::eDevice)
+      const Memory::MemoryTypes& tensorType = Memory::MemoryTypes::eDevice,
+      std::shared_ptr<MemoryPool> memoryPool = nullptr,
+      std::shared_ptr<StagingRing> stagingRing = nullptr,
+      const StagingPolicy& stagingPolicy = StagingPolicy::eEager,
+      std::shared_ptr<MemoryBudget> memoryBudget = nullptr)
       : Tensor(physicalDevice,
                device,
                (void*)data.data(),
-               static_cast<uint32_t>(data.size()),
+               static_cast<uint64_t>(data.size()),
                sizeof(T),
                Memory::dataType<T>(),
-               tensorType)
+               tensorType,
+               memoryPool,
+               stagingRing,
+               stagingPolicy,
+               HostMemoryPolicy::eCopy,
+               memoryBudget)
     {
         KP_LOG_DEBUG("Kompute TensorT filling constructor with data size {}",
                      data.size());
@@ -276,4 +651,56 @@ class TensorT : public Tensor
     T* data() { return Memory::data<T>(); }
 };
 
+/**
+ * View of a range of elements of a tensor, which can be used anywhere a
+ * memory object is accepted, such as algorithms, OpCopy, OpSyncDevice and
+ * OpSyncLocal.
+ *
+ * Views bind and copy only their range of the buffers of the parent tensor
+ * and do not allocate any memory, so many logical tensors can be packed in a
+ * single allocation. The offset in bytes of the view has to be a multiple of
+ * the minStorageBufferOffsetAlignment limit of the device. Destroying the
+ * parent tensor or releasing its staging memory invalidates its views.
+ */
+class TensorView : public Tensor
+{
+  public:
+    /**
+     * Constructor for a view of a range of elements of the parent tensor.
+     *
+     * @param parent The tensor to create the view of, which can be a view
+     * @param elementOffset The index of the first element of the view
+     * @param elementCount The number of elements of the view
+     */
+    TensorView(std::shared_ptr<Tensor> parent,
+               uint64_t elementOffset,
+               uint64_t elementCount)
+      : Tensor(parent, elementOffset, elementCount)
+    {
+        KP_LOG_DEBUG("Kompute TensorView constructor with offset {} and "
+                     "size {}",
+                     elementOffset,
+                     elementCount);
+    }
+
+    /**
+     * @brief Make TensorView uncopyable
+     *
+     */
+    TensorView(const TensorView&) = delete;
+    TensorView(const TensorView&&) = delete;
+    TensorView& operator=(const TensorView&) = delete;
+    TensorView& operator=(const TensorView&&) = delete;
+
+    ~TensorView() { KP_LOG_DEBUG("Kompute TensorView destructor"); }
+
+    /**
+     * The tensor owning the buffers of the view, which for views of views is
+     * the tensor the first view was created from.
+     *
+     * @return Shared pointer to the parent tensor
+     */
+    std::shared_ptr<Tensor> getParent() { return this->mParent; }
+};
+
 } // End namespace kp
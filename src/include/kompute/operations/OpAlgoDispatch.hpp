@@ -71,6 +71,19 @@ class OpAlgoDispatch : public OpBase
      */
     virtual void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Records the dispatch after the barriers required for the accesses the
+     * algorithm performs on its memory objects, based on the binding accesses
+     * annotated in the algorithm. Unlike record, back to back dispatches that
+     * write and read the same memory object are synchronised, while
+     * dispatches that only read it do not record any barrier.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     * @param tracker The state tracker of the sequence recording the operation
+     */
+    virtual void recordTracked(const vk::CommandBuffer& commandBuffer,
+                               ResourceStateTracker& tracker) override;
+
     /**
      * Does not perform any preEval commands.
      *
@@ -4,6 +4,7 @@
 #include "kompute/Algorithm.hpp"
 #include "kompute/Core.hpp"
 #include "kompute/Image.hpp"
+#include "kompute/ResourceStateTracker.hpp"
 #include "kompute/Tensor.hpp"
 
 namespace kp {
@@ -50,6 +51,27 @@ class OpBase
      */
     virtual void record(const vk::CommandBuffer& commandBuffer) = 0;
 
+    /**
+     * Record function used by sequences, which track the state of the memory
+     * objects across the operations recorded. Operations that support it
+     * declare their accesses to the tracker and flush the required barriers
+     * instead of recording fixed barriers. By default the operation is
+     * recorded with record() and the tracker is reset, as the accesses
+     * performed by the operation are unknown. The memory objects are then
+     * also assumed to have been written by the operation, so the sync
+     * operations recorded after it are not skipped.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     * @param tracker The state tracker of the sequence recording the operation
+     */
+    virtual void recordTracked(const vk::CommandBuffer& commandBuffer,
+                               ResourceStateTracker& tracker)
+    {
+        this->record(commandBuffer);
+        tracker.reset();
+        tracker.invalidateResidency();
+    }
+
     /**
      * Pre eval is called before the Sequence has called eval and submitted the
      * commands to the GPU for processing, and can be used to perform any
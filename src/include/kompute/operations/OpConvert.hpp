@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "ShaderOpConvert.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoDispatch.hpp"
+
+#include <limits>
+
+// Invocations in a workgroup of the OpConvert shader, which has to match its
+// local_size_x
+#define KP_OP_CONVERT_WORKGROUP_SIZE 256
+
+// Workgroup count every device supports in each dimension, as required by
+// the Vulkan specification for maxComputeWorkGroupCount
+#define KP_OP_CONVERT_MAX_WORKGROUP_COUNT 65535
+
+namespace kp {
+
+/**
+ * Operation that converts the elements of a tensor of type eFloat to a tensor
+ * of type eHalf or eBFloat16 of the same size, or the other way around, so
+ * data can be stored at reduced precision and widened on the device.
+ *
+ * The 16-bit elements are accessed as pairs packed in 32-bit words so the
+ * shader does not require the 16-bit storage features of the device, which
+ * requires the tensors to have an even number of elements. Tensors with more
+ * pairs than fit in a single row of workgroups are dispatched over several
+ * rows, up to 2^32 - 1 elements.
+ */
+class OpConvert : public OpAlgoDispatch
+{
+  public:
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param memObjects Tensors that are to be used in this operation, which
+     * are expected to be 2, the first being converted into the second
+     * @param algorithm An algorithm that will be overridden with the OpConvert
+     * shader data and the tensors provided
+     */
+    OpConvert(std::vector<std::shared_ptr<Memory>> memObjects,
+              std::shared_ptr<Algorithm> algorithm)
+      : OpAlgoDispatch(algorithm)
+    {
+        KP_LOG_DEBUG("Kompute OpConvert constructor with params");
+
+        if (memObjects.size() != 2) {
+            throw std::runtime_error(
+              "Kompute OpConvert expected 2 mem objects but got " +
+              std::to_string(memObjects.size()));
+        }
+
+        for (const std::shared_ptr<Memory>& memObject : memObjects) {
+            if (memObject->type() != Memory::Type::eTensor) {
+                throw std::runtime_error(
+                  "Kompute OpConvert only supports tensors");
+            }
+        }
+
+        std::shared_ptr<Memory> src = memObjects[0];
+        std::shared_ptr<Memory> dst = memObjects[1];
+
+        if (src->size() != dst->size()) {
+            throw std::runtime_error(
+              "Kompute OpConvert expected tensors of the same size but got " +
+              std::to_string(src->size()) + " and " +
+              std::to_string(dst->size()));
+        }
+        if (src->size() % 2 != 0) {
+            throw std::runtime_error(
+              "Kompute OpConvert expected an even number of elements but got " +
+              std::to_string(src->size()));
+        }
+
+        // The shader indexes the 32-bit words of the tensors with 32 bits
+        if (src->size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error(
+              "Kompute OpConvert supports up to " +
+              std::to_string(std::numeric_limits<uint32_t>::max()) +
+              " elements but got " + std::to_string(src->size()));
+        }
+
+        uint32_t mode = OpConvert::conversionMode(src->dataType(),
+                                                  dst->dataType());
+
+        const std::vector<uint32_t> spirv = std::vector<uint32_t>(
+          SHADEROPCONVERT_COMP_SPV.begin(), SHADEROPCONVERT_COMP_SPV.end());
+
+        // Each invocation converts a pair of elements
+        uint32_t pairCount = static_cast<uint32_t>(src->size() / 2);
+        algorithm->rebuild<uint32_t, uint32_t>(
+          memObjects, spirv, OpConvert::workgroup(pairCount), { mode },
+          { pairCount });
+        algorithm->setBindingAccess(0, Algorithm::BindingAccess::eReadOnly);
+        algorithm->setBindingAccess(1, Algorithm::BindingAccess::eWriteOnly);
+    }
+
+    /**
+     * @brief Make OpConvert non-copyable
+     *
+     */
+    OpConvert(const OpConvert&) = delete;
+    OpConvert(const OpConvert&&) = delete;
+    OpConvert& operator=(const OpConvert&) = delete;
+    OpConvert& operator=(const OpConvert&&) = delete;
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    ~OpConvert() noexcept override
+    {
+        KP_LOG_DEBUG("Kompute OpConvert destructor started");
+    }
+
+  private:
+    static Workgroup workgroup(uint32_t pairCount)
+    {
+        uint64_t count = (static_cast<uint64_t>(pairCount) +
+                          KP_OP_CONVERT_WORKGROUP_SIZE - 1) /
+                         KP_OP_CONVERT_WORKGROUP_SIZE;
+        if (count <= KP_OP_CONVERT_MAX_WORKGROUP_COUNT) {
+            return { static_cast<uint32_t>(std::max<uint64_t>(count, 1)),
+                     1,
+                     1 };
+        }
+
+        uint64_t rows = (count + KP_OP_CONVERT_MAX_WORKGROUP_COUNT - 1) /
+                        KP_OP_CONVERT_MAX_WORKGROUP_COUNT;
+        if (rows > KP_OP_CONVERT_MAX_WORKGROUP_COUNT) {
+            throw std::runtime_error(
+              "Kompute OpConvert dispatch of " + std::to_string(count) +
+              " workgroups exceeds the maximum workgroup count");
+        }
+        return { KP_OP_CONVERT_MAX_WORKGROUP_COUNT,
+                 static_cast<uint32_t>(rows),
+                 1 };
+    }
+
+    static uint32_t conversionMode(Memory::DataTypes src,
+                                   Memory::DataTypes dst)
+    {
+        // Modes of the MODE specialization constant of the shader
+        if (src == Memory::DataTypes::eFloat &&
+            dst == Memory::DataTypes::eHalf) {
+            return 0;
+        } else if (src == Memory::DataTypes::eHalf &&
+                   dst == Memory::DataTypes::eFloat) {
+            return 1;
+        } else if (src == Memory::DataTypes::eFloat &&
+                   dst == Memory::DataTypes::eBFloat16) {
+            return 2;
+        } else if (src == Memory::DataTypes::eBFloat16 &&
+                   dst == Memory::DataTypes::eFloat) {
+            return 3;
+        }
+
+        throw std::runtime_error("Kompute OpConvert does not support "
+                                 "converting " +
+                                 Memory::toString(src) + " to " +
+                                 Memory::toString(dst));
+    }
+};
+
+} // End namespace kp
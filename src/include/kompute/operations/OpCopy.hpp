@@ -49,6 +49,17 @@ class OpCopy : public OpBase
      */
     void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Records the copy commands after the barriers required for the transfer
+     * read of the first memory object and the transfer writes into the other
+     * memory objects.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     * @param tracker The state tracker of the sequence recording the operation
+     */
+    void recordTracked(const vk::CommandBuffer& commandBuffer,
+                       ResourceStateTracker& tracker) override;
+
     /**
      * Does not perform any preEval commands.
      *
@@ -57,8 +68,10 @@ class OpCopy : public OpBase
     virtual void preEval(const vk::CommandBuffer& commandBuffer) override;
 
     /**
-     * Copies the local vectors for all the memory objects to sync the data with
-     * the gpu.
+     * Does not copy the host data of the memory objects, the device writes of
+     * the copy mark the host data of the memory objects of type eDevice
+     * copied into as outdated instead, so it is only transferred when synced
+     * with OpSyncLocal.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "kompute/Core.hpp"
+
+#include "ShaderOpDequantize.hpp"
+
+#include "kompute/Algorithm.hpp"
+#include "kompute/Tensor.hpp"
+
+#include "kompute/operations/OpAlgoDispatch.hpp"
+
+namespace kp {
+
+/**
+ * Operation that dequantizes a tensor of type eBlockInt8 or eBlockInt4 into a
+ * tensor of type eFloat with 32 elements per block, so weights can be
+ * uploaded and kept on the device quantized and only widened when needed.
+ *
+ * The blocks are accessed as 32-bit words so the shader does not require the
+ * 8-bit and 16-bit storage features of the device, which requires the
+ * quantized tensor to have an even number of blocks, as returned by
+ * BlockInt8::quantize and BlockInt4::quantize.
+ */
+class OpDequantize : public OpAlgoDispatch
+{
+  public:
+    /**
+     * Default constructor with parameters that provides the bare minimum
+     * requirements for the operations to be able to create and manage their
+     * sub-components.
+     *
+     * @param memObjects Tensors that are to be used in this operation, which
+     * are expected to be 2, the quantized tensor and the tensor to dequantize
+     * into
+     * @param algorithm An algorithm that will be overridden with the
+     * OpDequantize shader data and the tensors provided
+     */
+    OpDequantize(std::vector<std::shared_ptr<Memory>> memObjects,
+                 std::shared_ptr<Algorithm> algorithm)
+      : OpAlgoDispatch(algorithm)
+    {
+        KP_LOG_DEBUG("Kompute OpDequantize constructor with params");
+
+        if (memObjects.size() != 2) {
+            throw std::runtime_error(
+              "Kompute OpDequantize expected 2 mem objects but got " +
+              std::to_string(memObjects.size()));
+        }
+
+        for (const std::shared_ptr<Memory>& memObject : memObjects) {
+            if (memObject->type() != Memory::Type::eTensor) {
+                throw std::runtime_error(
+                  "Kompute OpDequantize only supports tensors");
+            }
+        }
+
+        std::shared_ptr<Memory> src = memObjects[0];
+        std::shared_ptr<Memory> dst = memObjects[1];
+
+        uint32_t format;
+        if (src->dataType() == Memory::DataTypes::eBlockInt8) {
+            format = 0;
+        } else if (src->dataType() == Memory::DataTypes::eBlockInt4) {
+            format = 1;
+        } else {
+            throw std::runtime_error(
+              "Kompute OpDequantize does not support dequantizing " +
+              Memory::toString(src->dataType()));
+        }
+
+        if (dst->dataType() != Memory::DataTypes::eFloat) {
+            throw std::runtime_error(
+              "Kompute OpDequantize expected a tensor of type eFloat but got " +
+              Memory::toString(dst->dataType()));
+        }
+        if (src->size() % 2 != 0) {
+            throw std::runtime_error(
+              "Kompute OpDequantize expected an even number of blocks but "
+              "got " +
+              std::to_string(src->size()));
+        }
+        if (dst->size() != src->size() * BlockInt8::blockSize) {
+            throw std::runtime_error(
+              "Kompute OpDequantize expected a tensor of " +
+              std::to_string(src->size() * BlockInt8::blockSize) +
+              " elements but got " + std::to_string(dst->size()));
+        }
+
+        const std::vector<uint32_t> spirv =
+          std::vector<uint32_t>(SHADEROPDEQUANTIZE_COMP_SPV.begin(),
+                                SHADEROPDEQUANTIZE_COMP_SPV.end());
+
+        // The default workgroup dispatches a workgroup for each block
+        algorithm->rebuild<uint32_t>(memObjects, spirv, {}, { format });
+        algorithm->setBindingAccess(0, Algorithm::BindingAccess::eReadOnly);
+        algorithm->setBindingAccess(1, Algorithm::BindingAccess::eWriteOnly);
+    }
+
+    /**
+     * @brief Make OpDequantize non-copyable
+     *
+     */
+    OpDequantize(const OpDequantize&) = delete;
+    OpDequantize(const OpDequantize&&) = delete;
+    OpDequantize& operator=(const OpDequantize&) = delete;
+    OpDequantize& operator=(const OpDequantize&&) = delete;
+
+    /**
+     * Default destructor, which is in charge of destroying the algorithm
+     * components but does not destroy the underlying tensors
+     */
+    ~OpDequantize() noexcept override
+    {
+        KP_LOG_DEBUG("Kompute OpDequantize destructor started");
+    }
+};
+
+} // End namespace kp
@@ -64,6 +64,17 @@ class OpMemoryBarrier : public OpBase
      */
     virtual void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Records the memory barrier and resets the tracker, as the barrier is
+     * not declared as an access. The residency of the memory objects is kept
+     * as the barrier does not write them.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     * @param tracker The state tracker of the sequence recording the operation
+     */
+    virtual void recordTracked(const vk::CommandBuffer& commandBuffer,
+                               ResourceStateTracker& tracker) override;
+
     /**
      * Does not perform any preEval commands.
      *
@@ -13,7 +13,12 @@ namespace kp {
  * for the memory to be syncd into GPU memory which means that the operation
  * will be done in sync with GPU commands. For MemoryTypes::eHost it will only
  * map the data into host memory which will happen during preEval before the
- * recorded commands are dispatched.
+ * recorded commands are dispatched. Device memory objects that use a staging
+ * ring are also streamed into device memory during preEval, before the
+ * recorded commands are submitted, so they cannot be accessed by the
+ * operations recorded before this one in the same sequence. Memory objects
+ * whose host data and device memory are already coherent are not
+ * transferred.
  */
 class OpSyncDevice : public OpBase
 {
@@ -28,6 +33,19 @@ class OpSyncDevice : public OpBase
      */
     OpSyncDevice(const std::vector<std::shared_ptr<Memory>>& memObjects);
 
+    /**
+     * Constructor that only syncs the ranges of elements provided of each of
+     * the tensors, so the size of the transfers scales with the data that
+     * changed rather than with the size of the tensors. The ranges of each
+     * tensor are copied with a single copy command.
+     *
+     * @param memObjects Tensors that will be used to create in operation.
+     * @param ranges Ranges of elements to sync of each of the tensors, where
+     * an empty list syncs the whole tensors.
+     */
+    OpSyncDevice(const std::vector<std::shared_ptr<Memory>>& memObjects,
+                 const std::vector<Tensor::Range>& ranges);
+
     /**
      * @brief Make OpSyncDevice non-copyable
      *
@@ -53,7 +71,20 @@ class OpSyncDevice : public OpBase
     void record(const vk::CommandBuffer& commandBuffer) override;
 
     /**
-     * Does not perform any preEval commands.
+     * Records the copy commands after the barriers required for the transfer
+     * writes into the device memory of the memory objects. Throws if a memory
+     * object streamed through the staging ring was accessed earlier in the
+     * recording, as its transfer would be executed before these accesses.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     * @param tracker The state tracker of the sequence recording the operation
+     */
+    void recordTracked(const vk::CommandBuffer& commandBuffer,
+                       ResourceStateTracker& tracker) override;
+
+    /**
+     * Streams the data of the memory objects that use a staging ring into
+     * their device memory.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -69,6 +100,11 @@ class OpSyncDevice : public OpBase
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Memory>> mMemObjects;
+    std::vector<Tensor::Range> mRanges;
+
+    void recordCopy(const vk::CommandBuffer& commandBuffer,
+                    const std::shared_ptr<Memory>& memObject);
+    bool syncsWholeMemory(const std::shared_ptr<Memory>& memObject);
 };
 
 } // End namespace kp
@@ -15,7 +15,10 @@ namespace kp {
  * for the memory to be syncd into GPU memory which means that the operation
  * will be done in sync with GPU commands. For MemoryTypes::eHost it will
  * only map the data into host memory which will happen during preEval before
- * the recorded commands are dispatched.
+ * the recorded commands are dispatched. Device memory objects that use a
+ * staging ring are instead streamed into host memory during postEval, once
+ * the recorded commands have completed. Memory objects whose host data and
+ * device memory are already coherent are not transferred.
  */
 class OpSyncLocal : public OpBase
 {
@@ -30,6 +33,19 @@ class OpSyncLocal : public OpBase
      */
     OpSyncLocal(const std::vector<std::shared_ptr<Memory>>& memObjects);
 
+    /**
+     * Constructor that only syncs the ranges of elements provided of each of
+     * the tensors, so the size of the transfers scales with the data needed
+     * rather than with the size of the tensors. The ranges of each tensor are
+     * copied with a single copy command.
+     *
+     * @param memObjects Tensors that will be used to create in operation.
+     * @param ranges Ranges of elements to sync of each of the tensors, where
+     * an empty list syncs the whole tensors.
+     */
+    OpSyncLocal(const std::vector<std::shared_ptr<Memory>>& memObjects,
+                const std::vector<Tensor::Range>& ranges);
+
     /**
      * @brief Make OpSyncLocal non-copyable
      *
@@ -53,6 +69,17 @@ class OpSyncLocal : public OpBase
      */
     void record(const vk::CommandBuffer& commandBuffer) override;
 
+    /**
+     * Records the copy commands after the barriers required for the transfer
+     * reads from the device memory of the memory objects, followed by the
+     * barriers that make the staging memory visible to the host.
+     *
+     * @param commandBuffer The command buffer to record the command into.
+     * @param tracker The state tracker of the sequence recording the operation
+     */
+    void recordTracked(const vk::CommandBuffer& commandBuffer,
+                       ResourceStateTracker& tracker) override;
+
     /**
      * Does not perform any preEval commands.
      *
@@ -62,7 +89,8 @@ class OpSyncLocal : public OpBase
 
     /**
      * For host memory objects it performs the map command from the host memory
-     * into local memory.
+     * into local memory. Memory objects that use a staging ring are streamed
+     * from their device memory.
      *
      * @param commandBuffer The command buffer to record the command into.
      */
@@ -71,6 +99,11 @@ class OpSyncLocal : public OpBase
   private:
     // -------------- ALWAYS OWNED RESOURCES
     std::vector<std::shared_ptr<Memory>> mMemObjects;
+    std::vector<Tensor::Range> mRanges;
+
+    void recordCopy(const vk::CommandBuffer& commandBuffer,
+                    const std::shared_ptr<Memory>& memObject);
+    bool syncsWholeMemory(const std::shared_ptr<Memory>& memObject);
 };
 
 } // End namespace kp
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestAlgorithmRebind, RebindTensors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 4, 5, 6 });
+    std::shared_ptr<kp::TensorT<float>> tensorD = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorC })
+      ->eval<kp::OpAlgoDispatch>(algorithm)
+      ->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+
+    algorithm->rebind({ tensorC, tensorD });
+
+    EXPECT_TRUE(algorithm->isInit());
+    EXPECT_EQ(algorithm->getMemObjects()[0], tensorC);
+    EXPECT_EQ(algorithm->getMemObjects()[1], tensorD);
+
+    mgr.sequence()
+      ->eval<kp::OpAlgoDispatch>(algorithm)
+      ->eval<kp::OpSyncLocal>({ tensorD });
+
+    EXPECT_EQ(tensorD->vector(), std::vector<float>({ 5, 6, 7 }));
+}
+
+TEST(TestAlgorithmRebind, PingPongDescriptorSets)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 10, 20 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+
+    uint32_t pongIndex = algorithm->addDescriptorSet({ tensorB, tensorA });
+
+    EXPECT_EQ(pongIndex, 1);
+    EXPECT_EQ(algorithm->getDescriptorSetCount(), 2);
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    sq->eval<kp::OpSyncDevice>({ tensorA });
+
+    for (uint32_t i = 0; i < 4; i++) {
+        algorithm->setDescriptorSet(i % 2);
+        sq->eval<kp::OpAlgoDispatch>(algorithm);
+    }
+
+    sq->eval<kp::OpSyncLocal>({ tensorA });
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 4, 14, 24 }));
+
+    EXPECT_ANY_THROW(algorithm->setDescriptorSet(2));
+}
+
+TEST(TestAlgorithmRebind, RebindIncompatibleMemObjects)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::ImageT<float>> image = mgr.image({ 0, 0, 0 }, 3, 1, 1);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+
+    EXPECT_ANY_THROW(algorithm->rebind({ tensorA }));
+    EXPECT_ANY_THROW(algorithm->rebind({ tensorA, image }));
+    EXPECT_ANY_THROW(algorithm->addDescriptorSet({ image, tensorB }));
+
+    EXPECT_EQ(algorithm->getMemObjects()[0], tensorA);
+    EXPECT_EQ(algorithm->getMemObjects()[1], tensorB);
+    EXPECT_EQ(algorithm->getDescriptorSetCount(), 1);
+}
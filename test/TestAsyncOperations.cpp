@@ -2,7 +2,9 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
 #include <chrono>
+#include <future>
 
 #include "kompute/Kompute.hpp"
 #include "kompute/logger/Logger.hpp"
@@ -253,9 +255,82 @@ TEST(TestAsyncOperations, TestManagerAsyncExecutionTimeout)
     // of 1m ns)
     EXPECT_LT(duration, 100000);
 
+    // Submissions abandoned on timeout no longer prevent evictions
+    EXPECT_FALSE(tensorA->isPinned());
+    EXPECT_FALSE(tensorB->isPinned());
+
     sq1->evalAsync<kp::OpSyncLocal>({ tensorA, tensorB });
     sq1->evalAwait();
 
     EXPECT_EQ(tensorA->vector(), resultAsync);
     EXPECT_EQ(tensorB->vector(), resultAsync);
 }
+
+TEST(TestAsyncOperations, TestManagerAsyncFutureAndCallback)
+{
+    std::vector<uint32_t> spirv = compileSource(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] * 2;
+        }
+    )");
+
+    kp::Manager mgr;
+
+    uint32_t numSequences = 8;
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+    for (uint32_t i = 0; i < numSequences; i++) {
+        std::shared_ptr<kp::TensorT<float>> tensor =
+          mgr.tensor({ float(i), float(i + 1) });
+        tensors.push_back(tensor);
+        sequences.push_back(
+          mgr.sequence()
+            ->record<kp::OpSyncDevice>({ tensor })
+            ->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirv))
+            ->record<kp::OpSyncLocal>({ tensor }));
+    }
+
+    std::atomic<uint32_t> callbackCount(0);
+
+    // The sequences are awaited by the waiter thread of the manager, which
+    // runs the postEval of their operations before the callbacks
+    std::vector<std::future<void>> futures;
+    for (uint32_t i = 0; i < numSequences; i++) {
+        std::shared_ptr<kp::TensorT<float>> tensor = tensors[i];
+        futures.push_back(
+          mgr.evalAsyncFuture(sequences[i], [tensor, i, &callbackCount]() {
+              if (tensor->vector() ==
+                  std::vector<float>({ 2.0f * i, 2.0f * (i + 1) })) {
+                  callbackCount++;
+              }
+          }));
+    }
+
+    for (std::future<void>& future : futures) {
+        future.get();
+    }
+
+    EXPECT_EQ(callbackCount.load(), numSequences);
+    EXPECT_EQ(mgr.getFenceWaiter()->pendingCount(), 0);
+
+    for (uint32_t i = 0; i < numSequences; i++) {
+        EXPECT_FALSE(sequences[i]->isRunning());
+        EXPECT_EQ(tensors[i]->vector(),
+                  std::vector<float>({ 2.0f * i, 2.0f * (i + 1) }));
+    }
+
+    // Exceptions thrown by the callback are stored in the future
+    std::future<void> failed = mgr.evalAsyncFuture(
+      sequences[0], []() { throw std::runtime_error("callback failed"); });
+
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_FALSE(sequences[0]->isRunning());
+}
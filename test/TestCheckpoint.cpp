@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+static const std::string checkpointPath = "kompute_test_checkpoint.bin";
+
+TEST(TestCheckpoint, SaveAndLoadTensors)
+{
+    std::vector<float> dataFloat = { 1.5f, -2.0f, 3.25f };
+    std::vector<int32_t> dataInt = { 1, -2, 3, -4 };
+    std::vector<double> dataDouble = { 0.125, 1e10 };
+
+    {
+        kp::Manager mgr;
+
+        std::shared_ptr<kp::TensorT<float>> tensorDevice =
+          mgr.tensorT(dataFloat);
+        std::shared_ptr<kp::TensorT<int32_t>> tensorHost =
+          mgr.tensorT(dataInt, kp::Memory::MemoryTypes::eHost);
+        std::shared_ptr<kp::TensorT<double>> tensorDeviceAndHost =
+          mgr.tensorT(dataDouble, kp::Memory::MemoryTypes::eDeviceAndHost);
+        std::shared_ptr<kp::TensorT<float>> tensorStorage =
+          mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eStorage);
+        std::shared_ptr<kp::TensorT<float>> tensorOutput =
+          mgr.tensorT<float>(3);
+
+        std::vector<std::shared_ptr<kp::Memory>> params = { tensorDevice,
+                                                            tensorDevice,
+                                                            tensorOutput };
+        mgr.sequence()
+          ->record<kp::OpSyncDevice>({ tensorDevice })
+          ->record<kp::OpCopy>({ tensorDevice, tensorStorage })
+          ->record<kp::OpMult>(params, mgr.algorithm())
+          ->eval();
+
+        // The output is only current in device memory
+        EXPECT_EQ(tensorOutput->residency(),
+                  kp::Memory::Residency::eDeviceDirty);
+
+        mgr.saveTensors(checkpointPath,
+                        { tensorDevice,
+                          tensorHost,
+                          tensorDeviceAndHost,
+                          tensorStorage,
+                          tensorOutput });
+
+        // Saving does not change the host data of the tensors
+        EXPECT_EQ(tensorOutput->residency(),
+                  kp::Memory::Residency::eDeviceDirty);
+    }
+
+    kp::Manager mgr;
+
+    std::vector<std::shared_ptr<kp::Tensor>> tensors =
+      mgr.loadTensors(checkpointPath);
+
+    ASSERT_EQ(tensors.size(), 5);
+    EXPECT_EQ(tensors[0]->dataType(), kp::Memory::DataTypes::eFloat);
+    EXPECT_EQ(tensors[0]->memoryType(), kp::Memory::MemoryTypes::eDevice);
+    EXPECT_EQ(tensors[1]->dataType(), kp::Memory::DataTypes::eInt);
+    EXPECT_EQ(tensors[1]->memoryType(), kp::Memory::MemoryTypes::eHost);
+    EXPECT_EQ(tensors[2]->dataType(), kp::Memory::DataTypes::eDouble);
+    EXPECT_EQ(tensors[2]->memoryType(),
+              kp::Memory::MemoryTypes::eDeviceAndHost);
+    EXPECT_EQ(tensors[3]->memoryType(), kp::Memory::MemoryTypes::eStorage);
+    EXPECT_EQ(tensors[4]->size(), 3);
+
+    std::shared_ptr<kp::TensorT<float>> tensorStorageOutput =
+      mgr.tensorT<float>(3);
+    mgr.sequence()
+      ->record<kp::OpCopy>({ tensors[3], tensorStorageOutput })
+      ->record<kp::OpSyncLocal>(
+        { tensors[0], tensors[4], tensorStorageOutput })
+      ->eval();
+
+    EXPECT_EQ(tensors[0]->vector<float>(), dataFloat);
+    EXPECT_EQ(tensors[1]->vector<int32_t>(), dataInt);
+    EXPECT_EQ(tensors[2]->vector<double>(), dataDouble);
+    EXPECT_EQ(tensorStorageOutput->vector(), dataFloat);
+    EXPECT_EQ(tensors[4]->vector<float>(),
+              std::vector<float>({ 2.25f, 4.0f, 10.5625f }));
+
+    std::remove(checkpointPath.c_str());
+}
+
+TEST(TestCheckpoint, SaveInChunksThroughStagingRing)
+{
+    std::vector<float> data(100000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (float)i;
+    }
+
+    {
+        kp::Manager mgr;
+        mgr.enableStagingRing(64 * 1024);
+
+        std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensorT(data);
+        mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+        // Only the device memory holds the data saved
+        tensor->setData(std::vector<float>(data.size(), 0.0f));
+        tensor->setResidency(kp::Memory::Residency::eDeviceDirty);
+
+        mgr.saveTensors(checkpointPath, { tensor, tensor });
+    }
+
+    // The data of each tensor starts at an aligned offset
+    std::ifstream file(checkpointPath, std::ios::binary);
+    kp::CheckpointHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    EXPECT_EQ(header.tensorCount, 2);
+    std::vector<kp::CheckpointEntry> entries(2);
+    file.read(reinterpret_cast<char*>(entries.data()),
+              2 * sizeof(kp::CheckpointEntry));
+    file.close();
+    for (const kp::CheckpointEntry& entry : entries) {
+        EXPECT_EQ(entry.offset % kp::CheckpointHeader::alignment, 0);
+        EXPECT_EQ(entry.size, data.size());
+    }
+
+    kp::Manager mgr;
+    std::vector<std::shared_ptr<kp::Tensor>> tensors =
+      mgr.loadTensors(checkpointPath);
+    ASSERT_EQ(tensors.size(), 2);
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensors[0], tensors[1] });
+
+    EXPECT_EQ(tensors[0]->vector<float>(), data);
+    EXPECT_EQ(tensors[1]->vector<float>(), data);
+
+    std::remove(checkpointPath.c_str());
+}
+
+TEST(TestCheckpoint, InvalidCheckpoint)
+{
+    kp::Manager mgr;
+
+    EXPECT_ANY_THROW(mgr.loadTensors("kompute_test_missing_checkpoint.bin"));
+
+    {
+        std::ofstream file(checkpointPath, std::ios::binary);
+        file << "not a checkpoint of tensors";
+    }
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    // Data of the tensor past the end of the file
+    mgr.saveTensors(checkpointPath, { mgr.tensor({ 1.0f, 2.0f }) });
+    {
+        std::fstream file(checkpointPath,
+                          std::ios::binary | std::ios::in | std::ios::out);
+        kp::CheckpointEntry entry;
+        file.seekg(sizeof(kp::CheckpointHeader));
+        file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+        entry.size = 1000;
+        file.seekp(sizeof(kp::CheckpointHeader));
+        file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    std::remove(checkpointPath.c_str());
+}
+
+// Overwrites the second entry of the checkpoint with the one provided
+static void
+writeSecondEntry(const kp::CheckpointEntry& entry)
+{
+    std::fstream file(checkpointPath,
+                      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(sizeof(kp::CheckpointHeader) + sizeof(kp::CheckpointEntry));
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+}
+
+TEST(TestCheckpoint, CorruptedCheckpoint)
+{
+    kp::Manager mgr;
+
+    mgr.saveTensors(checkpointPath,
+                    { mgr.tensor({ 1.0f, 2.0f }),
+                      mgr.tensorT<uint32_t>({ 3, 4, 5, 6 }) });
+
+    kp::CheckpointEntry entry;
+    {
+        std::ifstream file(checkpointPath, std::ios::binary);
+        file.seekg(sizeof(kp::CheckpointHeader) + sizeof(entry));
+        file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    }
+    EXPECT_EQ(mgr.loadTensors(checkpointPath).size(), 2);
+
+    // Data type and memory type outside of their enums
+    kp::CheckpointEntry corrupted = entry;
+    corrupted.dataType = 100;
+    writeSecondEntry(corrupted);
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    corrupted = entry;
+    corrupted.memoryType = 100;
+    writeSecondEntry(corrupted);
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    // Element size not matching the data type
+    corrupted = entry;
+    corrupted.elementMemorySize = 2;
+    writeSecondEntry(corrupted);
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    // Size and offset whose product and sum overflow
+    corrupted = entry;
+    corrupted.size = UINT64_MAX / 4 + 1;
+    writeSecondEntry(corrupted);
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    corrupted = entry;
+    corrupted.offset = UINT64_MAX - 8;
+    writeSecondEntry(corrupted);
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    // Data of the last tensor cut short by the end of the file
+    writeSecondEntry(entry);
+    std::vector<char> data;
+    {
+        std::ifstream file(checkpointPath, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file),
+                    std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(checkpointPath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size() - 4);
+    }
+    EXPECT_ANY_THROW(mgr.loadTensors(checkpointPath));
+
+    std::remove(checkpointPath.c_str());
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderCopy(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index];
+    }
+)");
+
+TEST(TestDescriptorAllocator, AlgorithmsShareDescriptorPages)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::DescriptorAllocator> allocator =
+      mgr.getDescriptorAllocator();
+    EXPECT_TRUE(allocator != nullptr);
+
+    std::vector<uint32_t> spirv = compileSource(shaderCopy);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+    for (uint32_t i = 0; i < 10; i++) {
+        algorithms.push_back(mgr.algorithm({ tensorA, tensorB }, spirv));
+    }
+
+    EXPECT_EQ(allocator->pageCount(), 1);
+    EXPECT_EQ(allocator->setCount(), 10);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA })
+      ->eval<kp::OpAlgoDispatch>(algorithms.back())
+      ->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), tensorA->vector());
+
+    algorithms.clear();
+
+    EXPECT_EQ(allocator->setCount(), 0);
+    EXPECT_EQ(allocator->totalSetCount(), 10);
+    EXPECT_EQ(allocator->pageCount(), 1);
+}
+
+TEST(TestDescriptorAllocator, GrowsAndReleasesPages)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::DescriptorAllocator> allocator =
+      mgr.getDescriptorAllocator();
+
+    std::vector<uint32_t> spirv = compileSource(shaderCopy);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<std::shared_ptr<kp::Algorithm>> algorithms;
+    for (uint32_t i = 0; i < allocator->pageSize() + 1; i++) {
+        algorithms.push_back(mgr.algorithm({ tensorA, tensorB }, spirv));
+    }
+
+    EXPECT_EQ(allocator->pageCount(), 2);
+    EXPECT_EQ(allocator->setCount(), allocator->pageSize() + 1);
+
+    algorithms.clear();
+
+    // Only the last page is kept around once all the sets are released
+    EXPECT_EQ(allocator->setCount(), 0);
+    EXPECT_EQ(allocator->pageCount(), 1);
+}
+
+TEST(TestDescriptorAllocator, ExtraDescriptorSetsFromAllocator)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::DescriptorAllocator> allocator =
+      mgr.getDescriptorAllocator();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderCopy));
+    algorithm->addDescriptorSet({ tensorB, tensorA });
+
+    EXPECT_EQ(allocator->setCount(), 2);
+
+    algorithm->destroy();
+
+    EXPECT_EQ(allocator->setCount(), 0);
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+// Large enough for the minImportedHostPointerAlignment of common devices
+static const size_t importAlignment = 65536;
+
+static float*
+alignedData(std::vector<uint8_t>& storage, size_t offset)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+    address = (address + importAlignment - 1) / importAlignment *
+              importAlignment;
+    return reinterpret_cast<float*>(address + offset);
+}
+
+TEST(TestHostImport, ImportAlignedHostMemory)
+{
+    kp::Manager mgr;
+
+    const size_t count = importAlignment / sizeof(float);
+    std::vector<uint8_t> storageLHS(2 * importAlignment);
+    std::vector<uint8_t> storageRHS(2 * importAlignment);
+    std::vector<uint8_t> storageOutput(2 * importAlignment);
+    float* dataLHS = alignedData(storageLHS, 0);
+    float* dataRHS = alignedData(storageRHS, 0);
+    float* dataOutput = alignedData(storageOutput, 0);
+    for (size_t i = 0; i < count; i++) {
+        dataLHS[i] = (float)(i % 100);
+        dataRHS[i] = 2.0f;
+        dataOutput[i] = 0.0f;
+    }
+
+    std::shared_ptr<kp::Tensor> tensorLHS = mgr.importTensor(
+      dataLHS, count, sizeof(float), kp::Memory::DataTypes::eFloat);
+    std::shared_ptr<kp::Tensor> tensorRHS = mgr.importTensor(
+      dataRHS, count, sizeof(float), kp::Memory::DataTypes::eFloat);
+    std::shared_ptr<kp::Tensor> tensorOutput = mgr.importTensor(
+      dataOutput, count, sizeof(float), kp::Memory::DataTypes::eFloat);
+
+    EXPECT_EQ(tensorOutput->memoryType(), kp::Memory::MemoryTypes::eHost);
+
+    std::vector<std::shared_ptr<kp::Memory>> params = { tensorLHS,
+                                                        tensorRHS,
+                                                        tensorOutput };
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>(params)
+      ->record<kp::OpMult>(params, mgr.algorithm())
+      ->record<kp::OpSyncLocal>(params)
+      ->eval();
+
+    std::vector<float> output = tensorOutput->vector<float>();
+    for (size_t i = 0; i < count; i++) {
+        EXPECT_EQ(output[i], (float)(i % 100) * 2.0f);
+    }
+
+    // Only imported when VK_EXT_external_memory_host is available
+    if (tensorOutput->isHostMemoryImported()) {
+        EXPECT_EQ(tensorOutput->data<float>(), dataOutput);
+        EXPECT_EQ(mgr.tensorView(tensorOutput, 0, 4)->data<float>(),
+                  dataOutput);
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(dataOutput[i], (float)(i % 100) * 2.0f);
+        }
+    } else {
+        KP_LOG_WARN("VK_EXT_external_memory_host not available, only "
+                    "testing the copy fallback");
+    }
+}
+
+TEST(TestHostImport, UnalignedHostMemoryIsCopied)
+{
+    kp::Manager mgr;
+
+    std::vector<uint8_t> storage(2 * importAlignment);
+    float* data = alignedData(storage, sizeof(float));
+    for (size_t i = 0; i < 16; i++) {
+        data[i] = (float)i;
+    }
+
+    std::shared_ptr<kp::Tensor> tensor = mgr.importTensor(
+      data, 16, sizeof(float), kp::Memory::DataTypes::eFloat);
+
+    EXPECT_FALSE(tensor->isHostMemoryImported());
+    EXPECT_NE(tensor->data<float>(), data);
+    EXPECT_EQ(tensor->vector<float>(), std::vector<float>(data, data + 16));
+
+    // The copy is independent of the host memory it was created from
+    data[0] = 100.0f;
+    EXPECT_EQ(tensor->data<float>()[0], 0.0f);
+}
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+static const std::string mappedFilePath = "kompute_test_mapped_file.bin";
+
+// Writes a file of a header of 3 floats followed by the data provided
+static std::vector<float>
+writeDataFile(size_t size)
+{
+    std::vector<float> data(size + 3);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (float)i * 0.5f;
+    }
+
+    std::ofstream file(mappedFilePath, std::ios::binary);
+    file.write((const char*)data.data(), data.size() * sizeof(float));
+
+    return std::vector<float>(data.begin() + 3, data.end());
+}
+
+TEST(TestMappedFile, MapFileRegion)
+{
+    std::vector<float> data = writeDataFile(1000);
+
+    {
+        kp::MappedFile mappedFile(
+          mappedFilePath, 3 * sizeof(float), 100 * sizeof(float));
+
+        EXPECT_EQ(mappedFile.size(), 100 * sizeof(float));
+        const float* mappedData = (const float*)mappedFile.data();
+        EXPECT_EQ(std::vector<float>(mappedData, mappedData + 100),
+                  std::vector<float>(data.begin(), data.begin() + 100));
+
+        // Released pages are read from the file again
+        mappedFile.prefetch(0, mappedFile.size());
+        mappedFile.release(0, mappedFile.size());
+        EXPECT_EQ(mappedData[99], data[99]);
+    }
+
+    {
+        // The rest of the file is mapped by default
+        kp::MappedFile mappedFile(mappedFilePath, 3 * sizeof(float));
+        EXPECT_EQ(mappedFile.size(), data.size() * sizeof(float));
+    }
+
+    EXPECT_EQ(kp::MappedFile::fileSize(mappedFilePath),
+              (data.size() + 3) * sizeof(float));
+    EXPECT_ANY_THROW(kp::MappedFile(mappedFilePath, 0, 1004 * sizeof(float)));
+    EXPECT_ANY_THROW(kp::MappedFile(mappedFilePath, 1003 * sizeof(float)));
+    EXPECT_ANY_THROW(kp::MappedFile("kompute_test_missing_file.bin"));
+
+    std::remove(mappedFilePath.c_str());
+}
+
+TEST(TestMappedFile, TensorFromFile)
+{
+    std::vector<float> data = writeDataFile(1000);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::Tensor> tensorDevice =
+      mgr.tensorFromFile(mappedFilePath,
+                         3 * sizeof(float),
+                         1000,
+                         sizeof(float),
+                         kp::Memory::DataTypes::eFloat);
+    std::shared_ptr<kp::Tensor> tensorHost =
+      mgr.tensorFromFile(mappedFilePath,
+                         3 * sizeof(float),
+                         1000,
+                         sizeof(float),
+                         kp::Memory::DataTypes::eFloat,
+                         kp::Memory::MemoryTypes::eHost);
+
+    EXPECT_EQ(tensorDevice->vector<float>(), data);
+    EXPECT_EQ(tensorHost->vector<float>(), data);
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorDevice });
+    tensorDevice->setData(std::vector<float>(1000, 0.0f));
+    tensorDevice->setResidency(kp::Memory::Residency::eDeviceDirty);
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorDevice });
+
+    EXPECT_EQ(tensorDevice->vector<float>(), data);
+
+    EXPECT_ANY_THROW(mgr.tensorFromFile(mappedFilePath,
+                                        0,
+                                        2000,
+                                        sizeof(float),
+                                        kp::Memory::DataTypes::eFloat));
+
+    std::remove(mappedFilePath.c_str());
+}
+
+TEST(TestMappedFile, TensorFromFileStreamedThroughStagingRing)
+{
+    std::vector<float> data = writeDataFile(100000);
+
+    kp::Manager mgr;
+    mgr.enableStagingRing(64 * 1024);
+
+    std::shared_ptr<kp::Tensor> tensor =
+      mgr.tensorFromFile(mappedFilePath,
+                         3 * sizeof(float),
+                         data.size(),
+                         sizeof(float),
+                         kp::Memory::DataTypes::eFloat);
+    std::shared_ptr<kp::TensorT<float>> tensorOutput =
+      mgr.tensorT<float>(data.size());
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensor })
+      ->record<kp::OpCopy>({ tensor, tensorOutput })
+      ->record<kp::OpSyncLocal>({ tensorOutput })
+      ->eval();
+
+    EXPECT_EQ(tensorOutput->vector(), data);
+
+    // The file itself is never written through the mapping
+    tensor->setData(std::vector<float>(data.size(), 1.0f));
+    kp::MappedFile mappedFile(mappedFilePath, 3 * sizeof(float));
+    EXPECT_EQ(((const float*)mappedFile.data())[0], data[0]);
+
+    std::remove(mappedFilePath.c_str());
+}
+
+TEST(TestMappedFile, LoadTensorInChunks)
+{
+    std::vector<float> data = writeDataFile(100000);
+
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorDevice =
+      mgr.tensorT<float>(data.size());
+    std::shared_ptr<kp::TensorT<float>> tensorHost = mgr.tensorT<float>(
+      data.size(), kp::Memory::MemoryTypes::eHost);
+
+    // Uses a temporary staging ring as the staging ring is not enabled
+    mgr.loadTensor(tensorDevice, mappedFilePath, 3 * sizeof(float));
+    mgr.loadTensor(tensorHost, mappedFilePath, 3 * sizeof(float));
+
+    EXPECT_EQ(tensorDevice->residency(),
+              kp::Memory::Residency::eDeviceDirty);
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorDevice });
+
+    EXPECT_EQ(tensorDevice->vector(), data);
+    EXPECT_EQ(tensorHost->vector(), data);
+
+    // Chunks smaller than the staging ring segments
+    mgr.enableStagingRing(64 * 1024);
+    std::shared_ptr<kp::TensorT<float>> tensorStreamed =
+      mgr.tensorT<float>(data.size());
+    tensorStreamed->loadFile(
+      mappedFilePath, 3 * sizeof(float), mgr.getStagingRing(), 4096 + 2);
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorStreamed });
+
+    EXPECT_EQ(tensorStreamed->vector(), data);
+
+    EXPECT_ANY_THROW(
+      mgr.loadTensor(mgr.tensorT<float>(data.size() + 1), mappedFilePath, 12));
+
+    std::remove(mappedFilePath.c_str());
+}
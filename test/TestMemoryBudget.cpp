@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOneInPlace(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { uint pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + 1;
+    }
+)");
+
+TEST(TestMemoryBudget, ReportsBudgetAndTrackedTensors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryBudget> budget = mgr.getMemoryBudget();
+
+    EXPECT_GT(budget->budget(), 0);
+    EXPECT_EQ(budget->tensorCount(), 0);
+    EXPECT_EQ(budget->trackedSize(), 0);
+    EXPECT_EQ(budget->getEvictionPolicy(),
+              kp::MemoryBudget::EvictionPolicy::eNone);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 4, 5 });
+
+    // Only the device memory of tensors of type eDevice is tracked
+    std::shared_ptr<kp::TensorT<float>> tensorHost =
+      mgr.tensor({ 6 }, kp::Memory::MemoryTypes::eHost);
+
+    EXPECT_EQ(budget->tensorCount(), 2);
+    EXPECT_EQ(budget->trackedSize(),
+              tensorA->memorySize() + tensorB->memorySize());
+
+    tensorA->destroy();
+
+    EXPECT_EQ(budget->tensorCount(), 1);
+    EXPECT_EQ(budget->trackedSize(), tensorB->memorySize());
+}
+
+TEST(TestMemoryBudget, LimitEvictsLeastRecentlyUsedTensors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryBudget> budget = mgr.getMemoryBudget();
+
+    std::vector<uint32_t> data(16, 0);
+    vk::DeviceSize tensorSize = data.size() * sizeof(uint32_t);
+
+    budget->setLimit(3 * tensorSize);
+    mgr.setEvictionPolicy(
+      kp::MemoryBudget::EvictionPolicy::eLeastRecentlyUsed);
+
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorA = mgr.tensorT(data);
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorB = mgr.tensorT(data);
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorC = mgr.tensorT(data);
+
+    EXPECT_EQ(budget->evictionCount(), 0);
+
+    // Using the first tensor makes the second one the least recently used
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA });
+
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorD = mgr.tensorT(data);
+
+    EXPECT_FALSE(tensorA->isEvicted());
+    EXPECT_TRUE(tensorB->isEvicted());
+    EXPECT_FALSE(tensorC->isEvicted());
+    EXPECT_FALSE(tensorD->isEvicted());
+    EXPECT_EQ(budget->evictionCount(), 1);
+    EXPECT_EQ(budget->tensorCount(), 4);
+    EXPECT_EQ(budget->trackedSize(), 3 * tensorSize);
+
+    // Recording an operation restores the tensor, evicting the next one
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorB });
+
+    EXPECT_FALSE(tensorB->isEvicted());
+    EXPECT_TRUE(tensorC->isEvicted());
+    EXPECT_EQ(budget->evictionCount(), 2);
+    EXPECT_EQ(budget->trackedSize(), 3 * tensorSize);
+}
+
+TEST(TestMemoryBudget, EvictedTensorKeepsDeviceData)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryBudget> budget = mgr.getMemoryBudget();
+
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorA =
+      mgr.tensorT<uint32_t>({ 1, 2, 3, 4 });
+
+    budget->setLimit(2 * tensorA->memorySize());
+    mgr.setEvictionPolicy(
+      kp::MemoryBudget::EvictionPolicy::eLeastRecentlyUsed);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA }, compileSource(shaderAddOneInPlace));
+
+    // The result is left in device memory only
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->eval();
+
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorB =
+      mgr.tensorT<uint32_t>({ 0, 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorC =
+      mgr.tensorT<uint32_t>({ 0, 0, 0, 0 });
+
+    EXPECT_TRUE(tensorA->isEvicted());
+    EXPECT_EQ(tensorA->vector(), std::vector<uint32_t>({ 2, 3, 4, 5 }));
+
+    mgr.sequence()
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorA })
+      ->eval();
+
+    EXPECT_FALSE(tensorA->isEvicted());
+    EXPECT_TRUE(tensorB->isEvicted());
+    EXPECT_EQ(tensorA->vector(), std::vector<uint32_t>({ 3, 4, 5, 6 }));
+}
+
+TEST(TestMemoryBudget, PinnedTensorIsNotEvicted)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::MemoryBudget> budget = mgr.getMemoryBudget();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2 });
+
+    budget->setLimit(tensorA->memorySize());
+    mgr.setEvictionPolicy(
+      kp::MemoryBudget::EvictionPolicy::eLeastRecentlyUsed);
+
+    tensorA->pin();
+
+    EXPECT_TRUE(tensorA->isPinned());
+    EXPECT_THROW(tensorA->evict(), std::runtime_error);
+
+    // The allocation goes ahead when nothing can be evicted
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 3, 4 });
+
+    EXPECT_FALSE(tensorA->isEvicted());
+    EXPECT_EQ(budget->evictionCount(), 0);
+    EXPECT_EQ(budget->trackedSize(), 2 * tensorA->memorySize());
+
+    tensorA->unpin();
+
+    EXPECT_FALSE(tensorA->isPinned());
+
+    tensorA->evict();
+
+    EXPECT_TRUE(tensorA->isEvicted());
+    EXPECT_EQ(budget->evictionCount(), 1);
+
+    tensorA->restore();
+
+    EXPECT_FALSE(tensorA->isEvicted());
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 1, 2 }));
+}
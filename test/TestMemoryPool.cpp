@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+TEST(TestMemoryPool, TensorsShareBlocks)
+{
+    kp::Manager mgr;
+    mgr.enableMemoryPool();
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+    EXPECT_TRUE(pool != nullptr);
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    for (uint32_t i = 0; i < 100; i++) {
+        tensors.push_back(mgr.tensor({ 0, 1, 2 }));
+    }
+
+    // Primary and staging allocations for each device tensor, carved out of
+    // one device local and one host visible block
+    EXPECT_EQ(pool->allocationCount(), 200);
+    EXPECT_LE(pool->blockCount(), 2);
+
+    tensors.clear();
+
+    EXPECT_EQ(pool->allocationCount(), 0);
+}
+
+TEST(TestMemoryPool, CopyPooledTensors)
+{
+    kp::Manager mgr;
+    mgr.enableMemoryPool();
+
+    std::vector<float> testVecA{ 1, 2, 3 };
+    std::vector<float> testVecB{ 0, 0, 0 };
+    std::vector<float> testVecC{ 4, 5, 6 };
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor(testVecA);
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor(testVecB);
+    std::shared_ptr<kp::TensorT<float>> tensorC =
+      mgr.tensor(testVecC, kp::Memory::MemoryTypes::eHost);
+
+    EXPECT_TRUE(tensorA->isInit());
+    EXPECT_TRUE(tensorB->isInit());
+    EXPECT_TRUE(tensorC->isInit());
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->eval<kp::OpCopy>({ tensorA, tensorB })
+      ->eval<kp::OpSyncLocal>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->vector(), testVecA);
+    EXPECT_EQ(tensorB->vector(), testVecA);
+    EXPECT_EQ(tensorC->vector(), testVecC);
+}
+
+TEST(TestMemoryPool, AlgorithmWithPooledTensors)
+{
+    std::string shader(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+        layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pb[index] = pa[index] * 2.0;
+        }
+    )");
+
+    kp::Manager mgr;
+    mgr.enableMemoryPool();
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::vector<std::shared_ptr<kp::Memory>> params = { tensorA, tensorB };
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>(params)
+      ->eval<kp::OpAlgoDispatch>(
+        mgr.algorithm(params, compileSource(shader)))
+      ->eval<kp::OpSyncLocal>(params);
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+}
+
+TEST(TestMemoryPool, CopyPooledTensorToImage)
+{
+    kp::Manager mgr;
+    mgr.enableMemoryPool();
+
+    std::vector<float> testVecA{ 1, 2, 3 };
+    std::vector<float> testVecB{ 0, 0, 0 };
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor(testVecA);
+    std::shared_ptr<kp::ImageT<float>> image =
+      mgr.image(testVecB, testVecB.size(), 1, 1);
+
+    EXPECT_TRUE(tensor->isInit());
+    EXPECT_TRUE(image->isInit());
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensor, image })
+      ->eval<kp::OpCopy>({ tensor, image })
+      ->eval<kp::OpSyncLocal>({ tensor, image });
+
+    EXPECT_EQ(tensor->vector(), image->vector());
+}
+
+TEST(TestMemoryPool, EmptyBlocksReleased)
+{
+    kp::Manager mgr;
+    mgr.enableMemoryPool(1024 * 1024);
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+    EXPECT_EQ(pool->blockSize(), 1024 * 1024);
+
+    // Each tensor takes half of a block once rounded to the buddy node size
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    for (uint32_t i = 0; i < 8; i++) {
+        tensors.push_back(mgr.tensorT<float>(
+          100 * 1024, kp::Memory::MemoryTypes::eStorage));
+    }
+
+    EXPECT_GE(pool->blockCount(), 4);
+
+    tensors.clear();
+
+    // Only the last block of the memory type is kept around
+    EXPECT_EQ(pool->allocationCount(), 0);
+    EXPECT_EQ(pool->blockCount(), 1);
+}
+
+TEST(TestMemoryPool, PoolOutlivesManagerWithExistingDevice)
+{
+    vk::ApplicationInfo applicationInfo;
+    applicationInfo.apiVersion = KOMPUTE_VK_API_VERSION;
+    vk::InstanceCreateInfo instanceInfo;
+    instanceInfo.pApplicationInfo = &applicationInfo;
+    std::shared_ptr<vk::Instance> instance = std::make_shared<vk::Instance>();
+    vk::createInstance(&instanceInfo, nullptr, instance.get());
+
+    std::shared_ptr<vk::PhysicalDevice> physicalDevice =
+      std::make_shared<vk::PhysicalDevice>(
+        instance->enumeratePhysicalDevices()[0]);
+
+    uint32_t queueIndex = 0;
+    std::vector<vk::QueueFamilyProperties> queueFamilies =
+      physicalDevice->getQueueFamilyProperties();
+    while (!(queueFamilies[queueIndex].queueFlags &
+             vk::QueueFlagBits::eCompute)) {
+        queueIndex++;
+    }
+
+    float queuePriority = 1.0f;
+    vk::DeviceQueueCreateInfo queueInfo(
+      vk::DeviceQueueCreateFlags(), queueIndex, 1, &queuePriority);
+    vk::DeviceCreateInfo deviceInfo(vk::DeviceCreateFlags(), 1, &queueInfo);
+    std::shared_ptr<vk::Device> device = std::make_shared<vk::Device>();
+    physicalDevice->createDevice(&deviceInfo, nullptr, device.get());
+    std::shared_ptr<vk::Queue> queue =
+      std::make_shared<vk::Queue>(device->getQueue(queueIndex, 0));
+
+    std::weak_ptr<kp::MemoryPool> pool;
+    std::shared_ptr<kp::TensorT<float>> tensor;
+
+    {
+        kp::Manager mgr(instance, physicalDevice, device);
+        mgr.enableMemoryPool();
+
+        pool = mgr.getMemoryPool();
+        // Not managed, as the manager does not own the device
+        tensor = mgr.tensor({ 1, 2, 3 });
+    }
+
+    // The allocations of the tensor stay valid after the manager is gone
+    EXPECT_FALSE(pool.expired());
+    EXPECT_EQ(pool.lock()->allocationCount(), 2);
+
+    {
+        std::shared_ptr<kp::Sequence> sq = std::make_shared<kp::Sequence>(
+          physicalDevice, device, queue, queueIndex);
+
+        sq->eval<kp::OpSyncDevice>({ tensor });
+        tensor->setData(std::vector<float>(3, 0));
+        sq->eval<kp::OpSyncLocal>({ tensor });
+
+        sq->destroy();
+    }
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 1, 2, 3 }));
+
+    // The blocks are freed with the last tensor, while the device is alive
+    tensor = nullptr;
+    EXPECT_TRUE(pool.expired());
+
+    device->destroy((vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    instance->destroy((vk::Optional<const vk::AllocationCallbacks>)nullptr);
+}
+
+TEST(TestMemoryPool, DedicatedBlockForLargeTensor)
+{
+    kp::Manager mgr;
+    mgr.enableMemoryPool(1024 * 1024);
+
+    std::shared_ptr<kp::MemoryPool> pool = mgr.getMemoryPool();
+
+    {
+        std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensorT<float>(
+          1024 * 1024, kp::Memory::MemoryTypes::eStorage);
+
+        EXPECT_EQ(pool->blockCount(), 1);
+        EXPECT_GE(pool->allocatedSize(), 4 * 1024 * 1024);
+    }
+
+    EXPECT_EQ(pool->blockCount(), 0);
+}
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include <cmath>
+#include <limits>
+
+TEST(TestOpConvert, HostConversions)
+{
+    EXPECT_EQ(kp::Half(1.5f).bits, 0x3e00);
+    EXPECT_EQ(kp::Half(-2.0f).bits, 0xc000);
+    EXPECT_EQ(kp::Half(65504.0f).bits, 0x7bff);
+    EXPECT_EQ(kp::Half(65520.0f).bits, 0x7c00);
+    EXPECT_EQ(kp::Half(70000.0f).bits, 0x7c00);
+    // The smallest subnormal half
+    EXPECT_EQ(kp::Half(5.9604645e-8f).bits, 0x0001);
+    EXPECT_EQ(kp::Half(1e-6f).bits, 0x0011);
+    EXPECT_EQ((float)kp::Half(0.333333f), 0.33325195f);
+
+    EXPECT_EQ(kp::BFloat16(1.0f).bits, 0x3f80);
+    // Ties round to even
+    EXPECT_EQ(kp::BFloat16(1.00390625f).bits, 0x3f80);
+    EXPECT_EQ(kp::BFloat16(1.01171875f).bits, 0x3f82);
+    EXPECT_EQ((float)kp::BFloat16(-3.0f), -3.0f);
+
+    EXPECT_TRUE(std::isnan(
+      (float)kp::Half(std::numeric_limits<float>::quiet_NaN())));
+    EXPECT_TRUE(std::isnan(
+      (float)kp::BFloat16(std::numeric_limits<float>::quiet_NaN())));
+}
+
+TEST(TestOpConvert, ReducedPrecisionAndInt64Tensors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<kp::Half>> tensorHalf =
+      mgr.tensorT<kp::Half>({ 1.5f, -2.25f, 0.0f });
+    std::shared_ptr<kp::TensorT<kp::BFloat16>> tensorBFloat16 =
+      mgr.tensorT<kp::BFloat16>({ 1.5f, -2.25f, 0.0f });
+    std::shared_ptr<kp::TensorT<int64_t>> tensorInt64 =
+      mgr.tensorT<int64_t>({ 1ll << 40, -(1ll << 40), 1 });
+    std::shared_ptr<kp::TensorT<uint64_t>> tensorUnsignedInt64 =
+      mgr.tensorT<uint64_t>({ 1ull << 63, 1, 0 });
+
+    EXPECT_EQ(tensorHalf->dataType(), kp::Memory::DataTypes::eHalf);
+    EXPECT_EQ(tensorBFloat16->dataType(), kp::Memory::DataTypes::eBFloat16);
+    EXPECT_EQ(tensorInt64->dataType(), kp::Memory::DataTypes::eInt64);
+    EXPECT_EQ(tensorUnsignedInt64->dataType(),
+              kp::Memory::DataTypes::eUnsignedInt64);
+
+    EXPECT_EQ(tensorHalf->memorySize(), 6);
+    EXPECT_EQ(tensorBFloat16->memorySize(), 6);
+    EXPECT_EQ(tensorInt64->memorySize(), 24);
+    EXPECT_EQ(tensorUnsignedInt64->memorySize(), 24);
+
+    std::vector<std::shared_ptr<kp::Memory>> params = {
+        tensorHalf, tensorBFloat16, tensorInt64, tensorUnsignedInt64
+    };
+
+    mgr.sequence()->eval<kp::OpSyncDevice>(params);
+
+    tensorHalf->setData(std::vector<kp::Half>(3));
+    tensorInt64->setData(std::vector<int64_t>(3));
+
+    mgr.sequence()->eval<kp::OpSyncLocal>(params);
+
+    EXPECT_EQ((float)tensorHalf->vector()[1], -2.25f);
+    EXPECT_EQ(tensorInt64->vector(),
+              std::vector<int64_t>({ 1ll << 40, -(1ll << 40), 1 }));
+
+    EXPECT_EQ(mgr.imageT<kp::Half>(2, 2, 4)->dataType(),
+              kp::Memory::DataTypes::eHalf);
+    EXPECT_ANY_THROW(mgr.imageT<kp::BFloat16>(2, 2, 1));
+}
+
+TEST(TestOpConvert, ConvertFloatToHalfAndBack)
+{
+    kp::Manager mgr;
+
+    // Only values exact in half precision, as the rounding of the device
+    // conversion and the flushing of subnormals are implementation defined
+    std::vector<float> data = {
+        1.5f, -2.25f, 0.375f, 0.0009765625f, 65504.0f, 0
+    };
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensor(data);
+    std::shared_ptr<kp::TensorT<kp::Half>> tensorHalf =
+      mgr.tensorT<kp::Half>(data.size());
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensorT<float>(data.size());
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorIn })
+      ->record<kp::OpConvert>({ tensorIn, tensorHalf }, mgr.algorithm())
+      ->record<kp::OpConvert>({ tensorHalf, tensorOut }, mgr.algorithm())
+      ->record<kp::OpSyncLocal>({ tensorHalf, tensorOut })
+      ->eval();
+
+    std::vector<kp::Half> half = tensorHalf->vector();
+    std::vector<float> out = tensorOut->vector();
+    for (size_t i = 0; i < data.size(); i++) {
+        EXPECT_EQ(half[i].bits, kp::Half(data[i]).bits);
+        EXPECT_EQ(out[i], data[i]);
+    }
+}
+
+TEST(TestOpConvert, ConvertFloatToBFloat16AndBack)
+{
+    kp::Manager mgr;
+
+    std::vector<float> data = { 1.5f, -2.25f, 0.333333f, 1e-30f, 3e38f, 0 };
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensor(data);
+    std::shared_ptr<kp::TensorT<kp::BFloat16>> tensorBFloat16 =
+      mgr.tensorT<kp::BFloat16>(data.size());
+    std::shared_ptr<kp::TensorT<float>> tensorOut =
+      mgr.tensorT<float>(data.size());
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorIn })
+      ->record<kp::OpConvert>({ tensorIn, tensorBFloat16 }, mgr.algorithm())
+      ->record<kp::OpConvert>({ tensorBFloat16, tensorOut }, mgr.algorithm())
+      ->record<kp::OpSyncLocal>({ tensorBFloat16, tensorOut })
+      ->eval();
+
+    std::vector<kp::BFloat16> bfloat16 = tensorBFloat16->vector();
+    std::vector<float> out = tensorOut->vector();
+    for (size_t i = 0; i < data.size(); i++) {
+        EXPECT_EQ(bfloat16[i].bits, kp::BFloat16(data[i]).bits);
+        EXPECT_EQ(out[i], (float)kp::BFloat16(data[i]));
+    }
+}
+
+TEST(TestOpConvert, ConvertSpansMultipleWorkgroups)
+{
+    kp::Manager mgr;
+
+    // Two workgroups of 256 pairs, the second one only partially used
+    std::vector<float> data(1000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = i * 0.5f;
+    }
+
+    std::shared_ptr<kp::TensorT<float>> tensorIn = mgr.tensor(data);
+    std::shared_ptr<kp::TensorT<kp::Half>> tensorHalf =
+      mgr.tensorT<kp::Half>(data.size());
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm();
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorIn })
+      ->record<kp::OpConvert>({ tensorIn, tensorHalf }, algorithm)
+      ->record<kp::OpSyncLocal>({ tensorHalf })
+      ->eval();
+
+    EXPECT_EQ(algorithm->getWorkgroup(), kp::Workgroup({ 2, 1, 1 }));
+
+    std::vector<kp::Half> half = tensorHalf->vector();
+    for (size_t i = 0; i < data.size(); i++) {
+        EXPECT_EQ((float)half[i], data[i]);
+    }
+}
+
+TEST(TestOpConvert, InvalidConversions)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorFloat = mgr.tensorT<float>(4);
+    std::shared_ptr<kp::TensorT<float>> tensorOdd = mgr.tensorT<float>(3);
+    std::shared_ptr<kp::TensorT<kp::Half>> tensorHalf =
+      mgr.tensorT<kp::Half>(4);
+    std::shared_ptr<kp::TensorT<kp::Half>> tensorHalfOdd =
+      mgr.tensorT<kp::Half>(3);
+    std::shared_ptr<kp::TensorT<int32_t>> tensorInt = mgr.tensorT<int32_t>(4);
+
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpConvert>(
+      { tensorFloat, tensorInt }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpConvert>(
+      { tensorFloat, tensorHalfOdd }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpConvert>(
+      { tensorOdd, tensorHalfOdd }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpConvert>(
+      { tensorFloat, tensorHalf, tensorFloat }, mgr.algorithm()));
+}
@@ -133,7 +133,8 @@ TEST(TestOpCopyImage, CopyHostToDeviceImage)
 
     mgr.sequence()->eval<kp::OpCopy>({ imageA, imageB });
 
-    EXPECT_EQ(imageA->vector(), imageB->vector());
+    // The host data of the device memory copied into is only invalidated
+    EXPECT_EQ(imageB->residency(), kp::Memory::Residency::eDeviceDirty);
 
     // Making sure the GPU holds the same vector
     mgr.sequence()->eval<kp::OpSyncLocal>({ imageB });
@@ -110,7 +110,8 @@ TEST(TestOpCopyImageToTensor, CopyHostToDeviceTensor)
 
     mgr.sequence()->eval<kp::OpCopy>({ imageA, tensorB });
 
-    EXPECT_EQ(imageA->vector(), tensorB->vector());
+    // The host data of the device memory copied into is only invalidated
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eDeviceDirty);
 
     // Making sure the GPU holds the same vector
     mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
@@ -104,7 +104,8 @@ TEST(TestOpCopyTensor, CopyHostToDeviceTensor)
 
     mgr.sequence()->eval<kp::OpCopy>({ tensorA, tensorB });
 
-    EXPECT_EQ(tensorA->vector(), tensorB->vector());
+    // The host data of the device memory copied into is only invalidated
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eDeviceDirty);
 
     // Making sure the GPU holds the same vector
     mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
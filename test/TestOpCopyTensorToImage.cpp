@@ -112,7 +112,8 @@ TEST(TestOpCopyTensorToImage, CopyHostToDeviceTensor)
 
     mgr.sequence()->eval<kp::OpCopy>({ tensorA, imageB });
 
-    EXPECT_EQ(tensorA->vector(), imageB->vector());
+    // The host data of the device memory copied into is only invalidated
+    EXPECT_EQ(imageB->residency(), kp::Memory::Residency::eDeviceDirty);
 
     // Making sure the GPU holds the same vector
     mgr.sequence()->eval<kp::OpSyncLocal>({ imageB });
@@ -121,3 +121,55 @@ TEST(TestOpSync, NegativeUnrelatedImageSync)
     // Making sure the GPU holds the same vector
     EXPECT_NE(ImageIn->vector(), ImageOut->vector());
 }
+
+TEST(TestOpSync, SyncTensorRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(8, 0));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+    tensor->setData(2, std::vector<float>({ 5, 6 }));
+    float value = 7;
+    tensor->setData(6 * sizeof(float), &value, sizeof(float));
+
+    EXPECT_EQ(tensor->vector(),
+              std::vector<float>({ 0, 0, 5, 6, 0, 0, 7, 0 }));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>(
+      { tensor }, std::vector<kp::Tensor::Range>({ { 6, 1 }, { 2, 2 } }));
+
+    tensor->setData(std::vector<float>(8, 9));
+
+    // Only the ranges synced back overwrite the host data
+    mgr.sequence()->eval<kp::OpSyncLocal>(
+      { tensor }, std::vector<kp::Tensor::Range>({ { 1, 2 }, { 3, 1 } }));
+
+    EXPECT_EQ(tensor->vector(),
+              std::vector<float>({ 9, 0, 5, 6, 9, 9, 9, 9 }));
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensor });
+
+    EXPECT_EQ(tensor->vector(),
+              std::vector<float>({ 0, 0, 5, 6, 0, 0, 7, 0 }));
+}
+
+TEST(TestOpSync, NegativeSyncInvalidRanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(4, 0));
+    std::shared_ptr<kp::ImageT<float>> image =
+      mgr.image(std::vector<float>(4, 0), 2, 2, 1);
+
+    EXPECT_ANY_THROW(tensor->setData(3, std::vector<float>({ 1, 2 })));
+
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpSyncDevice>(
+      { tensor }, std::vector<kp::Tensor::Range>({ { 2, 3 } })));
+
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpSyncLocal>(
+      { image }, std::vector<kp::Tensor::Range>({ { 0, 1 } })));
+}
@@ -58,3 +58,16 @@ TEST(TestOpTensorCreate, ExceptionOnZeroSizeTensor)
                     std::string::npos);
     }
 }
+
+TEST(TestOpTensorCreate, ExceptionOnTensorLargerThanDeviceLimits)
+{
+    kp::Manager mgr;
+
+    // The size in bytes of the tensor overflows 64 bits
+    EXPECT_ANY_THROW(mgr.tensor(
+      uint64_t(1) << 62, sizeof(double), kp::Memory::DataTypes::eDouble));
+
+    // Sizes above 4 GiB are not truncated but checked against the device
+    EXPECT_ANY_THROW(mgr.tensor(
+      uint64_t(1) << 50, sizeof(float), kp::Memory::DataTypes::eFloat));
+}
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderMult2(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] * 2.0;
+    }
+)");
+
+TEST(TestPipelineCache, AlgorithmsShareManagerCache)
+{
+    kp::Manager mgr;
+
+    EXPECT_TRUE(mgr.getPipelineCache() != nullptr);
+
+    std::vector<uint32_t> spirv = compileSource(shaderMult2);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::vector<std::shared_ptr<kp::Memory>> params = { tensorA, tensorB };
+
+    {
+        // Destroying an algorithm must not destroy the shared pipeline cache
+        std::shared_ptr<kp::Algorithm> algorithm =
+          mgr.algorithm(params, spirv);
+        algorithm->destroy();
+    }
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>(params)
+      ->eval<kp::OpAlgoDispatch>(mgr.algorithm(params, spirv))
+      ->eval<kp::OpSyncLocal>(params);
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+}
+
+TEST(TestPipelineCache, SaveAndLoadPipelineCache)
+{
+    std::string path = "kompute_test_pipeline_cache.bin";
+    std::vector<uint32_t> spirv = compileSource(shaderMult2);
+
+    {
+        kp::Manager mgr;
+
+        std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+        std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+        mgr.algorithm({ tensorA, tensorB }, spirv);
+        mgr.savePipelineCache(path);
+    }
+
+    {
+        kp::Manager mgr;
+
+        EXPECT_TRUE(mgr.loadPipelineCache(path));
+
+        std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+        std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+        std::vector<std::shared_ptr<kp::Memory>> params = { tensorA, tensorB };
+
+        mgr.sequence()
+          ->eval<kp::OpSyncDevice>(params)
+          ->eval<kp::OpAlgoDispatch>(mgr.algorithm(params, spirv))
+          ->eval<kp::OpSyncLocal>(params);
+
+        EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(TestPipelineCache, LoadInvalidPipelineCache)
+{
+    std::string path = "kompute_test_invalid_pipeline_cache.bin";
+
+    kp::Manager mgr;
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(mgr.loadPipelineCache(path));
+
+    {
+        std::ofstream fileStream(path, std::ios::binary);
+        fileStream << "not a pipeline cache";
+    }
+    EXPECT_FALSE(mgr.loadPipelineCache(path));
+
+    std::remove(path.c_str());
+}
+
+TEST(TestPipelineCache, CacheOutlivesManagerWithExistingDevice)
+{
+    std::vector<uint32_t> spirv = compileSource(shaderMult2);
+
+    vk::ApplicationInfo applicationInfo;
+    applicationInfo.apiVersion = KOMPUTE_VK_API_VERSION;
+    vk::InstanceCreateInfo instanceInfo;
+    instanceInfo.pApplicationInfo = &applicationInfo;
+    std::shared_ptr<vk::Instance> instance = std::make_shared<vk::Instance>();
+    vk::createInstance(&instanceInfo, nullptr, instance.get());
+
+    std::shared_ptr<vk::PhysicalDevice> physicalDevice =
+      std::make_shared<vk::PhysicalDevice>(
+        instance->enumeratePhysicalDevices()[0]);
+
+    uint32_t queueIndex = 0;
+    std::vector<vk::QueueFamilyProperties> queueFamilies =
+      physicalDevice->getQueueFamilyProperties();
+    while (!(queueFamilies[queueIndex].queueFlags &
+             vk::QueueFlagBits::eCompute)) {
+        queueIndex++;
+    }
+
+    float queuePriority = 1.0f;
+    vk::DeviceQueueCreateInfo queueInfo(
+      vk::DeviceQueueCreateFlags(), queueIndex, 1, &queuePriority);
+    vk::DeviceCreateInfo deviceInfo(vk::DeviceCreateFlags(), 1, &queueInfo);
+    std::shared_ptr<vk::Device> device = std::make_shared<vk::Device>();
+    physicalDevice->createDevice(&deviceInfo, nullptr, device.get());
+    std::shared_ptr<vk::Queue> queue =
+      std::make_shared<vk::Queue>(device->getQueue(queueIndex, 0));
+
+    std::shared_ptr<vk::PipelineCache> pipelineCache;
+    std::shared_ptr<kp::TensorT<float>> tensorA;
+    std::shared_ptr<kp::TensorT<float>> tensorB;
+    std::shared_ptr<kp::Algorithm> algorithm;
+
+    {
+        kp::Manager mgr(instance, physicalDevice, device);
+
+        pipelineCache = mgr.getPipelineCache();
+        tensorA = mgr.tensor({ 1, 2, 3 });
+        tensorB = mgr.tensor({ 0, 0, 0 });
+
+        // Not managed, as the manager does not own the device
+        algorithm = mgr.algorithm({ tensorA, tensorB }, spirv);
+    }
+
+    // The pipeline is created again with the cache of the destroyed manager
+    algorithm->rebuild({ tensorA, tensorB }, spirv);
+
+    EXPECT_TRUE(algorithm->isInit());
+
+    {
+        std::shared_ptr<kp::Sequence> sq = std::make_shared<kp::Sequence>(
+          physicalDevice, device, queue, queueIndex);
+
+        sq->eval<kp::OpSyncDevice>({ tensorA, tensorB })
+          ->eval<kp::OpAlgoDispatch>(algorithm)
+          ->eval<kp::OpSyncLocal>({ tensorA, tensorB });
+
+        sq->destroy();
+    }
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    algorithm->destroy();
+    tensorA->destroy();
+    tensorB->destroy();
+
+    device->destroy(*pipelineCache,
+                    (vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    device->destroy((vk::Optional<const vk::AllocationCallbacks>)nullptr);
+    instance->destroy((vk::Optional<const vk::AllocationCallbacks>)nullptr);
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderMultConst(R"(
+    #version 450
+
+    layout (constant_id = 0) const float factor = 0;
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] * factor;
+    }
+)");
+
+TEST(TestPipelineRegistry, IdenticalAlgorithmsSharePipeline)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::PipelineRegistry> registry = mgr.getPipelineRegistry();
+    EXPECT_TRUE(registry != nullptr);
+
+    std::vector<uint32_t> spirv = compileSource(shaderMultConst);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 4, 5, 6 });
+    std::shared_ptr<kp::TensorT<float>> tensorD = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algoA = mgr.algorithm(
+      { tensorA, tensorB }, spirv, {}, std::vector<float>{ 2 }, {});
+    std::shared_ptr<kp::Algorithm> algoB = mgr.algorithm(
+      { tensorC, tensorD }, spirv, {}, std::vector<float>{ 2 }, {});
+
+    EXPECT_EQ(registry->size(), 1);
+    EXPECT_EQ(registry->hitCount(), 1);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorC })
+      ->record<kp::OpAlgoDispatch>(algoA)
+      ->record<kp::OpAlgoDispatch>(algoB)
+      ->record<kp::OpSyncLocal>({ tensorB, tensorD })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+    EXPECT_EQ(tensorD->vector(), std::vector<float>({ 8, 10, 12 }));
+
+    // The pipeline stays alive while any algorithm still references it
+    algoA->destroy();
+    EXPECT_EQ(registry->size(), 1);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorC })
+      ->eval<kp::OpAlgoDispatch>(algoB)
+      ->eval<kp::OpSyncLocal>({ tensorD });
+
+    EXPECT_EQ(tensorD->vector(), std::vector<float>({ 8, 10, 12 }));
+
+    algoB->destroy();
+    EXPECT_EQ(registry->size(), 0);
+}
+
+TEST(TestPipelineRegistry, DifferentConstantsDoNotSharePipeline)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::PipelineRegistry> registry = mgr.getPipelineRegistry();
+
+    std::vector<uint32_t> spirv = compileSource(shaderMultConst);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algoA = mgr.algorithm(
+      { tensorA, tensorB }, spirv, {}, std::vector<float>{ 2 }, {});
+    std::shared_ptr<kp::Algorithm> algoB = mgr.algorithm(
+      { tensorA, tensorC }, spirv, {}, std::vector<float>{ 3 }, {});
+
+    EXPECT_EQ(registry->size(), 2);
+    EXPECT_EQ(registry->hitCount(), 0);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algoA)
+      ->record<kp::OpAlgoDispatch>(algoB)
+      ->record<kp::OpSyncLocal>({ tensorB, tensorC })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 4, 6 }));
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 3, 6, 9 }));
+}
+
+TEST(TestPipelineRegistry, RebuildReleasesPreviousPipeline)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::PipelineRegistry> registry = mgr.getPipelineRegistry();
+
+    std::vector<uint32_t> spirv = compileSource(shaderMultConst);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensorA, tensorB }, spirv, {}, std::vector<float>{ 2 }, {});
+    EXPECT_EQ(registry->size(), 1);
+
+    algorithm->rebuild<float, float>(
+      { tensorA, tensorB }, spirv, {}, std::vector<float>{ 4 }, {});
+    EXPECT_EQ(registry->size(), 1);
+
+    mgr.sequence()
+      ->eval<kp::OpSyncDevice>({ tensorA })
+      ->eval<kp::OpAlgoDispatch>(algorithm)
+      ->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 4, 8, 12 }));
+}
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include <cmath>
+#include <cstring>
+
+static std::vector<float>
+randomData(size_t size)
+{
+    std::vector<float> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = std::sin(i * 0.37f) * (i % 7 == 0 ? 20.0f : 1.0f);
+    }
+    return data;
+}
+
+TEST(TestQuantization, BlockCountIsPaddedToEvenBlocks)
+{
+    EXPECT_EQ(kp::BlockInt8::blockCount(1), 2);
+    EXPECT_EQ(kp::BlockInt8::blockCount(64), 2);
+    EXPECT_EQ(kp::BlockInt8::blockCount(65), 4);
+    EXPECT_EQ(kp::BlockInt4::blockCount(0), 0);
+    EXPECT_EQ(kp::BlockInt4::blockCount(100), 4);
+
+    std::vector<kp::BlockInt4> blocks = kp::BlockInt4::quantize({ 1.0f });
+    EXPECT_EQ(blocks.size(), 2);
+
+    std::vector<float> data = kp::BlockInt4::dequantize(blocks);
+    EXPECT_EQ(data.size(), 64);
+    EXPECT_EQ(data[0], 1.0f);
+    for (size_t i = 1; i < data.size(); i++) {
+        EXPECT_EQ(data[i], 0.0f);
+    }
+}
+
+TEST(TestQuantization, QuantizeRepresentableValuesExactly)
+{
+    // Blocks with a scale of 0.25 as their largest magnitude is 127 * 0.25
+    std::vector<float> dataInt8;
+    for (int32_t i = 0; i < 256; i++) {
+        dataInt8.push_back((i % 32 == 0 ? 127 : i - 128) * 0.25f);
+    }
+
+    std::vector<float> dequantizedInt8 =
+      kp::BlockInt8::dequantize(kp::BlockInt8::quantize(dataInt8));
+    EXPECT_EQ(dequantizedInt8, dataInt8);
+
+    // Blocks with a scale of 0.5 as their largest magnitude is -8 * 0.5
+    std::vector<float> dataInt4;
+    for (int32_t i = 0; i < 64; i++) {
+        dataInt4.push_back(((i % 16) - 8) * 0.5f);
+    }
+
+    std::vector<float> dequantizedInt4 =
+      kp::BlockInt4::dequantize(kp::BlockInt4::quantize(dataInt4));
+    EXPECT_EQ(dequantizedInt4, dataInt4);
+}
+
+TEST(TestQuantization, QuantizeErrorIsBoundedByScale)
+{
+    std::vector<float> data = randomData(1000);
+
+    std::vector<kp::BlockInt8> blocksInt8 = kp::BlockInt8::quantize(data);
+    std::vector<kp::BlockInt4> blocksInt4 = kp::BlockInt4::quantize(data);
+    std::vector<float> dequantizedInt8 = kp::BlockInt8::dequantize(blocksInt8);
+    std::vector<float> dequantizedInt4 = kp::BlockInt4::dequantize(blocksInt4);
+
+    for (size_t i = 0; i < data.size(); i++) {
+        float scaleInt8 = blocksInt8[i / kp::BlockInt8::blockSize].scale;
+        float scaleInt4 = blocksInt4[i / kp::BlockInt4::blockSize].scale;
+        EXPECT_LE(std::fabs(dequantizedInt8[i] - data[i]),
+                  std::fabs(scaleInt8) * 0.5f + 1e-5f);
+        // Values of the opposite sign of the largest magnitude are clamped
+        // to 7 instead of 8
+        EXPECT_LE(std::fabs(dequantizedInt4[i] - data[i]),
+                  std::fabs(scaleInt4) + 1e-5f);
+    }
+}
+
+TEST(TestQuantization, DequantizeOnDeviceMatchesHost)
+{
+    kp::Manager mgr;
+
+    std::vector<float> data = randomData(1000);
+    std::vector<kp::BlockInt8> blocksInt8 = kp::BlockInt8::quantize(data);
+    std::vector<kp::BlockInt4> blocksInt4 = kp::BlockInt4::quantize(data);
+
+    std::shared_ptr<kp::TensorT<kp::BlockInt8>> tensorInt8 =
+      mgr.tensorT(blocksInt8);
+    std::shared_ptr<kp::TensorT<kp::BlockInt4>> tensorInt4 =
+      mgr.tensorT(blocksInt4);
+
+    EXPECT_EQ(tensorInt8->dataType(), kp::Memory::DataTypes::eBlockInt8);
+    EXPECT_EQ(tensorInt4->dataType(), kp::Memory::DataTypes::eBlockInt4);
+    EXPECT_EQ(tensorInt8->memorySize(), blocksInt8.size() * 34);
+    EXPECT_EQ(tensorInt4->memorySize(), blocksInt4.size() * 18);
+
+    std::shared_ptr<kp::TensorT<float>> outInt8 =
+      mgr.tensorT<float>(blocksInt8.size() * kp::BlockInt8::blockSize);
+    std::shared_ptr<kp::TensorT<float>> outInt4 =
+      mgr.tensorT<float>(blocksInt4.size() * kp::BlockInt4::blockSize);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorInt8, tensorInt4 })
+      ->record<kp::OpDequantize>({ tensorInt8, outInt8 }, mgr.algorithm())
+      ->record<kp::OpDequantize>({ tensorInt4, outInt4 }, mgr.algorithm())
+      ->record<kp::OpSyncLocal>({ outInt8, outInt4 })
+      ->eval();
+
+    EXPECT_EQ(outInt8->vector(), kp::BlockInt8::dequantize(blocksInt8));
+    EXPECT_EQ(outInt4->vector(), kp::BlockInt4::dequantize(blocksInt4));
+
+    // The blocks read back from the device are the ones uploaded
+    tensorInt4->setData(std::vector<kp::BlockInt4>(blocksInt4.size()));
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorInt4 });
+    EXPECT_EQ(memcmp(tensorInt4->data(),
+                     blocksInt4.data(),
+                     blocksInt4.size() * sizeof(kp::BlockInt4)),
+              0);
+}
+
+TEST(TestQuantization, InvalidDequantize)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<kp::BlockInt8>> tensorInt8 =
+      mgr.tensorT(kp::BlockInt8::quantize(randomData(64)));
+    std::shared_ptr<kp::TensorT<kp::BlockInt8>> tensorOdd =
+      mgr.tensorT(std::vector<kp::BlockInt8>(3));
+    std::shared_ptr<kp::TensorT<float>> tensorFloat = mgr.tensorT<float>(64);
+    std::shared_ptr<kp::TensorT<float>> tensorSmall = mgr.tensorT<float>(32);
+    std::shared_ptr<kp::TensorT<kp::Half>> tensorHalf =
+      mgr.tensorT<kp::Half>(64);
+
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpDequantize>(
+      { tensorFloat, tensorFloat }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpDequantize>(
+      { tensorInt8, tensorHalf }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpDequantize>(
+      { tensorInt8, tensorSmall }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpDequantize>(
+      { tensorOdd, mgr.tensorT<float>(96) }, mgr.algorithm()));
+    EXPECT_ANY_THROW(mgr.imageT<kp::BlockInt8>(2, 2, 1));
+}
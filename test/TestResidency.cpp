@@ -0,0 +1,222 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestResidency, SyncOperationsTrackResidency)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorHost =
+      mgr.tensor({ 1, 2, 3 }, kp::Memory::MemoryTypes::eHost);
+
+    EXPECT_EQ(tensorA->residency(), kp::Memory::Residency::eHostDirty);
+    EXPECT_EQ(tensorHost->residency(), kp::Memory::Residency::eCoherent);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+    algorithm->setBindingAccess(0, kp::Algorithm::BindingAccess::eReadOnly);
+    algorithm->setBindingAccess(1, kp::Algorithm::BindingAccess::eWriteOnly);
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA, tensorB });
+
+    EXPECT_EQ(tensorA->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eCoherent);
+
+    mgr.sequence()->eval<kp::OpAlgoDispatch>(algorithm);
+
+    EXPECT_EQ(tensorA->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eDeviceDirty);
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+
+    tensorA->setData(std::vector<float>({ 4, 5, 6 }));
+
+    EXPECT_EQ(tensorA->residency(), kp::Memory::Residency::eHostDirty);
+}
+
+TEST(TestResidency, CoherentSyncsAreSkipped)
+{
+    kp::Manager mgr;
+
+    mgr.enableStagingRing(1024);
+
+    std::shared_ptr<kp::StagingRing> stagingRing = mgr.getStagingRing();
+
+    std::shared_ptr<kp::TensorT<float>> tensor =
+      mgr.tensor(std::vector<float>(128, 1));
+    EXPECT_TRUE(tensor->usesStagingRing());
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+    EXPECT_EQ(stagingRing->chunkCount(), 1);
+
+    // Neither direction needs a transfer while the tensor is coherent
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensor });
+    EXPECT_EQ(stagingRing->chunkCount(), 1);
+
+    tensor->setData(std::vector<float>(128, 2));
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+    EXPECT_EQ(stagingRing->chunkCount(), 2);
+}
+
+TEST(TestResidency, OpCopyInvalidatesHostData)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpCopy>({ tensorA, tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorA->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eDeviceDirty);
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_EQ(tensorB->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestResidency, SequenceRerecordedWhenResidencyChanges)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+    algorithm->setBindingAccess(0, kp::Algorithm::BindingAccess::eReadOnly);
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorA });
+
+    // The upload of A is skipped when recorded as A is already coherent
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    sq->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorB });
+
+    sq->eval();
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+
+    sq->eval();
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+
+    // Writing A on the host requires the skipped upload to be recorded
+    tensorA->setData(std::vector<float>({ 4, 5, 6 }));
+
+    sq->eval();
+    EXPECT_EQ(tensorA->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 5, 6, 7 }));
+
+    tensorA->setData(std::vector<float>({ 7, 8, 9 }));
+
+    sq->eval();
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 8, 9, 10 }));
+}
+
+// Writes the primary buffer without declaring the access to the tracker
+class OpFillBuffer : public kp::OpBase
+{
+  public:
+    OpFillBuffer(std::shared_ptr<kp::Tensor> tensor, uint32_t value)
+      : mTensor(tensor)
+      , mValue(value)
+    {
+    }
+
+    void record(const vk::CommandBuffer& commandBuffer) override
+    {
+        commandBuffer.fillBuffer(
+          *this->mTensor->getPrimaryBuffer(), 0, VK_WHOLE_SIZE, this->mValue);
+    }
+
+    void preEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+    void postEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+  private:
+    std::shared_ptr<kp::Tensor> mTensor;
+    uint32_t mValue;
+};
+
+TEST(TestResidency, UntrackedWritesAreSyncedBack)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+    EXPECT_EQ(tensor->residency(), kp::Memory::Residency::eCoherent);
+
+    float value = 5.0f;
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    // The sync is not skipped even though the tensor was coherent, as the
+    // operation before it may have written the tensor
+    mgr.sequence()
+      ->record(std::make_shared<OpFillBuffer>(tensor, bits))
+      ->record<kp::OpSyncLocal>({ tensor })
+      ->eval();
+
+    EXPECT_EQ(tensor->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 5, 5, 5 }));
+}
+
+TEST(TestResidency, UntrackedWritesInvalidateOtherSequences)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorOther = mgr.tensor({ 4, 5, 6 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor, tensorOther });
+    EXPECT_EQ(tensor->residency(), kp::Memory::Residency::eCoherent);
+
+    float value = 5.0f;
+    uint32_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+
+    // The sequence writing the tensor never declares an access to it
+    mgr.sequence()->eval(std::make_shared<OpFillBuffer>(tensor, bits));
+
+    EXPECT_EQ(tensor->residency(), kp::Memory::Residency::eDeviceDirty);
+    EXPECT_EQ(tensorOther->residency(), kp::Memory::Residency::eDeviceDirty);
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensor, tensorOther });
+
+    EXPECT_EQ(tensor->residency(), kp::Memory::Residency::eCoherent);
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 5, 5, 5 }));
+    EXPECT_EQ(tensorOther->vector(), std::vector<float>({ 4, 5, 6 }));
+}
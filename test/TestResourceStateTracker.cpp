@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestResourceStateTracker, BackToBackDispatchesReadPreviousWrites)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algoAB =
+      mgr.algorithm({ tensorA, tensorB }, spirv);
+    std::shared_ptr<kp::Algorithm> algoBC =
+      mgr.algorithm({ tensorB, tensorC }, spirv);
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    std::shared_ptr<kp::ResourceStateTracker> tracker =
+      sq->getResourceStateTracker();
+
+    sq->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algoAB);
+
+    uint32_t barrierCount = tracker->barrierCount();
+    uint32_t pipelineBarrierCount = tracker->pipelineBarrierCount();
+
+    // Reading B written by the previous dispatch requires a barrier, which is
+    // batched with the one required to write C
+    sq->record<kp::OpAlgoDispatch>(algoBC);
+
+    EXPECT_EQ(tracker->barrierCount(), barrierCount + 2);
+    EXPECT_EQ(tracker->pipelineBarrierCount(), pipelineBarrierCount + 1);
+
+    sq->record<kp::OpSyncLocal>({ tensorC })->eval();
+
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 3, 4, 5 }));
+}
+
+TEST(TestResourceStateTracker, ReadOnlyBindingsSkipReadAfterRead)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algoAB =
+      mgr.algorithm({ tensorA, tensorB }, spirv);
+    std::shared_ptr<kp::Algorithm> algoAC =
+      mgr.algorithm({ tensorA, tensorC }, spirv);
+
+    for (const std::shared_ptr<kp::Algorithm>& algo : { algoAB, algoAC }) {
+        algo->setBindingAccess(0, kp::Algorithm::BindingAccess::eReadOnly);
+        algo->setBindingAccess(1, kp::Algorithm::BindingAccess::eWriteOnly);
+    }
+
+    EXPECT_EQ(algoAB->getBindingAccess(0),
+              kp::Algorithm::BindingAccess::eReadOnly);
+    EXPECT_ANY_THROW(
+      algoAB->setBindingAccess(2, kp::Algorithm::BindingAccess::eReadOnly));
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    std::shared_ptr<kp::ResourceStateTracker> tracker =
+      sq->getResourceStateTracker();
+
+    sq->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algoAB);
+
+    uint32_t barrierCount = tracker->barrierCount();
+
+    // A was already made visible to the first dispatch, so only the write
+    // into C requires a barrier
+    sq->record<kp::OpAlgoDispatch>(algoAC);
+
+    EXPECT_EQ(tracker->barrierCount(), barrierCount + 1);
+
+    sq->record<kp::OpSyncLocal>({ tensorB, tensorC })->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 2, 3, 4 }));
+}
+
+TEST(TestResourceStateTracker, UntrackedOperationsResetState)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, spirv);
+    algorithm->setBindingAccess(0, kp::Algorithm::BindingAccess::eReadOnly);
+
+    std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+    std::shared_ptr<kp::ResourceStateTracker> tracker =
+      sq->getResourceStateTracker();
+
+    sq->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpMemoryBarrier>({ tensorB },
+                                    vk::AccessFlagBits::eShaderWrite,
+                                    vk::AccessFlagBits::eShaderRead,
+                                    vk::PipelineStageFlagBits::eComputeShader,
+                                    vk::PipelineStageFlagBits::eComputeShader);
+
+    uint32_t barrierCount = tracker->barrierCount();
+
+    // The accesses of the memory barrier operation are unknown to the
+    // tracker, so both memory objects are synchronised again
+    sq->record<kp::OpAlgoDispatch>(algorithm);
+
+    EXPECT_EQ(tracker->barrierCount(), barrierCount + 2);
+
+    sq->record<kp::OpSyncLocal>({ tensorB })->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+}
@@ -243,3 +243,315 @@ TEST(TestSequence, CorrectSequenceRunningError)
 
     EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 2, 4, 6 }));
 }
+
+TEST(TestSequence, BatchedSequenceSubmit)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] + 1;
+        }
+    )");
+
+    std::vector<std::shared_ptr<kp::TensorT<float>>> tensors;
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+    for (uint32_t i = 0; i < 3; i++) {
+        std::shared_ptr<kp::TensorT<float>> tensor =
+          mgr.tensor({ float(i), float(i), float(i) });
+        mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+        std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+        sq->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirv))
+          ->record<kp::OpSyncLocal>({ tensor });
+
+        tensors.push_back(tensor);
+        sequences.push_back(sq);
+    }
+
+    mgr.evalAsync(sequences);
+
+    for (const std::shared_ptr<kp::Sequence>& sq : sequences) {
+        EXPECT_TRUE(sq->isRunning());
+    }
+
+    // Running sequences cannot be submitted again
+    EXPECT_ANY_THROW(mgr.evalAsync({ sequences[1] }));
+
+    mgr.evalAwait(sequences);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        EXPECT_FALSE(sequences[i]->isRunning());
+        EXPECT_EQ(tensors[i]->vector(), std::vector<float>(3, i + 1));
+    }
+
+    // The same sequence cannot be submitted twice in a batch
+    EXPECT_ANY_THROW(mgr.evalAsync({ sequences[0], sequences[0] }));
+    EXPECT_FALSE(sequences[0]->isRunning());
+
+    // The sequences of a batch can also be awaited one by one
+    mgr.evalAsync(sequences);
+
+    sequences[2]->evalAwait();
+    sequences[0]->evalAwait();
+    sequences[1]->evalAwait();
+
+    for (uint32_t i = 0; i < 3; i++) {
+        EXPECT_FALSE(sequences[i]->isRunning());
+        EXPECT_EQ(tensors[i]->vector(), std::vector<float>(3, i + 2));
+    }
+}
+
+// Fails when the sequence it is recorded in is submitted
+class OpFailPreEval : public kp::OpBase
+{
+  public:
+    void record(const vk::CommandBuffer& /*commandBuffer*/) override {}
+
+    void preEval(const vk::CommandBuffer& /*commandBuffer*/) override
+    {
+        throw std::runtime_error("OpFailPreEval preEval failed");
+    }
+
+    void postEval(const vk::CommandBuffer& /*commandBuffer*/) override {}
+};
+
+TEST(TestSequence, BatchedSequenceSubmitErrors)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 1, 2, 3 });
+
+    std::vector<std::shared_ptr<kp::Sequence>> sequences;
+    for (uint32_t i = 0; i < 3; i++) {
+        std::shared_ptr<kp::Sequence> sq = mgr.sequence();
+        sq->record<kp::OpSyncDevice>({ tensor });
+        sequences.push_back(sq);
+    }
+
+    mgr.evalAsync(sequences);
+    sequences[0]->evalAwait();
+
+    // The other sequences still wait on the fence of the first one
+    EXPECT_ANY_THROW(sequences[0]->evalAsync());
+    EXPECT_ANY_THROW(mgr.evalAsync({ sequences[0] }));
+    EXPECT_FALSE(sequences[0]->isRunning());
+
+    mgr.evalAwait({ sequences[1], sequences[2] });
+
+    sequences[0]->evalAsync();
+    sequences[0]->evalAwait();
+    EXPECT_FALSE(sequences[0]->isRunning());
+
+    // A sequence failing to be prepared leaves none of the batch running
+    std::shared_ptr<kp::Sequence> sqFail = mgr.sequence();
+    sqFail->record(std::make_shared<OpFailPreEval>());
+
+    EXPECT_ANY_THROW(mgr.evalAsync({ sequences[0], sequences[1], sqFail }));
+    EXPECT_FALSE(sequences[0]->isRunning());
+    EXPECT_FALSE(sequences[1]->isRunning());
+    EXPECT_FALSE(sqFail->isRunning());
+
+    mgr.evalAsync({ sequences[0], sequences[1] });
+    mgr.evalAwait({ sequences[0], sequences[1] });
+    EXPECT_FALSE(sequences[0]->isRunning());
+    EXPECT_FALSE(sequences[1]->isRunning());
+}
+
+TEST(TestSequence, SequenceWaitOnSequence)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirvAdd = compileSource(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] + 1;
+        }
+    )");
+
+    std::vector<uint32_t> spirvDouble = compileSource(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] * 2;
+        }
+    )");
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 1, 2 });
+
+    std::shared_ptr<kp::Sequence> sqUpload =
+      mgr.sequence()->record<kp::OpSyncDevice>({ tensor });
+    std::shared_ptr<kp::Sequence> sqAdd =
+      mgr.sequence()->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensor }, spirvAdd));
+    std::shared_ptr<kp::Sequence> sqDouble =
+      mgr.sequence()
+        ->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirvDouble))
+        ->record<kp::OpSyncLocal>({ tensor });
+
+    sqAdd->waitOn(sqUpload);
+    sqDouble->waitOn(sqAdd);
+
+    EXPECT_ANY_THROW(sqAdd->waitOn(sqAdd));
+
+    // All the stages are submitted up front and only the last one is waited
+    // on before reading the result
+    for (uint32_t i = 0; i < 2; i++) {
+        sqUpload->evalAsync();
+        sqAdd->evalAsync();
+        sqDouble->evalAsync();
+
+        sqDouble->evalAwait();
+
+        EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 4, 6 }));
+
+        sqUpload->evalAwait();
+        sqAdd->evalAwait();
+
+        tensor->setData(std::vector<float>({ 0, 1, 2 }));
+    }
+
+    // Dependencies also hold within a batch
+    mgr.evalAsync({ sqUpload, sqAdd, sqDouble });
+    mgr.evalAwait({ sqUpload, sqAdd, sqDouble });
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 2, 4, 6 }));
+
+    sqDouble->clearDependencies();
+    sqAdd->clearDependencies();
+}
+
+TEST(TestSequence, SequenceSlotsSteadyStateLoop)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] + 1;
+        }
+    )");
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor({ 0, 1, 2 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensor });
+
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence(0, 0, 3)->record<kp::OpAlgoDispatch>(
+        mgr.algorithm({ tensor }, spirv));
+
+    EXPECT_EQ(sq->slotCount(), 3);
+
+    // Submitting more times than there are slots only blocks on the oldest
+    // submission instead of throwing
+    for (uint32_t i = 0; i < 10; i++) {
+        sq->evalAsync();
+        EXPECT_TRUE(sq->isRunning());
+    }
+
+    sq->evalAwait();
+
+    EXPECT_FALSE(sq->isRunning());
+
+    // Operations recorded later are recorded into every slot once used
+    sq->record<kp::OpSyncLocal>({ tensor });
+    for (uint32_t i = 0; i < 3; i++) {
+        sq->evalAsync();
+    }
+    sq->evalAwait();
+
+    EXPECT_EQ(tensor->vector(), std::vector<float>({ 13, 14, 15 }));
+
+    // A single slot still requires awaiting before evaluating again
+    std::shared_ptr<kp::Sequence> sqSingle = mgr.sequence();
+    sqSingle->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensor }, spirv));
+
+    EXPECT_EQ(sqSingle->slotCount(), 1);
+
+    sqSingle->evalAsync();
+    EXPECT_ANY_THROW(sqSingle->evalAsync());
+    sqSingle->evalAwait();
+}
+
+TEST(TestSequence, SequenceCompletionQueries)
+{
+    kp::Manager mgr;
+
+    std::vector<uint32_t> spirv = compileSource(R"(
+        #version 450
+
+        layout (local_size_x = 1) in;
+
+        layout(set = 0, binding = 0) buffer a { float pa[]; };
+
+        void main() {
+            uint index = gl_GlobalInvocationID.x;
+            pa[index] = pa[index] + 1;
+        }
+    )");
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 0, 1 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 2, 3 });
+
+    std::vector<std::shared_ptr<kp::Sequence>> sequences = {
+        mgr.sequence()
+          ->record<kp::OpSyncDevice>({ tensorA })
+          ->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensorA }, spirv))
+          ->record<kp::OpSyncLocal>({ tensorA }),
+        mgr.sequence()
+          ->record<kp::OpSyncDevice>({ tensorB })
+          ->record<kp::OpAlgoDispatch>(mgr.algorithm({ tensorB }, spirv))
+          ->record<kp::OpSyncLocal>({ tensorB })
+    };
+
+    EXPECT_TRUE(sequences[0]->isComplete());
+    EXPECT_EQ(mgr.waitAny(sequences), -1);
+    EXPECT_TRUE(mgr.waitAll(sequences));
+
+    for (const std::shared_ptr<kp::Sequence>& sequence : sequences) {
+        sequence->evalAsync();
+    }
+
+    // The sequence found completed but is still running until awaited
+    int32_t index = mgr.waitAny(sequences);
+    ASSERT_GE(index, 0);
+    ASSERT_LT(index, 2);
+    EXPECT_TRUE(sequences[index]->isComplete());
+    EXPECT_TRUE(sequences[index]->isRunning());
+
+    sequences[index]->evalAwait();
+
+    EXPECT_FALSE(sequences[index]->isRunning());
+
+    EXPECT_TRUE(mgr.waitAll(sequences));
+    EXPECT_TRUE(sequences[1 - index]->isComplete());
+
+    sequences[1 - index]->evalAwait();
+
+    EXPECT_EQ(tensorA->vector(), std::vector<float>({ 1, 2 }));
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 3, 4 }));
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestStagingPolicy, EagerByDefault)
+{
+    kp::Manager mgr;
+
+    EXPECT_EQ(mgr.getStagingPolicy(), kp::Memory::StagingPolicy::eEager);
+
+    std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensorT<float>(3);
+    std::shared_ptr<kp::TensorT<float>> tensorHost =
+      mgr.tensorT<float>(3, kp::Memory::MemoryTypes::eHost);
+    std::shared_ptr<kp::ImageT<float>> image = mgr.imageT<float>(3, 3, 1);
+
+    EXPECT_TRUE(tensor->hasStagingMemory());
+    EXPECT_FALSE(tensorHost->hasStagingMemory());
+    EXPECT_TRUE(image->hasStagingMemory());
+}
+
+TEST(TestStagingPolicy, LazyStagingOnlyAllocatedWhenSynced)
+{
+    kp::Manager mgr;
+
+    mgr.setStagingPolicy(kp::Memory::StagingPolicy::eLazy);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensorT<float>(3);
+    std::shared_ptr<kp::TensorT<float>> tensorC = mgr.tensorT<float>(3);
+    std::shared_ptr<kp::ImageT<float>> image = mgr.imageT<float>(3, 3, 1);
+
+    // Setting the initial data of the tensor requires its staging memory
+    EXPECT_TRUE(tensorA->hasStagingMemory());
+    EXPECT_FALSE(tensorB->hasStagingMemory());
+    EXPECT_FALSE(tensorC->hasStagingMemory());
+    EXPECT_FALSE(image->hasStagingMemory());
+
+    std::vector<uint32_t> spirv = compileSource(shaderAddOne);
+    std::shared_ptr<kp::Algorithm> algoAB =
+      mgr.algorithm({ tensorA, tensorB }, spirv);
+    std::shared_ptr<kp::Algorithm> algoBC =
+      mgr.algorithm({ tensorB, tensorC }, spirv);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algoAB)
+      ->record<kp::OpAlgoDispatch>(algoBC)
+      ->eval();
+
+    // B is an intermediate result that is never read back by the host
+    EXPECT_FALSE(tensorB->hasStagingMemory());
+    EXPECT_FALSE(tensorC->hasStagingMemory());
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorC });
+
+    EXPECT_FALSE(tensorB->hasStagingMemory());
+    EXPECT_TRUE(tensorC->hasStagingMemory());
+    EXPECT_EQ(tensorC->vector(), std::vector<float>({ 3, 4, 5 }));
+
+    image->setData(std::vector<float>(9, 1));
+    EXPECT_TRUE(image->hasStagingMemory());
+}
+
+TEST(TestStagingPolicy, ReleaseStagingMemory)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2, 3 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->eval();
+
+    tensorA->releaseStagingMemory();
+    tensorB->releaseStagingMemory();
+
+    EXPECT_FALSE(tensorA->hasStagingMemory());
+    EXPECT_FALSE(tensorB->hasStagingMemory());
+
+    // Releasing twice is a no-op
+    tensorB->releaseStagingMemory();
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ tensorB });
+
+    EXPECT_FALSE(tensorA->hasStagingMemory());
+    EXPECT_TRUE(tensorB->hasStagingMemory());
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3, 4 }));
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] + 1.0;
+    }
+)");
+
+TEST(TestStagingRing, TensorsStreamInChunks)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorBefore = mgr.tensor({ 1, 2 });
+
+    mgr.enableStagingRing(1024);
+
+    std::shared_ptr<kp::StagingRing> stagingRing = mgr.getStagingRing();
+    EXPECT_TRUE(stagingRing != nullptr);
+    EXPECT_EQ(stagingRing->size(), 1024);
+    EXPECT_EQ(stagingRing->chunkSize(), 512);
+
+    // Each tensor is four times as large as a chunk of the ring
+    std::vector<float> dataA(512);
+    for (size_t i = 0; i < dataA.size(); i++) {
+        dataA[i] = (float)i;
+    }
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor(dataA);
+    std::shared_ptr<kp::TensorT<float>> tensorB =
+      mgr.tensor(std::vector<float>(dataA.size(), 0));
+    std::shared_ptr<kp::TensorT<float>> tensorHost =
+      mgr.tensor({ 1, 2 }, kp::Memory::MemoryTypes::eHost);
+
+    EXPECT_FALSE(tensorBefore->usesStagingRing());
+    EXPECT_TRUE(tensorA->usesStagingRing());
+    EXPECT_FALSE(tensorHost->usesStagingRing());
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA, tensorB })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(stagingRing->chunkCount(), 12);
+
+    std::vector<float> expected(dataA.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        expected[i] = dataA[i] + 1;
+    }
+    EXPECT_EQ(tensorB->vector(), expected);
+}
+
+TEST(TestStagingRing, ImagesStreamInRows)
+{
+    kp::Manager mgr;
+
+    mgr.enableStagingRing(1024);
+
+    // Chunks of 512 bytes hold 8 rows of 16 floats
+    std::vector<float> data(16 * 20);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (float)i;
+    }
+
+    std::shared_ptr<kp::ImageT<float>> image = mgr.image(data, 16, 20, 1);
+    EXPECT_TRUE(image->usesStagingRing());
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ image });
+
+    image->setData(std::vector<float>(data.size(), 0));
+
+    mgr.sequence()->eval<kp::OpSyncLocal>({ image });
+
+    EXPECT_EQ(image->vector(), data);
+    EXPECT_EQ(mgr.getStagingRing()->chunkCount(), 6);
+}
+
+TEST(TestStagingRing, SyncAfterAccessInSameRecordingThrows)
+{
+    kp::Manager mgr;
+
+    mgr.enableStagingRing(1024);
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensor({ 1, 2 });
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensor({ 0, 0 });
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA, tensorB }, compileSource(shaderAddOne));
+
+    // The upload through the ring would be executed before the dispatch
+    std::shared_ptr<kp::Sequence> sq =
+      mgr.sequence()->record<kp::OpAlgoDispatch>(algorithm);
+    EXPECT_ANY_THROW(sq->record<kp::OpSyncDevice>({ tensorB }));
+
+    // Memory objects not accessed yet are still streamed through the ring
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ tensorA })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ tensorB })
+      ->eval();
+
+    EXPECT_EQ(tensorB->vector(), std::vector<float>({ 2, 3 }));
+}
+
+TEST(TestStagingRing, RowsLargerThanChunkThrow)
+{
+    kp::Manager mgr;
+
+    mgr.enableStagingRing(512);
+
+    std::shared_ptr<kp::ImageT<float>> image =
+      mgr.image(std::vector<float>(128 * 2, 0), 128, 2, 1);
+
+    EXPECT_ANY_THROW(mgr.sequence()->eval<kp::OpSyncDevice>({ image }));
+}
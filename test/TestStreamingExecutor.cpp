@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderScale(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+    layout(set = 0, binding = 2) buffer scale { float pscale[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] * pscale[0];
+    }
+)");
+
+static const std::string shaderAddOneInPlace(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { uint pa[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pa[index] = pa[index] + 1;
+    }
+)");
+
+TEST(TestStreamingExecutor, StreamsChunksThroughAlgorithm)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensorT<float>(64);
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensorT<float>(64);
+    std::shared_ptr<kp::TensorT<float>> tensorScale = mgr.tensor({ 3 });
+
+    mgr.sequence()->eval<kp::OpSyncDevice>({ tensorScale });
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensorA, tensorB, tensorScale }, compileSource(shaderScale));
+
+    std::shared_ptr<kp::StreamingExecutor> executor =
+      mgr.streamingExecutor(algorithm, { 0 }, { 1 });
+
+    EXPECT_EQ(executor->chunkSize(), 64);
+    EXPECT_EQ(executor->slotCount(), 3);
+
+    // Not a multiple of the chunk size, so the last chunk is partial
+    std::vector<float> input(1000);
+    for (size_t i = 0; i < input.size(); i++) {
+        input[i] = static_cast<float>(i);
+    }
+    std::vector<float> output(input.size(), -1);
+
+    kp::StreamingExecutor::Stats stats =
+      executor->run({ input.data() }, { output.data() }, input.size());
+
+    for (size_t i = 0; i < output.size(); i++) {
+        EXPECT_EQ(output[i], input[i] * 3);
+    }
+
+    EXPECT_EQ(stats.elementCount, 1000);
+    EXPECT_EQ(stats.chunkCount, 16);
+    EXPECT_EQ(stats.bytesUploaded, 1000 * sizeof(float));
+    EXPECT_EQ(stats.bytesDownloaded, 1000 * sizeof(float));
+    EXPECT_GT(stats.seconds, 0);
+    EXPECT_GT(stats.throughput(), 0);
+
+    // The sequences are recorded once and reused by later runs
+    std::vector<float> smallOutput(10);
+    executor->run({ input.data() }, { smallOutput.data() }, 10);
+
+    EXPECT_EQ(smallOutput,
+              std::vector<float>(output.begin(), output.begin() + 10));
+}
+
+TEST(TestStreamingExecutor, InPlaceBinding)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<uint32_t>> tensorA = mgr.tensorT<uint32_t>(16);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ tensorA }, compileSource(shaderAddOneInPlace));
+
+    std::shared_ptr<kp::StreamingExecutor> executor =
+      mgr.streamingExecutor(algorithm, { 0 }, { 0 }, 2);
+
+    std::vector<uint32_t> data(100);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<uint32_t>(i);
+    }
+
+    kp::StreamingExecutor::Stats stats =
+      executor->run({ data.data() }, { data.data() }, data.size());
+
+    for (size_t i = 0; i < data.size(); i++) {
+        EXPECT_EQ(data[i], i + 1);
+    }
+    EXPECT_EQ(stats.chunkCount, 7);
+}
+
+TEST(TestStreamingExecutor, InvalidBindings)
+{
+    kp::Manager mgr;
+
+    std::shared_ptr<kp::TensorT<float>> tensorA = mgr.tensorT<float>(64);
+    std::shared_ptr<kp::TensorT<float>> tensorB = mgr.tensorT<float>(32);
+    std::shared_ptr<kp::TensorT<float>> tensorScale = mgr.tensor({ 3 });
+
+    std::shared_ptr<kp::Algorithm> algorithm = mgr.algorithm(
+      { tensorA, tensorB, tensorScale }, compileSource(shaderScale));
+
+    // The streamed bindings have to hold the same number of elements
+    EXPECT_THROW(mgr.streamingExecutor(algorithm, { 0 }, { 1 }),
+                 std::runtime_error);
+    EXPECT_THROW(mgr.streamingExecutor(algorithm, { 0 }, { 3 }),
+                 std::runtime_error);
+    EXPECT_THROW(mgr.streamingExecutor(algorithm, { 0 }, { 1 }, 0),
+                 std::runtime_error);
+
+    std::shared_ptr<kp::StreamingExecutor> executor =
+      mgr.streamingExecutor(algorithm, { 0 }, {});
+
+    std::vector<float> input(64);
+    EXPECT_THROW(executor->run({}, {}, input.size()), std::runtime_error);
+}
@@ -32,6 +32,8 @@ TEST(TestTensor, ConstructorData)
     std::vector<float> vec{ 0, 1, 2 };
     std::shared_ptr<kp::TensorT<float>> tensor = mgr.tensor(vec);
     EXPECT_EQ(tensor->size(), vec.size());
+    EXPECT_EQ(tensor->getX(), vec.size());
+    EXPECT_EQ(tensor->getY(), 1);
     EXPECT_EQ(tensor->dataTypeMemorySize(), sizeof(float));
     EXPECT_EQ(tensor->vector(), vec);
 }
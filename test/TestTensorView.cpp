@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "gtest/gtest.h"
+
+#include "kompute/Kompute.hpp"
+#include "kompute/logger/Logger.hpp"
+
+#include "shaders/Utils.hpp"
+
+static const std::string shaderAddOne(R"(
+    #version 450
+
+    layout (local_size_x = 1) in;
+
+    layout(set = 0, binding = 0) buffer a { float pa[]; };
+    layout(set = 0, binding = 1) buffer b { float pb[]; };
+
+    void main() {
+        uint index = gl_GlobalInvocationID.x;
+        pb[index] = pa[index] + 1.0;
+    }
+)");
+
+// Number of floats between two offsets aligned for storage buffer bindings
+static uint32_t
+alignedStride(kp::Manager& mgr)
+{
+    vk::DeviceSize alignment =
+      mgr.getDeviceProperties().limits.minStorageBufferOffsetAlignment;
+    return std::max<uint32_t>(4, (uint32_t)(alignment / sizeof(float)));
+}
+
+TEST(TestTensorView, AlgorithmBindsViews)
+{
+    kp::Manager mgr;
+
+    uint32_t stride = alignedStride(mgr);
+
+    std::vector<float> data(stride * 2, 0);
+    data[0] = 1;
+    data[1] = 2;
+    data[2] = 3;
+
+    std::shared_ptr<kp::TensorT<float>> parent = mgr.tensor(data);
+    std::shared_ptr<kp::TensorView> viewA = mgr.tensorView(parent, 0, 3);
+    std::shared_ptr<kp::TensorView> viewB = mgr.tensorView(parent, stride, 3);
+
+    EXPECT_EQ(viewA->getParent(), parent);
+    EXPECT_EQ(viewB->getMemoryOffset(), stride * sizeof(float));
+    EXPECT_EQ(viewB->size(), 3);
+
+    std::shared_ptr<kp::Algorithm> algorithm =
+      mgr.algorithm({ viewA, viewB }, compileSource(shaderAddOne));
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ parent })
+      ->record<kp::OpAlgoDispatch>(algorithm)
+      ->record<kp::OpSyncLocal>({ viewB })
+      ->eval();
+
+    EXPECT_EQ(viewB->vector<float>(), std::vector<float>({ 2, 3, 4 }));
+
+    // Only the range of the view is synced back into the parent
+    EXPECT_EQ(parent->data()[stride - 1], 0);
+    EXPECT_EQ(parent->data()[stride], 2);
+}
+
+TEST(TestTensorView, CopyAndSyncViews)
+{
+    kp::Manager mgr;
+
+    uint32_t stride = alignedStride(mgr);
+
+    std::shared_ptr<kp::TensorT<float>> parent =
+      mgr.tensorT<float>(stride * 2);
+    std::shared_ptr<kp::TensorT<float>> tensorOut = mgr.tensorT<float>(3);
+
+    std::shared_ptr<kp::TensorView> viewA = mgr.tensorView(parent, 0, 3);
+    std::shared_ptr<kp::TensorView> viewB = mgr.tensorView(parent, stride, 3);
+
+    viewA->setData(std::vector<float>({ 1, 2, 3 }));
+    EXPECT_EQ(parent->data()[1], 2);
+
+    mgr.sequence()
+      ->record<kp::OpSyncDevice>({ viewA })
+      ->record<kp::OpCopy>({ viewA, viewB, tensorOut })
+      ->record<kp::OpSyncLocal>({ viewB, tensorOut })
+      ->eval();
+
+    EXPECT_EQ(viewB->vector<float>(), std::vector<float>({ 1, 2, 3 }));
+    EXPECT_EQ(tensorOut->vector(), std::vector<float>({ 1, 2, 3 }));
+}
+
+TEST(TestTensorView, ViewsOfViews)
+{
+    kp::Manager mgr;
+
+    uint32_t stride = alignedStride(mgr);
+
+    std::shared_ptr<kp::TensorT<float>> parent =
+      mgr.tensor(std::vector<float>(stride * 3, 1));
+
+    std::shared_ptr<kp::TensorView> view =
+      mgr.tensorView(parent, stride, stride * 2);
+    std::shared_ptr<kp::TensorView> nestedView =
+      mgr.tensorView(view, stride, 2);
+
+    EXPECT_EQ(nestedView->getParent(), parent);
+    EXPECT_EQ(nestedView->getMemoryOffset(), stride * 2 * sizeof(float));
+
+    nestedView->setData(std::vector<float>({ 5, 6 }));
+    EXPECT_EQ(parent->data()[stride * 2 + 1], 6);
+}
+
+TEST(TestTensorView, InvalidViewsThrow)
+{
+    kp::Manager mgr;
+
+    uint32_t stride = alignedStride(mgr);
+
+    std::shared_ptr<kp::TensorT<float>> parent =
+      mgr.tensorT<float>(stride * 2);
+
+    EXPECT_ANY_THROW(mgr.tensorView(parent, stride, stride + 1));
+    EXPECT_ANY_THROW(mgr.tensorView(parent, 0, 0));
+
+    if (mgr.getDeviceProperties().limits.minStorageBufferOffsetAlignment >
+        sizeof(float)) {
+        EXPECT_ANY_THROW(mgr.tensorView(parent, 1, 1));
+    }
+}